@@ -27,8 +27,9 @@
 
 #include <cassert>
 #include <utility>
-#include <memory>     // for std::allocator
+#include <memory>     // for std::allocator and std::allocator_traits
 #include <functional> // for std::less
+#include <type_traits> // for std::enable_if
 #include <utility>    // for std::pair
 
 class TestBST; // forward declaration for unit tests
@@ -43,31 +44,46 @@ namespace custom
    template <typename KK, typename VV>
    class map;
 
+/*****************************************************
+ * IS LOOKUP KEY
+ * A type other than T that compares both ways with T,
+ * like a const char * against a std::string. Looking
+ * one up need not build a T first. Numbers are left
+ * out so they still convert to T, as they always have.
+ ****************************************************/
+template <class T, class K, class = void>
+struct is_lookup_key : std::false_type {};
+
+template <class T, class K>
+struct is_lookup_key <T, K, decltype((void)(std::declval<const K&>() < std::declval<const T&>()),
+                                     (void)(std::declval<const T&>() < std::declval<const K&>()))>
+   : std::integral_constant<bool, !std::is_same<K, T>::value && !std::is_arithmetic<K>::value> {};
+
 /*****************************************************************
  * BINARY SEARCH TREE
  * Create a Binary Search Tree
  *****************************************************************/
-template <typename T>
+template <typename T, typename A = std::allocator<T>>
 class BST
 {
    friend class ::TestBST; // give unit tests access to the privates
    friend class ::TestSet;
    friend class ::TestMap;
 
-   template <class TT>
+   template <class TT, class AA>
    friend class custom::set;
 
-   template <class KK, class VV>
+   template <class KK, class VV, class AA>
    friend class custom::map;
 public:
    //
    // Construct
    //
 
-   BST();
+   BST(const A& a = A());
    BST(const BST &  rhs);
    BST(      BST && rhs);
-   BST(const std::initializer_list<T>& il);
+   BST(const std::initializer_list<T>& il, const A& a = A());
    ~BST();
 
    //
@@ -92,6 +108,8 @@ public:
    //
 
    iterator find(const T& t);
+   template <class K, class = typename std::enable_if<is_lookup_key<T, K>::value>::type>
+   iterator find(const K& k);
 
    // 
    // Insert
@@ -117,8 +135,16 @@ public:
 private:
 
    class BNode;
+
+   // every node is allocated and freed through the allocator
+   typedef typename std::allocator_traits<A>::template rebind_alloc<BNode> NodeAlloc;
+   template <typename ... Args>
+   BNode* newNode(Args&& ... args);
+   void destroyNode(BNode* pNode);
+
    BNode * root;              // root node of the binary search tree
    size_t numElements;        // number of elements currently in the tree
+   A alloc;                   // where the nodes come from
 
    void _clear(BNode*& pThis)
    {
@@ -127,7 +153,7 @@ private:
 
       _clear(pThis->pLeft);   // L
       _clear(pThis->pRight);  // R
-      delete pThis;           // V
+      destroyNode(pThis);     // V
       pThis = nullptr;
    }
 
@@ -141,7 +167,7 @@ private:
       {
          // Destination is empty test case.
          if (!pDest)
-            pDest = new BNode(pSrc->data);
+            pDest = newNode(pSrc->data);
 
          // Neither the source nor destination are empty.
          else
@@ -163,12 +189,12 @@ private:
 
    }
 
-   std::pair<typename BST<T>::iterator, bool>_insert(BNode*& pNode, const T& t, bool keepUnique)
+   std::pair<typename BST<T, A>::iterator, bool>_insert(BNode*& pNode, const T& t, bool keepUnique)
    {
       // empty tree.
       if (!pNode)
       {
-         pNode = new BNode(t);
+         pNode = newNode(t);
          return std::make_pair(iterator(pNode), true);
       }
 
@@ -184,7 +210,7 @@ private:
          if (pNode->pLeft)
             return _insert(pNode->pLeft, t, keepUnique);
 
-         pNode->addLeft(t);
+         pNode->addLeft(newNode(t));
          pNode->pLeft->balance();
          return std::make_pair(iterator(root->pLeft), true);
       }
@@ -193,18 +219,18 @@ private:
       if (pNode->pRight)
          return _insert(pNode->pRight, t, keepUnique);
 
-      pNode->addRight(t);
+      pNode->addRight(newNode(t));
       pNode->pRight->balance();
       return std::make_pair(iterator(root->pRight), true);
       
    }
 
-   std::pair<typename BST<T>::iterator, bool>_insertMove(BNode*& pNode, T && t, bool keepUnique)
+   std::pair<typename BST<T, A>::iterator, bool>_insertMove(BNode*& pNode, T && t, bool keepUnique)
    {
       // empty tree.
       if (!pNode)
       {
-         pNode = new BNode(t);
+         pNode = newNode(t);
          return std::make_pair(iterator(pNode), true);
       }
 
@@ -222,7 +248,7 @@ private:
             return _insertMove(pNode->pLeft, std::move(t), keepUnique);
 
          // we can now insert the node to the left and balance the tree.
-         pNode->addLeft(std::move(t));
+         pNode->addLeft(newNode(std::move(t)));
          pNode->pLeft->balance();
          return std::make_pair(iterator(root->pLeft), true);
       }
@@ -231,7 +257,7 @@ private:
       if (pNode->pRight)
          return _insertMove(pNode->pRight, std::move(t), keepUnique);
 
-      pNode->addRight(std::move(t));
+      pNode->addRight(newNode(std::move(t)));
       pNode->pRight->balance();
       return std::make_pair(iterator(root->pRight), true);
       
@@ -244,8 +270,8 @@ private:
  * A single node in a binary tree. Note that the node does not know
  * anything about the properties of the tree so no validation can be done.
  *****************************************************************/
-template <typename T>
-class BST <T> :: BNode
+template <typename T, typename A>
+class BST <T, A> :: BNode
 {
 public:
    // 
@@ -260,10 +286,6 @@ public:
    //
    void addLeft (BNode * pNode);
    void addRight(BNode * pNode);
-   void addLeft (const T &  t);
-   void addRight(const T &  t);
-   void addLeft(       T && t);
-   void addRight(      T && t);
 
    // 
    // Status
@@ -298,14 +320,14 @@ public:
  * BINARY SEARCH TREE ITERATOR
  * Forward and reverse iterator through a BST
  *********************************************************/
-template <typename T>
-class BST <T> :: iterator
+template <typename T, typename A>
+class BST <T, A> :: iterator
 {
    friend class ::TestBST; // give unit tests access to the privates
    friend class ::TestSet;
    friend class ::TestMap;
 
-   template <class KK, class VV>
+   template <class KK, class VV, class AA>
    friend class custom::map;
 public:
    // constructors and assignment
@@ -354,7 +376,7 @@ public:
    }
 
    // must give friend status to remove so it can call getNode() from it
-   friend BST <T> :: iterator BST <T> :: erase(iterator & it);
+   friend BST <T, A> :: iterator BST <T, A> :: erase(iterator & it);
 
 private:
    
@@ -372,18 +394,55 @@ private:
  *********************************************/
 
 
+
+/*********************************************
+ * BST :: NEW NODE
+ * Allocate a node through the allocator and
+ * construct it from the arguments
+ ********************************************/
+template <typename T, typename A>
+template <typename ... Args>
+typename BST <T, A> ::BNode* BST <T, A> ::newNode(Args&& ... args)
+{
+   NodeAlloc allocNode(alloc);
+   BNode* pNew = std::allocator_traits<NodeAlloc>::allocate(allocNode, 1);
+   try
+   {
+      std::allocator_traits<NodeAlloc>::construct(allocNode, pNew, std::forward<Args>(args)...);
+   }
+   catch (...)
+   {
+      std::allocator_traits<NodeAlloc>::deallocate(allocNode, pNew, 1);
+      throw;
+   }
+   return pNew;
+}
+
+/*********************************************
+ * BST :: DESTROY NODE
+ * Destroy a node and give its memory back
+ * to the allocator
+ ********************************************/
+template <typename T, typename A>
+void BST <T, A> ::destroyNode(BNode* pNode)
+{
+   NodeAlloc allocNode(alloc);
+   std::allocator_traits<NodeAlloc>::destroy(allocNode, pNode);
+   std::allocator_traits<NodeAlloc>::deallocate(allocNode, pNode, 1);
+}
+
  /*********************************************
   * BST :: DEFAULT CONSTRUCTOR
   ********************************************/
-template <typename T>
-BST <T> ::BST() : numElements(0), root(nullptr){}
+template <typename T, typename A>
+BST <T, A> ::BST(const A& a) : alloc(a), numElements(0), root(nullptr){}
 
 /*********************************************
  * BST :: COPY CONSTRUCTOR
  * Copy one tree to another
  ********************************************/
-template <typename T>
-BST <T> :: BST ( const BST<T>& rhs) : root(nullptr), numElements(rhs.numElements)
+template <typename T, typename A>
+BST <T, A> :: BST ( const BST<T, A>& rhs) : alloc(rhs.alloc), root(nullptr), numElements(rhs.numElements)
 {
    *this = rhs;
 }
@@ -392,8 +451,8 @@ BST <T> :: BST ( const BST<T>& rhs) : root(nullptr), numElements(rhs.numElements
  * BST :: MOVE CONSTRUCTOR
  * Move one tree to another
  ********************************************/
-template <typename T>
-BST <T> :: BST(BST <T> && rhs) : root(rhs.root), numElements(rhs.numElements)
+template <typename T, typename A>
+BST <T, A> :: BST(BST <T, A> && rhs) : alloc(rhs.alloc), root(rhs.root), numElements(rhs.numElements)
 {
    rhs.root = nullptr;
    rhs.numElements = 0;
@@ -403,8 +462,8 @@ BST <T> :: BST(BST <T> && rhs) : root(rhs.root), numElements(rhs.numElements)
  * BST :: INITIALIZER LIST CONSTRUCTOR
  * Create a BST from an initializer list
  ********************************************/
-template <typename T>
-BST <T> ::BST(const std::initializer_list<T>& il) : root(nullptr), numElements(il.size())
+template <typename T, typename A>
+BST <T, A> ::BST(const std::initializer_list<T>& il, const A& a) : alloc(a), root(nullptr), numElements(il.size())
 {
    *this = il;
 }
@@ -412,8 +471,8 @@ BST <T> ::BST(const std::initializer_list<T>& il) : root(nullptr), numElements(i
 /*********************************************
  * BST :: DESTRUCTOR
  ********************************************/
-template <typename T>
-BST <T> :: ~BST()
+template <typename T, typename A>
+BST <T, A> :: ~BST()
 {
    clear();
 }
@@ -423,8 +482,8 @@ BST <T> :: ~BST()
  * BST :: ASSIGNMENT OPERATOR
  * Copy one tree to another
  ********************************************/
-template <typename T>
-BST <T> & BST <T> :: operator = (const BST <T> & rhs)
+template <typename T, typename A>
+BST <T, A> & BST <T, A> :: operator = (const BST <T, A> & rhs)
 {
    _assign(root, rhs.root);
    numElements = rhs.numElements;
@@ -435,8 +494,8 @@ BST <T> & BST <T> :: operator = (const BST <T> & rhs)
  * BST :: ASSIGNMENT OPERATOR with INITIALIZATION LIST
  * Copy nodes onto a BTree
  ********************************************/
-template <typename T>
-BST <T> & BST <T> :: operator = (const std::initializer_list<T>& il)
+template <typename T, typename A>
+BST <T, A> & BST <T, A> :: operator = (const std::initializer_list<T>& il)
 {
     clear(); // Clear the existing tree
 
@@ -450,8 +509,8 @@ BST <T> & BST <T> :: operator = (const std::initializer_list<T>& il)
  * BST :: ASSIGN-MOVE OPERATOR
  * Move one tree to another
  ********************************************/
-template <typename T>
-BST <T> & BST <T> :: operator = (BST <T> && rhs)
+template <typename T, typename A>
+BST <T, A> & BST <T, A> :: operator = (BST <T, A> && rhs)
 {
    clear();
    swap(rhs);
@@ -462,12 +521,15 @@ BST <T> & BST <T> :: operator = (BST <T> && rhs)
  * BST :: SWAP
  * Swap two trees
  ********************************************/
-template <typename T>
-void BST <T> :: swap (BST <T>& rhs)
+template <typename T, typename A>
+void BST <T, A> :: swap (BST <T, A>& rhs)
 {
    // swap the root pointers of the two trees.
    std::swap(root, rhs.root);
 
+   // the nodes stay with the allocator that made them
+   std::swap(alloc, rhs.alloc);
+
    // swap the number of elements.
    std::swap(numElements, rhs.numElements);
 }
@@ -476,8 +538,8 @@ void BST <T> :: swap (BST <T>& rhs)
  * BST :: INSERT
  * Insert a node at a given location in the tree
  ****************************************************/
-template <typename T>
-std::pair<typename BST <T> :: iterator, bool> BST <T> :: insert(const T & t, bool keepUnique)
+template <typename T, typename A>
+std::pair<typename BST <T, A> :: iterator, bool> BST <T, A> :: insert(const T & t, bool keepUnique)
 {
    // if there is a node in the root then populate the tree.
    if (root)
@@ -496,15 +558,15 @@ std::pair<typename BST <T> :: iterator, bool> BST <T> :: insert(const T & t, boo
    // empty tree.
    else
    {
-      root = new BNode(t);
+      root = newNode(t);
       root->isRed = false;  // Root is always black in a red-black tree
       numElements++;
       return std::make_pair(iterator(root), true);
    }
 }
 
-template <typename T>
-std::pair<typename BST <T> ::iterator, bool> BST <T> ::insert(T && t, bool keepUnique)
+template <typename T, typename A>
+std::pair<typename BST <T, A> ::iterator, bool> BST <T, A> ::insert(T && t, bool keepUnique)
 {
    // if there is a node in the root then populate the tree.
    if (root)
@@ -523,7 +585,7 @@ std::pair<typename BST <T> ::iterator, bool> BST <T> ::insert(T && t, bool keepU
    // empty tree.
    else
    {
-      root = new BNode(t);
+      root = newNode(t);
       root->isRed = false;  // Root is always black in a red-black tree.
       numElements++;
       return std::make_pair(iterator(root), true);
@@ -535,8 +597,8 @@ std::pair<typename BST <T> ::iterator, bool> BST <T> ::insert(T && t, bool keepU
  * BST :: ERASE
  * Remove a given node as specified by the iterator
  ************************************************/
-template <typename T>
-typename BST <T> ::iterator BST <T> :: erase(iterator & it)
+template <typename T, typename A>
+typename BST <T, A> ::iterator BST <T, A> :: erase(iterator & it)
 {  
     if (!it.pNode)
         return it;
@@ -552,7 +614,7 @@ typename BST <T> ::iterator BST <T> :: erase(iterator & it)
            it.pNode->pParent->pRight = nullptr :
            it.pNode->pParent->pLeft = nullptr;
 
-        delete it.pNode;
+        destroyNode(it.pNode);
         --numElements;
         return itNext;
     }
@@ -570,7 +632,7 @@ typename BST <T> ::iterator BST <T> :: erase(iterator & it)
            it.pNode->pParent->pRight = it.pNode->pLeft :
            it.pNode->pParent->pLeft = it.pNode->pLeft;
 
-        delete it.pNode;
+        destroyNode(it.pNode);
         --numElements;
         return itNext;
     }
@@ -587,7 +649,7 @@ typename BST <T> ::iterator BST <T> :: erase(iterator & it)
            it.pNode->pParent->pRight = it.pNode->pRight :
            it.pNode->pParent->pLeft = it.pNode->pRight;
 
-        delete it.pNode;
+        destroyNode(it.pNode);
         --numElements;
         return itNext;
     }
@@ -627,7 +689,7 @@ typename BST <T> ::iterator BST <T> :: erase(iterator & it)
             it.pNode->pRight->pParent = pSuccessor.pNode;
 
         // Delete the erased node and update the numElements
-        delete it.pNode;
+        destroyNode(it.pNode);
         --numElements;
         return pSuccessor;
     }
@@ -639,8 +701,8 @@ typename BST <T> ::iterator BST <T> :: erase(iterator & it)
  * BST :: CLEAR
  * Removes all the BNodes from a tree
  ****************************************************/
-template <typename T>
-void BST <T> ::clear() noexcept
+template <typename T, typename A>
+void BST <T, A> ::clear() noexcept
 {
    numElements = 0;
    _clear(root);
@@ -650,14 +712,14 @@ void BST <T> ::clear() noexcept
  * BST :: BEGIN
  * Return the first node (left-most) in a binary search tree
  ****************************************************/
-template <typename T>
-typename BST <T> :: iterator custom :: BST <T> :: begin() const noexcept
+template <typename T, typename A>
+typename BST <T, A> :: iterator custom :: BST <T, A> :: begin() const noexcept
 {
    // if it's empty, return end.
    if (empty())
       return end();
 
-   BST<T>::BNode* pNode = root;
+   BST<T, A>::BNode* pNode = root;
 
    while (pNode->pLeft)
       pNode = pNode->pLeft;
@@ -669,8 +731,8 @@ typename BST <T> :: iterator custom :: BST <T> :: begin() const noexcept
  * BST :: FIND
  * Return the node corresponding to a given value
  ****************************************************/
-template <typename T>
-typename BST <T> :: iterator BST<T> :: find(const T & t)
+template <typename T, typename A>
+typename BST <T, A> :: iterator BST<T, A> :: find(const T & t)
 {
    auto p = root;
 
@@ -692,6 +754,26 @@ typename BST <T> :: iterator BST<T> :: find(const T & t)
    return end();
 }
 
+/****************************************************
+ * BST :: FIND
+ * Look up a key that compares with T without
+ * building a T to compare against
+ ****************************************************/
+template <typename T, typename A>
+template <class K, class>
+typename BST <T, A> ::iterator BST<T, A> ::find(const K& k)
+{
+   for (BNode* p = root; p != nullptr; )
+      if (k < p->data)
+         p = p->pLeft;
+      else if (p->data < k)
+         p = p->pRight;
+      else
+         return iterator(p);
+
+   return end();
+}
+
 /******************************************************
  ******************************************************
  ******************************************************
@@ -705,8 +787,8 @@ typename BST <T> :: iterator BST<T> :: find(const T & t)
  * BINARY NODE :: ADD LEFT
  * Add a node to the left of the current node
  ******************************************************/
-template <typename T>
-void BST <T> :: BNode :: addLeft (BNode * pNode)
+template <typename T, typename A>
+void BST <T, A> :: BNode :: addLeft (BNode * pNode)
 {
     // If pNode is not null...
     if (pNode)
@@ -721,8 +803,8 @@ void BST <T> :: BNode :: addLeft (BNode * pNode)
  * BINARY NODE :: ADD RIGHT
  * Add a node to the right of the current node
  ******************************************************/
-template <typename T>
-void BST <T> :: BNode :: addRight (BNode * pNode)
+template <typename T, typename A>
+void BST <T, A> :: BNode :: addRight (BNode * pNode)
 {
     // If pNode is not null...
     if (pNode)
@@ -733,82 +815,14 @@ void BST <T> :: BNode :: addRight (BNode * pNode)
     this->pRight = pNode;
 }
 
-/******************************************************
- * BINARY NODE :: ADD LEFT
- * Add a node to the left of the current node
- ******************************************************/
-template <typename T>
-void BST<T> :: BNode :: addLeft (const T & t)
-{
-    // Create the new node.
-   BST<T>:: BNode* pAdd = new BST<T>::BNode(t);
-
-    // Make it's parent the Node we're adding it from.
-    pAdd->pParent = this;
-
-    // Attatch it to it's parents pLeft.
-    this->pLeft = pAdd;
-}
-
-/******************************************************
- * BINARY NODE :: ADD LEFT
- * Add a node to the left of the current node
- ******************************************************/
-template <typename T>
-void BST<T> ::BNode::addLeft(T && t)
-{
-    // Create the new node.
-    BST<T>::BNode* pAdd = new BST<T>::BNode(std::move(t));
-
-    // Make it's parent the Node we're adding it from.
-    pAdd->pParent = this;
-
-    // Attatch it to it's parents pLeft.
-    this->pLeft = pAdd;
-}
-
-/******************************************************
- * BINARY NODE :: ADD RIGHT
- * Add a node to the right of the current node
- ******************************************************/
-template <typename T>
-void BST <T> :: BNode :: addRight (const T & t)
-{
-    // Create the new node.
-    BST<T>::BNode* pAdd = new BST<T>::BNode(t);
-
-    // Make it's parent the Node we're adding it from.
-    pAdd->pParent = this;
-
-    // Attatch it to it's parents pRight.
-    this->pRight = pAdd;
-}
-
-/******************************************************
- * BINARY NODE :: ADD RIGHT
- * Add a node to the right of the current node
- ******************************************************/
-template <typename T>
-void BST <T> ::BNode::addRight(T && t)
-{
-    // Create the new node.
-    BST<T>::BNode* pAdd = new BST<T>::BNode(std::move(t));
-
-    // Make it's parent the Node we're adding it from.
-    pAdd->pParent = this;
-
-    // Attatch it to it's parents pRight.
-    this->pRight = pAdd;
-}
-
 #ifdef DEBUG
 /****************************************************
  * BINARY NODE :: FIND DEPTH
  * Find the depth of the black nodes. This is useful for
  * verifying that a given red-black tree is valid
  ****************************************************/
-template <typename T>
-int BST <T> :: BNode :: findDepth() const
+template <typename T, typename A>
+int BST <T, A> :: BNode :: findDepth() const
 {
    // if there are no children, the depth is ourselves
    if (pRight == nullptr && pLeft == nullptr)
@@ -825,8 +839,8 @@ int BST <T> :: BNode :: findDepth() const
  * BINARY NODE :: VERIFY RED BLACK
  * Do all four red-black rules work here?
  ***************************************************/
-template <typename T>
-bool BST <T> :: BNode :: verifyRedBlack(int depth) const
+template <typename T, typename A>
+bool BST <T, A> :: BNode :: verifyRedBlack(int depth) const
 {
    bool fReturn = true;
    depth -= (isRed == false) ? 1 : 0;
@@ -870,8 +884,8 @@ bool BST <T> :: BNode :: verifyRedBlack(int depth) const
  * VERIFY B TREE
  * Verify that the tree is correctly formed
  ******************************************************/
-template <typename T>
-std::pair <T, T> BST <T> :: BNode :: verifyBTree() const
+template <typename T, typename A>
+std::pair <T, T> BST <T, A> :: BNode :: verifyBTree() const
 {
    // largest and smallest values
    std::pair <T, T> extremes;
@@ -914,8 +928,8 @@ std::pair <T, T> BST <T> :: BNode :: verifyBTree() const
  * COMPUTE SIZE
  * Verify that the BST is as large as we think it is
  ********************************************/
-template <typename T>
-int BST <T> :: BNode :: computeSize() const
+template <typename T, typename A>
+int BST <T, A> :: BNode :: computeSize() const
 {
    return 1 +
       (pLeft  == nullptr ? 0 : pLeft->computeSize()) +
@@ -927,8 +941,8 @@ int BST <T> :: BNode :: computeSize() const
  * BINARY NODE :: BALANCE
  * Balance the tree from a given location
  ******************************************************/
-template <typename T>
-void BST <T> :: BNode :: balance()
+template <typename T, typename A>
+void BST <T, A> :: BNode :: balance()
 {
    // Case 1: if we are the root, then color ourselves black and call it a day.
    if (!pParent)
@@ -1082,8 +1096,8 @@ void BST <T> :: BNode :: balance()
  * BST ITERATOR :: INCREMENT PREFIX
  * advance by one
  *************************************************/
-template <typename T>
-typename BST <T> :: iterator & BST <T> :: iterator :: operator ++ ()
+template <typename T, typename A>
+typename BST <T, A> :: iterator & BST <T, A> :: iterator :: operator ++ ()
 {
     if (pNode)
     {
@@ -1124,8 +1138,8 @@ typename BST <T> :: iterator & BST <T> :: iterator :: operator ++ ()
  * BST ITERATOR :: DECREMENT PREFIX
  * advance by one
  *************************************************/
-template <typename T>
-typename BST <T>::iterator& BST <T>::iterator::operator--()
+template <typename T, typename A>
+typename BST <T, A>::iterator& BST <T, A>::iterator::operator--()
 {
     if (pNode != nullptr)
     {
@@ -0,0 +1,292 @@
+/***********************************************************************
+ * Header:
+ *    POOL
+ * Summary:
+ *    A fixed-size node pool and an allocator that draws from it
+ *      __      __     _______        __
+ *     /  |    /  |   |  _____|   _  / /
+ *     `| |    `| |   | |____    (_)/ /
+ *      | |     | |   '_.____''.   / / _
+ *     _| |_   _| |_  | \____) |  / / (_)
+ *    |_____| |_____|  \______.' /_/
+ *
+ *    This will contain the class definition of:
+ *        node_pool          : Recycles blocks of one size on a free list
+ *        pool_allocator     : An allocator for any custom container
+ *                             that keeps its nodes in a node_pool
+ * Author
+ *    Peter Benson, Jarom Diaz, Isaac Radford
+ ************************************************************************/
+
+#pragma once
+
+#include <cassert>     // because I am paranoid
+#include <cstddef>     // for std::ptrdiff_t and std::max_align_t
+#include <new>         // for ::operator new and placement new
+#include <utility>     // for std::forward
+
+class TestPool;        // forward declaration for unit tests
+
+namespace custom
+{
+
+/*****************************************
+ * NODE POOL
+ * Hands out blocks that are all the same size. A freed
+ * block goes on a free list and is the next one handed
+ * out, so insert/erase churn never reaches malloc. New
+ * blocks are carved in order out of slabs that double in
+ * size, so nodes allocated together sit next to each
+ * other in memory.
+ *
+ * Each thread has its own pool per block size and
+ * alignment, shared by every container on that thread,
+ * so threads never contend for a free list and need no
+ * lock. A block may be given back on another thread: it
+ * joins that thread's free list, and blocks_in_use()
+ * then only balances across the threads together.
+ ****************************************/
+template <size_t sizeNode, size_t alignNode>
+class node_pool
+{
+   friend class ::TestPool;    // give unit tests access to the privates
+public:
+   // a free block must hold the free list pointer
+   static const size_t ALIGN = alignNode < alignof(void *) ? alignof(void *) : alignNode;
+   static const size_t SIZE  = ((sizeNode < sizeof(void *) ? sizeof(void *) : sizeNode) + ALIGN - 1) / ALIGN * ALIGN;
+   static_assert(ALIGN <= alignof(std::max_align_t), "slabs come from ::operator new");
+
+   //
+   // Construct
+   //
+   node_pool() : pSlabs(nullptr), pFree(nullptr), pNext(nullptr), pEnd(nullptr),
+      numSlabBlocks(32), numSlabs(0), numInUse(0) {}
+   node_pool(const node_pool & rhs) = delete;
+   node_pool & operator = (const node_pool & rhs) = delete;
+   ~node_pool() { release(); }
+
+   // the pool every pool_allocator of this size shares on this thread
+   static node_pool & instance();
+
+   //
+   // Allocate
+   //
+   void * allocate();
+   void deallocate(void * p) noexcept;
+   void release() noexcept;
+
+   //
+   // Status
+   //
+   size_t slabs()         const noexcept { return numSlabs;  }
+   size_t blocks_in_use() const noexcept { return numInUse;  }
+   size_t blocks_free()   const noexcept;
+
+private:
+   struct Block
+   {
+      Block * pNext;           // next block on the free list or slab chain
+   };
+
+   void addSlab();
+
+   Block * pSlabs;             // most recent slab, the head of the chain
+   Block * pFree;              // blocks given back, the first to be reused
+   char  * pNext;              // next never-used block in the most recent slab
+   char  * pEnd;               // one past the last block of that slab
+   size_t  numSlabBlocks;      // number of blocks in the next slab
+   size_t  numSlabs;           // number of slabs in the chain
+   size_t  numInUse;           // number of blocks handed out and not returned
+};
+
+/*****************************************
+ * NODE POOL :: INSTANCE
+ * This thread's pool. It is never destroyed, so containers
+ * with static storage can still give their nodes back at
+ * exit, and a node freed after its thread ends still
+ * points at live memory.
+ ****************************************/
+template <size_t sizeNode, size_t alignNode>
+node_pool <sizeNode, alignNode> & node_pool <sizeNode, alignNode> :: instance()
+{
+   static thread_local node_pool * pPool = new node_pool;
+   return *pPool;
+}
+
+/*****************************************
+ * NODE POOL :: ALLOCATE
+ * Reuse a freed block if there is one, otherwise
+ * take the next block of the current slab
+ ****************************************/
+template <size_t sizeNode, size_t alignNode>
+void * node_pool <sizeNode, alignNode> :: allocate()
+{
+   numInUse++;
+
+   if (pFree)
+   {
+      Block * pBlock = pFree;
+      pFree = pFree->pNext;
+      return pBlock;
+   }
+
+   if (pNext == pEnd)
+      addSlab();
+
+   void * p = pNext;
+   pNext += SIZE;
+   return p;
+}
+
+/*****************************************
+ * NODE POOL :: DEALLOCATE
+ * Push the block on the free list
+ ****************************************/
+template <size_t sizeNode, size_t alignNode>
+void node_pool <sizeNode, alignNode> :: deallocate(void * p) noexcept
+{
+   if (p == nullptr)
+      return;
+
+   // no assert on numInUse: the block may have come from another thread's pool
+   Block * pBlock = (Block *)p;
+   pBlock->pNext = pFree;
+   pFree = pBlock;
+   numInUse--;
+}
+
+/*****************************************
+ * NODE POOL :: ADD SLAB
+ * Chain on a slab twice the size of the last one.
+ * The first block of a slab links the chain.
+ ****************************************/
+template <size_t sizeNode, size_t alignNode>
+void node_pool <sizeNode, alignNode> :: addSlab()
+{
+   char * pSlab = (char *)::operator new((numSlabBlocks + 1) * SIZE);
+
+   ((Block *)pSlab)->pNext = pSlabs;
+   pSlabs = (Block *)pSlab;
+   pNext = pSlab + SIZE;
+   pEnd = pSlab + (numSlabBlocks + 1) * SIZE;
+
+   if (numSlabBlocks < 4096)
+      numSlabBlocks *= 2;
+   numSlabs++;
+}
+
+/*****************************************
+ * NODE POOL :: RELEASE
+ * Free every slab at once. Only call this when
+ * no block is in use.
+ ****************************************/
+template <size_t sizeNode, size_t alignNode>
+void node_pool <sizeNode, alignNode> :: release() noexcept
+{
+   while (pSlabs)
+   {
+      Block * pDelete = pSlabs;
+      pSlabs = pSlabs->pNext;
+      ::operator delete(pDelete);
+   }
+
+   pFree = nullptr;
+   pNext = pEnd = nullptr;
+   numSlabBlocks = 32;
+   numSlabs = 0;
+   numInUse = 0;
+}
+
+/*****************************************
+ * NODE POOL :: BLOCKS FREE
+ * How many blocks can be handed out before the
+ * next slab is needed
+ ****************************************/
+template <size_t sizeNode, size_t alignNode>
+size_t node_pool <sizeNode, alignNode> :: blocks_free() const noexcept
+{
+   size_t num = (pEnd - pNext) / SIZE;
+   for (Block * p = pFree; p; p = p->pNext)
+      num++;
+   return num;
+}
+
+/*****************************************
+ * POOL ALLOCATOR
+ * Keep a container's nodes in a node pool:
+ *    custom::list<int, custom::pool_allocator<int>> l;
+ * Containers rebind it to their node type, so each node
+ * type gets a pool of exactly its size. Requests for more
+ * than one object, such as a bucket array, go to the heap.
+ * A block can go back to any thread's pool, so every
+ * pool_allocator is equal.
+ ****************************************/
+template <typename T>
+class pool_allocator
+{
+public:
+   typedef T         value_type;
+   typedef T *       pointer;
+   typedef const T * const_pointer;
+   typedef T &       reference;
+   typedef const T & const_reference;
+   typedef size_t    size_type;
+   typedef std::ptrdiff_t difference_type;
+   typedef node_pool <sizeof(T), alignof(T)> pool_type;
+
+   template <typename U>
+   struct rebind
+   {
+      typedef pool_allocator<U> other;
+   };
+
+   //
+   // Construct
+   //
+   pool_allocator() noexcept {}
+   template <typename U>
+   pool_allocator(const pool_allocator<U> &) noexcept {}
+
+   //
+   // Allocate
+   //
+   T * allocate(size_t num)
+   {
+      if (num == 1)
+         return (T *)pool_type::instance().allocate();
+      return (T *)::operator new(num * sizeof(T));
+   }
+   void deallocate(T * p, size_t num) noexcept
+   {
+      if (num == 1)
+         pool_type::instance().deallocate(p);
+      else
+         ::operator delete(p);
+   }
+
+   //
+   // Construct and destroy elements
+   //
+   template <typename U, typename ... Args>
+   void construct(U * p, Args && ... args)
+   {
+      new ((void *)p) U(std::forward<Args>(args)...);
+   }
+   template <typename U>
+   void destroy(U * p)
+   {
+      p->~U();
+   }
+
+   //
+   // Status
+   //
+   static pool_type & resource() { return pool_type::instance(); }
+
+   template <typename U>
+   bool operator == (const pool_allocator<U> &) const noexcept { return true;  }
+   template <typename U>
+   bool operator != (const pool_allocator<U> &) const noexcept { return false; }
+};
+
+} // namespace custom
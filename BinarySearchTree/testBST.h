@@ -12,6 +12,8 @@
 #ifdef DEBUG
 
 #include "bst.h"
+#include "arena.h"
+#include "pool.h"
 #include "unitTest.h"
 #include "spy.h"
 
@@ -128,6 +130,14 @@ public:
       test_size_empty();
       test_size_standard();
 
+      // Lookup
+      test_find_lookupKey();
+
+      // Allocator
+      test_arena_insert();
+      test_arena_erase();
+      test_pool_churn();
+
       report("BST");
    }
    
@@ -4138,6 +4148,86 @@ public:
       bst.root = nullptr;
       bst.numElements = 0;
    }
+   /***************************************
+    * LOOKUP
+    ***************************************/
+
+   // find a string by a const char * without building a string
+   void test_find_lookupKey()
+   {  // setup
+      custom::BST<std::string> bst{ "50", "30", "70", "60" };
+      // exercise
+      auto itFound = bst.find("60");
+      auto itMissing = bst.find("65");
+      // verify
+      assertUnit(itFound != bst.end());
+      assertUnit(*itFound == std::string("60"));
+      assertUnit(itMissing == bst.end());
+   }  // teardown
+
+   /***************************************
+    * ALLOCATOR
+    ***************************************/
+
+   // every node of the tree comes out of the arena
+   void test_arena_insert()
+   {  // setup
+      custom::arena a;
+      {
+         custom::BST<Spy, custom::arena_allocator<Spy>> bst(a);
+         // exercise
+         bst.insert(Spy(50));
+         bst.insert(Spy(30));
+         bst.insert(Spy(70));
+         bst.insert(Spy(60));
+         // verify
+         assertUnit(bst.alloc.resource() == &a);
+         assertUnit(a.bytes_allocated() == 4 * sizeof(custom::BST<Spy, custom::arena_allocator<Spy>>::BNode));
+         assertUnit(bst.size() == 4);
+         Spy::reset();
+      }
+      assertUnit(Spy::numDestructor() == 4); // the tree still destroys its elements
+   }  // teardown
+
+   // erasing destroys the element but the memory stays in the arena
+   void test_arena_erase()
+   {  // setup
+      custom::arena a;
+      custom::BST<Spy, custom::arena_allocator<Spy>> bst(a);
+      bst.insert(Spy(50));
+      bst.insert(Spy(30));
+      size_t numBytes = a.bytes_allocated();
+      auto it = bst.find(Spy(30));
+      Spy::reset();
+      // exercise
+      bst.erase(it);
+      // verify
+      assertUnit(Spy::numDestructor() == 1);
+      assertUnit(a.bytes_allocated() == numBytes);
+      assertUnit(bst.size() == 1);
+   }  // teardown
+
+   // erase then insert reuses the same node
+   void test_pool_churn()
+   {  // setup
+      typedef custom::BST<int, custom::pool_allocator<int>> Tree;
+      typedef custom::pool_allocator<Tree::BNode> NodeAlloc;
+      Tree bst{ 50, 30, 70 };
+      size_t numSlabs = NodeAlloc::resource().slabs();
+      size_t numInUse = NodeAlloc::resource().blocks_in_use();
+      // exercise
+      for (int i = 0; i < 1000; i++)
+      {
+         auto it = bst.find(70);
+         bst.erase(it);
+         bst.insert(70);
+      }
+      // verify
+      assertUnit(NodeAlloc::resource().slabs() == numSlabs);
+      assertUnit(NodeAlloc::resource().blocks_in_use() == numInUse);
+      assertUnit(bst.size() == 3);
+   }  // teardown
+
 
   
 };
@@ -21,6 +21,7 @@
 
 #include <iostream>  // for OFSTREAM
 #include <cassert>
+#include "pool.h"    // for node_pool
 
 /*****************************************************************
  * BNODE
@@ -38,6 +39,24 @@ public:
    BNode(const T &  t) : data(t), pLeft(nullptr), pRight(nullptr), pParent(nullptr) {}
    BNode(T && t) : data(std::move(t)), pLeft(nullptr), pRight(nullptr), pParent(nullptr) {}
 
+   //
+   // Allocate
+   // Nodes come out of this thread's pool so adding and clearing do not go to malloc
+   //
+   static void * operator new(size_t size)
+   {
+      if (size != sizeof(BNode <T>))
+         return ::operator new(size);
+      return custom::node_pool <sizeof(BNode <T>), alignof(BNode <T>)> :: instance().allocate();
+   }
+   static void operator delete(void * p, size_t size) noexcept
+   {
+      if (size != sizeof(BNode <T>))
+         ::operator delete(p);
+      else
+         custom::node_pool <sizeof(BNode <T>), alignof(BNode <T>)> :: instance().deallocate(p);
+   }
+
    //
    // Data
    //
@@ -72,6 +72,10 @@ public:
       test_size_one();
       test_size_standard();
 
+      // Pool
+      test_pool_reuse();
+      test_pool_clear();
+
       report("BNode");
    }
 
@@ -1683,6 +1687,43 @@ public:
       }
    }
 
+   /***************************************
+    * POOL
+    ***************************************/
+
+   // a deleted node is the next one handed out
+   void test_pool_reuse()
+   {  // setup
+      typedef custom::node_pool <sizeof(BNode <Spy>), alignof(BNode <Spy>)> Pool;
+      BNode <Spy> * pFirst = new BNode <Spy>(Spy(26));
+      size_t numInUse = Pool::instance().blocks_in_use();
+      delete pFirst;
+      // exercise
+      BNode <Spy> * pSecond = new BNode <Spy>(Spy(49));
+      // verify
+      assertUnit(pSecond == pFirst);
+      assertUnit(pSecond->data == Spy(49));
+      assertUnit(Pool::instance().blocks_in_use() == numInUse);
+      // teardown
+      delete pSecond;
+   }
+
+   // clearing a tree gives every node back to the pool
+   void test_pool_clear()
+   {  // setup
+      typedef custom::node_pool <sizeof(BNode <int>), alignof(BNode <int>)> Pool;
+      size_t numInUse = Pool::instance().blocks_in_use();
+      BNode <int> * pRoot = new BNode <int>(50);
+      addLeft(pRoot, 30);
+      addRight(pRoot, 70);
+      assertUnit(Pool::instance().blocks_in_use() == numInUse + 3);
+      // exercise
+      clear(pRoot);
+      // verify
+      assertUnit(pRoot == nullptr);
+      assertUnit(Pool::instance().blocks_in_use() == numInUse);
+   }  // teardown
+
 };
 
 #endif // DEBUG
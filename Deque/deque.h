@@ -21,7 +21,8 @@
 
 // Debug stuff
 #include <cassert>
-#include <memory>   // for std::allocator
+#include <memory>   // for std::allocator and std::allocator_traits
+#include <utility>  // for std::move
 
 class TestDeque;    // forward declaration for TestDeque unit test class
 
@@ -40,13 +41,16 @@ public:
    // 
    // Construct
    //
-   deque(const A& a = A()) : data(nullptr), numCells(16), numBlocks(0),
+   deque(const A& a = A()) : alloc(a), data(nullptr), numCells(16), numBlocks(0),
          numElements(0), iaFront(0)
    {
    }
    deque(deque & rhs);
    ~deque()
    {
+      clear();
+      if (data)
+         deallocateBlocks(data, numBlocks);
    }
 
    //
@@ -167,6 +171,19 @@ private:
    // reallocate
    void reallocate(int numBlocksNew);
 
+   // the array of block pointers also comes from the allocator
+   typedef typename std::allocator_traits<A>::template rebind_alloc<T*> BlocksAlloc;
+   T** allocateBlocks(size_t num)
+   {
+      BlocksAlloc allocBlocks(alloc);
+      return std::allocator_traits<BlocksAlloc>::allocate(allocBlocks, num);
+   }
+   void deallocateBlocks(T** p, size_t num)
+   {
+      BlocksAlloc allocBlocks(alloc);
+      std::allocator_traits<BlocksAlloc>::deallocate(allocBlocks, p, num);
+   }
+
    A    alloc;                // use alloacator for memory allocation
    size_t numCells;           // number of cells in a block
    size_t numBlocks;          // number of blocks in the data array
@@ -270,7 +287,7 @@ private:
  * call the copy constructor on each element
  ****************************************/
 template <typename T, typename A>
-deque <T, A> ::deque(deque& rhs) : data(nullptr), numCells(16), numBlocks(0),
+deque <T, A> ::deque(deque& rhs) : alloc(rhs.alloc), data(nullptr), numCells(16), numBlocks(0),
 numElements(0), iaFront(0)
 {
    *this = rhs;
@@ -506,7 +523,7 @@ template <typename T, typename A>
 void deque <T, A> :: reallocate(int numBlocksNew)
 {
    // 1. Allocate a new array of pointers that is the requested size.
-   T** dataNew = new T * [numBlocksNew];
+   T** dataNew = allocateBlocks(numBlocksNew);
 
    // 2. Copy over the pointers, unwrapping as we go.
    int ibNew = 0;
@@ -531,15 +548,18 @@ void deque <T, A> :: reallocate(int numBlocksNew)
       auto ibFrontOld = ibFromID(0);
       auto ibBackOld = ibFromID(numElements - 1);
       auto ibBackNew = numElements / numCells;
-      dataNew[ibBackNew] = new T[numCells];
+      dataNew[ibBackNew] = alloc.allocate(numCells);
       for (size_t ic = 0; ic < icFromID(numElements - 1); ic++)
-         dataNew[ibBackNew][ic] = std::move(data[ibBackOld][ic]);
+      {
+         alloc.construct(&dataNew[ibBackNew][ic], std::move(data[ibBackOld][ic]));
+         alloc.destroy(&data[ibBackOld][ic]);
+      }
 
    }
 
   // 5. Change the deques member variables with the new ones.
   if (data)
-      delete[] data;
+      deallocateBlocks(data, numBlocks);
 
    data = dataNew;
    numBlocks = numBlocksNew;
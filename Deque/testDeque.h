@@ -12,6 +12,7 @@
 #ifdef DEBUG
 
 #include "deque.h"
+#include "arena.h"
 #include "unitTest.h"
 
 #include <iostream>
@@ -111,7 +112,9 @@ public:
       test_empty_empty();
       test_empty_standard();
 
-
+      //// Allocator
+      test_arena_pushback();
+      test_arena_destructor();
 
       report("Deque");
    }
@@ -375,7 +378,7 @@ public:
       d.numCells = 3;
       d.numElements = 1;
       d.numBlocks = 1;
-      d.data = new Spy * [1];
+      d.data = d.allocateBlocks(1);
       d.data[0] = d.alloc.allocate(d.numCells);
       d.alloc.construct(&d.data[0][1], Spy(99));
       d.iaFront = 1;
@@ -432,7 +435,7 @@ public:
       d.numCells = 3;
       d.numElements = 3;
       d.numBlocks = 2;
-      d.data = new Spy * [2];
+      d.data = d.allocateBlocks(2);
       d.data[0] = nullptr;
       d.data[1] = d.alloc.allocate(d.numCells);
       d.alloc.construct(&d.data[1][0], Spy(67));
@@ -499,7 +502,7 @@ public:
       d.numCells = 2;
       d.numElements = 3;
       d.numBlocks = 4;
-      d.data = new Spy * [4];
+      d.data = d.allocateBlocks(4);
       d.data[0] = d.alloc.allocate(d.numCells);
       d.data[1] = nullptr;
       d.data[2] = nullptr;
@@ -572,7 +575,7 @@ public:
       d.numCells = 3;
       d.numElements = 8;
       d.numBlocks = 3;
-      d.data = new Spy * [3];
+      d.data = d.allocateBlocks(3);
       d.data[0] = d.alloc.allocate(d.numCells);
       d.data[1] = d.alloc.allocate(d.numCells);
       d.data[2] = d.alloc.allocate(d.numCells);
@@ -874,7 +877,7 @@ public:
       dSrc.numCells = 3;
       dSrc.numElements = 3;
       dSrc.numBlocks = 7;
-      dSrc.data = new Spy * [7];
+      dSrc.data = dSrc.allocateBlocks(7);
       dSrc.data[0] = dSrc.alloc.allocate(dSrc.numCells);
       dSrc.data[1] = nullptr;
       dSrc.data[2] = nullptr;
@@ -1087,7 +1090,7 @@ public:
       dSrc.numCells = 3;
       dSrc.numElements = 3;
       dSrc.numBlocks = 7;
-      dSrc.data = new Spy * [7];
+      dSrc.data = dSrc.allocateBlocks(7);
       dSrc.data[0] = dSrc.alloc.allocate(dSrc.numCells);
       dSrc.data[1] = nullptr;
       dSrc.data[2] = nullptr;
@@ -1379,7 +1382,7 @@ public:
       d.numCells = 4;
       d.numElements = 2;
       d.numBlocks = 1;
-      d.data = new Spy * [1];
+      d.data = d.allocateBlocks(1);
       d.data[0] = d.alloc.allocate(d.numCells);
       d.alloc.construct(&d.data[0][2], Spy(11));
       d.alloc.construct(&d.data[0][3], Spy(28));
@@ -1443,7 +1446,7 @@ public:
       d.numCells = 3;
       d.numElements = 8;
       d.numBlocks = 3;
-      d.data = new Spy * [3];
+      d.data = d.allocateBlocks(3);
       d.data[0] = d.alloc.allocate(d.numCells);
       d.data[1] = d.alloc.allocate(d.numCells);
       d.data[2] = d.alloc.allocate(d.numCells);
@@ -1700,7 +1703,7 @@ public:
       d.numCells = 4;
       d.numElements = 2;
       d.numBlocks = 1;
-      d.data = new Spy * [1];
+      d.data = d.allocateBlocks(1);
       d.data[0] = d.alloc.allocate(d.numCells);
       d.alloc.construct(&d.data[0][0], Spy(11));
       d.alloc.construct(&d.data[0][1], Spy(28));
@@ -1767,7 +1770,7 @@ public:
       d.numCells = 3;
       d.numElements = 8;
       d.numBlocks = 3;
-      d.data = new Spy * [3];
+      d.data = d.allocateBlocks(3);
       d.data[0] = d.alloc.allocate(d.numCells);
       d.data[1] = d.alloc.allocate(d.numCells);
       d.data[2] = d.alloc.allocate(d.numCells);
@@ -1858,7 +1861,7 @@ public:
       d.numCells = 3;
       d.numElements = 2;
       d.numBlocks = 7;
-      d.data = new Spy * [7];
+      d.data = d.allocateBlocks(7);
       d.data[0] = d.alloc.allocate(d.numCells);
       d.data[1] = nullptr;
       d.data[2] = nullptr;
@@ -1995,7 +1998,7 @@ public:
       d.numCells = 4;
       d.numElements = 3;
       d.numBlocks = 1;
-      d.data = new Spy * [1];
+      d.data = d.allocateBlocks(1);
       d.data[0] = d.alloc.allocate(d.numCells);
       d.alloc.construct(&d.data[0][3], Spy(11));
       d.alloc.construct(&d.data[0][0], Spy(28));
@@ -2057,7 +2060,7 @@ public:
       d.numCells = 4;
       d.numElements = 1;
       d.numBlocks = 1;
-      d.data = new Spy * [1];
+      d.data = d.allocateBlocks(1);
       d.data[0] = d.alloc.allocate(d.numCells);
       d.alloc.construct(&d.data[0][1], Spy(31));
       d.iaFront = 1;
@@ -2163,7 +2166,7 @@ public:
       d.numCells = 3;
       d.numElements = 3;
       d.numBlocks = 7;
-      d.data = new Spy * [7];
+      d.data = d.allocateBlocks(7);
       d.data[0] = d.alloc.allocate(d.numCells);
       d.data[1] = nullptr;
       d.data[2] = nullptr;
@@ -2293,7 +2296,7 @@ public:
       d.numCells = 4;
       d.numElements = 2;
       d.numBlocks = 1;
-      d.data = new Spy * [1];
+      d.data = d.allocateBlocks(1);
       d.data[0] = d.alloc.allocate(d.numCells);
       d.alloc.construct(&d.data[0][2], Spy(11));
       d.alloc.construct(&d.data[0][3], Spy(28));
@@ -2353,7 +2356,7 @@ public:
       d.numCells = 4;
       d.numElements = 1;
       d.numBlocks = 1;
-      d.data = new Spy * [1];
+      d.data = d.allocateBlocks(1);
       d.data[0] = d.alloc.allocate(d.numCells);
       d.alloc.construct(&d.data[0][1], Spy(31));
       d.iaFront = 1;
@@ -2458,7 +2461,7 @@ public:
       d.numCells = 3;
       d.numElements = 3;
       d.numBlocks = 7;
-      d.data = new Spy * [7];
+      d.data = d.allocateBlocks(7);
       d.data[0] = d.alloc.allocate(d.numCells);
       d.data[1] = nullptr;
       d.data[2] = nullptr;
@@ -2571,7 +2574,7 @@ public:
       d.numCells = 3;
       d.numElements = 4;
       d.iaFront = 10;
-      d.data = new Spy * [d.numBlocks];
+      d.data = d.allocateBlocks(d.numBlocks);
       d.data[0] = d.alloc.allocate(d.numCells);
       d.data[1] = nullptr;
       d.data[2] = nullptr;
@@ -2696,7 +2699,7 @@ public:
       d.numCells = 3;
       d.numElements = 4;
       d.iaFront = 10;
-      d.data = new Spy * [d.numBlocks];
+      d.data = d.allocateBlocks(d.numBlocks);
       d.data[0] = d.alloc.allocate(d.numCells);
       d.data[1] = nullptr;
       d.data[2] = nullptr;
@@ -2911,7 +2914,7 @@ public:
       d.numCells = 3;
       d.numElements = 4;
       d.iaFront = 10;
-      d.data = new Spy * [d.numBlocks];
+      d.data = d.allocateBlocks(d.numBlocks);
       d.data[0] = d.alloc.allocate(d.numCells);
       d.data[1] = nullptr;
       d.data[2] = nullptr;
@@ -3055,7 +3058,7 @@ public:
       d.numCells = 3;
       d.numElements = 4;
       d.iaFront = 10;
-      d.data = new Spy * [d.numBlocks];
+      d.data = d.allocateBlocks(d.numBlocks);
       d.data[0] = d.alloc.allocate(d.numCells);
       d.data[1] = nullptr;
       d.data[2] = nullptr;
@@ -3523,6 +3526,41 @@ public:
    }
 
 
+   /***************************************
+    * ALLOCATOR
+    ***************************************/
+
+   // the blocks and the array of blocks come from the arena
+   void test_arena_pushback()
+   {  // setup
+      custom::arena a;
+      custom::deque<int, custom::arena_allocator<int>> d(a);
+      // exercise
+      for (int i = 0; i < 20; i++)
+         d.push_back(i);
+      // verify
+      assertUnit(d.size() == 20);
+      assertUnit(d.numBlocks == 2);
+      assertUnit(d.front() == 0);
+      assertUnit(d.back() == 19);
+      assertUnit(a.bytes_allocated() == 1 * sizeof(int*) + 2 * sizeof(int*) +  // array of 1 block, then 2
+                                        2 * 16 * sizeof(int));                  // two blocks of 16
+   }  // teardown
+
+   // the destructor cleans up the elements and the blocks
+   void test_arena_destructor()
+   {  // setup
+      custom::arena a;
+      {
+         custom::deque<Spy, custom::arena_allocator<Spy>> d(a);
+         d.push_back(Spy(26));
+         d.push_front(Spy(11));
+         Spy::reset();
+      }  // exercise
+      // verify
+      assertUnit(Spy::numDestructor() == 2);
+   }  // teardown
+
    /*************************************************************
     * SETUP STANDARD FIXTURE
     *    [31, 49, 55, 67]
@@ -3546,7 +3584,7 @@ public:
       d.numCells    = 3;
       d.numElements = 4;
       d.iaFront     = 4;
-      d.data = new Spy * [d.numBlocks];
+      d.data = d.allocateBlocks(d.numBlocks);
 
       d.data[0] = nullptr;
       d.data[1] = d.alloc.allocate(d.numCells);
@@ -3645,7 +3683,7 @@ public:
          if (d.numBlocks > 4 && d.data[4])
             d.alloc.deallocate(d.data[4], d.numCells);
 
-         delete [] d.data;
+         d.deallocateBlocks(d.data, d.numBlocks);
       }
       d.data = nullptr;
       d.numBlocks = 0;
@@ -0,0 +1,243 @@
+/***********************************************************************
+ * Header:
+ *    CONCURRENT HASH
+ * Summary:
+ *    Our unordered_set split into independently locked shards
+ *      __      __     _______        __
+ *     /  |    /  |   |  _____|   _  / /
+ *     `| |    `| |   | |____    (_)/ /
+ *      | |     | |   '_.____''.   / / _
+ *     _| |_   _| |_  | \____) |  / / (_)
+ *    |_____| |_____|  \______.' /_/
+ *
+ *    This will contain the class definition of:
+ *        concurrent_unordered_set : A hash many threads can share
+ * Author
+ *    Isaac Radford, Jarom Diaz, Peter Benson
+ ************************************************************************/
+
+#pragma once
+
+#include "pair.h"     // for custom::pair, which hash.h needs first
+#include "hash.h"     // because each shard is an unordered_set
+#include <atomic>     // for std::atomic, the next shard to walk
+#include <cstdint>    // for uint64_t
+#include <functional> // for std::hash and std::equal_to
+#include <mutex>      // for std::mutex and std::lock_guard
+#include <thread>     // for std::thread
+#include <vector>     // for std::vector, the walking threads
+
+class TestConcurrentHash;   // forward declaration for unit tests
+
+namespace custom
+{
+
+/************************************************
+ * CONCURRENT UNORDERED SET
+ * NumShards unordered_sets, each behind its own lock.
+ * An element lives in the shard picked by the high bits
+ * of its mixed hash, so threads working on different
+ * elements rarely wait on each other. The low bits still
+ * pick the bucket inside the shard.
+ *
+ * Iterators could not survive another thread's insert,
+ * so find() hands the element to a callback while the
+ * shard is locked, and for_each() does the same for every
+ * element, walking the shards in parallel.
+ ************************************************/
+template <typename T,
+          typename Hash = std::hash<T>,
+          typename EqPred = std::equal_to<T>,
+          size_t NumShards = 16>
+class concurrent_unordered_set
+{
+   friend class ::TestConcurrentHash; // give unit tests access to the privates
+   static_assert(NumShards > 0 && (NumShards & (NumShards - 1)) == 0,
+                 "the shard count must be a power of two");
+public:
+   //
+   // Construct
+   //
+   concurrent_unordered_set() {}
+   concurrent_unordered_set(const std::initializer_list<T>& il)
+   {
+      for (auto it = il.begin(); it != il.end(); ++it)
+         insert(*it);
+   }
+   concurrent_unordered_set(const concurrent_unordered_set& rhs) = delete;
+   concurrent_unordered_set& operator = (const concurrent_unordered_set& rhs) = delete;
+
+   //
+   // Access
+   //
+   bool contains(const T& t) const;
+   template <class Fn>
+   bool find(const T& t, Fn fn) const;
+   template <class Fn>
+   void for_each(Fn fn, size_t numThreads = 0) const;
+
+   //
+   // Insert
+   //
+   bool insert(const T& t);
+
+   //
+   // Remove
+   //
+   bool erase(const T& t);
+   void clear();
+
+   //
+   // Status
+   //
+   size_t size() const;
+   bool empty() const { return size() == 0; }
+   static size_t shard_count() { return NumShards; }
+   size_t shard(const T& t) const { return shardOf(Hash()(t)); }
+
+private:
+   typedef custom::unordered_set<T, Hash, EqPred> Set;
+
+   // each shard on its own cache line so two locks never share one
+   struct alignas(64) Shard
+   {
+      mutable std::mutex mutex;   // held while touching the set
+      mutable Set set;            // the elements whose hash picks this shard
+   };
+
+   // high bits of the mixed hash, which the buckets do not use
+   static size_t shardOf(size_t hashValue)
+   {
+      uint64_t x = (uint64_t)hashValue * 0x9E3779B97F4A7C15ull;
+      return (size_t)(x >> 32) & (NumShards - 1);
+   }
+
+   Shard shards[NumShards];
+};
+
+/*****************************************
+ * CONCURRENT UNORDERED SET :: CONTAINS
+ * Is the element in the set?
+ ****************************************/
+template <typename T, typename H, typename E, size_t N>
+bool concurrent_unordered_set<T, H, E, N>::contains(const T& t) const
+{
+   const Shard & s = shards[shard(t)];
+   std::lock_guard<std::mutex> lock(s.mutex);
+   return s.set.find(t) != s.set.end();
+}
+
+/*****************************************
+ * CONCURRENT UNORDERED SET :: FIND
+ * Call fn with the element while its shard is locked.
+ * Returns false, without calling fn, if it is not there.
+ ****************************************/
+template <typename T, typename H, typename E, size_t N>
+template <class Fn>
+bool concurrent_unordered_set<T, H, E, N>::find(const T& t, Fn fn) const
+{
+   const Shard & s = shards[shard(t)];
+   std::lock_guard<std::mutex> lock(s.mutex);
+   auto it = s.set.find(t);
+   if (it == s.set.end())
+      return false;
+   fn((const T&)*it);
+   return true;
+}
+
+/*****************************************
+ * CONCURRENT UNORDERED SET :: FOR EACH
+ * Call fn with every element. numThreads threads, or one
+ * per core if 0, each take the next shard nobody has
+ * walked yet and hold its lock while walking it, so fn
+ * must be safe to call from several threads at once.
+ ****************************************/
+template <typename T, typename H, typename E, size_t N>
+template <class Fn>
+void concurrent_unordered_set<T, H, E, N>::for_each(Fn fn, size_t numThreads) const
+{
+   if (numThreads == 0)
+      numThreads = std::thread::hardware_concurrency();
+   if (numThreads == 0)
+      numThreads = 1;
+   if (numThreads > N)
+      numThreads = N;
+
+   std::atomic<size_t> iNext(0);
+   auto walk = [this, &iNext, &fn]()
+   {
+      for (size_t i = iNext++; i < N; i = iNext++)
+      {
+         std::lock_guard<std::mutex> lock(shards[i].mutex);
+         for (auto it = shards[i].set.begin(); it != shards[i].set.end(); ++it)
+            fn((const T&)*it);
+      }
+   };
+
+   // this thread walks too
+   std::vector<std::thread> threads;
+   for (size_t i = 1; i < numThreads; i++)
+      threads.push_back(std::thread(walk));
+   walk();
+   for (auto & thread : threads)
+      thread.join();
+}
+
+/*****************************************
+ * CONCURRENT UNORDERED SET :: INSERT
+ * Insert one element. Returns false if it was already there.
+ ****************************************/
+template <typename T, typename H, typename E, size_t N>
+bool concurrent_unordered_set<T, H, E, N>::insert(const T& t)
+{
+   Shard & s = shards[shard(t)];
+   std::lock_guard<std::mutex> lock(s.mutex);
+   return s.set.insert(t).second;
+}
+
+/*****************************************
+ * CONCURRENT UNORDERED SET :: ERASE
+ * Remove one element. Returns false if it was not there.
+ ****************************************/
+template <typename T, typename H, typename E, size_t N>
+bool concurrent_unordered_set<T, H, E, N>::erase(const T& t)
+{
+   Shard & s = shards[shard(t)];
+   std::lock_guard<std::mutex> lock(s.mutex);
+   size_t numBefore = s.set.size();
+   s.set.erase(t);
+   return s.set.size() != numBefore;
+}
+
+/*****************************************
+ * CONCURRENT UNORDERED SET :: CLEAR
+ * Empty every shard, one at a time
+ ****************************************/
+template <typename T, typename H, typename E, size_t N>
+void concurrent_unordered_set<T, H, E, N>::clear()
+{
+   for (size_t i = 0; i < N; i++)
+   {
+      std::lock_guard<std::mutex> lock(shards[i].mutex);
+      shards[i].set.clear();
+   }
+}
+
+/*****************************************
+ * CONCURRENT UNORDERED SET :: SIZE
+ * The shards are counted one at a time, so with other
+ * threads writing this is only a snapshot
+ ****************************************/
+template <typename T, typename H, typename E, size_t N>
+size_t concurrent_unordered_set<T, H, E, N>::size() const
+{
+   size_t num = 0;
+   for (size_t i = 0; i < N; i++)
+   {
+      std::lock_guard<std::mutex> lock(shards[i].mutex);
+      num += shards[i].set.size();
+   }
+   return num;
+}
+
+} // namespace custom
@@ -0,0 +1,762 @@
+/***********************************************************************
+ * Header:
+ *    FLAT HASH
+ * Summary:
+ *    An open addressing alternative to our unordered_set
+ *      __      __     _______        __
+ *     /  |    /  |   |  _____|   _  / /
+ *     `| |    `| |   | |____    (_)/ /
+ *      | |     | |   '_.____''.   / / _
+ *     _| |_   _| |_  | \____) |  / / (_)
+ *    |_____| |_____|  \______.' /_/
+ *
+ *    This will contain the class definition of:
+ *        flat_unordered_set           : A hash with no buckets
+ *        flat_unordered_set::iterator : An interator through the hash
+ * Author
+ *    Isaac Radford, Jarom Diaz, Peter Benson
+ ************************************************************************/
+
+#pragma once
+
+#include "pair.h"     // for custom::pair, the return of insert()
+#include <cassert>    // because I am paranoid
+#include <cstdint>    // for int8_t and uint64_t
+#include <cstring>    // for memset and memcpy
+#include <functional> // for std::hash and std::equal_to
+#include <initializer_list>
+#include <memory>     // for std::allocator and std::allocator_traits
+#include <utility>    // for std::move and std::swap
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define CUSTOM_FLAT_SSE2
+#include <emmintrin.h> // for _mm_cmpeq_epi8 and _mm_movemask_epi8
+#endif
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>    // for _BitScanForward
+#endif
+
+class TestFlatHash;         // forward declaration for unit tests
+
+namespace custom
+{
+namespace flat
+{
+   //
+   // Control bytes
+   //
+   const int8_t EMPTY   = -128;         // 0b10000000
+   const int8_t DELETED = -2;           // 0b11111110
+   const size_t GROUP_WIDTH = 16;       // slots compared at once
+
+   /************************************************
+    * GROUP PORTABLE
+    * The control bytes of GROUP_WIDTH slots, one byte
+    * at a time. Each match returns one bit per slot.
+    ************************************************/
+   struct GroupPortable
+   {
+      GroupPortable(const int8_t* pCtrl) : pCtrl(pCtrl) {}
+      unsigned match(int8_t h2) const
+      {
+         unsigned bits = 0;
+         for (size_t i = 0; i < GROUP_WIDTH; i++)
+            if (pCtrl[i] == h2)
+               bits |= 1u << i;
+         return bits;
+      }
+      unsigned matchEmpty() const
+      {
+         return match(EMPTY);
+      }
+      unsigned matchEmptyOrDeleted() const
+      {
+         unsigned bits = 0;
+         for (size_t i = 0; i < GROUP_WIDTH; i++)
+            if (pCtrl[i] < 0)
+               bits |= 1u << i;
+         return bits;
+      }
+      const int8_t* pCtrl;
+   };
+
+#ifdef CUSTOM_FLAT_SSE2
+   /************************************************
+    * GROUP SSE2
+    * All 16 control bytes at once: one compare and one
+    * movemask per match. Groups start on 16-byte offsets,
+    * so with the heap's alignment a group never straddles
+    * a cache line, and a miss usually costs one load of
+    * control bytes and no element compares.
+    ************************************************/
+   struct GroupSse2
+   {
+      GroupSse2(const int8_t* pCtrl) : ctrl(_mm_loadu_si128((const __m128i*)pCtrl)) {}
+      unsigned match(int8_t h2) const
+      {
+         return (unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(ctrl, _mm_set1_epi8(h2)));
+      }
+      unsigned matchEmpty() const
+      {
+         return match(EMPTY);
+      }
+      unsigned matchEmptyOrDeleted() const
+      {
+         // EMPTY and DELETED are the only bytes with the sign bit set
+         return (unsigned)_mm_movemask_epi8(ctrl);
+      }
+      __m128i ctrl;
+   };
+   typedef GroupSse2 Group;
+#else
+   typedef GroupPortable Group;
+#endif
+
+   // index of the lowest set bit, which must exist
+   inline size_t lowestBit(unsigned bits)
+   {
+      assert(bits != 0);
+#if defined(_MSC_VER) && !defined(__clang__)
+      unsigned long i;
+      _BitScanForward(&i, bits);
+      return (size_t)i;
+#elif defined(__GNUC__) || defined(__clang__)
+      return (size_t)__builtin_ctz(bits);
+#else
+      size_t i = 0;
+      while (!(bits & 1u))
+      {
+         bits >>= 1;
+         i++;
+      }
+      return i;
+#endif
+   }
+} // namespace flat
+
+/************************************************
+ * FLAT UNORDERED SET
+ * A set implemented as one flat array of slots, with
+ * no list nodes. Each slot has a control byte:
+ *    EMPTY    the slot has never been used
+ *    DELETED  a tombstone left by erase()
+ *    0..127   the slot is full; the byte holds the
+ *             low 7 bits of the element's hash
+ * The slots are split into groups of 16. A lookup
+ * compares the 7 hash bits against a whole group of
+ * control bytes (one SSE2 compare where available)
+ * before it touches any element, and stops
+ * at the first group that has an EMPTY slot. Groups are
+ * probed in triangular order, which visits every group
+ * exactly once because the group count is a power of two.
+ *
+ * It has the same insert/find/erase/rehash/reserve
+ * interface as unordered_set, so one can replace the
+ * other. There are no buckets, so there is no bucket()
+ * or local_iterator.
+ ************************************************/
+template <typename T,
+          typename Hash = std::hash<T>,
+          typename EqPred = std::equal_to<T>,
+          typename A = std::allocator<T> >
+class flat_unordered_set
+{
+   friend class ::TestFlatHash;   // give unit tests access to the privates
+public:
+   //
+   // Construct
+   //
+   flat_unordered_set(const A& a = A()) : alloc(a)
+   {
+      initEmpty();
+   }
+   flat_unordered_set(size_t numSlots, const A& a = A()) : alloc(a)
+   {
+      initEmpty();
+      rehash(numSlots);
+   }
+   flat_unordered_set(const flat_unordered_set& rhs);
+   flat_unordered_set(flat_unordered_set&& rhs) : alloc(rhs.alloc), hash(rhs.hash), eq(rhs.eq)
+   {
+      initEmpty();
+      swapTable(rhs);
+   }
+   template <class Iterator>
+   flat_unordered_set(Iterator first, Iterator last, const A& a = A()) : alloc(a)
+   {
+      initEmpty();
+      reserve(last - first);
+      for (auto it = first; it != last; ++it)
+         insert(*it);
+   }
+   flat_unordered_set(const std::initializer_list<T>& il, const A& a = A()) : alloc(a)
+   {
+      initEmpty();
+      insert(il);
+   }
+   ~flat_unordered_set()
+   {
+      clear();
+      deallocateTable(ctrl, slots, capacity);
+   }
+
+   //
+   // Assign
+   //
+   flat_unordered_set& operator = (const flat_unordered_set& rhs)
+   {
+      flat_unordered_set temp(rhs);
+      swap(temp);
+      return *this;
+   }
+   flat_unordered_set& operator = (flat_unordered_set&& rhs)
+   {
+      clear();
+      swap(rhs);
+      return *this;
+   }
+   flat_unordered_set& operator = (const std::initializer_list<T>& il)
+   {
+      clear();
+      insert(il);
+      return *this;
+   }
+   void swap(flat_unordered_set& rhs)
+   {
+      std::swap(alloc, rhs.alloc);
+      std::swap(hash, rhs.hash);
+      std::swap(eq, rhs.eq);
+      swapTable(rhs);
+   }
+
+   //
+   // Iterator
+   //
+   class iterator;
+   iterator begin()
+   {
+      iterator it(ctrl, slots, ctrl + capacity);
+      it.skipEmpty();
+      return it;
+   }
+   iterator end()
+   {
+      return iterator(ctrl + capacity, slots + capacity, ctrl + capacity);
+   }
+
+   //
+   // Access
+   //
+   iterator find(const T& t);
+   template <class K, class H = Hash, class E = EqPred,
+             class = typename H::is_transparent, class = typename E::is_transparent>
+   iterator find(const K& k)
+   {
+      size_t i = findIndex(k, mix(hash(k)));
+      if (i == capacity)
+         return end();
+      return iterator(ctrl + i, slots + i, ctrl + capacity);
+   }
+
+   //
+   // Insert
+   //
+   custom::pair<iterator, bool> insert(const T& t);
+   custom::pair<iterator, bool> insert(T&& t);
+   void insert(const std::initializer_list<T>& il)
+   {
+      reserve(numElements + il.size());
+      for (const T& t : il)
+         insert(t);
+   }
+   void rehash(size_t numSlots);
+   void reserve(size_t num)
+   {
+      rehash((size_t)((float)num / max_load_factor()) + 1);
+   }
+
+   //
+   // Remove
+   //
+   void clear() noexcept;
+   iterator erase(const T& t);
+   iterator erase(const iterator& it);
+
+   //
+   // Status
+   //
+   size_t size() const  { return numElements;      }
+   bool empty() const   { return numElements == 0; }
+   size_t bucket_count() const { return capacity;  }
+   float load_factor() const noexcept
+   {
+      return capacity ? (float)numElements / (float)capacity : 0.0f;
+   }
+   float max_load_factor() const noexcept
+   {
+      return (float)LOAD_NUMERATOR / (float)LOAD_DENOMINATOR;
+   }
+
+private:
+   //
+   // Control bytes
+   //
+   static const int8_t EMPTY   = flat::EMPTY;
+   static const int8_t DELETED = flat::DELETED;
+   static const size_t GROUP_WIDTH = flat::GROUP_WIDTH;
+   static const size_t LOAD_NUMERATOR = 7;     // the table is full at 7/8
+   static const size_t LOAD_DENOMINATOR = 8;
+
+   static bool isFull(int8_t c) { return c >= 0; }
+
+   typedef flat::Group Group;
+   static size_t lowestBit(unsigned bits) { return flat::lowestBit(bits); }
+
+   // spread the bits so an identity hash still fills every group
+   static size_t mix(size_t h)
+   {
+      uint64_t x = (uint64_t)h * 0x9E3779B97F4A7C15ull;
+      return (size_t)(x ^ (x >> 32));
+   }
+   static size_t h1(size_t h) { return h >> 7;           }
+   static int8_t h2(size_t h) { return (int8_t)(h & 0x7F); }
+
+   // the i'th group to probe, counting from 0
+   size_t probeGroup(size_t hashValue, size_t i) const
+   {
+      size_t numGroups = capacity / GROUP_WIDTH;
+      return (h1(hashValue) + i * (i + 1) / 2) & (numGroups - 1);
+   }
+
+   template <class K>
+   size_t findIndex(const K& k, size_t hashValue) const;
+   size_t findInsertSlot(size_t hashValue) const;
+   template <class U>
+   custom::pair<iterator, bool> insertUnique(U&& t);
+   void setCtrl(size_t i, int8_t c) { ctrl[i] = c; }
+   void eraseIndex(size_t i);
+   void resize(size_t capacityNew);
+
+   //
+   // Memory
+   //
+   typedef std::allocator_traits<A> Traits;
+   typedef typename Traits::template rebind_alloc<int8_t> CtrlAlloc;
+   typedef typename Traits::template rebind_alloc<T>      SlotAlloc;
+   typedef std::allocator_traits<SlotAlloc>               SlotTraits;
+
+   void initEmpty()
+   {
+      ctrl = nullptr;
+      slots = nullptr;
+      capacity = 0;
+      numElements = 0;
+      growthLeft = 0;
+   }
+   void allocateTable(size_t capacityNew, int8_t*& ctrlNew, T*& slotsNew);
+   void deallocateTable(int8_t* ctrlOld, T* slotsOld, size_t capacityOld);
+   void swapTable(flat_unordered_set& rhs)
+   {
+      std::swap(ctrl, rhs.ctrl);
+      std::swap(slots, rhs.slots);
+      std::swap(capacity, rhs.capacity);
+      std::swap(numElements, rhs.numElements);
+      std::swap(growthLeft, rhs.growthLeft);
+   }
+   static size_t growthFor(size_t cap)
+   {
+      return cap / LOAD_DENOMINATOR * LOAD_NUMERATOR;
+   }
+
+   A alloc;                // where the control bytes and slots come from
+   Hash hash;              // the hash function
+   EqPred eq;              // compares two elements
+   int8_t* ctrl;           // one control byte per slot
+   T* slots;               // the elements, constructed only where full
+   size_t capacity;        // number of slots, 0 or a power of two >= 16
+   size_t numElements;     // number of full slots
+   size_t growthLeft;      // inserts left before we must rehash
+};
+
+/************************************************
+ * FLAT UNORDERED SET ITERATOR
+ * Walks the slots, skipping the ones that are not full
+ ************************************************/
+template <typename T, typename H, typename E, typename A>
+class flat_unordered_set <T, H, E, A> ::iterator
+{
+   friend class ::TestFlatHash;   // give unit tests access to the privates
+   template <typename TT, typename HH, typename EE, typename AA>
+   friend class custom::flat_unordered_set;
+public:
+   //
+   // Construct
+   //
+   iterator() : pCtrl(nullptr), pSlot(nullptr), pCtrlEnd(nullptr) {}
+   iterator(int8_t* pCtrl, T* pSlot, int8_t* pCtrlEnd) :
+      pCtrl(pCtrl), pSlot(pSlot), pCtrlEnd(pCtrlEnd) {}
+
+   //
+   // Compare
+   //
+   bool operator == (const iterator& rhs) const { return pCtrl == rhs.pCtrl; }
+   bool operator != (const iterator& rhs) const { return pCtrl != rhs.pCtrl; }
+
+   //
+   // Access
+   //
+   const T& operator * () const { return *pSlot; }
+   const T* operator -> () const { return pSlot; }
+
+   //
+   // Arithmetic
+   //
+   iterator& operator ++ ()
+   {
+      ++pCtrl;
+      ++pSlot;
+      skipEmpty();
+      return *this;
+   }
+   iterator operator ++ (int postfix)
+   {
+      iterator temp(*this);
+      ++(*this);
+      return temp;
+   }
+
+private:
+   void skipEmpty()
+   {
+      while (pCtrl != pCtrlEnd && !isFull(*pCtrl))
+      {
+         ++pCtrl;
+         ++pSlot;
+      }
+   }
+
+   int8_t* pCtrl;         // control byte of the current slot
+   T* pSlot;              // the current slot
+   int8_t* pCtrlEnd;      // one past the last control byte
+};
+
+/*****************************************
+ * FLAT UNORDERED SET :: COPY CONSTRUCTOR
+ * Same capacity, so every element keeps its slot
+ ****************************************/
+template <typename T, typename H, typename E, typename A>
+flat_unordered_set <T, H, E, A> ::flat_unordered_set(const flat_unordered_set& rhs) :
+   alloc(rhs.alloc), hash(rhs.hash), eq(rhs.eq)
+{
+   initEmpty();
+   if (rhs.capacity == 0)
+      return;
+
+   allocateTable(rhs.capacity, ctrl, slots);
+   capacity = rhs.capacity;
+   memset(ctrl, EMPTY, capacity);
+
+   SlotAlloc allocSlot(alloc);
+   try
+   {
+      for (size_t i = 0; i < capacity; i++)
+         if (isFull(rhs.ctrl[i]))
+         {
+            SlotTraits::construct(allocSlot, slots + i, rhs.slots[i]);
+            ctrl[i] = rhs.ctrl[i];
+            numElements++;
+         }
+   }
+   catch (...)
+   {
+      clear();
+      deallocateTable(ctrl, slots, capacity);
+      throw;
+   }
+
+   // tombstones are not copied, so the copy has more room
+   growthLeft = growthFor(capacity) - numElements;
+}
+
+/*****************************************
+ * FLAT UNORDERED SET :: FIND INDEX
+ * The slot holding k, or capacity if it is not there.
+ * k is a T, or a key the hash and eq accept directly.
+ ****************************************/
+template <typename T, typename H, typename E, typename A>
+template <class K>
+size_t flat_unordered_set <T, H, E, A> ::findIndex(const K& k, size_t hashValue) const
+{
+   if (capacity == 0)
+      return capacity;
+
+   int8_t h = h2(hashValue);
+   for (size_t i = 0; i < capacity / GROUP_WIDTH; i++)
+   {
+      size_t iGroup = probeGroup(hashValue, i) * GROUP_WIDTH;
+      Group g(ctrl + iGroup);
+
+      // only compare the elements whose 7 bits match
+      for (unsigned bits = g.match(h); bits; bits &= bits - 1)
+      {
+         size_t iSlot = iGroup + lowestBit(bits);
+         if (eq(slots[iSlot], k))
+            return iSlot;
+      }
+
+      // an EMPTY slot means k was never pushed past this group
+      if (g.matchEmpty())
+         return capacity;
+   }
+   return capacity;
+}
+
+/*****************************************
+ * FLAT UNORDERED SET :: FIND INSERT SLOT
+ * The first EMPTY or DELETED slot along the probe
+ * sequence. There is always one because the table is
+ * never more than 7/8 full.
+ ****************************************/
+template <typename T, typename H, typename E, typename A>
+size_t flat_unordered_set <T, H, E, A> ::findInsertSlot(size_t hashValue) const
+{
+   assert(capacity != 0);
+   for (size_t i = 0; i < capacity / GROUP_WIDTH; i++)
+   {
+      size_t iGroup = probeGroup(hashValue, i) * GROUP_WIDTH;
+      unsigned bits = Group(ctrl + iGroup).matchEmptyOrDeleted();
+      if (bits)
+         return iGroup + lowestBit(bits);
+   }
+   assert(false);
+   return capacity;
+}
+
+/*****************************************
+ * FLAT UNORDERED SET :: FIND
+ * Find an element in the set
+ ****************************************/
+template <typename T, typename H, typename E, typename A>
+typename flat_unordered_set <T, H, E, A> ::iterator flat_unordered_set <T, H, E, A> ::find(const T& t)
+{
+   size_t i = findIndex(t, mix(hash(t)));
+   if (i == capacity)
+      return end();
+   return iterator(ctrl + i, slots + i, ctrl + capacity);
+}
+
+/*****************************************
+ * FLAT UNORDERED SET :: INSERT
+ * Insert one element if it is not already there
+ ****************************************/
+template <typename T, typename H, typename E, typename A>
+custom::pair<typename flat_unordered_set <T, H, E, A> ::iterator, bool> flat_unordered_set <T, H, E, A> ::insert(const T& t)
+{
+   return insertUnique(t);
+}
+template <typename T, typename H, typename E, typename A>
+custom::pair<typename flat_unordered_set <T, H, E, A> ::iterator, bool> flat_unordered_set <T, H, E, A> ::insert(T&& t)
+{
+   return insertUnique(std::move(t));
+}
+
+template <typename T, typename H, typename E, typename A>
+template <class U>
+custom::pair<typename flat_unordered_set <T, H, E, A> ::iterator, bool> flat_unordered_set <T, H, E, A> ::insertUnique(U&& t)
+{
+   // 1. See if the element is already there
+   size_t hashValue = mix(hash(t));
+   size_t i = findIndex(t, hashValue);
+   if (i != capacity)
+      return custom::pair<iterator, bool>(iterator(ctrl + i, slots + i, ctrl + capacity), false);
+
+   // 2. Make room. Reuse a tombstone if that is where the probe lands.
+   i = capacity ? findInsertSlot(hashValue) : capacity;
+   if (capacity == 0 || (growthLeft == 0 && ctrl[i] != DELETED))
+   {
+      // lots of tombstones: clean up in place, otherwise grow
+      if (capacity && numElements < growthFor(capacity) / 2)
+         resize(capacity);
+      else
+         resize(capacity ? capacity * 2 : GROUP_WIDTH);
+      i = findInsertSlot(hashValue);
+   }
+
+   // 3. Construct the element, then mark the slot full
+   SlotAlloc allocSlot(alloc);
+   SlotTraits::construct(allocSlot, slots + i, std::forward<U>(t));
+   if (ctrl[i] == EMPTY)
+      growthLeft--;
+   setCtrl(i, h2(hashValue));
+   numElements++;
+
+   return custom::pair<iterator, bool>(iterator(ctrl + i, slots + i, ctrl + capacity), true);
+}
+
+/*****************************************
+ * FLAT UNORDERED SET :: REHASH
+ * Make sure there are at least numSlots slots
+ ****************************************/
+template <typename T, typename H, typename E, typename A>
+void flat_unordered_set <T, H, E, A> ::rehash(size_t numSlots)
+{
+   // round up to a power of two, never less than a group
+   size_t capacityNew = GROUP_WIDTH;
+   while (capacityNew < numSlots)
+      capacityNew *= 2;
+
+   // the elements must fit under the load factor too
+   while (growthFor(capacityNew) < numElements)
+      capacityNew *= 2;
+
+   if (capacityNew > capacity)
+      resize(capacityNew);
+}
+
+/*****************************************
+ * FLAT UNORDERED SET :: RESIZE
+ * Move every element into a fresh table. Tombstones
+ * are left behind.
+ ****************************************/
+template <typename T, typename H, typename E, typename A>
+void flat_unordered_set <T, H, E, A> ::resize(size_t capacityNew)
+{
+   int8_t* ctrlOld = ctrl;
+   T* slotsOld = slots;
+   size_t capacityOld = capacity;
+
+   allocateTable(capacityNew, ctrl, slots);
+   capacity = capacityNew;
+   memset(ctrl, EMPTY, capacity);
+
+   SlotAlloc allocSlot(alloc);
+   for (size_t i = 0; i < capacityOld; i++)
+      if (isFull(ctrlOld[i]))
+      {
+         size_t hashValue = mix(hash(slotsOld[i]));
+         size_t iNew = findInsertSlot(hashValue);
+         SlotTraits::construct(allocSlot, slots + iNew, std::move(slotsOld[i]));
+         SlotTraits::destroy(allocSlot, slotsOld + i);
+         setCtrl(iNew, h2(hashValue));
+      }
+
+   growthLeft = growthFor(capacity) - numElements;
+   deallocateTable(ctrlOld, slotsOld, capacityOld);
+}
+
+/*****************************************
+ * FLAT UNORDERED SET :: ERASE
+ * Remove one element from the set
+ ****************************************/
+template <typename T, typename H, typename E, typename A>
+typename flat_unordered_set <T, H, E, A> ::iterator flat_unordered_set <T, H, E, A> ::erase(const T& t)
+{
+   size_t i = findIndex(t, mix(hash(t)));
+   if (i == capacity)
+      return end();
+   return erase(iterator(ctrl + i, slots + i, ctrl + capacity));
+}
+template <typename T, typename H, typename E, typename A>
+typename flat_unordered_set <T, H, E, A> ::iterator flat_unordered_set <T, H, E, A> ::erase(const iterator& it)
+{
+   if (it == end())
+      return it;
+
+   eraseIndex(it.pCtrl - ctrl);
+
+   // the next full slot, if any
+   iterator itNext(it.pCtrl, it.pSlot, ctrl + capacity);
+   return ++itNext;
+}
+
+/*****************************************
+ * FLAT UNORDERED SET :: ERASE INDEX
+ * Destroy the element in slot i. If its group still has
+ * an EMPTY slot then no probe ever went past this group,
+ * so the slot can go back to EMPTY instead of a tombstone.
+ ****************************************/
+template <typename T, typename H, typename E, typename A>
+void flat_unordered_set <T, H, E, A> ::eraseIndex(size_t i)
+{
+   assert(isFull(ctrl[i]));
+   SlotAlloc allocSlot(alloc);
+   SlotTraits::destroy(allocSlot, slots + i);
+   numElements--;
+
+   if (Group(ctrl + i / GROUP_WIDTH * GROUP_WIDTH).matchEmpty())
+   {
+      setCtrl(i, EMPTY);
+      growthLeft++;
+   }
+   else
+      setCtrl(i, DELETED);
+}
+
+/*****************************************
+ * FLAT UNORDERED SET :: CLEAR
+ * Destroy every element but keep the slots
+ ****************************************/
+template <typename T, typename H, typename E, typename A>
+void flat_unordered_set <T, H, E, A> ::clear() noexcept
+{
+   if (capacity == 0)
+      return;
+
+   SlotAlloc allocSlot(alloc);
+   for (size_t i = 0; i < capacity; i++)
+      if (isFull(ctrl[i]))
+         SlotTraits::destroy(allocSlot, slots + i);
+
+   memset(ctrl, EMPTY, capacity);
+   numElements = 0;
+   growthLeft = growthFor(capacity);
+}
+
+/*****************************************
+ * FLAT UNORDERED SET :: ALLOCATE TABLE
+ * Control bytes and slots for capacityNew elements
+ ****************************************/
+template <typename T, typename H, typename E, typename A>
+void flat_unordered_set <T, H, E, A> ::allocateTable(size_t capacityNew, int8_t*& ctrlNew, T*& slotsNew)
+{
+   CtrlAlloc allocCtrl(alloc);
+   SlotAlloc allocSlot(alloc);
+   ctrlNew = std::allocator_traits<CtrlAlloc>::allocate(allocCtrl, capacityNew);
+   try
+   {
+      slotsNew = SlotTraits::allocate(allocSlot, capacityNew);
+   }
+   catch (...)
+   {
+      std::allocator_traits<CtrlAlloc>::deallocate(allocCtrl, ctrlNew, capacityNew);
+      throw;
+   }
+}
+
+/*****************************************
+ * FLAT UNORDERED SET :: DEALLOCATE TABLE
+ * The elements must already be destroyed
+ ****************************************/
+template <typename T, typename H, typename E, typename A>
+void flat_unordered_set <T, H, E, A> ::deallocateTable(int8_t* ctrlOld, T* slotsOld, size_t capacityOld)
+{
+   if (capacityOld == 0)
+      return;
+
+   CtrlAlloc allocCtrl(alloc);
+   SlotAlloc allocSlot(alloc);
+   std::allocator_traits<CtrlAlloc>::deallocate(allocCtrl, ctrlOld, capacityOld);
+   SlotTraits::deallocate(allocSlot, slotsOld, capacityOld);
+}
+
+/*****************************************
+ * SWAP
+ * Stand-alone flat unordered set swap
+ ****************************************/
+template <typename T, typename H, typename E, typename A>
+void swap(flat_unordered_set<T, H, E, A>& lhs, flat_unordered_set<T, H, E, A>& rhs)
+{
+   lhs.swap(rhs);
+}
+
+} // namespace custom
@@ -23,21 +23,171 @@
 #include "vector.h"   // because this->buckets is a vector
 #include <memory>     // for std::allocator
 #include <functional> // for std::hash
+#include <chrono>     // for std::chrono::steady_clock, to time rehashing
 #include <cmath>      // for std::ceil
+#include <cstdint>    // for uint32_t and uint64_t
+#include <type_traits> // for std::conditional
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <xmmintrin.h> // for _mm_prefetch
+#define CUSTOM_PREFETCH(p) _mm_prefetch((const char *)(p), _MM_HINT_T0)
+#else
+#define CUSTOM_PREFETCH(p) __builtin_prefetch(p)
+#endif
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>    // for _BitScanForward64
+#endif
    
 
 class TestHash;             // forward declaration for Hash unit tests
 
 namespace custom
 {
+/************************************************
+ * HASH MIX
+ * The finalizer of MurmurHash3. Every bit of h affects
+ * every bit of the result, so even an identity hash such
+ * as std::hash<int> fills every bucket of a table whose
+ * size is a power of two.
+ ************************************************/
+inline size_t hash_mix(size_t h)
+{
+   uint64_t x = (uint64_t)h;
+   x ^= x >> 33;
+   x *= 0xFF51AFD7ED558CCDull;
+   x ^= x >> 33;
+   x *= 0xC4CEB9FE1A85EC53ull;
+   x ^= x >> 33;
+   return (size_t)x;
+}
+
+/************************************************
+ * BUCKET POLICIES
+ * How unordered_set turns a hash into a bucket. Each one
+ * has round(), the bucket count to really use when asked
+ * for num, and index(), which bucket of num a hash is in.
+ *    mod_buckets       : any count, hashValue % num. One
+ *                        division, tens of cycles, per lookup
+ *    pow2_buckets      : a power of two, the mixed hash masked
+ *    fibonacci_buckets : a power of two, the top bits of the
+ *                        hash times 2^64 / phi
+ *    lemire_buckets    : any count below 2^32, the mixed hash
+ *                        scaled into range by a multiply and a shift
+ ************************************************/
+struct mod_buckets
+{
+   static size_t round(size_t num)                    { return num;                }
+   static size_t index(size_t hashValue, size_t num)  { return hashValue % num;    }
+};
+
+struct pow2_buckets
+{
+   static size_t round(size_t num)
+   {
+      size_t numRound = 1;
+      while (numRound < num)
+         numRound *= 2;
+      return numRound;
+   }
+   static size_t index(size_t hashValue, size_t num)  { return hash_mix(hashValue) & (num - 1); }
+};
+
+struct fibonacci_buckets
+{
+   static size_t round(size_t num)                    { return pow2_buckets::round(num); }
+   static size_t index(size_t hashValue, size_t num)
+   {
+      // 64 - log2(num) bits shifted out leaves log2(num) bits
+      uint64_t x = (uint64_t)hashValue * 0x9E3779B97F4A7C15ull;
+      return num == 1 ? 0 : (size_t)(x >> (64 - log2(num)));
+   }
+   static unsigned log2(size_t num)
+   {
+#if defined(_MSC_VER) && !defined(__clang__)
+      unsigned long i;
+      _BitScanForward64(&i, (uint64_t)num);
+      return (unsigned)i;
+#else
+      return (unsigned)__builtin_ctzll((unsigned long long)num);
+#endif
+   }
+};
+
+struct lemire_buckets
+{
+   static size_t round(size_t num)
+   {
+      assert(num <= 0xFFFFFFFFull);
+      return num;
+   }
+   static size_t index(size_t hashValue, size_t num)
+   {
+      // 32 well mixed bits as a fraction of 2^32, times num
+      uint32_t mixed = (uint32_t)(((uint64_t)hashValue * 0x9E3779B97F4A7C15ull) >> 32);
+      return (size_t)(((uint64_t)mixed * (uint64_t)num) >> 32);
+   }
+};
+
+/************************************************
+ * HASH STATS
+ * A picture of an unordered_set, to tune its hash
+ * function and max_load_factor() against
+ ************************************************/
+struct hash_stats
+{
+   size_t numElements;        // elements in the set
+   size_t numBuckets;         // buckets, old ones too while rehashing
+   size_t numEmptyBuckets;    // buckets with nothing in them
+   size_t longestChain;       // elements in the fullest bucket
+   float  loadFactor;         // elements per bucket
+   double avgProbeHit;        // elements compared by a find that succeeds
+   double avgProbeMiss;       // elements compared by a find that fails
+   size_t bytesUsed;          // the set, its buckets, and its nodes
+   double bytesPerElement;    // bytesUsed spread over the elements
+   custom::vector<size_t> occupancy; // occupancy[k] is how many buckets hold k elements
+   size_t numRehashes;        // rehashes since the set was made
+   double secondsRehashing;   // time spent in them
+};
+
+/************************************************
+ * HASHED VALUE
+ * An element stored with its full hash code
+ ************************************************/
+template <typename T>
+struct hashed_value
+{
+   template <class U, class ... Args>
+   hashed_value(size_t hashValue, U&& u, Args&& ... args) :
+      hashValue(hashValue), value(std::forward<U>(u), std::forward<Args>(args)...) {}
+
+   size_t hashValue;          // Hash()(value), computed once on insert
+   T value;                   // the element itself
+};
+
 /************************************************
  * UNORDERED SET
- * A set implemented as a hash
+ * A set implemented as a hash. With CacheHash each
+ * element keeps its full hash code, so rehash never
+ * calls the hash function again and a probe skips any
+ * element whose code differs without comparing it.
+ * Worth it when hashing or comparing T is expensive,
+ * as with long strings.
+ *
+ * BucketPolicy picks the bucket of a hash. The default
+ * takes the hash modulo the bucket count; the others
+ * avoid that division.
+ *
+ * With incremental_rehash(true) a growing set does not
+ * rebuild the table inside one insert. It keeps the old
+ * buckets next to the new ones and moves a few of them
+ * on every insert, find, and erase until none are left.
  ************************************************/
 template <typename T,
           typename Hash = std::hash<T>,
           typename EqPred = std::equal_to<T>,
-          typename A = std::allocator<T> >
+          typename A = std::allocator<T>,
+          bool CacheHash = false,
+          typename BucketPolicy = mod_buckets>
 class unordered_set
 {
    friend class ::TestHash;   // give unit tests access to the privates
@@ -45,20 +195,32 @@ public:
    //
    // Construct
    //
-   unordered_set() : maxLoadFactor(1.0), numElements(0), buckets(8)
+   unordered_set(const A& a = A()) : alloc(a), maxLoadFactor(1.0), numElements(0), buckets(8, BucketAlloc(a)),
+      bucketsOld(BucketAlloc(a)), iMigrate(0), incremental(false),
+      numRehashes(0), timeRehashing(0)
    {
+      adoptBuckets(buckets);
    }
-   unordered_set(size_t numBuckets) : maxLoadFactor(1.0), numElements(0), buckets(numBuckets)
+   unordered_set(size_t numBuckets, const A& a = A()) : alloc(a), maxLoadFactor(1.0), numElements(0), buckets(BucketPolicy::round(numBuckets), BucketAlloc(a)),
+      bucketsOld(BucketAlloc(a)), iMigrate(0), incremental(false),
+      numRehashes(0), timeRehashing(0)
    {
+      adoptBuckets(buckets);
    }
-   unordered_set(const unordered_set& rhs) : maxLoadFactor(rhs.maxLoadFactor), numElements(rhs.numElements), buckets(rhs.buckets)
+   unordered_set(const unordered_set& rhs) : alloc(rhs.alloc), maxLoadFactor(rhs.maxLoadFactor), numElements(rhs.numElements), buckets(rhs.buckets),
+      bucketsOld(rhs.bucketsOld), iMigrate(rhs.iMigrate), incremental(rhs.incremental),
+      numRehashes(rhs.numRehashes), timeRehashing(rhs.timeRehashing)
    {
    }
-   unordered_set(unordered_set&& rhs) : maxLoadFactor(rhs.maxLoadFactor), numElements(rhs.numElements), buckets(rhs.buckets)
+   unordered_set(unordered_set&& rhs) : alloc(rhs.alloc), maxLoadFactor(rhs.maxLoadFactor), numElements(rhs.numElements), buckets(rhs.buckets),
+      bucketsOld(rhs.bucketsOld), iMigrate(rhs.iMigrate), incremental(rhs.incremental),
+      numRehashes(rhs.numRehashes), timeRehashing(rhs.timeRehashing)
    {
    }
    template <class Iterator>
-   unordered_set(Iterator first, Iterator last) : maxLoadFactor(1.0), numElements(0)
+   unordered_set(Iterator first, Iterator last, const A& a = A()) : alloc(a), maxLoadFactor(1.0), numElements(0),
+      bucketsOld(BucketAlloc(a)), iMigrate(0), incremental(false),
+      numRehashes(0), timeRehashing(0)
    {
       // First we need to reserve the number of buckets.
       reserve(last - first);
@@ -76,6 +238,11 @@ public:
       numElements = rhs.numElements;
       maxLoadFactor = rhs.maxLoadFactor;
       buckets = rhs.buckets;
+      bucketsOld = rhs.bucketsOld;
+      iMigrate = rhs.iMigrate;
+      incremental = rhs.incremental;
+      numRehashes = rhs.numRehashes;
+      timeRehashing = rhs.timeRehashing;
 
       return *this;
    }
@@ -85,11 +252,18 @@ public:
       numElements = rhs.numElements;
       maxLoadFactor = rhs.maxLoadFactor;
       buckets = std::move(rhs.buckets);
+      bucketsOld = std::move(rhs.bucketsOld);
+      iMigrate = rhs.iMigrate;
+      incremental = rhs.incremental;
+      numRehashes = rhs.numRehashes;
+      timeRehashing = rhs.timeRehashing;
 
       // return rhs to default state.
+      rhs.iMigrate = 0;
       rhs.numElements = 0;
       rhs.maxLoadFactor = 1.0;
       rhs.buckets.resize(8);
+      rhs.adoptBuckets(rhs.buckets);
 
       return *this;
    }
@@ -101,7 +275,13 @@ public:
    {
       std::swap(numElements, rhs.numElements);
       std::swap(maxLoadFactor, rhs.maxLoadFactor);
+      std::swap(alloc, rhs.alloc);
+      std::swap(iMigrate, rhs.iMigrate);
+      std::swap(incremental, rhs.incremental);
+      std::swap(numRehashes, rhs.numRehashes);
+      std::swap(timeRehashing, rhs.timeRehashing);
       buckets.swap(rhs.buckets);
+      bucketsOld.swap(rhs.bucketsOld);
    }
 
    // 
@@ -111,6 +291,8 @@ public:
    class local_iterator;
    iterator begin()
    {
+      // an iterator only walks the new buckets
+      finishMigration();
       for (auto itBucket = buckets.begin(); itBucket != buckets.end(); itBucket++)
          if (!((*itBucket).empty()))
             return iterator(buckets.end(), itBucket, (*itBucket).begin());
@@ -136,20 +318,31 @@ public:
    {
       Hash hashFunc;
       size_t hashValue = hashFunc(t);
-      return hashValue % bucket_count();
+      return indexOf(hashValue, bucket_count());
    }
    iterator find(const T& t);
+   template <class K, class H = Hash, class E = EqPred,
+             class = typename H::is_transparent, class = typename E::is_transparent>
+   iterator find(const K& k);
+   size_t find_batch(const T* keys, size_t num, iterator* out);
+   size_t contains_batch(const T* keys, size_t num, bool* out);
 
    //   
    // Insert
    //
    custom::pair<iterator, bool> insert(const T& t);
+   template <class K, class ... Args>
+   custom::pair<iterator, bool> try_emplace(const K& k, Args&& ... args);
    void insert(const std::initializer_list<T> & il);
    void rehash(size_t numBuckets);
    void reserve(size_t num)
    {
       rehash(num / maxLoadFactor);
    }
+   void incremental_rehash(bool on)
+   {
+      incremental = on;
+   }
 
    // 
    // Remove
@@ -158,9 +351,13 @@ public:
    {
       for (auto itBucket = buckets.begin(); itBucket != buckets.end(); itBucket++)
 			(*itBucket).clear();
+      bucketsOld.clear();
+      bucketsOld.shrink_to_fit();
+      iMigrate = 0;
 		numElements = 0;
    }
    iterator erase(const T& t);
+   iterator erase(iterator itErase);
 
    //
    // Status
@@ -183,7 +380,7 @@ public:
    }
    float load_factor() const noexcept
    {
-      return numElements / buckets.size();
+      return (float)numElements / (float)buckets.size();
    }
    float max_load_factor() const noexcept
    {
@@ -193,6 +390,15 @@ public:
    {
       maxLoadFactor = m;
    }
+   bool incremental_rehash() const noexcept
+   {
+      return incremental;
+   }
+   bool rehashing() const noexcept
+   {
+      return !bucketsOld.empty();
+   }
+   hash_stats stats() const;
 
 private:
 
@@ -202,9 +408,88 @@ private:
       return (size_t) loadFactor;
    }
 
-   custom::vector<custom::list<T,A>> buckets;  // each bucket in the hash
+   // each bucket is a list whose nodes come from the allocator
+   typedef typename std::conditional<CacheHash, hashed_value<T>, T>::type Slot;
+   typedef typename std::allocator_traits<A>::template rebind_alloc<Slot> SlotAlloc;
+   typedef custom::list<Slot, SlotAlloc> Bucket;
+   typedef typename std::allocator_traits<A>::template rebind_alloc<Bucket> BucketAlloc;
+
+   // which bucket of num a hash goes in
+   static size_t indexOf(size_t hashValue, size_t num) { return BucketPolicy::index(hashValue, num); }
+   static size_t roundOf(size_t num)                   { return BucketPolicy::round(num);            }
+
+   // get at the element and its hash, cached or not
+   static T& valueOf(T& t)                           { return t;              }
+   static T& valueOf(hashed_value<T>& s)             { return s.value;        }
+   static size_t hashOf(const T& t)                  { return Hash()(t);      }
+   static size_t hashOf(const hashed_value<T>& s)    { return s.hashValue;    }
+   static bool mayEqual(const T&, size_t)            { return true;           }
+   static bool mayEqual(const hashed_value<T>& s, size_t hashValue)
+                                                     { return s.hashValue == hashValue; }
+   template <class ... Args>
+   static void emplaceSlot(Bucket& b, size_t, std::false_type, Args&& ... args)
+   {
+      b.emplace_back(std::forward<Args>(args)...);
+   }
+   template <class ... Args>
+   static void emplaceSlot(Bucket& b, size_t hashValue, std::true_type, Args&& ... args)
+   {
+      b.emplace_back(hashValue, std::forward<Args>(args)...);
+   }
+
+   // the element of bucket iBucket that equal() matches with k. With
+   // cached hash codes, only the elements whose code matches are compared
+   template <class K, class Eq>
+   typename Bucket::iterator findInBucket(size_t iBucket, const K& k, size_t hashValue, Eq equal)
+   {
+      for (auto itList = buckets[iBucket].begin(); itList != buckets[iBucket].end(); ++itList)
+         if (mayEqual(*itList, hashValue) && equal(valueOf(*itList), k))
+            return itList;
+      return buckets[iBucket].end();
+   }
+
+   // grow if one more element would pass the load factor,
+   // returning the bucket hashValue now belongs in
+   size_t makeRoom(size_t hashValue);
+
+   // look up keys a batch at a time, with the memory of the
+   // whole batch requested before any of it is needed
+   static const size_t BATCH = 16;            // keys hashed and prefetched together
+   template <class Fn>
+   size_t lookupBatch(const T* keys, size_t num, Fn found);
+
+   // move the old buckets over a few at a time
+   static const size_t MIGRATE_STEP = 2;      // non-empty old buckets moved per operation
+   void startMigration(size_t numBuckets);
+   void migrateBucket(size_t iOld);
+   void migrateKey(size_t hashValue)
+   {
+      if (rehashing())
+         migrateBucket(indexOf(hashValue, bucketsOld.size()));
+   }
+   void migrateStep();
+   void finishMigration()
+   {
+      while (rehashing())
+         migrateStep();
+   }
+
+   // hand the allocator to each bucket
+   void adoptBuckets(custom::vector<Bucket, BucketAlloc>& b) const
+   {
+      for (size_t i = 0; i < b.size(); i++)
+         b[i] = Bucket(SlotAlloc(alloc));
+   }
+
+   A alloc;                                    // where the nodes and buckets come from
+   custom::vector<Bucket, BucketAlloc> buckets;// each bucket in the hash
    int numElements;                            // number of elements in the Hash
    float maxLoadFactor;                        // the ratio of elements to buckets signifying a rehash
+   custom::vector<Bucket, BucketAlloc> bucketsOld; // buckets not yet moved, empty unless rehashing
+   size_t iMigrate;                            // next old bucket to move
+   bool incremental;                           // grow a few buckets at a time?
+   size_t numRehashes;                         // times the buckets were replaced
+   std::chrono::steady_clock::duration timeRehashing; // time spent moving elements
 };
 
 
@@ -212,11 +497,11 @@ private:
  * UNORDERED SET ITERATOR
  * Iterator for an unordered set
  ************************************************/
-template <typename T, typename H, typename E, typename A>
-class unordered_set <T, H, E, A> ::iterator
+template <typename T, typename H, typename E, typename A, bool C, typename P>
+class unordered_set <T, H, E, A, C, P> ::iterator
 {
    friend class ::TestHash;   // give unit tests access to the privates
-   template <typename TT, typename HH, typename EE, typename AA>
+   template <typename TT, typename HH, typename EE, typename AA, bool CC, typename PP>
    friend class custom::unordered_set;
 public:
    // 
@@ -224,9 +509,9 @@ public:
    iterator() 
    {
    }
-   iterator(const typename custom::vector<custom::list<T> >::iterator& itVectorEnd,
-            const typename custom::vector<custom::list<T> >::iterator& itVector,
-            const typename custom::list<T>::iterator &itList)
+   iterator(const typename custom::vector<Bucket, BucketAlloc>::iterator& itVectorEnd,
+            const typename custom::vector<Bucket, BucketAlloc>::iterator& itVector,
+            const typename Bucket::iterator &itList)
    {
       this->itVectorEnd = itVectorEnd;
       this->itVector = itVector;
@@ -267,7 +552,7 @@ public:
    //
    T& operator * ()
    {
-      return *itList;
+      return valueOf(*itList);
    }
 
    //
@@ -282,9 +567,9 @@ public:
    }
 
 private:
-   typename vector<list<T>>::iterator itVectorEnd;
-   typename list<T>::iterator itList;
-   typename vector<list<T>>::iterator itVector;
+   typename vector<Bucket, BucketAlloc>::iterator itVectorEnd;
+   typename Bucket::iterator itList;
+   typename vector<Bucket, BucketAlloc>::iterator itVector;
 };
 
 
@@ -292,12 +577,12 @@ private:
  * UNORDERED SET LOCAL ITERATOR
  * Iterator for a single bucket in an unordered set
  ************************************************/
-template <typename T, typename H, typename E, typename A>
-class unordered_set <T, H, E, A> ::local_iterator
+template <typename T, typename H, typename E, typename A, bool C, typename P>
+class unordered_set <T, H, E, A, C, P> ::local_iterator
 {
    friend class ::TestHash;   // give unit tests access to the privates
 
-   template <typename TT, typename HH, typename EE, typename AA>
+   template <typename TT, typename HH, typename EE, typename AA, bool CC, typename PP>
    friend class custom::unordered_set;
 public:
    // 
@@ -306,7 +591,7 @@ public:
    local_iterator()  
    {
    }
-   local_iterator(const typename custom::list<T>::iterator& itList)
+   local_iterator(const typename Bucket::iterator& itList)
    {
       this->itList = itList;
    }
@@ -360,7 +645,7 @@ public:
    }
 
 private:
-   typename list<T>::iterator itList;
+   typename Bucket::iterator itList;
 };
 
 
@@ -368,21 +653,31 @@ private:
  * UNORDERED SET :: ERASE
  * Remove one element from the unordered set
  ****************************************/
-template <typename T, typename Hash, typename E, typename A>
-typename unordered_set <T, Hash, E, A> ::iterator unordered_set<T, Hash, E, A>::erase(const T& t)
+template <typename T, typename Hash, typename E, typename A, bool C, typename P>
+typename unordered_set <T, Hash, E, A, C, P> ::iterator unordered_set<T, Hash, E, A, C, P>::erase(const T& t)
 {
    // 1. Find element to be erased. Return end() if the element is not present.
    auto itErase = find(t);
    if (itErase == end())
       return itErase;
-   // 2. Determine the return value.
+   return erase(itErase);
+}
+
+/*****************************************
+ * UNORDERED SET :: ERASE
+ * Remove the element an iterator refers to
+ ****************************************/
+template <typename T, typename Hash, typename E, typename A, bool C, typename P>
+typename unordered_set <T, Hash, E, A, C, P> ::iterator unordered_set<T, Hash, E, A, C, P>::erase(iterator itErase)
+{
+   // 1. Determine the return value.
    auto itReturn = itErase;
    ++itReturn;
-   // 3. Erase the element from the bucket.
+   // 2. Erase the element from the bucket.
    (*itErase.itVector).erase(itErase.itList);
    if (numElements != 0)
       numElements--;
-   // 4. Returns iterator to the next element.
+   // 3. Returns iterator to the next element.
    return itReturn;
 }
 
@@ -390,43 +685,94 @@ typename unordered_set <T, Hash, E, A> ::iterator unordered_set<T, Hash, E, A>::
  * UNORDERED SET :: INSERT
  * Insert one element into the hash
  ****************************************/
-template <typename T, typename H, typename E, typename A>
-custom::pair<typename custom::unordered_set<T, H, E, A>::iterator, bool> unordered_set<T, H, E, A>::insert(const T& t)
+template <typename T, typename H, typename E, typename A, bool C, typename P>
+custom::pair<typename custom::unordered_set<T, H, E, A, C, P>::iterator, bool> unordered_set<T, H, E, A, C, P>::insert(const T& t)
 {
    // 1. Find the bucket where the new element is to reside.
-   auto iBucket = bucket(t);
+   //    If it is still in the old buckets, move it over first.
+   size_t hashValue = H()(t);
+   migrateKey(hashValue);
+   size_t iBucket = indexOf(hashValue, bucket_count());
 
    // 2. See if the element is already there. If so, then return out.
-   for (auto it = buckets[iBucket].begin(); it != buckets[iBucket].end(); ++it)
-      if (*it == t)
-      {
-         iterator itHash(buckets.end(), buckets.begin(), it);
-         return custom::pair<custom::unordered_set<T, H, E, A>::iterator, bool>(itHash, false);
-      }
-
-   // load factor needs to be a float to take in decimals.
-   float loadFactor = ((float)numElements + 1) / (float)bucket_count();
-
-   // 3. Reserve more space if we are already at the limit.
-   if (loadFactor > max_load_factor())
+   auto it = findInBucket(iBucket, t, hashValue, E());
+   if (it != buckets[iBucket].end())
    {
-      reserve(numElements * 2);
-      iBucket = bucket(t);
+      iterator itHash(buckets.end(), typename vector<Bucket, BucketAlloc>::iterator(iBucket, buckets), it);
+      return custom::pair<custom::unordered_set<T, H, E, A, C, P>::iterator, bool>(itHash, false);
    }
 
+   // 3. Reserve more space if we are already at the limit.
+   iBucket = makeRoom(hashValue);
+
    // 4. Actually insert the new element on the back of the bucket.
-   buckets[iBucket].push_back(t);
+   emplaceSlot(buckets[iBucket], hashValue, std::integral_constant<bool, C>(), t);
    numElements++;
 
    // 5. Return the results.
-   iterator itHash(buckets.end(), buckets.begin(), buckets[iBucket].rbegin());
-   return custom::pair<custom::unordered_set<T, H, E, A>::iterator, bool>(itHash, true);
+   iterator itHash(buckets.end(), typename vector<Bucket, BucketAlloc>::iterator(iBucket, buckets), buckets[iBucket].rbegin());
+   return custom::pair<custom::unordered_set<T, H, E, A, C, P>::iterator, bool>(itHash, true);
 }
-template <typename T, typename H, typename E, typename A>
-void unordered_set<T, H, E, A>::insert(const std::initializer_list<T> & il)
+
+/*****************************************
+ * UNORDERED SET :: TRY EMPLACE
+ * Build an element from args in its bucket, unless one
+ * equal to k is already there. k is hashed and looked up
+ * once, and nothing is built unless it goes in the set.
+ * Hash and EqPred must both take k, as with the find
+ * that takes any key.
+ ****************************************/
+template <typename T, typename H, typename E, typename A, bool C, typename P>
+template <class K, class ... Args>
+custom::pair<typename custom::unordered_set<T, H, E, A, C, P>::iterator, bool>
+unordered_set<T, H, E, A, C, P>::try_emplace(const K& k, Args&& ... args)
+{
+   size_t hashValue = H()(k);
+   migrateKey(hashValue);
+   size_t iBucket = indexOf(hashValue, bucket_count());
+
+   auto it = findInBucket(iBucket, k, hashValue, E());
+   if (it != buckets[iBucket].end())
+   {
+      iterator itHash(buckets.end(), typename vector<Bucket, BucketAlloc>::iterator(iBucket, buckets), it);
+      return custom::pair<iterator, bool>(itHash, false);
+   }
+
+   iBucket = makeRoom(hashValue);
+   emplaceSlot(buckets[iBucket], hashValue, std::integral_constant<bool, C>(), std::forward<Args>(args)...);
+   numElements++;
+
+   iterator itHash(buckets.end(), typename vector<Bucket, BucketAlloc>::iterator(iBucket, buckets), buckets[iBucket].rbegin());
+   return custom::pair<iterator, bool>(itHash, true);
+}
+
+/*****************************************
+ * UNORDERED SET :: MAKE ROOM
+ * Grow the buckets if one more element would pass the
+ * max load factor, all at once or by starting a migration
+ ****************************************/
+template <typename T, typename H, typename E, typename A, bool C, typename P>
+size_t unordered_set<T, H, E, A, C, P>::makeRoom(size_t hashValue)
+{
+   // load factor needs to be a float to take in decimals.
+   float loadFactor = ((float)numElements + 1) / (float)bucket_count();
+   if (loadFactor > max_load_factor())
+   {
+      if (incremental)
+         startMigration((size_t)(numElements * 2 / maxLoadFactor));
+      else
+         reserve(numElements * 2);
+   }
+   if (rehashing())
+      migrateStep();
+   return indexOf(hashValue, bucket_count());
+}
+
+template <typename T, typename H, typename E, typename A, bool C, typename P>
+void unordered_set<T, H, E, A, C, P>::insert(const std::initializer_list<T> & il)
 {
    //loop through the initializer list, then insert each element.
-   for (const auto&& t : il)
+   for (const auto& t : il)
    {
       insert(t);
    }
@@ -436,28 +782,36 @@ void unordered_set<T, H, E, A>::insert(const std::initializer_list<T> & il)
  * UNORDERED SET :: REHASH
  * Re-Hash the unordered set by numBuckets
  ****************************************/
-template <typename T, typename Hash, typename E, typename A>
-void unordered_set<T, Hash, E, A>::rehash(size_t numBuckets)
+template <typename T, typename Hash, typename E, typename A, bool C, typename P>
+void unordered_set<T, Hash, E, A, C, P>::rehash(size_t numBuckets)
 {
    using std::swap;
-   Hash hash;        // so we can use the hash function.
+
+   // an explicit rehash is never spread out
+   finishMigration();
+   numBuckets = roundOf(numBuckets);
 
    // if the current bucket is sufficient, then do nothing.
    if (numBuckets <= bucket_count())
       return;
 
    // create new hash bucket.
-   custom::vector<custom::list<T, A>> bucketsNew(numBuckets);
+   auto timeBegin = std::chrono::steady_clock::now();
+   custom::vector<Bucket, BucketAlloc> bucketsNew(numBuckets, BucketAlloc(alloc));
+   adoptBuckets(bucketsNew);
 
    // insert the elements into the new hash table, one at a time.
+   // a cached hash code is reused rather than computed again.
    for (auto it = begin(); it != end(); ++it)
    {
       assert(it != end());
-      bucketsNew[hash(*it) % numBuckets].push_back(std::move(*it));
+      bucketsNew[indexOf(hashOf(*it.itList), numBuckets)].push_back(std::move(*it.itList));
 	}
 
    // Swap the old bucket for the new.
    swap(buckets, bucketsNew);
+   numRehashes++;
+   timeRehashing += std::chrono::steady_clock::now() - timeBegin;
 }
 
 
@@ -465,17 +819,21 @@ void unordered_set<T, Hash, E, A>::rehash(size_t numBuckets)
  * UNORDERED SET :: FIND
  * Find an element in an unordered set
  ****************************************/
-template <typename T, typename H, typename E, typename A>
-typename unordered_set <T, H, E, A> ::iterator unordered_set<T, H, E, A>::find(const T& t)
+template <typename T, typename H, typename E, typename A, bool C, typename P>
+typename unordered_set <T, H, E, A, C, P> ::iterator unordered_set<T, H, E, A, C, P>::find(const T& t)
 {
    // Identify the bucket corresponding to the element
-   size_t iBucket = bucket(t);
+   size_t hashValue = H()(t);
+   migrateKey(hashValue);
+   if (rehashing())
+      migrateStep();
+   size_t iBucket = indexOf(hashValue, bucket_count());
 
    // Need a vector iterator.
-   typename vector<list<T>>::iterator iVector(iBucket, buckets);
+   typename vector<Bucket, BucketAlloc>::iterator iVector(iBucket, buckets);
 
-   // Get a list iterator to the element using the lists find() method
-   auto itList = buckets[iBucket].find(t);
+   // Get a list iterator to the element
+   auto itList = findInBucket(iBucket, t, hashValue, E());
 
    if (itList != buckets[iBucket].end())
       return iterator(buckets.end(), iVector , itList);
@@ -484,12 +842,241 @@ typename unordered_set <T, H, E, A> ::iterator unordered_set<T, H, E, A>::find(c
       return end();
 }
 
+/*****************************************
+ * UNORDERED SET :: FIND
+ * Find an element by anything the hash and the
+ * equality predicate both accept, such as a const
+ * char * for a set of std::string. Both must declare
+ * is_transparent, just as with std::unordered_set.
+ ****************************************/
+template <typename T, typename H, typename E, typename A, bool C, typename P>
+template <class K, class HH, class EE, class, class>
+typename unordered_set <T, H, E, A, C, P> ::iterator unordered_set<T, H, E, A, C, P>::find(const K& k)
+{
+   HH hashFunc;
+   EE equal;
+
+   // Identify the bucket corresponding to the key
+   size_t hashValue = hashFunc(k);
+   migrateKey(hashValue);
+   if (rehashing())
+      migrateStep();
+   size_t iBucket = indexOf(hashValue, bucket_count());
+   typename vector<Bucket, BucketAlloc>::iterator iVector(iBucket, buckets);
+
+   // Walk the bucket comparing against the key itself
+   auto itList = findInBucket(iBucket, k, hashValue, equal);
+   if (itList != buckets[iBucket].end())
+      return iterator(buckets.end(), iVector, itList);
+
+   return end();
+}
+
+/*****************************************
+ * UNORDERED SET :: START MIGRATION
+ * Set the current buckets aside and start over with
+ * numBuckets empty ones. The elements move over later,
+ * a few buckets per operation.
+ ****************************************/
+template <typename T, typename H, typename E, typename A, bool C, typename P>
+void unordered_set<T, H, E, A, C, P>::startMigration(size_t numBuckets)
+{
+   // only one migration at a time
+   finishMigration();
+   numBuckets = roundOf(numBuckets);
+   if (numBuckets <= bucket_count())
+      return;
+
+   custom::vector<Bucket, BucketAlloc> bucketsNew(numBuckets, BucketAlloc(alloc));
+   adoptBuckets(bucketsNew);
+   bucketsOld.swap(buckets);
+   buckets.swap(bucketsNew);
+   iMigrate = 0;
+   numRehashes++;
+}
+
+/*****************************************
+ * UNORDERED SET :: MIGRATE BUCKET
+ * Move every element of one old bucket to the new buckets
+ ****************************************/
+template <typename T, typename H, typename E, typename A, bool C, typename P>
+void unordered_set<T, H, E, A, C, P>::migrateBucket(size_t iOld)
+{
+   Bucket & bucket = bucketsOld[iOld];
+   if (bucket.empty())
+      return;
+
+   // a cached hash code is reused rather than computed again.
+   for (auto it = bucket.begin(); it != bucket.end(); ++it)
+      buckets[indexOf(hashOf(*it), bucket_count())].push_back(std::move(*it));
+   bucket.clear();
+}
+
+/*****************************************
+ * UNORDERED SET :: MIGRATE STEP
+ * Move the next few non-empty old buckets. A long run of
+ * empty ones is cut short so no step takes long. Once the
+ * last one is moved the old buckets are freed.
+ ****************************************/
+template <typename T, typename H, typename E, typename A, bool C, typename P>
+void unordered_set<T, H, E, A, C, P>::migrateStep()
+{
+   auto timeBegin = std::chrono::steady_clock::now();
+   size_t numMoved = 0;
+   size_t numVisits = MIGRATE_STEP * 10;
+   while (iMigrate < bucketsOld.size() && numMoved < MIGRATE_STEP && numVisits-- > 0)
+   {
+      if (!bucketsOld[iMigrate].empty())
+      {
+         migrateBucket(iMigrate);
+         numMoved++;
+      }
+      iMigrate++;
+   }
+
+   if (iMigrate == bucketsOld.size())
+   {
+      bucketsOld.clear();
+      bucketsOld.shrink_to_fit();
+      iMigrate = 0;
+   }
+   timeRehashing += std::chrono::steady_clock::now() - timeBegin;
+}
+
+/*****************************************
+ * UNORDERED SET :: STATS
+ * Walk every bucket once to describe the set. The
+ * probe lengths assume every element is looked up as
+ * often as every other: a hit in a bucket of k compares
+ * (k + 1) / 2 elements on average, a miss compares all k.
+ ****************************************/
+template <typename T, typename H, typename E, typename A, bool C, typename P>
+hash_stats unordered_set<T, H, E, A, C, P>::stats() const
+{
+   hash_stats s;
+   s.numElements = size();
+   s.numBuckets = buckets.size() + bucketsOld.size();
+   s.numEmptyBuckets = 0;
+   s.longestChain = 0;
+   s.loadFactor = load_factor();
+   s.numRehashes = numRehashes;
+   s.secondsRehashing = std::chrono::duration<double>(timeRehashing).count();
+
+   // 1. how full is each bucket?
+   size_t numCompares = 0;
+   const custom::vector<Bucket, BucketAlloc>* tables[] = { &buckets, &bucketsOld };
+   for (auto pTable : tables)
+      for (size_t i = 0; i < pTable->size(); i++)
+      {
+         size_t k = (*pTable)[i].size();
+         if (k == 0)
+            s.numEmptyBuckets++;
+         if (k > s.longestChain)
+            s.longestChain = k;
+         if (k >= s.occupancy.size())
+            s.occupancy.resize(k + 1, 0);
+         s.occupancy[k]++;
+         numCompares += k * (k + 1) / 2;
+      }
+
+   // 2. the probes
+   s.avgProbeHit = s.numElements ? (double)numCompares / (double)s.numElements : 0.0;
+   s.avgProbeMiss = s.numBuckets ? (double)s.numElements / (double)s.numBuckets : 0.0;
+
+   // 3. the memory
+   s.bytesUsed = sizeof(*this)
+               + (buckets.capacity() + bucketsOld.capacity()) * sizeof(Bucket)
+               + s.numElements * Bucket::node_size();
+   s.bytesPerElement = s.numElements ? (double)s.bytesUsed / (double)s.numElements : 0.0;
+   return s;
+}
+
+/*****************************************
+ * UNORDERED SET :: FIND BATCH
+ * Find num keys at once, putting each one's iterator, or
+ * end(), in out. Returns how many were found. Much faster
+ * than calling find() num times when the table is too big
+ * for the cache.
+ ****************************************/
+template <typename T, typename H, typename E, typename A, bool C, typename P>
+size_t unordered_set<T, H, E, A, C, P>::find_batch(const T* keys, size_t num, iterator* out)
+{
+   return lookupBatch(keys, num, [this, out](size_t i, size_t iBucket, typename Bucket::iterator itList)
+   {
+      if (itList != buckets[iBucket].end())
+         out[i] = iterator(buckets.end(), typename vector<Bucket, BucketAlloc>::iterator(iBucket, buckets), itList);
+      else
+         out[i] = end();
+   });
+}
+
+/*****************************************
+ * UNORDERED SET :: CONTAINS BATCH
+ * Is each of num keys in the set? Returns how many are.
+ ****************************************/
+template <typename T, typename H, typename E, typename A, bool C, typename P>
+size_t unordered_set<T, H, E, A, C, P>::contains_batch(const T* keys, size_t num, bool* out)
+{
+   return lookupBatch(keys, num, [this, out](size_t i, size_t iBucket, typename Bucket::iterator itList)
+   {
+      out[i] = itList != buckets[iBucket].end();
+   });
+}
+
+/*****************************************
+ * UNORDERED SET :: LOOKUP BATCH
+ * Each batch of keys is looked up in three passes, so the
+ * cache misses of one pass overlap instead of coming one
+ * after another:
+ *    1. hash every key and prefetch its bucket
+ *    2. prefetch the first node of every bucket
+ *    3. walk every bucket, calling found(i, iBucket, itList)
+ ****************************************/
+template <typename T, typename H, typename E, typename A, bool C, typename P>
+template <class Fn>
+size_t unordered_set<T, H, E, A, C, P>::lookupBatch(const T* keys, size_t num, Fn found)
+{
+   size_t hashValues[BATCH];
+   size_t iBuckets[BATCH];
+   size_t numFound = 0;
+
+   for (size_t iFirst = 0; iFirst < num; iFirst += BATCH)
+   {
+      size_t numBatch = num - iFirst < BATCH ? num - iFirst : BATCH;
+
+      // 1. a key still in the old buckets is moved over first
+      for (size_t i = 0; i < numBatch; i++)
+      {
+         hashValues[i] = H()(keys[iFirst + i]);
+         migrateKey(hashValues[i]);
+         iBuckets[i] = indexOf(hashValues[i], bucket_count());
+         CUSTOM_PREFETCH(&buckets[iBuckets[i]]);
+      }
+
+      // 2.
+      for (size_t i = 0; i < numBatch; i++)
+         if (!buckets[iBuckets[i]].empty())
+            CUSTOM_PREFETCH(&buckets[iBuckets[i]].front());
+
+      // 3.
+      for (size_t i = 0; i < numBatch; i++)
+      {
+         auto itList = findInBucket(iBuckets[i], keys[iFirst + i], hashValues[i], E());
+         if (itList != buckets[iBuckets[i]].end())
+            numFound++;
+         found(iFirst + i, iBuckets[i], itList);
+      }
+   }
+
+   return numFound;
+}
+
 /*****************************************
  * UNORDERED SET :: ITERATOR :: INCREMENT
  * Advance by one element in an unordered set
  ****************************************/
-template <typename T, typename H, typename E, typename A>
-typename unordered_set <T, H, E, A> ::iterator & unordered_set<T, H, E, A>::iterator::operator ++ ()
+template <typename T, typename H, typename E, typename A, bool C, typename P>
+typename unordered_set <T, H, E, A, C, P> ::iterator & unordered_set<T, H, E, A, C, P>::iterator::operator ++ ()
 {
    // 1. Only advance if we are not already at the end.
    if (itVector == itVectorEnd)
@@ -516,8 +1103,8 @@ typename unordered_set <T, H, E, A> ::iterator & unordered_set<T, H, E, A>::iter
  * SWAP
  * Stand-alone unordered set swap
  ****************************************/
-template <typename T, typename H, typename E, typename A>
-void swap(unordered_set<T,H,E,A>& lhs, unordered_set<T,H,E,A>& rhs)
+template <typename T, typename H, typename E, typename A, bool C, typename P>
+void swap(unordered_set<T,H,E,A, C, P>& lhs, unordered_set<T,H,E,A, C, P>& rhs)
 {
    lhs.swap(rhs);
 }
@@ -0,0 +1,361 @@
+/***********************************************************************
+ * Header:
+ *    HASH MAP
+ * Summary:
+ *    Our custom implementation of std::unordered_map
+ *      __      __     _______        __
+ *     /  |    /  |   |  _____|   _  / /
+ *     `| |    `| |   | |____    (_)/ /
+ *      | |     | |   '_.____''.   / / _
+ *     _| |_   _| |_  | \____) |  / / (_)
+ *    |_____| |_____|  \______.' /_/
+ *
+ *    This will contain the class definition of:
+ *        unordered_map           : A hash of key/value pairs
+ *        unordered_map::iterator : An interator through the map
+ * Author
+ *    Isaac Radford, Jarom Diaz, Peter Benson
+ ************************************************************************/
+
+#pragma once
+
+#include "pair.h"     // for pair, the elements of the map
+#include "hash.h"     // because the pairs live in an unordered_set
+#include <functional> // for std::hash and std::equal_to
+#include <memory>     // for std::allocator
+#include <stdexcept>  // for std::out_of_range
+#include <utility>    // for std::forward
+
+class TestHashMap;          // forward declaration for unit tests
+
+namespace custom
+{
+
+/************************************************
+ * UNORDERED MAP
+ * An unordered_set of pairs that hashes and compares
+ * only the key, just as map is a BST of pairs. Every
+ * lookup goes by the key alone, so no pair and no blank
+ * V is built just to find one.
+ ************************************************/
+template <class K, class V,
+          class Hash = std::hash<K>,
+          class EqPred = std::equal_to<K>,
+          class A = std::allocator<custom::pair<K, V>>>
+class unordered_map
+{
+   friend class ::TestHashMap;   // give unit tests access to the privates
+public:
+   using Pairs = custom::pair<K, V>;
+
+private:
+   // hash and compare a pair by its key, or a key by itself
+   struct KeyHash
+   {
+      typedef void is_transparent;
+      size_t operator () (const Pairs& p) const { return Hash()(p.first); }
+      size_t operator () (const K& k)     const { return Hash()(k);       }
+   };
+   struct KeyEq
+   {
+      typedef void is_transparent;
+      bool operator () (const Pairs& lhs, const Pairs& rhs) const { return EqPred()(lhs.first, rhs.first); }
+      bool operator () (const Pairs& p, const K& k)         const { return EqPred()(p.first, k);           }
+   };
+   typedef custom::unordered_set<Pairs, KeyHash, KeyEq, A> Set;
+
+public:
+   //
+   // Construct
+   //
+   unordered_map(const A& a = A()) : hash(a)
+   {
+   }
+   unordered_map(size_t numBuckets, const A& a = A()) : hash(numBuckets, a)
+   {
+   }
+   unordered_map(const unordered_map& rhs) : hash(rhs.hash)
+   {
+   }
+   unordered_map(unordered_map&& rhs) : hash(std::move(rhs.hash))
+   {
+   }
+   template <class Iterator>
+   unordered_map(Iterator first, Iterator last, const A& a = A()) : hash(a)
+   {
+      insert(first, last);
+   }
+   unordered_map(const std::initializer_list<Pairs>& il, const A& a = A()) : hash(a)
+   {
+      insert(il);
+   }
+
+   //
+   // Assign
+   //
+   unordered_map& operator = (const unordered_map& rhs)
+   {
+      hash = rhs.hash;
+      return *this;
+   }
+   unordered_map& operator = (unordered_map&& rhs)
+   {
+      hash = std::move(rhs.hash);
+      return *this;
+   }
+   void swap(unordered_map& rhs)
+   {
+      hash.swap(rhs.hash);
+   }
+
+   //
+   // Iterator
+   //
+   class iterator;
+   iterator begin()
+   {
+      return iterator(hash.begin());
+   }
+   iterator end()
+   {
+      return iterator(hash.end());
+   }
+
+   //
+   // Access
+   //
+   V& operator [] (const K& k)
+   {
+      return (*try_emplace(k).first).second;
+   }
+   V& at(const K& k);
+   iterator find(const K& k)
+   {
+      return iterator(hash.find(k));
+   }
+   size_t count(const K& k)
+   {
+      return find(k) == end() ? 0 : 1;
+   }
+
+   //
+   // Insert
+   //
+   custom::pair<iterator, bool> insert(const Pairs& rhs)
+   {
+      auto setPair = hash.insert(rhs);
+      return custom::pair<iterator, bool>(iterator(setPair.first), setPair.second);
+   }
+   template <class Iterator>
+   void insert(Iterator first, Iterator last)
+   {
+      for (auto it = first; it != last; ++it)
+         hash.insert(*it);
+   }
+   void insert(const std::initializer_list<Pairs>& il)
+   {
+      for (auto it = il.begin(); it != il.end(); ++it)
+         hash.insert(*it);
+   }
+   template <class ... Args>
+   custom::pair<iterator, bool> try_emplace(const K& k, Args&& ... args);
+   template <class M>
+   custom::pair<iterator, bool> insert_or_assign(const K& k, M&& m);
+   void rehash(size_t numBuckets)
+   {
+      hash.rehash(numBuckets);
+   }
+   void reserve(size_t num)
+   {
+      hash.reserve(num);
+   }
+
+   //
+   // Remove
+   //
+   void clear() noexcept
+   {
+      hash.clear();
+   }
+   size_t erase(const K& k);
+   iterator erase(iterator it)
+   {
+      return iterator(hash.erase(it.it));
+   }
+
+   //
+   // Status
+   //
+   size_t size() const
+   {
+      return hash.size();
+   }
+   bool empty() const
+   {
+      return hash.empty();
+   }
+   size_t bucket_count() const
+   {
+      return hash.bucket_count();
+   }
+   float max_load_factor() const noexcept
+   {
+      return hash.max_load_factor();
+   }
+   void max_load_factor(float m)
+   {
+      hash.max_load_factor(m);
+   }
+
+private:
+   Set hash;                     // the pairs, hashed by key
+};
+
+
+/************************************************
+ * UNORDERED MAP ITERATOR
+ * Iterator through an unordered map, just call through
+ * to the unordered set iterator
+ ************************************************/
+template <class K, class V, class H, class E, class A>
+class unordered_map <K, V, H, E, A> ::iterator
+{
+   friend class ::TestHashMap;   // give unit tests access to the privates
+   template <class KK, class VV, class HH, class EE, class AA>
+   friend class custom::unordered_map;
+public:
+   //
+   // Construct
+   //
+   iterator()
+   {
+   }
+   iterator(const typename Set::iterator& rhs) : it(rhs)
+   {
+   }
+   iterator(const iterator& rhs) : it(rhs.it)
+   {
+   }
+
+   //
+   // Assign
+   //
+   iterator& operator = (const iterator& rhs)
+   {
+      it = rhs.it;
+      return *this;
+   }
+
+   //
+   // Compare
+   //
+   bool operator == (const iterator& rhs) const
+   {
+      return it == rhs.it;
+   }
+   bool operator != (const iterator& rhs) const
+   {
+      return it != rhs.it;
+   }
+
+   //
+   // Access
+   //
+   Pairs& operator * ()
+   {
+      return *it;
+   }
+
+   //
+   // Increment
+   //
+   iterator& operator ++ ()
+   {
+      ++it;
+      return *this;
+   }
+   iterator operator ++ (int postfix)
+   {
+      iterator temp(*this);
+      ++it;
+      return temp;
+   }
+
+private:
+   typename Set::iterator it;
+};
+
+/*****************************************************
+ * UNORDERED MAP :: AT
+ * Retrieve a value, throwing if the key is not there
+ ****************************************************/
+template <class K, class V, class H, class E, class A>
+V& unordered_map <K, V, H, E, A> ::at(const K& k)
+{
+   auto it = find(k);
+   if (it == end())
+      throw std::out_of_range("invalid unordered_map<K, T> key");
+   return (*it).second;
+}
+
+/*****************************************************
+ * UNORDERED MAP :: TRY EMPLACE
+ * Insert k with a V built from args, unless k is already
+ * there. Then nothing is built and the value is left alone.
+ * k is looked up once and the pair is built in its node.
+ ****************************************************/
+template <class K, class V, class H, class E, class A>
+template <class ... Args>
+custom::pair<typename unordered_map <K, V, H, E, A> ::iterator, bool>
+unordered_map <K, V, H, E, A> ::try_emplace(const K& k, Args&& ... args)
+{
+   auto setPair = hash.try_emplace(k, emplace_second_t(), k, std::forward<Args>(args)...);
+   return custom::pair<iterator, bool>(iterator(setPair.first), setPair.second);
+}
+
+/*****************************************************
+ * UNORDERED MAP :: INSERT OR ASSIGN
+ * Insert k with the value m, or give the value already
+ * there for k the value m
+ ****************************************************/
+template <class K, class V, class H, class E, class A>
+template <class M>
+custom::pair<typename unordered_map <K, V, H, E, A> ::iterator, bool>
+unordered_map <K, V, H, E, A> ::insert_or_assign(const K& k, M&& m)
+{
+   auto it = find(k);
+   if (it != end())
+   {
+      (*it).second = std::forward<M>(m);
+      return custom::pair<iterator, bool>(it, false);
+   }
+
+   return insert(Pairs(k, V(std::forward<M>(m))));
+}
+
+/*****************************************************
+ * UNORDERED MAP :: ERASE
+ * Erase the pair with key k, returning how many went
+ ****************************************************/
+template <class K, class V, class H, class E, class A>
+size_t unordered_map <K, V, H, E, A> ::erase(const K& k)
+{
+   auto it = find(k);
+   if (it == end())
+      return 0;
+
+   erase(it);
+   return 1;
+}
+
+/*****************************************************
+ * SWAP
+ * Stand-alone unordered map swap
+ ****************************************************/
+template <class K, class V, class H, class E, class A>
+void swap(unordered_map <K, V, H, E, A>& lhs, unordered_map <K, V, H, E, A>& rhs)
+{
+   lhs.swap(rhs);
+}
+
+} // namespace custom
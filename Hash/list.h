@@ -21,7 +21,8 @@
 #include <cassert>     // for ASSERT
 #include <iostream>    // for nullptr
 #include <new>         // std::bad_alloc
-#include <memory>      // for std::allocator
+#include <memory>      // for std::allocator and std::allocator_traits
+#include <utility>     // for std::forward
 
 class TestList; // forward declaration for unit tests
 class TestHash; // forward declaration for hash used later
@@ -57,10 +58,11 @@ namespace custom
          }*/
       }
 
-      list(list <T, A>&& rhs, const A& a = A());
+      list(list <T, A>&& rhs);
       list(size_t num, const T& t, const A& a = A());
       list(size_t num, const A& a = A());
-      list(const std::initializer_list<T>& il, const A& a = A())
+      list(const std::initializer_list<T>& il, const A& a = A()) : alloc(a), numElements(0),
+         pHead(nullptr), pTail(nullptr)
       {
          for (auto it = il.begin(); it != il.end(); ++it)
          {
@@ -68,7 +70,8 @@ namespace custom
          }
       }
       template <class Iterator>
-      list(Iterator first, Iterator last, const A& a = A())
+      list(Iterator first, Iterator last, const A& a = A()) : alloc(a), numElements(0),
+         pHead(nullptr), pTail(nullptr)
       {
          for (auto it = first; it != last; ++it)
          {
@@ -110,6 +113,9 @@ namespace custom
          auto tempElements = rhs.numElements;
          rhs.numElements = numElements;
          numElements = tempElements;
+
+         // the nodes stay with the allocator that made them
+         std::swap(alloc, rhs.alloc);
       }
 
       //
@@ -145,6 +151,8 @@ namespace custom
       void push_front(T&& data);
       void push_back(const T& data);
       void push_back(T&& data);
+      template <class ... Args>
+      void emplace_back(Args&& ... args);
       iterator insert(iterator it, const T& data);
       iterator insert(iterator it, T&& data);
 
@@ -164,9 +172,19 @@ namespace custom
       bool empty()  const { return numElements == 0 ? true : false; }
       size_t size() const { return numElements; }
 
+      // bytes each element costs, links and all
+      static size_t node_size() { return sizeof(Node); }
+
    private:
       // nested linked list class
       class Node;
+      struct Emplace {};   // build the data of a node from arguments
+
+      // every node is allocated and freed through the allocator
+      typedef typename std::allocator_traits<A>::template rebind_alloc<Node> NodeAlloc;
+      template <typename ... Args>
+      Node* newNode(Args&& ... args);
+      void deleteNode(Node* p);
 
       // member variables
       A    alloc;         // use alloacator for memory allocation
@@ -195,6 +213,9 @@ namespace custom
       Node(const T& data) : data(data), pNext(nullptr), pPrev(nullptr) {};
       // Move constructor
       Node(T&& data) : pNext(nullptr), pPrev(nullptr), data(std::move(data)) {};
+      // Emplace constructor
+      template <class ... Args>
+      Node(Emplace, Args&& ... args) : data(std::forward<Args>(args)...), pNext(nullptr), pPrev(nullptr) {};
 
       //
       // Member Variables
@@ -207,6 +228,42 @@ namespace custom
 
    };
 
+   /*****************************************
+    * LIST :: NEW NODE
+    * Allocate a node through the allocator and
+    * construct it from the arguments
+    ****************************************/
+   template <typename T, typename A>
+   template <typename ... Args>
+   typename list <T, A> ::Node* list <T, A> ::newNode(Args&& ... args)
+   {
+      NodeAlloc allocNode(alloc);
+      Node* pNew = std::allocator_traits<NodeAlloc>::allocate(allocNode, 1);
+      try
+      {
+         std::allocator_traits<NodeAlloc>::construct(allocNode, pNew, std::forward<Args>(args)...);
+      }
+      catch (...)
+      {
+         std::allocator_traits<NodeAlloc>::deallocate(allocNode, pNew, 1);
+         throw;
+      }
+      return pNew;
+   }
+
+   /*****************************************
+    * LIST :: DELETE NODE
+    * Destroy a node and give its memory back
+    * to the allocator
+    ****************************************/
+   template <typename T, typename A>
+   void list <T, A> ::deleteNode(Node* p)
+   {
+      NodeAlloc allocNode(alloc);
+      std::allocator_traits<NodeAlloc>::destroy(allocNode, p);
+      std::allocator_traits<NodeAlloc>::deallocate(allocNode, p, 1);
+   }
+
    /*************************************************
     * LIST ITERATOR
     * Iterate through a List, non-constant version
@@ -319,7 +376,7 @@ namespace custom
 
       for (size_t i = 0; i < numElements; ++i)
       {
-         Node* pNew = new list <T, A> ::Node(t);
+         Node* pNew = newNode(t);
 
          if (!pHead)
          {
@@ -346,7 +403,7 @@ namespace custom
    {
       for (size_t i = 0; i < numElements; ++i)
       {
-         Node* pNew = new list <T, A> ::Node();
+         Node* pNew = newNode();
 
          if (!pHead)
          {
@@ -369,8 +426,8 @@ namespace custom
     * Steal the values from the RHS
     ****************************************/
    template <typename T, typename A>
-   list <T, A> ::list(list <T, A>&& rhs, const A& a) :
-      numElements(rhs.numElements), pHead(rhs.pHead), pTail(rhs.pTail), alloc(a)
+   list <T, A> ::list(list <T, A>&& rhs) :
+      alloc(rhs.alloc), numElements(rhs.numElements), pHead(rhs.pHead), pTail(rhs.pTail)
    {
       rhs.pHead = rhs.pTail = nullptr;
       rhs.numElements = 0;
@@ -436,7 +493,7 @@ namespace custom
          for (p = itLHS.p; p; p = pNext)
          {
             pNext = p->pNext;
-            delete p;
+            deleteNode(p);
             numElements--;
          }
          pTail->pNext = nullptr;
@@ -448,7 +505,7 @@ namespace custom
          while (p != nullptr)
          {
             pNext = p->pNext;
-            delete p;
+            deleteNode(p);
             p = pNext;
             numElements--;
          }
@@ -505,7 +562,7 @@ namespace custom
          while (p != nullptr)
          {
             pNext = p->pNext;
-            delete p;
+            deleteNode(p);
             p = pNext;
             numElements--;
          }
@@ -530,7 +587,7 @@ namespace custom
       for (list<T, A>::Node* p = pHead; p; p = pNext)
       {
          pNext = p->pNext;
-         delete p;
+         deleteNode(p);
       }
 
       pHead = pTail = nullptr;
@@ -540,7 +597,7 @@ namespace custom
          Node* pDelete = pHead;
          pHead = pHead->pNext;
          pTail = nullptr;
-         delete pDelete;
+         deleteNode(pDelete);
          numElements = 0;
       }*/
    }
@@ -556,7 +613,7 @@ namespace custom
    void list <T, A> ::push_back(const T& data)
    {
       // create new node.
-      list<T, A> ::Node* pNew = new list <T, A> ::Node(data);
+      Node* pNew = newNode(data);
       
       // point it to the old tail.
       pNew->pPrev = pTail;
@@ -596,7 +653,7 @@ namespace custom
    template <typename T, typename A>
    void list <T, A> ::push_back(T&& data)
    {
-      Node* pNew = new Node(std::move(data));
+      Node* pNew = newNode(std::move(data));
       pNew->pNext = pTail;
 
       if (pHead)
@@ -613,6 +670,27 @@ namespace custom
       numElements++;
    }
 
+   /*********************************************
+    * LIST :: EMPLACE BACK
+    * build an item at the end of the list from args
+    *    INPUT  : the arguments of T's constructor
+    *    OUTPUT :
+    *    COST   : O(1)
+    *********************************************/
+   template <typename T, typename A>
+   template <class ... Args>
+   void list <T, A> ::emplace_back(Args&& ... args)
+   {
+      Node* pNew = newNode(Emplace(), std::forward<Args>(args)...);
+      pNew->pPrev = pTail;
+      if (pTail != nullptr)
+         pTail->pNext = pNew;
+      else
+         pHead = pNew;
+      pTail = pNew;
+      numElements++;
+   }
+
    /*********************************************
     * LIST :: PUSH FRONT
     * add an item to the head of the list
@@ -623,7 +701,7 @@ namespace custom
    template <typename T, typename A>
    void list <T, A> ::push_front(const T& data)
    {
-      Node* pNew = new Node(data); // create a new node
+      Node* pNew = newNode(data); // create a new node
 
       pNew->pNext = pHead; // set the new node's next pointer to the head
       if (pHead) // if the list is not empty set the head's previous pointer to the new node
@@ -638,7 +716,7 @@ namespace custom
    template <typename T, typename A>
    void list <T, A> ::push_front(T&& data)
    {
-      Node* pNew = new Node(std::move(data));
+      Node* pNew = newNode(std::move(data));
 
       pNew->pNext = pHead;
       if (pHead)
@@ -741,7 +819,7 @@ namespace custom
             pHead = pHead->pNext;
 
          // Delete the node.
-         delete it.p;
+         deleteNode(it.p);
          numElements--;
          return itNext;
       }
@@ -764,14 +842,14 @@ namespace custom
       const T& data)
    {
       if (empty()) {
-         pHead = pTail = new Node(data);
+         pHead = pTail = newNode(data);
          numElements++;
          return begin();
       }
 
       if (it == end())
       {
-         Node* pNew = new Node(data);
+         Node* pNew = newNode(data);
          pTail->pNext = pNew;
          pNew->pPrev = pTail;
          pTail = pNew;
@@ -781,7 +859,7 @@ namespace custom
 
       if (it != end())
       {
-         Node* pNew = new Node(data);
+         Node* pNew = newNode(data);
          pNew->pPrev = it.p->pPrev;
          pNew->pNext = it.p;
 
@@ -815,14 +893,14 @@ namespace custom
       T&& data)
    {
       if (empty()) {
-         pHead = pTail = new Node(std::move(data));
+         pHead = pTail = newNode(std::move(data));
          numElements++;
          return begin();
       }
 
       if (it == end())
       {
-         Node* pNew = new Node(std::move(data));
+         Node* pNew = newNode(std::move(data));
          pTail->pNext = pNew;
          pNew->pPrev = pTail;
          pTail = pNew;
@@ -832,7 +910,7 @@ namespace custom
 
       if (it != end())
       {
-         Node* pNew = new Node(std::move(data));
+         Node* pNew = newNode(std::move(data));
          pNew->pPrev = it.p->pPrev;
          pNew->pNext = it.p;
 
@@ -10,10 +10,18 @@
 #pragma once
 
 #include <iostream>  // for ISTREAM and OSTREAM
+#include <utility>   // for std::forward
 
 namespace custom
 {
 
+/**********************************************
+ * EMPLACE SECOND
+ * Asks a pair to build its second from the
+ * arguments that follow the first
+ ***********************************************/
+struct emplace_second_t {};
+
 /**********************************************
  * PAIR
  * This class couples together a pair of values, which may be of
@@ -41,6 +49,10 @@ public:
       : first(first), second(std::move(second)), compare(c) {}
    pair(const T1& first, const C& c = C())
       : first(first), second(), compare(c) {}
+   // Emplace Constructor: build the second from args, in place
+   template <class ... Args>
+   pair(emplace_second_t, const T1& first, Args&& ... args)
+      : first(first), second(std::forward<Args>(args)...), compare() {}
    // Copy Constructor: call the T1, T2 copy constructors
    pair(const pair <T1, T2> & rhs, const C& c = C())
        : first(rhs.first), second(rhs.second), compare(c) {}
@@ -0,0 +1,344 @@
+/***********************************************************************
+ * Header:
+ *    RCU HASH
+ * Summary:
+ *    A read-mostly unordered_set whose readers never lock
+ *      __      __     _______        __
+ *     /  |    /  |   |  _____|   _  / /
+ *     `| |    `| |   | |____    (_)/ /
+ *      | |     | |   '_.____''.   / / _
+ *     _| |_   _| |_  | \____) |  / / (_)
+ *    |_____| |_____|  \______.' /_/
+ *
+ *    This will contain the class definition of:
+ *        rcu_unordered_set         : A hash published as snapshots
+ *        rcu_unordered_set::reader : A pinned snapshot to look things up in
+ * Author
+ *    Isaac Radford, Jarom Diaz, Peter Benson
+ ************************************************************************/
+
+#pragma once
+
+#include "pair.h"     // for custom::pair, which hash.h needs first
+#include "hash.h"     // because each snapshot is an unordered_set
+#include <atomic>     // for std::atomic
+#include <cassert>    // because I am paranoid
+#include <functional> // for std::hash and std::equal_to
+#include <mutex>      // for std::mutex, which only writers take
+#include <thread>     // for std::this_thread::yield
+#include <utility>    // for std::pair, a retired snapshot
+#include <vector>     // for std::vector, the retired snapshots
+
+class TestRcuHash;          // forward declaration for unit tests
+
+namespace custom
+{
+
+/************************************************
+ * RCU UNORDERED SET
+ * Read-copy-update over our unordered_set. A writer
+ * copies the current table, changes the copy, and
+ * publishes it with one atomic store. A reader loads
+ * whichever table is current and searches it as is,
+ * without taking a lock. Only worth it when reads far
+ * outnumber writes, as with configuration or routing
+ * tables: every write copies the whole table.
+ *
+ * A replaced table is freed by epoch-based reclamation.
+ * A reader counts itself in the current epoch while it
+ * holds a table, and each write moves to the next epoch.
+ * A table retired in epoch e is freed by a later write,
+ * once no reader is left in epoch e. Readers count
+ * themselves in per-thread slots on separate cache
+ * lines, so they never share anything they write to.
+ ************************************************/
+template <typename T,
+          typename Hash = std::hash<T>,
+          typename EqPred = std::equal_to<T>>
+class rcu_unordered_set
+{
+   friend class ::TestRcuHash;    // give unit tests access to the privates
+   typedef custom::unordered_set<T, Hash, EqPred> Set;
+public:
+   class reader;
+
+   //
+   // Construct
+   //
+   rcu_unordered_set() : pCurrent(new Set), epoch(1) {}
+   rcu_unordered_set(const std::initializer_list<T>& il) : pCurrent(new Set), epoch(1)
+   {
+      pCurrent.load()->insert(il);
+   }
+   rcu_unordered_set(const rcu_unordered_set& rhs) = delete;
+   rcu_unordered_set& operator = (const rcu_unordered_set& rhs) = delete;
+   ~rcu_unordered_set();
+
+   //
+   // Access
+   //
+   reader read() const { return reader(*this); }
+   bool contains(const T& t) const
+   {
+      reader r(*this);
+      return r.find(t) != r.end();
+   }
+   template <class Fn>
+   bool find(const T& t, Fn fn) const;
+
+   //
+   // Insert
+   //
+   bool insert(const T& t);
+   template <class Fn>
+   void update(Fn fn);
+
+   //
+   // Remove
+   //
+   bool erase(const T& t);
+
+   //
+   // Status
+   //
+   size_t size() const { return read().size(); }
+   bool empty() const { return size() == 0; }
+
+private:
+   static const size_t NUM_SLOTS = 64;   // reader threads that never share a slot
+
+   // readers of one thread count themselves here
+   struct alignas(64) ReaderSlot
+   {
+      ReaderSlot() { count[0] = 0; count[1] = 0; }
+      std::atomic<long> count[2];         // readers in an even and an odd epoch
+   };
+
+   // each thread is handed the next slot the first time it reads
+   static size_t threadSlot()
+   {
+      static std::atomic<size_t> numThreads(0);
+      static thread_local size_t iSlot = numThreads++ % NUM_SLOTS;
+      return iSlot;
+   }
+
+   size_t enter(size_t iSlot) const;
+   void leave(size_t iSlot, size_t e) const
+   {
+      slots[iSlot].count[e & 1]--;
+   }
+   void waitForReaders(size_t e) const;
+   void publish(Set * pNew);
+
+   std::atomic<Set *> pCurrent;          // the table readers see
+   std::atomic<size_t> epoch;            // bumped by every write
+   mutable ReaderSlot slots[NUM_SLOTS];  // readers in each epoch, by thread
+   std::mutex writer;                    // writers take turns
+   std::vector<std::pair<Set *, size_t>> retired;  // replaced tables and their epoch
+};
+
+/************************************************
+ * RCU UNORDERED SET READER
+ * Holds one snapshot for as long as it lives. Lookups
+ * go straight to that snapshot's unordered_set, so they
+ * are exactly the same as unordered_set::find. Writes
+ * made after the reader was created are not seen.
+ * A thread holding a reader must not write twice: the
+ * second write waits for the reader to go away.
+ ************************************************/
+template <typename T, typename H, typename E>
+class rcu_unordered_set <T, H, E> ::reader
+{
+   friend class ::TestRcuHash;    // give unit tests access to the privates
+public:
+   typedef typename Set::iterator iterator;
+
+   //
+   // Construct
+   //
+   reader(const rcu_unordered_set& rcu) : pRcu(&rcu), iSlot(threadSlot())
+   {
+      e = rcu.enter(iSlot);
+      pSet = rcu.pCurrent.load();
+   }
+   reader(reader&& rhs) : pRcu(rhs.pRcu), pSet(rhs.pSet), iSlot(rhs.iSlot), e(rhs.e)
+   {
+      rhs.pRcu = nullptr;
+   }
+   reader(const reader& rhs) = delete;
+   reader& operator = (const reader& rhs) = delete;
+   ~reader()
+   {
+      if (pRcu)
+         pRcu->leave(iSlot, e);
+   }
+
+   //
+   // Access
+   //
+   iterator find(const T& t) { return pSet->find(t); }
+   iterator begin()          { return pSet->begin(); }
+   iterator end()            { return pSet->end();   }
+
+   //
+   // Status
+   //
+   size_t size() const       { return pSet->size();  }
+   bool empty() const        { return pSet->empty(); }
+
+private:
+   const rcu_unordered_set * pRcu; // the set we are counted in, or nullptr when moved
+   Set * pSet;                     // the snapshot, never changed while we hold it
+   size_t iSlot;                   // the slot we are counted in
+   size_t e;                       // the epoch we are counted in
+};
+
+/*****************************************
+ * RCU UNORDERED SET :: DESTRUCTOR
+ * No reader may be left, so free every table
+ ****************************************/
+template <typename T, typename H, typename E>
+rcu_unordered_set <T, H, E> :: ~rcu_unordered_set()
+{
+   delete pCurrent.load();
+   for (auto & r : retired)
+      delete r.first;
+}
+
+/*****************************************
+ * RCU UNORDERED SET :: FIND
+ * Call fn with the element, which stays alive until fn
+ * returns. Returns false, without calling fn, if it is
+ * not there.
+ ****************************************/
+template <typename T, typename H, typename E>
+template <class Fn>
+bool rcu_unordered_set <T, H, E> ::find(const T& t, Fn fn) const
+{
+   reader r(*this);
+   auto it = r.find(t);
+   if (it == r.end())
+      return false;
+   fn((const T&)*it);
+   return true;
+}
+
+/*****************************************
+ * RCU UNORDERED SET :: INSERT
+ * Publish a copy with one more element. Returns false
+ * if it was already there.
+ ****************************************/
+template <typename T, typename H, typename E>
+bool rcu_unordered_set <T, H, E> ::insert(const T& t)
+{
+   bool inserted = false;
+   update([&t, &inserted](Set & s) { inserted = s.insert(t).second; });
+   return inserted;
+}
+
+/*****************************************
+ * RCU UNORDERED SET :: ERASE
+ * Publish a copy with one less element. Returns false
+ * if it was not there.
+ ****************************************/
+template <typename T, typename H, typename E>
+bool rcu_unordered_set <T, H, E> ::erase(const T& t)
+{
+   bool erased = false;
+   update([&t, &erased](Set & s)
+   {
+      size_t numBefore = s.size();
+      s.erase(t);
+      erased = s.size() != numBefore;
+   });
+   return erased;
+}
+
+/*****************************************
+ * RCU UNORDERED SET :: UPDATE
+ * Copy the current table, let fn change the copy, and
+ * publish it. Many changes made in one fn cost a single
+ * copy, and readers see all of them or none.
+ ****************************************/
+template <typename T, typename H, typename E>
+template <class Fn>
+void rcu_unordered_set <T, H, E> ::update(Fn fn)
+{
+   std::lock_guard<std::mutex> lock(writer);
+   Set * pNew = new Set(*pCurrent.load());
+   fn(*pNew);
+   publish(pNew);
+}
+
+/*****************************************
+ * RCU UNORDERED SET :: PUBLISH
+ * Make pNew the current table and retire the old one.
+ * Readers never write to a table, so pNew must not be
+ * part way through an incremental rehash: find and begin
+ * would move buckets on it. Tables retired before this epoch can be freed once the
+ * readers of the previous epoch are gone; they have to
+ * be gone anyway before that epoch's slot count is
+ * reused by the next one. Call with the writer lock held.
+ ****************************************/
+template <typename T, typename H, typename E>
+void rcu_unordered_set <T, H, E> ::publish(Set * pNew)
+{
+   // 1. finish any migration fn started and keep it from starting another.
+   //    A rehash to the current size only finishes the migration.
+   pNew->incremental_rehash(false);
+   pNew->rehash(pNew->bucket_count());
+   assert(!pNew->rehashing());
+
+   size_t e = epoch.load();
+
+   // 2. free what no reader can still hold
+   waitForReaders(e - 1);
+   size_t iKeep = 0;
+   for (size_t i = 0; i < retired.size(); i++)
+      if (retired[i].second < e)
+         delete retired[i].first;
+      else
+         retired[iKeep++] = retired[i];
+   retired.resize(iKeep);
+
+   // 3. new readers see the new table
+   Set * pOld = pCurrent.exchange(pNew);
+   retired.push_back(std::make_pair(pOld, e));
+
+   // 4. and count themselves in the next epoch
+   epoch.store(e + 1);
+}
+
+/*****************************************
+ * RCU UNORDERED SET :: ENTER
+ * Count a reader in the current epoch. If a writer moved
+ * on before we were counted, try again in the new epoch,
+ * otherwise the writer might miss us.
+ ****************************************/
+template <typename T, typename H, typename E>
+size_t rcu_unordered_set <T, H, E> ::enter(size_t iSlot) const
+{
+   while (true)
+   {
+      size_t e = epoch.load();
+      slots[iSlot].count[e & 1]++;
+      if (epoch.load() == e)
+         return e;
+      slots[iSlot].count[e & 1]--;
+   }
+}
+
+/*****************************************
+ * RCU UNORDERED SET :: WAIT FOR READERS
+ * Spin until no reader is counted in epoch e. Writes are
+ * rare and readers quick, so this seldom waits at all.
+ ****************************************/
+template <typename T, typename H, typename E>
+void rcu_unordered_set <T, H, E> ::waitForReaders(size_t e) const
+{
+   for (size_t i = 0; i < NUM_SLOTS; i++)
+      while (slots[i].count[e & 1].load() != 0)
+         std::this_thread::yield();
+}
+
+} // namespace custom
@@ -0,0 +1,275 @@
+/***********************************************************************
+ * Header:
+ *    TEST CONCURRENT HASH
+ * Summary:
+ *    Unit tests for concurrent_unordered_set
+ * Author
+ *    Isaac Radford, Jarom Diaz, Peter Benson
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include "concurrent_hash.h"
+#include "unitTest.h"
+
+#include <atomic>
+#include <cassert>
+#include <thread>
+#include <vector>
+
+class TestConcurrentHash : public UnitTest
+{
+
+public:
+   void run()
+   {
+      reset();
+
+      // Construct
+      test_construct_default();
+      test_construct_initializer();
+
+      // Insert
+      test_insert_standard();
+      test_insert_duplicate();
+      test_insert_spread();
+
+      // Find
+      test_find_present();
+      test_find_missing();
+
+      // Remove
+      test_erase_standard();
+      test_erase_missing();
+      test_clear_standard();
+
+      // Threads
+      test_insert_threads();
+      test_mixed_threads();
+      test_forEach_threads();
+
+      report("ConcurrentHash");
+   }
+
+   /***************************************
+    * CONSTRUCT
+    ***************************************/
+
+   // a new set has every shard empty
+   void test_construct_default()
+   {  // exercise
+      custom::concurrent_unordered_set<int> us;
+      // verify
+      assertUnit(us.size() == 0);
+      assertUnit(us.empty());
+      assertUnit(us.shard_count() == 16);
+      for (size_t i = 0; i < us.shard_count(); i++)
+         assertUnit(us.shards[i].set.empty());
+   }  // teardown
+
+   // every element of the list is inserted
+   void test_construct_initializer()
+   {  // exercise
+      custom::concurrent_unordered_set<int, std::hash<int>, std::equal_to<int>, 4> us { 26, 49, 67, 26 };
+      // verify
+      assertUnit(us.size() == 3);
+      assertUnit(us.shard_count() == 4);
+      assertUnit(us.contains(26));
+      assertUnit(us.contains(49));
+      assertUnit(us.contains(67));
+   }  // teardown
+
+   /***************************************
+    * INSERT
+    ***************************************/
+
+   // an element goes into the shard its hash picks
+   void test_insert_standard()
+   {  // setup
+      custom::concurrent_unordered_set<int> us;
+      // exercise
+      bool inserted = us.insert(26);
+      // verify
+      assertUnit(inserted);
+      assertUnit(us.size() == 1);
+      assertUnit(us.shards[us.shard(26)].set.size() == 1);
+      assertUnit(us.contains(26));
+   }  // teardown
+
+   // an element already there is not inserted again
+   void test_insert_duplicate()
+   {  // setup
+      custom::concurrent_unordered_set<int> us;
+      us.insert(26);
+      // exercise
+      bool inserted = us.insert(26);
+      // verify
+      assertUnit(!inserted);
+      assertUnit(us.size() == 1);
+   }  // teardown
+
+   // consecutive keys are spread over every shard
+   void test_insert_spread()
+   {  // setup
+      custom::concurrent_unordered_set<int> us;
+      // exercise
+      for (int i = 0; i < 1000; i++)
+         us.insert(i);
+      // verify
+      assertUnit(us.size() == 1000);
+      for (size_t i = 0; i < us.shard_count(); i++)
+      {
+         assertUnit(us.shards[i].set.size() > 20);
+         assertUnit(us.shards[i].set.size() < 120);
+      }
+   }  // teardown
+
+   /***************************************
+    * FIND
+    ***************************************/
+
+   // the callback sees the element
+   void test_find_present()
+   {  // setup
+      custom::concurrent_unordered_set<int> us { 26, 49, 67 };
+      int value = 0;
+      // exercise
+      bool found = us.find(49, [&value](const int & t) { value = t; });
+      // verify
+      assertUnit(found);
+      assertUnit(value == 49);
+   }  // teardown
+
+   // the callback is not called for a missing element
+   void test_find_missing()
+   {  // setup
+      custom::concurrent_unordered_set<int> us { 26, 49, 67 };
+      bool called = false;
+      // exercise
+      bool found = us.find(50, [&called](const int &) { called = true; });
+      // verify
+      assertUnit(!found);
+      assertUnit(!called);
+      assertUnit(!us.contains(50));
+   }  // teardown
+
+   /***************************************
+    * REMOVE
+    ***************************************/
+
+   // erase removes the element from its shard
+   void test_erase_standard()
+   {  // setup
+      custom::concurrent_unordered_set<int> us { 26, 49, 67 };
+      // exercise
+      bool erased = us.erase(49);
+      // verify
+      assertUnit(erased);
+      assertUnit(us.size() == 2);
+      assertUnit(!us.contains(49));
+      assertUnit(us.contains(26));
+   }  // teardown
+
+   // erasing a missing element changes nothing
+   void test_erase_missing()
+   {  // setup
+      custom::concurrent_unordered_set<int> us { 26, 49, 67 };
+      // exercise
+      bool erased = us.erase(50);
+      // verify
+      assertUnit(!erased);
+      assertUnit(us.size() == 3);
+   }  // teardown
+
+   // clear empties every shard
+   void test_clear_standard()
+   {  // setup
+      custom::concurrent_unordered_set<int> us;
+      for (int i = 0; i < 100; i++)
+         us.insert(i);
+      // exercise
+      us.clear();
+      // verify
+      assertUnit(us.empty());
+      assertUnit(!us.contains(26));
+   }  // teardown
+
+   /***************************************
+    * THREADS
+    ***************************************/
+
+   // four threads inserting at once lose nothing
+   void test_insert_threads()
+   {  // setup
+      custom::concurrent_unordered_set<int> us;
+      std::vector<std::thread> threads;
+      // exercise
+      for (int t = 0; t < 4; t++)
+         threads.push_back(std::thread([&us, t]()
+         {
+            for (int i = 0; i < 2000; i++)
+               us.insert(t * 2000 + i);
+         }));
+      for (auto & thread : threads)
+         thread.join();
+      // verify
+      assertUnit(us.size() == 8000);
+      for (int i = 0; i < 8000; i += 97)
+         assertUnit(us.contains(i));
+   }  // teardown
+
+   // inserts, finds, and erases of the same keys from different threads
+   void test_mixed_threads()
+   {  // setup
+      custom::concurrent_unordered_set<int> us;
+      for (int i = 0; i < 1000; i++)
+         us.insert(i);
+      std::atomic<int> numFound(0);
+      // exercise
+      std::thread eraser([&us]()
+      {
+         for (int i = 0; i < 1000; i += 2)
+            us.erase(i);
+      });
+      std::thread inserter([&us]()
+      {
+         for (int i = 1000; i < 2000; i++)
+            us.insert(i);
+      });
+      std::thread finder([&us, &numFound]()
+      {
+         for (int i = 1; i < 1000; i += 2)
+            if (us.contains(i))
+               numFound++;
+      });
+      eraser.join();
+      inserter.join();
+      finder.join();
+      // verify
+      assertUnit(numFound == 500);
+      assertUnit(us.size() == 1500);
+      assertUnit(!us.contains(0));
+      assertUnit(us.contains(1));
+      assertUnit(us.contains(1999));
+   }  // teardown
+
+   // every element is visited once however many threads walk
+   void test_forEach_threads()
+   {  // setup
+      custom::concurrent_unordered_set<int> us;
+      for (int i = 1; i <= 1000; i++)
+         us.insert(i);
+      std::atomic<long> sum(0);
+      std::atomic<int> num(0);
+      // exercise
+      us.for_each([&sum, &num](const int & t) { sum += t; num++; }, 4);
+      // verify
+      assertUnit(num == 1000);
+      assertUnit(sum == 500500);
+   }  // teardown
+
+};
+
+#endif // DEBUG
@@ -0,0 +1,476 @@
+/***********************************************************************
+ * Header:
+ *    TEST FLAT HASH
+ * Summary:
+ *    Unit tests for flat_unordered_set
+ * Author
+ *    Isaac Radford, Jarom Diaz, Peter Benson
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include "flat_hash.h"
+#include "unitTest.h"
+#include "spy.h"
+
+#include <cassert>
+#include <memory>
+#include <string>
+
+class TestFlatHash : public UnitTest
+{
+
+public:
+   void run()
+   {
+      reset();
+
+      // Group
+      test_group_match();
+      test_group_matchEmpty();
+      test_group_sameAsPortable();
+
+      // Construct
+      test_construct_default();
+      test_construct_nonDefault();
+      test_construct_copyStandard();
+      test_construct_moveStandard();
+      test_construct_initializer();
+
+      // Assign
+      test_assign_standardStandard();
+      test_swap_standardEmpty();
+
+      // Iterator
+      test_iterator_all();
+
+      // Insert
+      test_insert_empty();
+      test_insert_duplicate();
+      test_insert_grow();
+      test_insert_collide();
+
+      // Find
+      test_find_empty();
+      test_find_missing();
+      test_find_lookupKey();
+
+      // Remove
+      test_erase_standard();
+      test_erase_missing();
+      test_erase_tombstone();
+      test_erase_churn();
+      test_clear_standard();
+
+      report("FlatHash");
+   }
+
+   /***************************************
+    * GROUP
+    ***************************************/
+
+   // one bit for every control byte that matches
+   void test_group_match()
+   {  // setup
+      int8_t ctrl[16] = { 5, 0, 5, -128, -2, 127, 5, 0, 1, 2, 3, 4, 5, 6, 7, 8 };
+      // exercise
+      custom::flat::Group g(ctrl);
+      // verify
+      assertUnit(g.match(5) == ((1u << 0) | (1u << 2) | (1u << 6) | (1u << 12)));
+      assertUnit(g.match(0) == ((1u << 1) | (1u << 7)));
+      assertUnit(g.match(127) == (1u << 5));
+      assertUnit(g.match(99) == 0);
+   }  // teardown
+
+   // EMPTY and DELETED are told apart from full slots
+   void test_group_matchEmpty()
+   {  // setup
+      int8_t ctrl[16];
+      for (int i = 0; i < 16; i++)
+         ctrl[i] = (int8_t)i;
+      ctrl[3] = custom::flat::EMPTY;
+      ctrl[9] = custom::flat::DELETED;
+      ctrl[15] = custom::flat::EMPTY;
+      // exercise
+      custom::flat::Group g(ctrl);
+      // verify
+      assertUnit(g.matchEmpty() == ((1u << 3) | (1u << 15)));
+      assertUnit(g.matchEmptyOrDeleted() == ((1u << 3) | (1u << 9) | (1u << 15)));
+      assertUnit(custom::flat::lowestBit(g.matchEmptyOrDeleted()) == 3);
+   }  // teardown
+
+   // the vector group gives the same answers as the byte loop
+   void test_group_sameAsPortable()
+   {  // setup
+      int8_t ctrl[16];
+      unsigned seed = 26;
+      for (int n = 0; n < 100; n++)
+      {
+         for (int i = 0; i < 16; i++)
+         {
+            seed = seed * 1103515245u + 12345u;
+            int r = (int)((seed >> 16) % 20);
+            ctrl[i] = r == 0 ? custom::flat::EMPTY : r == 1 ? custom::flat::DELETED : (int8_t)(r % 8);
+         }
+         // exercise
+         custom::flat::Group g(ctrl);
+         custom::flat::GroupPortable gPortable(ctrl);
+         // verify
+         for (int8_t h = 0; h < 8; h++)
+            assertUnit(g.match(h) == gPortable.match(h));
+         assertUnit(g.matchEmpty() == gPortable.matchEmpty());
+         assertUnit(g.matchEmptyOrDeleted() == gPortable.matchEmptyOrDeleted());
+      }
+   }  // teardown
+
+   /***************************************
+    * CONSTRUCTOR
+    ***************************************/
+
+   // a new set has no slots at all
+   void test_construct_default()
+   {  // setup
+      Spy::reset();
+      // exercise
+      custom::flat_unordered_set<Spy> s;
+      // verify
+      assertUnit(Spy::numAlloc() == 0);
+      assertUnit(s.ctrl == nullptr);
+      assertUnit(s.slots == nullptr);
+      assertUnit(s.capacity == 0);
+      assertUnit(s.numElements == 0);
+      assertUnit(s.begin() == s.end());
+   }  // teardown
+
+   // the slot count is rounded up to a power of two
+   void test_construct_nonDefault()
+   {  // exercise
+      custom::flat_unordered_set<int> s(20);
+      // verify
+      assertUnit(s.capacity == 32);
+      assertUnit(s.growthLeft == 28);
+      assertUnit(s.size() == 0);
+      for (size_t i = 0; i < s.capacity; i++)
+         assertUnit(s.ctrl[i] == s.EMPTY);
+   }  // teardown
+
+   // a copy keeps every element in the same slot
+   void test_construct_copyStandard()
+   {  // setup
+      custom::flat_unordered_set<Spy> sSrc{ Spy(26), Spy(49), Spy(67) };
+      Spy::reset();
+      // exercise
+      custom::flat_unordered_set<Spy> sDest(sSrc);
+      // verify
+      assertUnit(Spy::numCopy() == 3);
+      assertUnit(Spy::numAlloc() == 3);
+      assertUnit(sDest.size() == 3);
+      assertUnit(sDest.capacity == sSrc.capacity);
+      for (size_t i = 0; i < sSrc.capacity; i++)
+         assertUnit(sDest.ctrl[i] == sSrc.ctrl[i]);
+      assertUnit(sDest.find(Spy(49)) != sDest.end());
+      assertUnit(sSrc.size() == 3);
+   }  // teardown
+
+   // a move steals the table without touching the elements
+   void test_construct_moveStandard()
+   {  // setup
+      custom::flat_unordered_set<Spy> sSrc{ Spy(26), Spy(49), Spy(67) };
+      Spy * slots = sSrc.slots;
+      Spy::reset();
+      // exercise
+      custom::flat_unordered_set<Spy> sDest(std::move(sSrc));
+      // verify
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numCopyMove() == 0);
+      assertUnit(sDest.slots == slots);
+      assertUnit(sDest.size() == 3);
+      assertUnit(sSrc.empty());
+      assertUnit(sSrc.capacity == 0);
+   }  // teardown
+
+   // build a set from a list of values
+   void test_construct_initializer()
+   {  // exercise
+      custom::flat_unordered_set<int> s{ 26, 49, 67, 26 };
+      // verify
+      assertUnit(s.size() == 3);
+      assertUnit(s.capacity == 16);
+      assertUnit(s.find(26) != s.end());
+      assertUnit(s.find(49) != s.end());
+      assertUnit(s.find(67) != s.end());
+   }  // teardown
+
+   /***************************************
+    * ASSIGN
+    ***************************************/
+
+   // assignment replaces every element
+   void test_assign_standardStandard()
+   {  // setup
+      custom::flat_unordered_set<int> sSrc{ 1, 2, 3, 4 };
+      custom::flat_unordered_set<int> sDest{ 26, 49 };
+      // exercise
+      sDest = sSrc;
+      // verify
+      assertUnit(sDest.size() == 4);
+      assertUnit(sDest.find(26) == sDest.end());
+      assertUnit(sDest.find(3) != sDest.end());
+   }  // teardown
+
+   // swap exchanges the tables
+   void test_swap_standardEmpty()
+   {  // setup
+      custom::flat_unordered_set<int> s1{ 26, 49 };
+      custom::flat_unordered_set<int> s2;
+      // exercise
+      swap(s1, s2);
+      // verify
+      assertUnit(s1.empty());
+      assertUnit(s1.capacity == 0);
+      assertUnit(s2.size() == 2);
+      assertUnit(s2.find(49) != s2.end());
+   }  // teardown
+
+   /***************************************
+    * ITERATOR
+    ***************************************/
+
+   // iterating visits every element exactly once
+   void test_iterator_all()
+   {  // setup
+      custom::flat_unordered_set<int> s;
+      for (int i = 0; i < 100; i++)
+         s.insert(i * 7);
+      // exercise
+      int sum = 0;
+      int num = 0;
+      for (auto it = s.begin(); it != s.end(); ++it)
+      {
+         sum += *it;
+         num++;
+      }
+      // verify
+      assertUnit(num == 100);
+      assertUnit(sum == 7 * 99 * 100 / 2);
+   }  // teardown
+
+   /***************************************
+    * INSERT
+    ***************************************/
+
+   // the first insert brings in the first group
+   void test_insert_empty()
+   {  // setup
+      custom::flat_unordered_set<Spy> s;
+      Spy::reset();
+      // exercise
+      auto result = s.insert(Spy(26));
+      // verify
+      assertUnit(result.second == true);
+      assertUnit(*result.first == Spy(26));
+      assertUnit(s.size() == 1);
+      assertUnit(s.capacity == 16);
+      assertUnit(s.growthLeft == 13);
+      size_t i = result.first.pCtrl - s.ctrl;
+      assertUnit(s.ctrl[i] >= 0);
+   }  // teardown
+
+   // inserting a value already there changes nothing
+   void test_insert_duplicate()
+   {  // setup
+      custom::flat_unordered_set<Spy> s{ Spy(26), Spy(49) };
+      Spy::reset();
+      // exercise
+      auto result = s.insert(Spy(49));
+      // verify
+      assertUnit(result.second == false);
+      assertUnit(*result.first == Spy(49));
+      assertUnit(s.size() == 2);
+      assertUnit(Spy::numCopy() == 0);
+   }  // teardown
+
+   // the table doubles when it reaches 7/8 full
+   void test_insert_grow()
+   {  // setup
+      custom::flat_unordered_set<int> s;
+      for (int i = 0; i < 14; i++)
+         s.insert(i);
+      assertUnit(s.capacity == 16);
+      assertUnit(s.growthLeft == 0);
+      // exercise
+      s.insert(14);
+      // verify
+      assertUnit(s.capacity == 32);
+      assertUnit(s.size() == 15);
+      assertUnit(s.growthLeft == 28 - 15);
+      for (int i = 0; i < 15; i++)
+         assertUnit(s.find(i) != s.end());
+   }  // teardown
+
+   // a hash that always collides still works, just slowly
+   void test_insert_collide()
+   {  // setup
+      struct HashZero
+      {
+         size_t operator () (int) const { return 0; }
+      };
+      custom::flat_unordered_set<int, HashZero> s;
+      // exercise
+      for (int i = 0; i < 50; i++)
+         s.insert(i);
+      // verify
+      assertUnit(s.size() == 50);
+      for (int i = 0; i < 50; i++)
+         assertUnit(s.find(i) != s.end());
+      assertUnit(s.find(50) == s.end());
+   }  // teardown
+
+   /***************************************
+    * FIND
+    ***************************************/
+
+   // nothing is found in an empty set
+   void test_find_empty()
+   {  // setup
+      custom::flat_unordered_set<Spy> s;
+      Spy::reset();
+      // exercise
+      auto it = s.find(Spy(26));
+      // verify
+      assertUnit(it == s.end());
+      assertUnit(Spy::numEquals() == 0);
+   }  // teardown
+
+   // a miss rarely compares an element
+   void test_find_missing()
+   {  // setup
+      custom::flat_unordered_set<Spy> s;
+      for (int i = 0; i < 10; i++)
+         s.insert(Spy(i));
+      Spy::reset();
+      // exercise
+      auto it = s.find(Spy(99));
+      // verify
+      assertUnit(it == s.end());
+      assertUnit(Spy::numEquals() <= 1);
+   }  // teardown
+
+   // find a string by a const char * without building a string
+   void test_find_lookupKey()
+   {  // setup
+      struct HashString
+      {
+         typedef void is_transparent;
+         size_t operator () (const char * s) const
+         {
+            size_t h = 14695981039346656037ull;
+            for (; *s; s++)
+               h = (h ^ (unsigned char)*s) * 1099511628211ull;
+            return h;
+         }
+         size_t operator () (const std::string & s) const { return (*this)(s.c_str()); }
+      };
+      custom::flat_unordered_set<std::string, HashString, std::equal_to<>> s;
+      s.insert(std::string("thirty"));
+      s.insert(std::string("fifty"));
+      // exercise
+      auto itFound = s.find("fifty");
+      auto itMissing = s.find("sixty");
+      // verify
+      assertUnit(itFound != s.end());
+      assertUnit(*itFound == std::string("fifty"));
+      assertUnit(itMissing == s.end());
+   }  // teardown
+
+   /***************************************
+    * REMOVE
+    ***************************************/
+
+   // erase destroys the element and frees the slot
+   void test_erase_standard()
+   {  // setup
+      custom::flat_unordered_set<Spy> s{ Spy(26), Spy(49), Spy(67) };
+      Spy::reset();
+      // exercise
+      s.erase(Spy(49));
+      // verify
+      assertUnit(Spy::numDestructor() == 2);   // the element and the argument
+      assertUnit(s.size() == 2);
+      assertUnit(s.find(Spy(49)) == s.end());
+      assertUnit(s.find(Spy(26)) != s.end());
+      assertUnit(s.growthLeft == 14 - 2);      // the group still has EMPTY slots
+   }  // teardown
+
+   // erasing something not there changes nothing
+   void test_erase_missing()
+   {  // setup
+      custom::flat_unordered_set<int> s{ 26, 49 };
+      // exercise
+      auto it = s.erase(67);
+      // verify
+      assertUnit(it == s.end());
+      assertUnit(s.size() == 2);
+   }  // teardown
+
+   // a slot in a full group becomes a tombstone so later probes keep going
+   void test_erase_tombstone()
+   {  // setup
+      struct HashZero
+      {
+         size_t operator () (int) const { return 0; }
+      };
+      custom::flat_unordered_set<int, HashZero> s(64);
+      for (int i = 0; i < 20; i++)
+         s.insert(i);
+      size_t i = s.find(3).pCtrl - s.ctrl;
+      // exercise
+      s.erase(3);
+      // verify
+      assertUnit(s.ctrl[i] == s.DELETED);
+      assertUnit(s.find(19) != s.end());
+      assertUnit(s.find(3) == s.end());
+      s.insert(3);
+      assertUnit(s.ctrl[i] >= 0);
+   }  // teardown
+
+   // insert/erase churn does not grow the table
+   void test_erase_churn()
+   {  // setup
+      custom::flat_unordered_set<int> s;
+      for (int i = 0; i < 10; i++)
+         s.insert(i);
+      size_t capacity = s.capacity;
+      // exercise
+      for (int i = 10; i < 10000; i++)
+      {
+         s.erase(i - 10);
+         s.insert(i);
+      }
+      // verify
+      assertUnit(s.size() == 10);
+      assertUnit(s.capacity == capacity);
+      for (int i = 9990; i < 10000; i++)
+         assertUnit(s.find(i) != s.end());
+   }  // teardown
+
+   // clear destroys everything but keeps the slots
+   void test_clear_standard()
+   {  // setup
+      custom::flat_unordered_set<Spy> s{ Spy(26), Spy(49), Spy(67) };
+      Spy::reset();
+      // exercise
+      s.clear();
+      // verify
+      assertUnit(Spy::numDestructor() == 3);
+      assertUnit(s.empty());
+      assertUnit(s.capacity == 16);
+      assertUnit(s.growthLeft == 14);
+      assertUnit(s.begin() == s.end());
+   }  // teardown
+
+};
+
+#endif // DEBUG
@@ -13,6 +13,10 @@
 
 #include "testPair.h"       // for the pair unit tests
 #include "testHash.h"       // for the hash unit tests
+#include "testFlatHash.h"   // for the flat hash unit tests
+#include "testHashMap.h"    // for the hash map unit tests
+#include "testConcurrentHash.h" // for the concurrent hash unit tests
+#include "testRcuHash.h"    // for the read-copy-update hash unit tests
 #include "testList.h"       // for the list unit tests
 #include "testVector.h"     // for the vector unit tests
 #include "testSpy.h"        // for the spy unit tests
@@ -31,6 +35,10 @@ int main()
    TestList().run();
    TestVector().run();
    TestHash().run();
+   TestFlatHash().run();
+   TestHashMap().run();
+   TestConcurrentHash().run();
+   TestRcuHash().run();
 #endif // DEBUG
    
    // driver
@@ -12,6 +12,7 @@
 #ifdef DEBUG
 
 #include "hash.h"
+#include "arena.h"
 #include "unitTest.h"
 #include "spy.h"
 
@@ -20,6 +21,8 @@
 #include <unordered_set>
 #include <functional>
 #include <vector>
+#include <string>
+#include <cctype>
 
 using std::cout;
 using std::endl;
@@ -137,6 +140,46 @@ public:
       test_loadFactor_default();
       test_loadFactor_two();
       test_setLoadFactor_five();
+
+      // Lookup
+      test_find_lookupKey();
+      test_find_lookupKeyMissing();
+
+      // Cached hash codes
+      test_cached_insert();
+      test_cached_rehashNoHash();
+      test_cached_findSkipsCompare();
+
+      // Incremental rehash
+      test_incremental_insertStarts();
+      test_incremental_findMidway();
+      test_incremental_eraseMidway();
+      test_incremental_insertFinishes();
+      test_incremental_beginFinishes();
+
+      // Batch lookup
+      test_findBatch_standard();
+      test_insert_customEquality();
+      test_findBatch_manyBatches();
+      test_containsBatch_standard();
+      test_containsBatch_cached();
+
+      // Bucket policies
+      test_policy_mod();
+      test_policy_pow2Round();
+      test_policy_pow2Spread();
+      test_policy_fibonacci();
+      test_policy_lemire();
+
+      // Stats
+      test_loadFactor_fraction();
+      test_stats_empty();
+      test_stats_standard();
+      test_stats_rehash();
+
+      // Allocator
+      test_arena_construct();
+      test_arena_insertRehash();
       
       report("Hash");
    }
@@ -2880,6 +2923,566 @@ public:
       teardownStandardFixture(us);
    }
 
+   /***************************************
+    * LOOKUP
+    ***************************************/
+
+   // a hash and a predicate that take a std::string or a const char *
+   struct HashString
+   {
+      typedef void is_transparent;
+      size_t operator () (const char * s) const
+      {
+         size_t h = 14695981039346656037ull;
+         for (; *s; s++)
+            h = (h ^ (unsigned char)*s) * 1099511628211ull;
+         return h;
+      }
+      size_t operator () (const std::string & s) const { return (*this)(s.c_str()); }
+   };
+
+   // find a string by a const char * without building a string
+   void test_find_lookupKey()
+   {  // setup
+      custom::unordered_set<std::string, HashString, std::equal_to<>> us;
+      us.insert(std::string("thirty"));
+      us.insert(std::string("fifty"));
+      us.insert(std::string("seventy"));
+      // exercise
+      auto it = us.find("fifty");
+      // verify
+      assertUnit(it != us.end());
+      assertUnit(*it == std::string("fifty"));
+   }  // teardown
+
+   // a key that is not there gives end()
+   void test_find_lookupKeyMissing()
+   {  // setup
+      custom::unordered_set<std::string, HashString, std::equal_to<>> us;
+      us.insert(std::string("thirty"));
+      // exercise
+      auto it = us.find("sixty");
+      // verify
+      assertUnit(it == us.end());
+   }  // teardown
+
+   /***************************************
+    * CACHED HASH CODES
+    ***************************************/
+
+   // a hash that counts how often it is called
+   struct HashCount
+   {
+      static int & num() { static int n = 0; return n; }
+      size_t operator () (const Spy & s) const { num()++; return (size_t)s.get(); }
+   };
+
+   // each element is stored next to its hash code
+   void test_cached_insert()
+   {  // setup
+      custom::unordered_set<Spy, std::hash<Spy>, std::equal_to<Spy>, std::allocator<Spy>, true> us;
+      // exercise
+      us.insert(Spy(26));
+      us.insert(Spy(49));
+      us.insert(Spy(26));
+      // verify
+      assertUnit(us.size() == 2);
+      assertUnit(us.buckets[8 % 8].size() == 1);      // 2 + 6
+      assertUnit(us.buckets[13 % 8].size() == 1);     // 4 + 9
+      assertUnit(us.buckets[0].front().hashValue == 8);
+      assertUnit(us.buckets[0].front().value == Spy(26));
+      assertUnit(*us.find(Spy(49)) == Spy(49));
+   }  // teardown
+
+   // rehash moves the elements by their cached codes
+   void test_cached_rehashNoHash()
+   {  // setup
+      custom::unordered_set<Spy, HashCount, std::equal_to<Spy>, std::allocator<Spy>, true> us;
+      for (int i = 0; i < 6; i++)
+         us.insert(Spy(i * 7));
+      HashCount::num() = 0;
+      // exercise
+      us.rehash(50);
+      // verify
+      assertUnit(HashCount::num() == 0);
+      assertUnit(us.bucket_count() == 50);
+      assertUnit(us.size() == 6);
+      for (int i = 0; i < 6; i++)
+         assertUnit(us.find(Spy(i * 7)) != us.end());
+   }  // teardown
+
+   // only an element with the same code is compared
+   void test_cached_findSkipsCompare()
+   {  // setup
+      //    bucket 0: 8, 16, 24, 32 with codes 8, 16, 24, 32
+      custom::unordered_set<Spy, HashCount, std::equal_to<Spy>, std::allocator<Spy>, true> us;
+      us.insert(Spy(8));
+      us.insert(Spy(16));
+      us.insert(Spy(24));
+      us.insert(Spy(32));
+      assertUnit(us.bucket_size(0) == 4);
+      Spy s(32);
+      Spy::reset();
+      // exercise
+      auto it = us.find(s);
+      // verify
+      assertUnit(Spy::numEquals() == 1);
+      assertUnit(*it == Spy(32));
+   }  // teardown
+
+   /***************************************
+    * INCREMENTAL REHASH
+    ***************************************/
+
+   // count the elements already in the new buckets
+   template <class Set>
+   size_t numMigrated(Set & us)
+   {
+      size_t num = 0;
+      for (size_t i = 0; i < us.bucket_count(); i++)
+         num += us.bucket_size(i);
+      return num;
+   }
+
+   // growing sets the old buckets aside without moving them all
+   void test_incremental_insertStarts()
+   {  // setup
+      custom::unordered_set<int> us;
+      us.incremental_rehash(true);
+      for (int i = 0; i < 8; i++)
+         us.insert(i);
+      assertUnit(!us.rehashing());
+      // exercise
+      us.insert(8);
+      // verify
+      assertUnit(us.rehashing());
+      assertUnit(us.bucket_count() == 16);
+      assertUnit(us.bucketsOld.size() == 8);
+      assertUnit(us.size() == 9);
+      assertUnit(numMigrated(us) < 9);
+   }  // teardown
+
+   // an element still in the old buckets is found
+   void test_incremental_findMidway()
+   {  // setup
+      custom::unordered_set<int> us;
+      us.incremental_rehash(true);
+      for (int i = 0; i < 9; i++)
+         us.insert(i);
+      // exercise and verify
+      for (int i = 0; i < 9; i++)
+         assertUnit(us.find(i) != us.end());
+      assertUnit(us.find(100) == us.end());
+      assertUnit(us.size() == 9);
+   }  // teardown
+
+   // an element still in the old buckets is erased
+   void test_incremental_eraseMidway()
+   {  // setup
+      custom::unordered_set<int> us;
+      us.incremental_rehash(true);
+      for (int i = 0; i < 9; i++)
+         us.insert(i);
+      assertUnit(us.rehashing());
+      // exercise
+      us.erase(7);
+      // verify
+      assertUnit(us.size() == 8);
+      assertUnit(us.find(7) == us.end());
+      assertUnit(us.find(6) != us.end());
+   }  // teardown
+
+   // a few more inserts move the rest and free the old buckets
+   void test_incremental_insertFinishes()
+   {  // setup
+      custom::unordered_set<int> us;
+      us.incremental_rehash(true);
+      for (int i = 0; i < 9; i++)
+         us.insert(i);
+      // exercise
+      for (int i = 9; i < 13; i++)
+         us.insert(i);
+      // verify
+      assertUnit(!us.rehashing());
+      assertUnit(us.bucketsOld.size() == 0);
+      assertUnit(us.bucket_count() == 16);
+      assertUnit(numMigrated(us) == 13);
+      for (int i = 0; i < 13; i++)
+         assertUnit(us.find(i) != us.end());
+   }  // teardown
+
+   // iterating first finishes the migration
+   void test_incremental_beginFinishes()
+   {  // setup
+      custom::unordered_set<int> us;
+      us.incremental_rehash(true);
+      for (int i = 0; i < 9; i++)
+         us.insert(i);
+      // exercise
+      size_t num = 0;
+      for (auto it = us.begin(); it != us.end(); ++it)
+         num++;
+      // verify
+      assertUnit(!us.rehashing());
+      assertUnit(num == 9);
+   }  // teardown
+
+   /***************************************
+    * BATCH LOOKUP
+    ***************************************/
+
+   // each key gets the same iterator find would give
+   void test_findBatch_standard()
+   {  // setup
+      custom::unordered_set<int> us;
+      us.insert(26);
+      us.insert(49);
+      us.insert(67);
+      int keys[] = { 49, 50, 26, 67, 0 };
+      custom::unordered_set<int>::iterator out[5];
+      // exercise
+      size_t num = us.find_batch(keys, 5, out);
+      // verify
+      assertUnit(num == 3);
+      assertUnit(out[0] == us.find(49));
+      assertUnit(out[1] == us.end());
+      assertUnit(out[2] == us.find(26));
+      assertUnit(out[3] == us.find(67));
+      assertUnit(out[4] == us.end());
+      assertUnit(*out[0] == 49);
+   }  // teardown
+
+   // the equality predicate decides what is a duplicate, cached or not
+   void test_insert_customEquality()
+   {  // setup
+      struct CaseHash
+      {
+         size_t operator () (const std::string& s) const
+         {
+            std::string lower(s);
+            for (auto& c : lower)
+               c = (char)std::tolower((unsigned char)c);
+            return std::hash<std::string>()(lower);
+         }
+      };
+      struct CaseEq
+      {
+         bool operator () (const std::string& lhs, const std::string& rhs) const
+         {
+            if (lhs.size() != rhs.size())
+               return false;
+            for (size_t i = 0; i < lhs.size(); i++)
+               if (std::tolower((unsigned char)lhs[i]) != std::tolower((unsigned char)rhs[i]))
+                  return false;
+            return true;
+         }
+      };
+      custom::unordered_set<std::string, CaseHash, CaseEq> us;
+      custom::unordered_set<std::string, CaseHash, CaseEq, std::allocator<std::string>, true> usCached;
+      // exercise
+      us.insert("Key");
+      auto result = us.insert("KEY");
+      usCached.insert("Key");
+      usCached.insert("kEY");
+      // verify
+      assertUnit(!result.second);
+      assertUnit(*result.first == "Key");
+      assertUnit(us.size() == 1);
+      assertUnit(usCached.size() == 1);
+      std::string keys[] = { "key", "KEy", "lock" };
+      bool out[3];
+      assertUnit(us.contains_batch(keys, 3, out) == 2);
+      assertUnit(usCached.contains_batch(keys, 3, out) == 2);
+      assertUnit(out[0] && out[1] && !out[2]);
+   }  // teardown
+
+   // more keys than fit in one batch
+   void test_findBatch_manyBatches()
+   {  // setup
+      custom::unordered_set<int> us;
+      for (int i = 0; i < 1000; i += 2)
+         us.insert(i);
+      std::vector<int> keys;
+      for (int i = 0; i < 100; i++)
+         keys.push_back(i);
+      std::vector<custom::unordered_set<int>::iterator> out(keys.size());
+      // exercise
+      size_t num = us.find_batch(keys.data(), keys.size(), out.data());
+      // verify
+      assertUnit(num == 50);
+      for (int i = 0; i < 100; i++)
+         if (i % 2 == 0)
+            assertUnit(out[i] != us.end() && *out[i] == i);
+         else
+            assertUnit(out[i] == us.end());
+   }  // teardown
+
+   // contains gives a yes or no for every key
+   void test_containsBatch_standard()
+   {  // setup
+      custom::unordered_set<int> us;
+      us.incremental_rehash(true);
+      for (int i = 0; i < 9; i++)
+         us.insert(i);
+      assertUnit(us.rehashing());
+      int keys[] = { 8, 9, 0, 7, -1 };
+      bool out[5];
+      // exercise
+      size_t num = us.contains_batch(keys, 5, out);
+      // verify
+      assertUnit(num == 3);
+      assertUnit(out[0] == true);
+      assertUnit(out[1] == false);
+      assertUnit(out[2] == true);
+      assertUnit(out[3] == true);
+      assertUnit(out[4] == false);
+   }  // teardown
+
+   // each key is hashed once, and only matching codes are compared
+   void test_containsBatch_cached()
+   {  // setup
+      custom::unordered_set<Spy, HashCount, std::equal_to<Spy>, std::allocator<Spy>, true> us;
+      us.insert(Spy(8));
+      us.insert(Spy(16));
+      us.insert(Spy(3));
+      Spy keys[] = { Spy(16), Spy(24), Spy(3) };
+      bool out[3];
+      HashCount::num() = 0;
+      Spy::reset();
+      // exercise
+      size_t num = us.contains_batch(keys, 3, out);
+      // verify
+      assertUnit(num == 2);
+      assertUnit(HashCount::num() == 3);
+      assertUnit(Spy::numEquals() == 2);
+      assertUnit(out[0] && !out[1] && out[2]);
+   }  // teardown
+
+   /***************************************
+    * BUCKET POLICIES
+    ***************************************/
+
+   // count the buckets with something in them
+   template <class Set>
+   size_t numNonEmpty(Set & us)
+   {
+      size_t num = 0;
+      for (size_t i = 0; i < us.bucket_count(); i++)
+         if (us.bucket_size(i) != 0)
+            num++;
+      return num;
+   }
+
+   // fill a set with policy P and make sure nothing is lost
+   template <class P>
+   bool fillAndFind(custom::unordered_set<int, std::hash<int>, std::equal_to<int>, std::allocator<int>, false, P> & us)
+   {
+      for (int i = 0; i < 500; i++)
+         us.insert(i * 3);
+      for (int i = 0; i < 500; i++)
+         if (us.find(i * 3) == us.end() || us.find(i * 3 + 1) != us.end())
+            return false;
+      size_t num = 0;
+      for (auto it = us.begin(); it != us.end(); ++it)
+         num++;
+      return num == 500 && us.size() == 500;
+   }
+
+   // the default keeps any count and takes the remainder
+   void test_policy_mod()
+   {
+      assertUnit(custom::mod_buckets::round(10) == 10);
+      assertUnit(custom::mod_buckets::index(26, 10) == 6);
+   }
+
+   // a power of two policy rounds every count up
+   void test_policy_pow2Round()
+   {  // setup
+      typedef custom::unordered_set<int, std::hash<int>, std::equal_to<int>, std::allocator<int>, false, custom::pow2_buckets> Set;
+      // exercise
+      Set us(10);
+      // verify
+      assertUnit(us.bucket_count() == 16);
+      assertUnit(custom::pow2_buckets::round(1) == 1);
+      assertUnit(custom::pow2_buckets::round(16) == 16);
+      assertUnit(custom::pow2_buckets::round(17) == 32);
+      assertUnit(fillAndFind(us));
+      assertUnit((us.bucket_count() & (us.bucket_count() - 1)) == 0);
+   }  // teardown
+
+   // the mixer spreads keys a mask alone would pile in one bucket
+   void test_policy_pow2Spread()
+   {  // setup
+      //    with std::hash<int> the identity, i * 16 & 15 is always 0
+      custom::unordered_set<int, std::hash<int>, std::equal_to<int>, std::allocator<int>, false, custom::pow2_buckets> us(16);
+      us.max_load_factor(2.0);
+      // exercise
+      for (int i = 0; i < 16; i++)
+         us.insert(i * 16);
+      // verify
+      assertUnit(us.bucket_count() == 16);
+      assertUnit(numNonEmpty(us) >= 8);
+      assertUnit(custom::hash_mix(0) == 0);
+      assertUnit(custom::hash_mix(1) != custom::hash_mix(2));
+   }  // teardown
+
+   // Fibonacci hashing keeps the top bits of the product
+   void test_policy_fibonacci()
+   {  // setup
+      custom::unordered_set<int, std::hash<int>, std::equal_to<int>, std::allocator<int>, false, custom::fibonacci_buckets> us(16);
+      us.max_load_factor(2.0);
+      // exercise
+      for (int i = 0; i < 16; i++)
+         us.insert(i * 16);
+      // verify
+      assertUnit(numNonEmpty(us) >= 8);
+      assertUnit(custom::fibonacci_buckets::log2(64) == 6);
+      assertUnit(custom::fibonacci_buckets::index(12345, 1) == 0);
+      for (size_t h = 0; h < 1000; h++)
+         assertUnit(custom::fibonacci_buckets::index(h, 64) < 64);
+      custom::unordered_set<int, std::hash<int>, std::equal_to<int>, std::allocator<int>, false, custom::fibonacci_buckets> usFill;
+      assertUnit(fillAndFind(usFill));
+   }  // teardown
+
+   // Lemire's reduction keeps any count and stays in range
+   void test_policy_lemire()
+   {  // setup
+      typedef custom::unordered_set<int, std::hash<int>, std::equal_to<int>, std::allocator<int>, false, custom::lemire_buckets> Set;
+      // exercise
+      Set us(10);
+      // verify
+      assertUnit(us.bucket_count() == 10);
+      for (size_t h = 0; h < 1000; h++)
+         assertUnit(custom::lemire_buckets::index(h, 10) < 10);
+      assertUnit(fillAndFind(us));
+   }  // teardown
+
+   /***************************************
+    * STATS
+    ***************************************/
+
+   // the load factor is not rounded down to a whole number
+   void test_loadFactor_fraction()
+   {  // setup
+      custom::unordered_set<int> us;
+      // exercise
+      us.insert(26);
+      us.insert(49);
+      // verify
+      assertUnit(us.load_factor() == 0.25);
+   }  // teardown
+
+   // an empty set still has buckets and costs memory
+   void test_stats_empty()
+   {  // setup
+      custom::unordered_set<int> us;
+      // exercise
+      custom::hash_stats s = us.stats();
+      // verify
+      assertUnit(s.numElements == 0);
+      assertUnit(s.numBuckets == 8);
+      assertUnit(s.numEmptyBuckets == 8);
+      assertUnit(s.longestChain == 0);
+      assertUnit(s.avgProbeHit == 0.0);
+      assertUnit(s.avgProbeMiss == 0.0);
+      assertUnit(s.occupancy.size() == 1);
+      assertUnit(s.occupancy[0] == 8);
+      assertUnit(s.bytesUsed >= sizeof(us) + 8 * sizeof(custom::unordered_set<int>::Bucket));
+      assertUnit(s.bytesPerElement == 0.0);
+      assertUnit(s.numRehashes == 0);
+   }  // teardown
+
+   // the standard fixture, chains of 1, 2, 1, and 0
+   void test_stats_standard()
+   {  // setup
+      // h[0] --> 31
+      // h[1] --> 49 67
+      // h[2] --> 59
+      // h[3] -->
+      custom::unordered_set<Spy> us;
+      setupStandardFixture(us);
+      Spy::reset();
+      // exercise
+      custom::hash_stats s = us.stats();
+      // verify
+      assertUnit(Spy::numEquals() == 0);
+      assertUnit(s.numElements == 4);
+      assertUnit(s.numBuckets == 4);
+      assertUnit(s.numEmptyBuckets == 1);
+      assertUnit(s.longestChain == 2);
+      assertUnit(s.loadFactor == 1.0);
+      assertUnit(s.occupancy.size() == 3);
+      assertUnit(s.occupancy[0] == 1);
+      assertUnit(s.occupancy[1] == 2);
+      assertUnit(s.occupancy[2] == 1);
+      assertUnit(s.avgProbeHit == 5.0 / 4.0);     // 1 + (1 + 2) + 1
+      assertUnit(s.avgProbeMiss == 1.0);
+      assertUnit(s.bytesUsed == sizeof(us)
+                              + us.buckets.capacity() * sizeof(custom::unordered_set<Spy>::Bucket)
+                              + 4 * custom::unordered_set<Spy>::Bucket::node_size());
+      assertUnit(s.bytesPerElement == s.bytesUsed / 4.0);
+      assertStandardFixture(us);
+      // teardown
+      teardownStandardFixture(us);
+   }
+
+   // growing is counted, whether all at once or a bit at a time
+   void test_stats_rehash()
+   {  // setup
+      custom::unordered_set<int> us;
+      custom::unordered_set<int> usIncremental;
+      usIncremental.incremental_rehash(true);
+      // exercise
+      for (int i = 0; i < 20; i++)
+      {
+         us.insert(i);
+         usIncremental.insert(i);
+      }
+      us.rehash(100);
+      // verify
+      assertUnit(us.stats().numRehashes == 3);             // 8 -> 16 -> 32 -> 100
+      assertUnit(us.stats().secondsRehashing > 0.0);
+      assertUnit(usIncremental.stats().numRehashes == 2);  // 8 -> 16 -> 32
+      assertUnit(usIncremental.stats().numElements == 20);
+   }  // teardown
+
+   /***************************************
+    * ALLOCATOR
+    ***************************************/
+
+   // the buckets and every bucket's nodes come from the arena
+   void test_arena_construct()
+   {  // setup
+      typedef custom::unordered_set<int, std::hash<int>, std::equal_to<int>, custom::arena_allocator<int>> Set;
+      custom::arena a;
+      // exercise
+      Set us(a);
+      // verify
+      assertUnit(us.alloc.resource() == &a);
+      assertUnit(us.buckets.size() == 8);
+      assertUnit(a.bytes_allocated() == 8 * sizeof(Set::Bucket));
+      for (size_t i = 0; i < us.buckets.size(); i++)
+         assertUnit(us.buckets[i].alloc.resource() == &a);
+   }  // teardown
+
+   // the new buckets made by a rehash also come from the arena
+   void test_arena_insertRehash()
+   {  // setup
+      typedef custom::unordered_set<int, std::hash<int>, std::equal_to<int>, custom::arena_allocator<int>> Set;
+      custom::arena a;
+      Set us(a);
+      // exercise
+      for (int i = 0; i < 20; i++)
+         us.insert(i);
+      // verify
+      assertUnit(us.size() == 20);
+      assertUnit(us.bucket_count() > 8);
+      for (size_t i = 0; i < us.buckets.size(); i++)
+         assertUnit(us.buckets[i].alloc.resource() == &a);
+      assertUnit(us.find(13) != us.end());
+      assertUnit(us.find(20) == us.end());
+   }  // teardown
+
    /*************************************************************
     * SETUP STANDARD FIXTURE
     *      h[0] --> 31 
@@ -0,0 +1,364 @@
+/***********************************************************************
+ * Header:
+ *    TEST HASH MAP
+ * Summary:
+ *    Unit tests for unordered_map
+ * Author
+ *    Isaac Radford, Jarom Diaz, Peter Benson
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include "hash_map.h"
+#include "unitTest.h"
+#include "spy.h"
+
+#include <cassert>
+#include <stdexcept>
+#include <string>
+#include <cctype>
+
+class TestHashMap : public UnitTest
+{
+
+public:
+   void run()
+   {
+      reset();
+
+      // Construct
+      test_construct_default();
+      test_construct_initializer();
+      test_construct_copy();
+
+      // Access
+      test_subscript_insert();
+      test_subscript_existing();
+      test_at_existing();
+      test_at_missing();
+      test_find_present();
+      test_find_missing();
+
+      // Insert
+      test_insert_duplicate();
+      test_tryEmplace_new();
+      test_tryEmplace_existing();
+      test_tryEmplace_inPlace();
+      test_insert_customEquality();
+      test_insertOrAssign_new();
+      test_insertOrAssign_existing();
+      test_insert_grow();
+
+      // Remove
+      test_erase_key();
+      test_erase_missing();
+
+      report("HashMap");
+   }
+
+   /***************************************
+    * CONSTRUCT
+    ***************************************/
+
+   // a new map is an empty hash of eight buckets
+   void test_construct_default()
+   {  // exercise
+      custom::unordered_map<int, Spy> m;
+      // verify
+      assertUnit(m.empty());
+      assertUnit(m.size() == 0);
+      assertUnit(m.bucket_count() == 8);
+      assertUnit(m.begin() == m.end());
+   }  // teardown
+
+   // a repeated key keeps its first value
+   void test_construct_initializer()
+   {  // exercise
+      custom::unordered_map<std::string, int> m { { "cat", 26 }, { "dog", 49 }, { "cat", 67 } };
+      // verify
+      assertUnit(m.size() == 2);
+      assertUnit(m["cat"] == 26);
+      assertUnit(m["dog"] == 49);
+   }  // teardown
+
+   // a copy does not share values with the original
+   void test_construct_copy()
+   {  // setup
+      custom::unordered_map<int, int> mSrc { { 26, 1 }, { 49, 2 } };
+      // exercise
+      custom::unordered_map<int, int> mDest(mSrc);
+      mDest[26] = 100;
+      // verify
+      assertUnit(mDest.size() == 2);
+      assertUnit(mSrc[26] == 1);
+      assertUnit(mDest[26] == 100);
+   }  // teardown
+
+   /***************************************
+    * ACCESS
+    ***************************************/
+
+   // a missing key is inserted with a blank value
+   void test_subscript_insert()
+   {  // setup
+      custom::unordered_map<int, Spy> m;
+      // exercise
+      m[26] = Spy(99);
+      // verify
+      assertUnit(m.size() == 1);
+      assertUnit(m[26] == Spy(99));
+      assertUnit(m.size() == 1);
+   }  // teardown
+
+   // a key already there is not inserted again
+   void test_subscript_existing()
+   {  // setup
+      custom::unordered_map<int, int> m { { 26, 1 } };
+      // exercise
+      m[26]++;
+      // verify
+      assertUnit(m.size() == 1);
+      assertUnit(m[26] == 2);
+   }  // teardown
+
+   // at hands back the value to change
+   void test_at_existing()
+   {  // setup
+      custom::unordered_map<int, int> m { { 26, 1 }, { 49, 2 } };
+      // exercise
+      m.at(49) = 5;
+      // verify
+      assertUnit(m.at(49) == 5);
+      assertUnit(m.size() == 2);
+   }  // teardown
+
+   // at throws rather than inserting
+   void test_at_missing()
+   {  // setup
+      custom::unordered_map<int, int> m { { 26, 1 } };
+      bool thrown = false;
+      // exercise
+      try
+      {
+         m.at(49);
+      }
+      catch (const std::out_of_range &)
+      {
+         thrown = true;
+      }
+      // verify
+      assertUnit(thrown);
+      assertUnit(m.size() == 1);
+   }  // teardown
+
+   // find builds no value, only the key is compared
+   void test_find_present()
+   {  // setup
+      custom::unordered_map<int, Spy> m;
+      m[26] = Spy(1);
+      m[49] = Spy(2);
+      Spy::reset();
+      // exercise
+      auto it = m.find(49);
+      // verify
+      assertUnit(it != m.end());
+      assertUnit((*it).first == 49);
+      assertUnit((*it).second == Spy(2));
+      Spy::reset();
+      m.find(26);
+      assertUnit(Spy::numDefault() == 0);
+      assertUnit(Spy::numEquals() == 0);
+   }  // teardown
+
+   // a missing key is end
+   void test_find_missing()
+   {  // setup
+      custom::unordered_map<int, Spy> m;
+      m[26] = Spy(1);
+      Spy::reset();
+      // exercise
+      auto it = m.find(49);
+      // verify
+      assertUnit(it == m.end());
+      assertUnit(m.count(49) == 0);
+      assertUnit(m.count(26) == 1);
+      assertUnit(Spy::numDefault() == 0);
+   }  // teardown
+
+   /***************************************
+    * INSERT
+    ***************************************/
+
+   // insert leaves the value of a key already there alone
+   void test_insert_duplicate()
+   {  // setup
+      custom::unordered_map<int, int> m { { 26, 1 } };
+      // exercise
+      auto result = m.insert(custom::pair<int, int>(26, 5));
+      // verify
+      assertUnit(!result.second);
+      assertUnit((*result.first).second == 1);
+      assertUnit(result.first == m.find(26));
+   }  // teardown
+
+   // try_emplace builds the value from its arguments
+   void test_tryEmplace_new()
+   {  // setup
+      custom::unordered_map<int, std::string> m;
+      // exercise
+      auto result = m.try_emplace(26, 3, 'x');
+      // verify
+      assertUnit(result.second);
+      assertUnit((*result.first).first == 26);
+      assertUnit((*result.first).second == "xxx");
+      assertUnit(m.size() == 1);
+   }  // teardown
+
+   // try_emplace builds nothing when the key is there
+   void test_tryEmplace_existing()
+   {  // setup
+      custom::unordered_map<int, Spy> m;
+      m[26] = Spy(1);
+      Spy::reset();
+      // exercise
+      auto result = m.try_emplace(26, 99);
+      // verify
+      assertUnit(!result.second);
+      assertUnit((*result.first).second == Spy(1));
+      Spy::reset();
+      m.try_emplace(26, 99);
+      assertUnit(Spy::numNondefault() == 0);
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numAssign() == 0);
+   }  // teardown
+
+   // try_emplace builds the value once, in its node
+   void test_tryEmplace_inPlace()
+   {  // setup
+      custom::unordered_map<int, Spy> m;
+      Spy::reset();
+      // exercise
+      auto result = m.try_emplace(26, 99);
+      // verify
+      assertUnit(result.second);
+      assertUnit((*result.first).second == Spy(99));
+      assertUnit(Spy::numNondefault() == 2);   // one in the map, one to compare with
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numCopyMove() == 0);
+   }  // teardown
+
+   // keys are the same when EqPred says so, not when == does
+   void test_insert_customEquality()
+   {  // setup
+      struct CaseHash
+      {
+         size_t operator () (const std::string& s) const
+         {
+            std::string lower(s);
+            for (auto& c : lower)
+               c = (char)std::tolower((unsigned char)c);
+            return std::hash<std::string>()(lower);
+         }
+      };
+      struct CaseEq
+      {
+         bool operator () (const std::string& lhs, const std::string& rhs) const
+         {
+            if (lhs.size() != rhs.size())
+               return false;
+            for (size_t i = 0; i < lhs.size(); i++)
+               if (std::tolower((unsigned char)lhs[i]) != std::tolower((unsigned char)rhs[i]))
+                  return false;
+            return true;
+         }
+      };
+      custom::unordered_map<std::string, int, CaseHash, CaseEq> m;
+      // exercise
+      m.insert(custom::pair<std::string, int>("Key", 1));
+      auto result = m.insert(custom::pair<std::string, int>("KEY", 2));
+      m.try_emplace("kEy", 3);
+      // verify
+      assertUnit(!result.second);
+      assertUnit(m.size() == 1);
+      assertUnit(m["key"] == 1);
+      assertUnit(m.size() == 1);
+      assertUnit(m.find("KEY") != m.end());
+      assertUnit(m.erase("kEY") == 1);
+      assertUnit(m.empty());
+   }  // teardown
+
+   // insert_or_assign inserts a missing key
+   void test_insertOrAssign_new()
+   {  // setup
+      custom::unordered_map<int, int> m;
+      // exercise
+      auto result = m.insert_or_assign(26, 1);
+      // verify
+      assertUnit(result.second);
+      assertUnit((*result.first).second == 1);
+      assertUnit(m.size() == 1);
+   }  // teardown
+
+   // insert_or_assign replaces the value of a key already there
+   void test_insertOrAssign_existing()
+   {  // setup
+      custom::unordered_map<int, int> m { { 26, 1 } };
+      // exercise
+      auto result = m.insert_or_assign(26, 5);
+      // verify
+      assertUnit(!result.second);
+      assertUnit((*result.first).second == 5);
+      assertUnit(m.size() == 1);
+   }  // teardown
+
+   // values survive every rehash
+   void test_insert_grow()
+   {  // setup
+      custom::unordered_map<int, int> m;
+      // exercise
+      for (int i = 0; i < 100; i++)
+         m[i] = i * i;
+      // verify
+      assertUnit(m.size() == 100);
+      assertUnit(m.bucket_count() >= 100);
+      for (int i = 0; i < 100; i++)
+         assertUnit(m.at(i) == i * i);
+      size_t num = 0;
+      for (auto it = m.begin(); it != m.end(); ++it)
+         num++;
+      assertUnit(num == 100);
+   }  // teardown
+
+   /***************************************
+    * REMOVE
+    ***************************************/
+
+   // erase by key removes the pair
+   void test_erase_key()
+   {  // setup
+      custom::unordered_map<int, int> m { { 26, 1 }, { 49, 2 }, { 67, 3 } };
+      // exercise
+      size_t num = m.erase(49);
+      // verify
+      assertUnit(num == 1);
+      assertUnit(m.size() == 2);
+      assertUnit(m.find(49) == m.end());
+      assertUnit(m.find(67) != m.end());
+   }  // teardown
+
+   // erasing a missing key changes nothing
+   void test_erase_missing()
+   {  // setup
+      custom::unordered_map<int, int> m { { 26, 1 } };
+      // exercise
+      size_t num = m.erase(49);
+      // verify
+      assertUnit(num == 0);
+      assertUnit(m.size() == 1);
+   }  // teardown
+
+};
+
+#endif // DEBUG
@@ -0,0 +1,316 @@
+/***********************************************************************
+ * Header:
+ *    TEST RCU HASH
+ * Summary:
+ *    Unit tests for rcu_unordered_set
+ * Author
+ *    Isaac Radford, Jarom Diaz, Peter Benson
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include "rcu_hash.h"
+#include "unitTest.h"
+
+#include <atomic>
+#include <cassert>
+#include <thread>
+#include <vector>
+
+class TestRcuHash : public UnitTest
+{
+
+public:
+   void run()
+   {
+      reset();
+
+      // Construct
+      test_construct_default();
+      test_construct_initializer();
+
+      // Read
+      test_read_find();
+      test_read_pinned();
+      test_read_counted();
+      test_read_move();
+
+      // Write
+      test_insert_publish();
+      test_insert_duplicate();
+      test_erase_standard();
+      test_update_batch();
+      test_update_incrementalRehash();
+      test_reclaim_afterReaders();
+      test_reclaim_waitsForReader();
+
+      // Threads
+      test_readers_writer();
+
+      report("RcuHash");
+   }
+
+   /***************************************
+    * CONSTRUCT
+    ***************************************/
+
+   // a new set publishes an empty table
+   void test_construct_default()
+   {  // exercise
+      custom::rcu_unordered_set<int> rcu;
+      // verify
+      assertUnit(rcu.pCurrent.load() != nullptr);
+      assertUnit(rcu.size() == 0);
+      assertUnit(rcu.empty());
+      assertUnit(rcu.retired.empty());
+   }  // teardown
+
+   // the first table already holds the list
+   void test_construct_initializer()
+   {  // exercise
+      custom::rcu_unordered_set<int> rcu { 26, 49, 67 };
+      // verify
+      assertUnit(rcu.size() == 3);
+      assertUnit(rcu.contains(49));
+      assertUnit(rcu.retired.empty());
+   }  // teardown
+
+   /***************************************
+    * READ
+    ***************************************/
+
+   // a reader finds like an unordered_set
+   void test_read_find()
+   {  // setup
+      custom::rcu_unordered_set<int> rcu { 26, 49, 67 };
+      // exercise
+      auto r = rcu.read();
+      auto it = r.find(49);
+      // verify
+      assertUnit(it != r.end());
+      assertUnit(*it == 49);
+      assertUnit(r.find(50) == r.end());
+      int value = 0;
+      assertUnit(rcu.find(67, [&value](const int & t) { value = t; }));
+      assertUnit(value == 67);
+   }  // teardown
+
+   // a reader keeps the snapshot it started with
+   void test_read_pinned()
+   {  // setup
+      custom::rcu_unordered_set<int> rcu { 26, 49 };
+      auto r = rcu.read();
+      // exercise
+      rcu.update([](custom::unordered_set<int> & s)
+      {
+         s.insert(67);
+         s.erase(26);
+      });
+      // verify
+      assertUnit(r.size() == 2);
+      assertUnit(r.find(26) != r.end());
+      assertUnit(r.find(67) == r.end());
+      assertUnit(rcu.contains(67));
+      assertUnit(!rcu.contains(26));
+   }  // teardown
+
+   // a reader is counted in its epoch only while it lives
+   void test_read_counted()
+   {  // setup
+      custom::rcu_unordered_set<int> rcu;
+      size_t e = rcu.epoch.load();
+      {
+         // exercise
+         auto r = rcu.read();
+         // verify
+         assertUnit(r.e == e);
+         assertUnit(rcu.slots[r.iSlot].count[e & 1] == 1);
+      }
+      assertUnit(rcu.slots[rcu.threadSlot()].count[e & 1] == 0);
+   }  // teardown
+
+   // a moved reader is only counted once
+   void test_read_move()
+   {  // setup
+      custom::rcu_unordered_set<int> rcu { 26 };
+      size_t e = rcu.epoch.load();
+      size_t iSlot = rcu.threadSlot();
+      {
+         auto rSrc = rcu.read();
+         // exercise
+         custom::rcu_unordered_set<int>::reader rDest(std::move(rSrc));
+         // verify
+         assertUnit(rSrc.pRcu == nullptr);
+         assertUnit(rDest.find(26) != rDest.end());
+         assertUnit(rcu.slots[iSlot].count[e & 1] == 1);
+      }
+      assertUnit(rcu.slots[iSlot].count[e & 1] == 0);
+   }  // teardown
+
+   /***************************************
+    * WRITE
+    ***************************************/
+
+   // a write publishes a new table and moves to the next epoch
+   void test_insert_publish()
+   {  // setup
+      custom::rcu_unordered_set<int> rcu;
+      auto pOld = rcu.pCurrent.load();
+      size_t e = rcu.epoch.load();
+      // exercise
+      bool inserted = rcu.insert(26);
+      // verify
+      assertUnit(inserted);
+      assertUnit(rcu.pCurrent.load() != pOld);
+      assertUnit(rcu.epoch.load() == e + 1);
+      assertUnit(rcu.retired.size() == 1);
+      assertUnit(rcu.retired[0].first == pOld);
+      assertUnit(rcu.contains(26));
+   }  // teardown
+
+   // inserting an element already there returns false
+   void test_insert_duplicate()
+   {  // setup
+      custom::rcu_unordered_set<int> rcu { 26 };
+      // exercise
+      bool inserted = rcu.insert(26);
+      // verify
+      assertUnit(!inserted);
+      assertUnit(rcu.size() == 1);
+   }  // teardown
+
+   // erase publishes a table without the element
+   void test_erase_standard()
+   {  // setup
+      custom::rcu_unordered_set<int> rcu { 26, 49, 67 };
+      // exercise
+      bool erased = rcu.erase(49);
+      bool erasedMissing = rcu.erase(50);
+      // verify
+      assertUnit(erased);
+      assertUnit(!erasedMissing);
+      assertUnit(rcu.size() == 2);
+      assertUnit(!rcu.contains(49));
+   }  // teardown
+
+   // many changes cost one copy and one epoch
+   void test_update_batch()
+   {  // setup
+      custom::rcu_unordered_set<int> rcu;
+      size_t e = rcu.epoch.load();
+      // exercise
+      rcu.update([](custom::unordered_set<int> & s)
+      {
+         for (int i = 0; i < 100; i++)
+            s.insert(i);
+      });
+      // verify
+      assertUnit(rcu.size() == 100);
+      assertUnit(rcu.epoch.load() == e + 1);
+      assertUnit(rcu.retired.size() == 1);
+   }  // teardown
+
+   // a rehash fn leaves part done is finished before readers see the table
+   void test_update_incrementalRehash()
+   {  // setup
+      custom::rcu_unordered_set<int> rcu;
+      bool rehashing = false;
+      // exercise
+      rcu.update([&rehashing](custom::unordered_set<int> & s)
+      {
+         s.incremental_rehash(true);
+         for (int i = 0; i < 100 && !s.rehashing(); i++)
+            s.insert(i);
+         rehashing = s.rehashing();
+      });
+      // verify
+      assertUnit(rehashing);
+      assertUnit(!rcu.pCurrent.load()->rehashing());
+      assertUnit(!rcu.pCurrent.load()->incremental_rehash());
+      assertUnit(rcu.contains(0));
+   }  // teardown
+
+   // with no readers, a table is freed by the next write
+   void test_reclaim_afterReaders()
+   {  // setup
+      custom::rcu_unordered_set<int> rcu;
+      rcu.insert(26);
+      rcu.insert(49);
+      // exercise
+      rcu.insert(67);
+      // verify
+      assertUnit(rcu.retired.size() == 1);
+      assertUnit(rcu.size() == 3);
+   }  // teardown
+
+   // a table a reader holds is not freed under it
+   void test_reclaim_waitsForReader()
+   {  // setup
+      custom::rcu_unordered_set<int> rcu { 26 };
+      std::atomic<bool> done(false);
+      std::atomic<bool> reading(false);
+      std::atomic<bool> found(false);
+      std::thread t([&rcu, &done, &reading, &found]()
+      {
+         auto r = rcu.read();
+         reading = true;
+         while (!done)
+            std::this_thread::yield();
+         found = r.find(26) != r.end();
+      });
+      while (!reading)
+         std::this_thread::yield();
+      rcu.erase(26);
+      // exercise
+      std::thread writer([&rcu]() { rcu.insert(49); });
+      std::this_thread::yield();
+      done = true;
+      writer.join();
+      t.join();
+      // verify
+      assertUnit(found);
+      assertUnit(rcu.contains(49));
+      assertUnit(!rcu.contains(26));
+   }  // teardown
+
+   /***************************************
+    * THREADS
+    ***************************************/
+
+   // readers always see a whole table while a writer publishes
+   void test_readers_writer()
+   {  // setup
+      custom::rcu_unordered_set<int> rcu;
+      std::atomic<bool> done(false);
+      std::atomic<int> numBad(0);
+      std::vector<std::thread> readers;
+      for (int t = 0; t < 4; t++)
+         readers.push_back(std::thread([&rcu, &done, &numBad]()
+         {
+            while (!done)
+            {
+               // each write inserts 0..n-1, so every table is a prefix
+               auto r = rcu.read();
+               size_t n = r.size();
+               for (size_t i = 0; i < n; i++)
+                  if (r.find((int)i) == r.end())
+                     numBad++;
+            }
+         }));
+      // exercise
+      for (int i = 0; i < 200; i++)
+         rcu.insert(i);
+      done = true;
+      for (auto & thread : readers)
+         thread.join();
+      // verify
+      assertUnit(numBad == 0);
+      assertUnit(rcu.size() == 200);
+      assertUnit(rcu.retired.size() <= 2);
+   }  // teardown
+
+};
+
+#endif // DEBUG
@@ -154,7 +154,7 @@ namespace custom
       iterator() { this->p = nullptr; }
       iterator(T* p) { this->p = p; }
       iterator(const iterator& rhs) { *this = rhs; }
-      iterator(size_t index, vector<T>& v) { this->p = v.data + index; }
+      iterator(size_t index, vector <T, A>& v) { this->p = v.data + index; }
       iterator& operator = (const iterator& rhs)
       {
         /* p = std::move(rhs.p)*/
@@ -21,6 +21,7 @@
 
 #include <cassert>     // for ASSERT
 #include <iostream>    // for NULL
+#include "pool.h"      // for node_pool
 
 /*************************************************
  * NODE
@@ -44,6 +45,25 @@ public:
     // Move constructor
     Node(T&& data) : pNext(nullptr), pPrev(nullptr), data(std::move(data)) {};
 
+   //
+   // Allocate
+   //
+
+    // Nodes come out of this thread's pool so inserting and removing do not go to malloc
+    static void * operator new(size_t size)
+    {
+       if (size != sizeof(Node <T>))
+          return ::operator new(size);
+       return custom::node_pool <sizeof(Node <T>), alignof(Node <T>)> :: instance().allocate();
+    }
+    static void operator delete(void * p, size_t size) noexcept
+    {
+       if (size != sizeof(Node <T>))
+          ::operator delete(p);
+       else
+          custom::node_pool <sizeof(Node <T>), alignof(Node <T>)> :: instance().deallocate(p);
+    }
+
    //
    // Member variables
    //
@@ -66,6 +66,10 @@ public:
       test_size_empty();
       test_size_standard();
       test_size_standardMiddle();
+
+      //// Pool
+      test_pool_reuse();
+      test_pool_insertRemove();
       
       report("Node");
    }
@@ -1570,6 +1574,48 @@ public:
       }
    }
 
+   /***************************************
+    * POOL
+    ***************************************/
+
+   // a deleted node is the next one handed out
+   void test_pool_reuse()
+   {  // setup
+      typedef custom::node_pool <sizeof(Node <Spy>), alignof(Node <Spy>)> Pool;
+      Node <Spy> * pFirst = new Node <Spy>(Spy(26));
+      size_t numInUse = Pool::instance().blocks_in_use();
+      delete pFirst;
+      // exercise
+      Node <Spy> * pSecond = new Node <Spy>(Spy(49));
+      // verify
+      assertUnit(pSecond == pFirst);
+      assertUnit(pSecond->data == Spy(49));
+      assertUnit(Pool::instance().blocks_in_use() == numInUse);
+      // teardown
+      delete pSecond;
+   }
+
+   // insert and remove churn stays within the same slab
+   void test_pool_insertRemove()
+   {  // setup
+      typedef custom::node_pool <sizeof(Node <int>), alignof(Node <int>)> Pool;
+      Node <int> * pHead = insert((Node <int> *)nullptr, 26);
+      size_t numSlabs = Pool::instance().slabs();
+      size_t numInUse = Pool::instance().blocks_in_use();
+      // exercise
+      for (int i = 0; i < 1000; i++)
+      {
+         Node <int> * pNew = insert(pHead, i, true /*after*/);
+         remove(pNew);
+      }
+      // verify
+      assertUnit(Pool::instance().slabs() == numSlabs);
+      assertUnit(Pool::instance().blocks_in_use() == numInUse);
+      assertUnit(size(pHead) == 1);
+      // teardown
+      clear(pHead);
+   }
+
 };
 
 #endif // DEBUG
@@ -21,10 +21,13 @@
 #include <cassert>     // for ASSERT
 #include <iostream>    // for nullptr
 #include <new>         // std::bad_alloc
-#include <memory>      // for std::allocator
+#include <memory>      // for std::allocator and std::allocator_traits
+#include <utility>     // for std::forward
 
 class TestList; // forward declaration for unit tests
 class TestHash; // forward declaration for hash used later
+class TestArena;
+class TestPool;
 
 namespace custom
 {
@@ -38,6 +41,8 @@ namespace custom
     {
         friend class ::TestList; // give unit tests access to the privates
         friend class ::TestHash;
+        friend class ::TestArena;
+        friend class ::TestPool;
         friend void swap(list& lhs, list& rhs);
     public:
 
@@ -58,7 +63,7 @@ namespace custom
             }
         }
 
-        list(list <T, A>&& rhs, const A& a = A());
+        list(list <T, A>&& rhs);
         list(size_t num, const T& t, const A& a = A());
         list(size_t num, const A& a = A());
         list(const std::initializer_list<T>& il, const A& a = A()) : alloc(a), numElements(0),
@@ -88,7 +93,7 @@ namespace custom
             {
                 Node* temp = pHead;
                 pHead = temp->pNext;
-                delete temp;
+                deleteNode(temp);
             }
 
             // Reset member variables
@@ -119,6 +124,9 @@ namespace custom
             auto tempElements = rhs.numElements;
             rhs.numElements = numElements;
             numElements = tempElements;
+
+            // The nodes stay with the allocator that made them
+            std::swap(alloc, rhs.alloc);
         }
 
         //
@@ -168,6 +176,12 @@ namespace custom
         // nested linked list class
         class Node;
 
+        // every node is allocated and freed through the allocator
+        typedef typename std::allocator_traits<A>::template rebind_alloc<Node> NodeAlloc;
+        template <typename ... Args>
+        Node* newNode(Args&& ... args);
+        void deleteNode(Node* p);
+
         // member variables
         A    alloc;         // use alloacator for memory allocation
         size_t numElements; // though we could count, it is faster to keep a variable
@@ -207,6 +221,42 @@ namespace custom
         
     };
 
+    /*****************************************
+     * LIST :: NEW NODE
+     * Allocate a node through the allocator and
+     * construct it from the arguments
+     ****************************************/
+    template <typename T, typename A>
+    template <typename ... Args>
+    typename list <T, A> ::Node* list <T, A> ::newNode(Args&& ... args)
+    {
+        NodeAlloc allocNode(alloc);
+        Node* pNew = std::allocator_traits<NodeAlloc>::allocate(allocNode, 1);
+        try
+        {
+            std::allocator_traits<NodeAlloc>::construct(allocNode, pNew, std::forward<Args>(args)...);
+        }
+        catch (...)
+        {
+            std::allocator_traits<NodeAlloc>::deallocate(allocNode, pNew, 1);
+            throw;
+        }
+        return pNew;
+    }
+
+    /*****************************************
+     * LIST :: DELETE NODE
+     * Destroy a node and give its memory back
+     * to the allocator
+     ****************************************/
+    template <typename T, typename A>
+    void list <T, A> ::deleteNode(Node* p)
+    {
+        NodeAlloc allocNode(alloc);
+        std::allocator_traits<NodeAlloc>::destroy(allocNode, p);
+        std::allocator_traits<NodeAlloc>::deallocate(allocNode, p, 1);
+    }
+
     /*************************************************
      * LIST ITERATOR
      * Iterate through a List, non-constant version
@@ -311,7 +361,7 @@ namespace custom
     {
        for (size_t i = 0; i < numElements; ++i)   // Loop through the number of elements.
        {
-          Node* pNew = new list <T, A> ::Node(t); // Create a new node with the value every loop.
+          Node* pNew = newNode(t);                // Create a new node with the value every loop.
 
           if (!pHead)                             // If the head is null, set the head and tail to the new node.
           {
@@ -338,7 +388,7 @@ namespace custom
     {
         for (size_t i = 0; i < numElements; ++i)   // Loop through the number of elements.
         {
-            Node* pNew = new list <T, A> ::Node(); // Create a new node with the value every loop.
+            Node* pNew = newNode();                // Create a new node with the value every loop.
 
             if (!pHead)                            // If the head is null, set the head and tail to the new node.
             {
@@ -361,8 +411,8 @@ namespace custom
      * Steal the values from the RHS
      ****************************************/
     template <typename T, typename A>
-    list <T, A> ::list(list <T, A>&& rhs, const A& a) :
-        numElements(rhs.numElements), pHead(rhs.pHead), pTail(rhs.pTail), alloc(a)
+    list <T, A> ::list(list <T, A>&& rhs) :
+        alloc(rhs.alloc), numElements(rhs.numElements), pHead(rhs.pHead), pTail(rhs.pTail)
     {
         rhs.pHead = rhs.pTail = nullptr; // Reset RHS.
         rhs.numElements = 0;
@@ -427,7 +477,7 @@ namespace custom
           while (p != nullptr)
           {
              pNext = p->pNext;
-             delete p;
+             deleteNode(p);
              p = pNext;
              numElements--;
           }
@@ -484,7 +534,7 @@ namespace custom
           while (p != nullptr)
           {
              pNext = p->pNext;
-             delete p;
+             deleteNode(p);
              p = pNext;
              numElements--;
           }
@@ -510,7 +560,7 @@ namespace custom
           Node* pDelete = pHead; // Delete each node, one at a time.
           pHead = pHead->pNext;
           pTail = nullptr;
-          delete pDelete;
+          deleteNode(pDelete);
           numElements = 0;
        }
     }
@@ -525,7 +575,7 @@ namespace custom
     template <typename T, typename A>
     void list <T, A> ::push_back(const T& data)
     {
-       Node* pNew = new Node(data); // create a new node
+       Node* pNew = newNode(data); // create a new node
        
        pNew->pNext = pTail;
 
@@ -547,7 +597,7 @@ namespace custom
     template <typename T, typename A>
     void list <T, A> ::push_back(T&& data)
     {
-        Node* pNew = new Node(std::move(data)); // Create a new node.
+        Node* pNew = newNode(std::move(data)); // Create a new node.
         pNew->pNext = pTail;
 
         if (pHead)                              // The old tail must be updated or...
@@ -574,7 +624,7 @@ namespace custom
     template <typename T, typename A>
     void list <T, A> ::push_front(const T& data)
     {
-        Node* pNew = new Node(data); // Create a new node
+        Node* pNew = newNode(data); // Create a new node
 
         pNew->pNext = pHead;
         if (pHead)                   // The old head must be updated or...
@@ -589,7 +639,7 @@ namespace custom
     template <typename T, typename A>
     void list <T, A> ::push_front(T&& data)
     {
-        Node* pNew = new Node(std::move(data)); // Create a new node.
+        Node* pNew = newNode(std::move(data)); // Create a new node.
         
         pNew->pNext = pHead;
         if (pHead)                              // The old head must be updated or...
@@ -692,7 +742,7 @@ namespace custom
              pHead = pHead->pNext;
 
           // Delete the node.
-          delete it.p;
+          deleteNode(it.p);
           numElements--;
           return itNext;
        }
@@ -715,14 +765,14 @@ namespace custom
         const T& data)
     {
         if (empty()) {
-            pHead = pTail = new Node(data); // New element is both head and tail.
+            pHead = pTail = newNode(data); // New element is both head and tail.
             numElements = 1;                // Just one element now.
             return begin();
         }
         
         if (it == end())
         {
-            Node* pNew = new Node(data); // Create the new node.
+            Node* pNew = newNode(data); // Create the new node.
             pTail->pNext = pNew;         // Hook up the pointers
             pNew->pPrev = pTail;
             pTail = pNew;
@@ -733,7 +783,7 @@ namespace custom
         if ( it != end())
         {
             // Step 1: A new node is created.
-            Node* pNew = new Node(data);
+            Node* pNew = newNode(data);
 
             // Step 2: The new node's pPrev and pNext are hooked up.
             pNew->pPrev = it.p->pPrev;
@@ -770,14 +820,14 @@ namespace custom
         T&& data)
     {
         if (empty()) {
-            pHead = pTail = new Node(std::move(data)); // New element is both head and tail.
+            pHead = pTail = newNode(std::move(data)); // New element is both head and tail.
             numElements = 1;                           // Just one element now.
             return begin();
         }
 
         if (it == end())
         {
-            Node* pNew = new Node(std::move(data));  // Create the new node.
+            Node* pNew = newNode(std::move(data));  // Create the new node.
             pTail->pNext = pNew;                     // Hook up the pointers
             pNew->pPrev = pTail;
             pTail = pNew;
@@ -788,7 +838,7 @@ namespace custom
         if (it != end())
         {
             // Step 1: A new node is created.
-            Node* pNew = new Node(std::move(data));
+            Node* pNew = newNode(std::move(data));
 
             // Step 2: The new node's pPrev and pNext are hooked up.
             pNew->pPrev = it.p->pPrev;
@@ -0,0 +1,230 @@
+/***********************************************************************
+ * Header:
+ *    TEST ARENA
+ * Summary:
+ *    Unit tests for arena and arena_allocator
+ * Author
+ *    Peter Benson, Jarom Diaz, Isaac Radford
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include "arena.h"
+#include "list.h"
+#include "unitTest.h"
+#include "spy.h"
+
+#include <cassert>
+#include <cstdint>
+
+class TestArena : public UnitTest
+{
+
+public:
+   void run()
+   {
+      reset();
+
+      // Arena
+      test_construct_default();
+      test_allocate_first();
+      test_allocate_aligned();
+      test_allocate_newChunk();
+      test_allocate_large();
+      test_release_standard();
+
+      // Allocator
+      test_allocator_rebind();
+      test_allocator_heap();
+
+      // List
+      test_list_nodesInArena();
+      test_list_erase();
+      test_list_move();
+
+      report("Arena");
+   }
+
+   /***************************************
+    * ARENA
+    ***************************************/
+
+   // a new arena has not allocated anything
+   void test_construct_default()
+   {  // exercise
+      custom::arena a(256);
+      // verify
+      assertUnit(a.pChunks == nullptr);
+      assertUnit(a.sizeChunk == 256);
+      assertUnit(a.chunks() == 0);
+      assertUnit(a.bytes_allocated() == 0);
+   }  // teardown
+
+   // the first allocation brings in the first chunk
+   void test_allocate_first()
+   {  // setup
+      custom::arena a(256);
+      // exercise
+      void * p1 = a.allocate(24, 8);
+      void * p2 = a.allocate(24, 8);
+      // verify
+      assertUnit(a.chunks() == 1);
+      assertUnit(a.sizeChunk == 512);
+      assertUnit(a.bytes_allocated() == 48);
+      assertUnit((char *)p2 == (char *)p1 + 24);
+   }  // teardown
+
+   // padding is skipped to honor the alignment
+   void test_allocate_aligned()
+   {  // setup
+      custom::arena a(256);
+      a.allocate(1, 1);
+      // exercise
+      void * p = a.allocate(8, 64);
+      // verify
+      assertUnit((std::uintptr_t)p % 64 == 0);
+      assertUnit(a.chunks() == 1);
+   }  // teardown
+
+   // a full chunk chains on a bigger one
+   void test_allocate_newChunk()
+   {  // setup
+      custom::arena a(64);
+      a.allocate(48, 8);
+      // exercise
+      void * p = a.allocate(48, 8);
+      // verify
+      assertUnit(a.chunks() == 2);
+      assertUnit(a.sizeChunk == 256);
+      assertUnit(a.bytes_allocated() == 96);
+      assertUnit(p != nullptr);
+   }  // teardown
+
+   // a request bigger than a chunk gets a chunk of its own
+   void test_allocate_large()
+   {  // setup
+      custom::arena a(64);
+      // exercise
+      char * p = (char *)a.allocate(1000, 8);
+      p[0] = 'a';
+      p[999] = 'z';
+      // verify
+      assertUnit(a.chunks() == 1);
+      assertUnit(a.pEnd - p >= 1000);
+   }  // teardown
+
+   // release frees everything and starts over
+   void test_release_standard()
+   {  // setup
+      custom::arena a(64);
+      for (int i = 0; i < 10; i++)
+         a.allocate(48, 8);
+      // exercise
+      a.release();
+      // verify
+      assertUnit(a.pChunks == nullptr);
+      assertUnit(a.chunks() == 0);
+      assertUnit(a.bytes_allocated() == 0);
+      assertUnit(a.sizeChunk == 64);
+   }  // teardown
+
+   /***************************************
+    * ALLOCATOR
+    ***************************************/
+
+   // a rebound allocator draws from the same arena
+   void test_allocator_rebind()
+   {  // setup
+      custom::arena a;
+      custom::arena_allocator<int> allocInt(a);
+      // exercise
+      custom::arena_allocator<double> allocDouble(allocInt);
+      double * p = allocDouble.allocate(4);
+      // verify
+      assertUnit(allocDouble.resource() == &a);
+      assertUnit(allocDouble == allocInt);
+      assertUnit((std::uintptr_t)p % alignof(double) == 0);
+      assertUnit(a.bytes_allocated() == 4 * sizeof(double));
+      allocDouble.deallocate(p, 4);
+      assertUnit(a.bytes_allocated() == 4 * sizeof(double));
+   }  // teardown
+
+   // without an arena the allocator uses the heap
+   void test_allocator_heap()
+   {  // setup
+      custom::arena_allocator<Spy> alloc;
+      Spy::reset();
+      // exercise
+      Spy * p = alloc.allocate(1);
+      alloc.construct(p, Spy(26));
+      // verify
+      assertUnit(alloc.resource() == nullptr);
+      assertUnit(*p == Spy(26));
+      alloc.destroy(p);
+      alloc.deallocate(p, 1);
+   }  // teardown
+
+   /***************************************
+    * LIST
+    ***************************************/
+
+   // every node of the list comes out of the arena
+   void test_list_nodesInArena()
+   {  // setup
+      custom::arena a;
+      {
+         custom::list<Spy, custom::arena_allocator<Spy>> l(a);
+         // exercise
+         l.push_back(Spy(26));
+         l.push_back(Spy(49));
+         l.push_front(Spy(11));
+         // verify
+         assertUnit(a.bytes_allocated() == 3 * sizeof(custom::list<Spy, custom::arena_allocator<Spy>>::Node));
+         assertUnit(a.chunks() == 1);
+         assertUnit(l.size() == 3);
+         assertUnit(l.front() == Spy(11));
+         assertUnit(l.back() == Spy(49));
+         Spy::reset();
+      }
+      assertUnit(Spy::numDestructor() == 3); // the list still destroys its elements
+   }  // teardown
+
+   // erasing destroys the element but the memory stays in the arena
+   void test_list_erase()
+   {  // setup
+      custom::arena a;
+      custom::list<Spy, custom::arena_allocator<Spy>> l(a);
+      l.push_back(Spy(26));
+      l.push_back(Spy(49));
+      size_t numBytes = a.bytes_allocated();
+      Spy::reset();
+      // exercise
+      l.pop_back();
+      // verify
+      assertUnit(Spy::numDestructor() == 1);
+      assertUnit(a.bytes_allocated() == numBytes);
+      assertUnit(l.size() == 1);
+   }  // teardown
+
+   // moving a list carries the arena along with the nodes
+   void test_list_move()
+   {  // setup
+      custom::arena a;
+      custom::list<int, custom::arena_allocator<int>> lSrc(a);
+      lSrc.push_back(26);
+      lSrc.push_back(49);
+      // exercise
+      custom::list<int, custom::arena_allocator<int>> lDest(std::move(lSrc));
+      lDest.push_back(67);
+      // verify
+      assertUnit(lDest.alloc.resource() == &a);
+      assertUnit(a.bytes_allocated() == 3 * sizeof(custom::list<int, custom::arena_allocator<int>>::Node));
+      assertUnit(lDest.size() == 3);
+      assertUnit(lSrc.empty());
+   }  // teardown
+
+};
+
+#endif // DEBUG
@@ -16,6 +16,8 @@
 
 #include "testList.h"       // for the list unit tests
 #include "testSpy.h"        // for the spy unit tests
+#include "testArena.h"      // for the arena unit tests
+#include "testPool.h"       // for the pool unit tests
 int Spy::counters[] = {};
 
 
@@ -29,6 +31,8 @@ int main()
    // unit tests
    TestSpy().run();
    TestList().run();
+   TestArena().run();
+   TestPool().run();
 #endif // DEBUG
    
    return 0;
@@ -0,0 +1,246 @@
+/***********************************************************************
+ * Header:
+ *    TEST POOL
+ * Summary:
+ *    Unit tests for node_pool and pool_allocator
+ * Author
+ *    Peter Benson, Jarom Diaz, Isaac Radford
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include "pool.h"
+#include "list.h"
+#include "unitTest.h"
+#include "spy.h"
+
+#include <cassert>
+#include <cstdint>
+#include <thread>
+
+class TestPool : public UnitTest
+{
+
+public:
+   void run()
+   {
+      reset();
+
+      // Pool
+      test_construct_default();
+      test_size_rounded();
+      test_allocate_adjacent();
+      test_deallocate_reuse();
+      test_allocate_newSlab();
+      test_release_standard();
+
+      // Allocator
+      test_allocator_single();
+      test_allocator_array();
+      test_allocator_perThread();
+
+      // List
+      test_list_nodesInPool();
+      test_list_churn();
+
+      report("Pool");
+   }
+
+   /***************************************
+    * POOL
+    ***************************************/
+
+   // a new pool has not allocated anything
+   void test_construct_default()
+   {  // exercise
+      custom::node_pool<24, 8> pool;
+      // verify
+      assertUnit(pool.pSlabs == nullptr);
+      assertUnit(pool.pFree == nullptr);
+      assertUnit(pool.slabs() == 0);
+      assertUnit(pool.blocks_in_use() == 0);
+      assertUnit(pool.blocks_free() == 0);
+   }  // teardown
+
+   // blocks are big enough for the free list and keep their alignment
+   void test_size_rounded()
+   {
+      assertUnit((custom::node_pool<1, 1>::SIZE) == sizeof(void *));
+      assertUnit((custom::node_pool<20, 4>::SIZE) == 24);
+      assertUnit((custom::node_pool<24, 16>::SIZE) == 32);
+   }
+
+   // blocks of a new slab are handed out side by side
+   void test_allocate_adjacent()
+   {  // setup
+      custom::node_pool<24, 8> pool;
+      // exercise
+      char * p1 = (char *)pool.allocate();
+      char * p2 = (char *)pool.allocate();
+      // verify
+      assertUnit(p2 == p1 + 24);
+      assertUnit((std::uintptr_t)p1 % 8 == 0);
+      assertUnit(pool.slabs() == 1);
+      assertUnit(pool.blocks_in_use() == 2);
+      assertUnit(pool.blocks_free() == 30);
+   }  // teardown
+
+   // the block freed last is the first one reused
+   void test_deallocate_reuse()
+   {  // setup
+      custom::node_pool<24, 8> pool;
+      void * p1 = pool.allocate();
+      void * p2 = pool.allocate();
+      pool.deallocate(p1);
+      // exercise
+      void * p3 = pool.allocate();
+      // verify
+      assertUnit(p3 == p1);
+      assertUnit(pool.blocks_in_use() == 2);
+      assertUnit(pool.pFree == nullptr);
+      pool.deallocate(p2);
+      pool.deallocate(p3);
+      assertUnit(pool.blocks_in_use() == 0);
+   }  // teardown
+
+   // a full slab chains on one twice as large
+   void test_allocate_newSlab()
+   {  // setup
+      custom::node_pool<24, 8> pool;
+      for (int i = 0; i < 32; i++)
+         pool.allocate();
+      // exercise
+      void * p = pool.allocate();
+      // verify
+      assertUnit(p != nullptr);
+      assertUnit(pool.slabs() == 2);
+      assertUnit(pool.blocks_in_use() == 33);
+      assertUnit(pool.blocks_free() == 63);
+   }  // teardown
+
+   // release frees every slab and starts over
+   void test_release_standard()
+   {  // setup
+      custom::node_pool<24, 8> pool;
+      for (int i = 0; i < 100; i++)
+         pool.allocate();
+      // exercise
+      pool.release();
+      // verify
+      assertUnit(pool.pSlabs == nullptr);
+      assertUnit(pool.slabs() == 0);
+      assertUnit(pool.blocks_in_use() == 0);
+      assertUnit(pool.numSlabBlocks == 32);
+   }  // teardown
+
+   /***************************************
+    * ALLOCATOR
+    ***************************************/
+
+   // one object at a time comes out of the shared pool
+   void test_allocator_single()
+   {  // setup
+      custom::pool_allocator<double> alloc;
+      size_t numInUse = alloc.resource().blocks_in_use();
+      // exercise
+      double * p = alloc.allocate(1);
+      // verify
+      assertUnit(alloc.resource().blocks_in_use() == numInUse + 1);
+      assertUnit((std::uintptr_t)p % alignof(double) == 0);
+      alloc.deallocate(p, 1);
+      assertUnit(alloc.resource().blocks_in_use() == numInUse);
+      assertUnit(alloc.allocate(1) == p);
+      alloc.deallocate(p, 1);
+   }  // teardown
+
+   // arrays bypass the pool
+   void test_allocator_array()
+   {  // setup
+      custom::pool_allocator<double> alloc;
+      size_t numInUse = alloc.resource().blocks_in_use();
+      // exercise
+      double * p = alloc.allocate(10);
+      p[9] = 9.0;
+      // verify
+      assertUnit(alloc.resource().blocks_in_use() == numInUse);
+      assertUnit(alloc == custom::pool_allocator<int>());
+      alloc.deallocate(p, 10);
+   }  // teardown
+
+   // each thread has its own pool, and a block freed on another
+   // thread is still good memory
+   void test_allocator_perThread()
+   {  // setup
+      typedef custom::pool_allocator<double>::pool_type Pool;
+      Pool * pMain = &Pool::instance();
+      Pool * pOther = nullptr;
+      double * p = nullptr;
+      // exercise
+      std::thread t([&pOther, &p]()
+      {
+         pOther = &Pool::instance();
+         p = custom::pool_allocator<double>().allocate(1);
+         *p = 2.5;
+      });
+      t.join();
+      // verify
+      assertUnit(pOther != nullptr && pOther != pMain);
+      assertUnit(p != nullptr && *p == 2.5);
+      custom::pool_allocator<double>().deallocate(p, 1);
+      assertUnit(custom::pool_allocator<double>().allocate(1) == p);
+      // teardown
+      custom::pool_allocator<double>().deallocate(p, 1);
+   }
+
+   /***************************************
+    * LIST
+    ***************************************/
+
+   // every node of the list comes out of the pool
+   void test_list_nodesInPool()
+   {  // setup
+      typedef custom::list<Spy, custom::pool_allocator<Spy>> List;
+      typedef custom::pool_allocator<List::Node> NodeAlloc;
+      size_t numInUse = NodeAlloc::resource().blocks_in_use();
+      {
+         List l;
+         // exercise
+         l.push_back(Spy(26));
+         l.push_back(Spy(49));
+         l.push_front(Spy(11));
+         // verify
+         assertUnit(NodeAlloc::resource().blocks_in_use() == numInUse + 3);
+         assertUnit(l.size() == 3);
+         assertUnit(l.front() == Spy(11));
+         assertUnit(l.back() == Spy(49));
+      }
+      assertUnit(NodeAlloc::resource().blocks_in_use() == numInUse);
+   }  // teardown
+
+   // erase then insert reuses the same node
+   void test_list_churn()
+   {  // setup
+      typedef custom::list<int, custom::pool_allocator<int>> List;
+      typedef custom::pool_allocator<List::Node> NodeAlloc;
+      List l;
+      l.push_back(26);
+      l.push_back(49);
+      List::Node * pBack = l.pTail;
+      size_t numSlabs = NodeAlloc::resource().slabs();
+      // exercise
+      for (int i = 0; i < 1000; i++)
+      {
+         l.pop_back();
+         l.push_back(i);
+      }
+      // verify
+      assertUnit(l.pTail == pBack);
+      assertUnit(l.back() == 999);
+      assertUnit(NodeAlloc::resource().slabs() == numSlabs);
+   }  // teardown
+
+};
+
+#endif // DEBUG
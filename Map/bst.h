@@ -27,8 +27,12 @@
 
 #include <cassert>
 #include <utility>
-#include <memory>     // for std::allocator
+#include <memory>     // for std::allocator and std::allocator_traits
 #include <functional> // for std::less
+#include <type_traits> // for std::enable_if
+#include <algorithm>  // for std::min
+#include <iterator>   // for std::iterator_traits
+#include <vector>     // for std::vector, the nodes of a bulk insert
 #include <utility>    // for std::pair
 
 class TestBST; // forward declaration for unit tests
@@ -38,36 +42,104 @@ class TestMap;
 namespace custom
 {
 
-   template <typename TT>
+   template <typename TT, typename AA, typename TTree>
    class set;
-   template <typename KK, typename VV>
+   template <typename KK, typename VV, typename AA, typename TTree>
    class map;
 
+   /*****************************************************
+    * IS LOOKUP KEY
+    * A type other than T that compares both ways with T,
+    * like a const char * against a std::string. Looking
+    * one up need not build a T first. Numbers are left
+    * out so they still convert to T, as they always have.
+    ****************************************************/
+   template <class T, class K, class = void>
+   struct is_lookup_key : std::false_type {};
+
+   template <class T, class K>
+   struct is_lookup_key <T, K, decltype((void)(std::declval<const K&>() < std::declval<const T&>()),
+                                        (void)(std::declval<const T&>() < std::declval<const K&>()))>
+      : std::integral_constant<bool, !std::is_same<K, T>::value && !std::is_arithmetic<K>::value> {};
+
+   /*****************************************************
+    * IS FORWARD ITERATOR
+    * An iterator we can walk more than once, so the
+    * elements stay put while we look at them
+    ****************************************************/
+   template <class Iterator, class = void>
+   struct is_forward_iterator : std::false_type {};
+
+   template <class Iterator>
+   struct is_forward_iterator <Iterator, typename std::enable_if<std::is_base_of<std::forward_iterator_tag,
+                        typename std::iterator_traits<Iterator>::iterator_category>::value>::type>
+      : std::true_type {};
+
+   /*****************************************************
+    * RANGE VIEW
+    * The elements of [itBegin, itEnd) for a range-based
+    * for loop. It holds two iterators and copies nothing.
+    ****************************************************/
+   template <class Iterator>
+   class range_view
+   {
+   public:
+      range_view(const Iterator& itBegin, const Iterator& itEnd) : itBegin(itBegin), itEnd(itEnd) {}
+
+      Iterator begin() const { return itBegin; }
+      Iterator end()   const { return itEnd;   }
+      bool     empty() const { return itBegin == itEnd; }
+
+   private:
+      Iterator itBegin;          // the first element in the range
+      Iterator itEnd;            // one past the last
+   };
+
+   /*****************************************************
+    * SUBTREE SIZE
+    * How many nodes hang from a node, itself included.
+    * Only a ranked BST keeps the count, so an ordinary
+    * BNode is no bigger than before.
+    ****************************************************/
+   template <bool Ranked>
+   struct subtree_size
+   {
+      size_t numNodes = 1;
+   };
+
+   template <>
+   struct subtree_size <false>
+   {
+   };
+
    /*****************************************************************
     * BINARY SEARCH TREE
-    * Create a Binary Search Tree
+    * Create a Binary Search Tree. With Ranked each node keeps
+    * the size of its subtree, so rank(), nth_element() and
+    * count_range() descend once instead of walking the elements.
+    * It costs a size_t per node and a walk up from each new node.
     *****************************************************************/
-   template <typename T>
+   template <typename T, typename A = std::allocator<T>, bool Ranked = false>
    class BST
    {
       friend class ::TestBST; // give unit tests access to the privates
       friend class ::TestSet;
       friend class ::TestMap;
 
-      template <class TT>
+      template <class TT, class AA, class TTree>
       friend class custom::set;
 
-      template <class KK, class VV>
+      template <class KK, class VV, class AA, class TTree>
       friend class custom::map;
    public:
       //
       // Construct
       //
 
-      BST();
+      BST(const A& a = A());
       BST(const BST& rhs);
       BST(BST&& rhs);
-      BST(const std::initializer_list<T>& il);
+      BST(const std::initializer_list<T>& il, const A& a = A());
       ~BST();
 
       //
@@ -92,6 +164,32 @@ namespace custom
       //
 
       iterator find(const T& t);
+      template <class K, class = typename std::enable_if<is_lookup_key<T, K>::value>::type>
+      iterator find(const K& k);
+      template <class K, class Compare>
+      iterator find(const K& k, Compare less) const;
+
+      iterator lower_bound(const T& t) const { return lower_bound(t, std::less<T>()); }
+      template <class K, class Compare>
+      iterator lower_bound(const K& k, Compare less) const;
+      iterator upper_bound(const T& t) const { return upper_bound(t, std::less<T>()); }
+      template <class K, class Compare>
+      iterator upper_bound(const K& k, Compare less) const;
+      std::pair<iterator, iterator> equal_range(const T& t) const { return equal_range(t, std::less<T>()); }
+      template <class K, class Compare>
+      std::pair<iterator, iterator> equal_range(const K& k, Compare less) const;
+
+      //
+      // Rank, only on a Ranked tree
+      //
+
+      iterator nth_element(size_t k) const;
+      size_t   rank(const T& t) const { return rank(t, std::less<T>()); }
+      template <class K, class Compare>
+      size_t   rank(const K& k, Compare less) const;
+      size_t   count_range(const T& lo, const T& hi) const { return count_range(lo, hi, std::less<T>()); }
+      template <class K, class Compare>
+      size_t   count_range(const K& lo, const K& hi, Compare less) const;
 
       // 
       // Insert
@@ -99,6 +197,14 @@ namespace custom
 
       std::pair<iterator, bool> insert(const T& t, bool keepUnique = false);
       std::pair<iterator, bool> insert(T&& t, bool keepUnique = false);
+      template <class Iterator, class = decltype(*std::declval<Iterator&>())>
+      void insert(Iterator first, Iterator last, bool keepUnique = false);
+      iterator insert(iterator hint, const T& t, bool keepUnique = false);
+      iterator insert(iterator hint, T&& t, bool keepUnique = false);
+      template <class ... Args>
+      std::pair<iterator, bool> emplace(bool keepUnique, Args&& ... args);
+      template <class ... Args>
+      iterator emplace_hint(iterator hint, bool keepUnique, Args&& ... args);
 
       //
       // Remove
@@ -117,11 +223,35 @@ namespace custom
    private:
 
       class BNode;
+
+      // every node is allocated and freed through the allocator
+      typedef typename std::allocator_traits<A>::template rebind_alloc<BNode> NodeAlloc;
+      template <typename ... Args>
+      BNode* newNode(Args&& ... args);
+      void destroyNode(BNode* pNode);
+
       BNode* root;              // root node of the binary search tree
       size_t numElements;        // number of elements currently in the tree
+      A alloc;                   // where the nodes come from
 
       void deleteNode(BNode*& pDelete, bool toRight);
 
+      // build many nodes at once, see insert(first, last)
+      template <class Iterator>
+      void insertRange(Iterator first, Iterator last, bool keepUnique, std::false_type);
+      template <class Iterator>
+      void insertRange(Iterator first, Iterator last, bool keepUnique, std::true_type);
+      static void sortRange(std::vector<const T*>& pElements);
+      static void gather(BNode* p, std::vector<BNode*>& pNodes);
+      static BNode* linkRange(BNode** pNodes, size_t num, BNode* pParent, size_t depth, size_t depthRed);
+
+      // insert a node that is already built, see emplace()
+      struct Emplace {};
+      std::pair<iterator, bool> insertNode(BNode* pNew, bool keepUnique);
+      bool findHint(BNode* pHint, const T& t, bool keepUnique,
+                 BNode*& pParent, bool& isLeft, bool& isDuplicate) const;
+      BNode* linkNode(BNode* pNew, BNode* pParent, bool isLeft);
+
       void _clear(BNode*& pThis)
       {
          if (!pThis)
@@ -129,7 +259,7 @@ namespace custom
 
          _clear(pThis->pLeft);   // L
          _clear(pThis->pRight);  // R
-         delete pThis;           // V
+         destroyNode(pThis);     // V
          pThis = nullptr;
       }
 
@@ -143,7 +273,7 @@ namespace custom
          {
             // Destination is empty test case.
             if (!pDest)
-               pDest = new BNode(pSrc->data);
+               pDest = newNode(pSrc->data);
 
             // Neither the source nor destination are empty.
             else
@@ -161,83 +291,10 @@ namespace custom
             _assign(pDest->pLeft, pSrc->pLeft);
             if (pDest->pLeft)
                pDest->pLeft->pParent = pDest;
+            pDest->resize();
          }
 
       }
-
-      std::pair<typename BST<T>::iterator, bool>_insert(BNode*& pNode, const T& t, bool keepUnique)
-      {
-         // empty tree.
-         if (!pNode)
-         {
-            pNode = new BNode(t);
-            return std::make_pair(iterator(pNode), true);
-         }
-
-         if (keepUnique && t == pNode->data)
-         {
-            // Duplicate values are not allowed, return false
-            return std::make_pair(iterator(pNode), false);
-         }
-
-         // If the value is less than the node.
-         if (t < pNode->data)
-         {
-            if (pNode->pLeft)
-               return _insert(pNode->pLeft, t, keepUnique);
-
-            pNode->addLeft(t);
-            pNode->pLeft->balance();
-            return std::make_pair(iterator(root->pLeft), true);
-         }
-
-         // if the value is greater than the node.
-         if (pNode->pRight)
-            return _insert(pNode->pRight, t, keepUnique);
-
-         pNode->addRight(t);
-         pNode->pRight->balance();
-         return std::make_pair(iterator(root->pRight), true);
-
-      }
-
-      std::pair<typename BST<T>::iterator, bool>_insertMove(BNode*& pNode, T&& t, bool keepUnique)
-      {
-         // empty tree.
-         if (!pNode)
-         {
-            pNode = new BNode(t);
-            return std::make_pair(iterator(pNode), true);
-         }
-
-         if (keepUnique && t == pNode->data)
-         {
-            // Duplicate values are not allowed, return false
-            return std::make_pair(iterator(pNode), false);
-         }
-
-         // If the value is less than the node.
-         if (t < pNode->data)
-         {
-            // if pLeft exists, move to the next pLeft node.
-            if (pNode->pLeft)
-               return _insertMove(pNode->pLeft, std::move(t), keepUnique);
-
-            // we can now insert the node to the left and balance the tree.
-            pNode->addLeft(std::move(t));
-            pNode->pLeft->balance();
-            return std::make_pair(iterator(root->pLeft), true);
-         }
-
-         // if the value is greater than the node.
-         if (pNode->pRight)
-            return _insertMove(pNode->pRight, std::move(t), keepUnique);
-
-         pNode->addRight(std::move(t));
-         pNode->pRight->balance();
-         return std::make_pair(iterator(root->pRight), true);
-
-      }
    };
 
 
@@ -246,8 +303,8 @@ namespace custom
     * A single node in a binary tree. Note that the node does not know
     * anything about the properties of the tree so no validation can be done.
     *****************************************************************/
-   template <typename T>
-   class BST <T> ::BNode
+   template <typename T, typename A, bool Ranked>
+   class BST <T, A, Ranked> ::BNode : public subtree_size <Ranked>
    {
    public:
       // 
@@ -256,16 +313,14 @@ namespace custom
       BNode() : pLeft(nullptr), pRight(nullptr), pParent(nullptr), data(), isRed(true) {}
       BNode(const T& t) : data(t), pLeft(nullptr), pRight(nullptr), pParent(nullptr), isRed(true) {}
       BNode(T&& t) : data(std::move(t)), pLeft(nullptr), pRight(nullptr), pParent(nullptr), isRed(true) {}
+      template <class ... Args>
+      BNode(Emplace, Args&& ... args) : data(std::forward<Args>(args)...), pLeft(nullptr), pRight(nullptr), pParent(nullptr), isRed(true) {}
 
       //
       // Insert
       //
       void addLeft(BNode* pNode);
       void addRight(BNode* pNode);
-      void addLeft(const T& t);
-      void addRight(const T& t);
-      void addLeft(T&& t);
-      void addRight(T&& t);
 
       // 
       // Status
@@ -276,6 +331,11 @@ namespace custom
       // balance the tree
       void balance();
 
+      // keep the subtree sizes right once the children change, see Ranked
+      void resize()   { resize(std::integral_constant<bool, Ranked>()); }
+      void resizeUp() { resizeUp(std::integral_constant<bool, Ranked>()); }
+      static size_t sizeOf(const BNode* p) { return p ? p->numNodes : 0; }
+
 #ifdef DEBUG
       //
       // Verify
@@ -294,20 +354,30 @@ namespace custom
       BNode* pRight;         // Right child - larger
       BNode* pParent;        // Parent
       bool isRed;              // Red-black balancing stuff
+
+   private:
+      void resize(std::false_type) {}
+      void resize(std::true_type) { this->numNodes = 1 + sizeOf(pLeft) + sizeOf(pRight); }
+      void resizeUp(std::false_type) {}
+      void resizeUp(std::true_type)
+      {
+         for (BNode* p = this; p; p = p->pParent)
+            p->resize(std::true_type());
+      }
    };
 
    /**********************************************************
     * BINARY SEARCH TREE ITERATOR
     * Forward and reverse iterator through a BST
     *********************************************************/
-   template <typename T>
-   class BST <T> ::iterator
+   template <typename T, typename A, bool Ranked>
+   class BST <T, A, Ranked> ::iterator
    {
       friend class ::TestBST; // give unit tests access to the privates
       friend class ::TestSet;
       friend class ::TestMap;
 
-      template <class KK, class VV>
+      template <class KK, class VV, class AA, class TTree>
       friend class custom::map;
    public:
       // constructors and assignment
@@ -356,7 +426,8 @@ namespace custom
       }
 
       // must give friend status to remove so it can call getNode() from it
-      friend BST <T> ::iterator BST <T> ::erase(iterator& it);
+      friend BST <T, A, Ranked> ::iterator BST <T, A, Ranked> ::erase(iterator& it);
+      friend class BST <T, A, Ranked>;
 
    private:
 
@@ -374,18 +445,55 @@ namespace custom
     *********************************************/
 
 
+
+   /*********************************************
+    * BST :: NEW NODE
+    * Allocate a node through the allocator and
+    * construct it from the arguments
+    ********************************************/
+   template <typename T, typename A, bool Ranked>
+   template <typename ... Args>
+   typename BST <T, A, Ranked> ::BNode* BST <T, A, Ranked> ::newNode(Args&& ... args)
+   {
+      NodeAlloc allocNode(alloc);
+      BNode* pNew = std::allocator_traits<NodeAlloc>::allocate(allocNode, 1);
+      try
+      {
+         std::allocator_traits<NodeAlloc>::construct(allocNode, pNew, std::forward<Args>(args)...);
+      }
+      catch (...)
+      {
+         std::allocator_traits<NodeAlloc>::deallocate(allocNode, pNew, 1);
+         throw;
+      }
+      return pNew;
+   }
+
+   /*********************************************
+    * BST :: DESTROY NODE
+    * Destroy a node and give its memory back
+    * to the allocator
+    ********************************************/
+   template <typename T, typename A, bool Ranked>
+   void BST <T, A, Ranked> ::destroyNode(BNode* pNode)
+   {
+      NodeAlloc allocNode(alloc);
+      std::allocator_traits<NodeAlloc>::destroy(allocNode, pNode);
+      std::allocator_traits<NodeAlloc>::deallocate(allocNode, pNode, 1);
+   }
+
     /*********************************************
      * BST :: DEFAULT CONSTRUCTOR
      ********************************************/
-   template <typename T>
-   BST <T> ::BST() : numElements(0), root(nullptr) {}
+   template <typename T, typename A, bool Ranked>
+   BST <T, A, Ranked> ::BST(const A& a) : alloc(a), numElements(0), root(nullptr) {}
 
    /*********************************************
     * BST :: COPY CONSTRUCTOR
     * Copy one tree to another
     ********************************************/
-   template <typename T>
-   BST <T> ::BST(const BST<T>& rhs) : root(nullptr), numElements(0)
+   template <typename T, typename A, bool Ranked>
+   BST <T, A, Ranked> ::BST(const BST<T, A, Ranked>& rhs) : alloc(rhs.alloc), root(nullptr), numElements(0)
    {
       *this = rhs;
    }
@@ -394,8 +502,8 @@ namespace custom
     * BST :: MOVE CONSTRUCTOR
     * Move one tree to another
     ********************************************/
-   template <typename T>
-   BST <T> ::BST(BST <T>&& rhs) : root(nullptr), numElements(0)
+   template <typename T, typename A, bool Ranked>
+   BST <T, A, Ranked> ::BST(BST <T, A, Ranked>&& rhs) : alloc(rhs.alloc), root(nullptr), numElements(0)
    {
       root = rhs.root;
       rhs.root = nullptr;
@@ -408,8 +516,8 @@ namespace custom
     * BST :: INITIALIZER LIST CONSTRUCTOR
     * Create a BST from an initializer list
     ********************************************/
-   template <typename T>
-   BST <T> ::BST(const std::initializer_list<T>& il) : root(nullptr), numElements(il.size())
+   template <typename T, typename A, bool Ranked>
+   BST <T, A, Ranked> ::BST(const std::initializer_list<T>& il, const A& a) : alloc(a), root(nullptr), numElements(il.size())
    {
       *this = il;
    }
@@ -417,8 +525,8 @@ namespace custom
    /*********************************************
     * BST :: DESTRUCTOR
     ********************************************/
-   template <typename T>
-   BST <T> :: ~BST()
+   template <typename T, typename A, bool Ranked>
+   BST <T, A, Ranked> :: ~BST()
    {
       clear();
    }
@@ -428,8 +536,8 @@ namespace custom
     * BST :: ASSIGNMENT OPERATOR
     * Copy one tree to another
     ********************************************/
-   template <typename T>
-   BST <T>& BST <T> :: operator = (const BST <T>& rhs)
+   template <typename T, typename A, bool Ranked>
+   BST <T, A, Ranked>& BST <T, A, Ranked> :: operator = (const BST <T, A, Ranked>& rhs)
    {
       _assign(root, rhs.root);
       numElements = rhs.numElements;
@@ -440,8 +548,8 @@ namespace custom
     * BST :: ASSIGNMENT OPERATOR with INITIALIZATION LIST
     * Copy nodes onto a BTree
     ********************************************/
-   template <typename T>
-   BST <T>& BST <T> :: operator = (const std::initializer_list<T>& il)
+   template <typename T, typename A, bool Ranked>
+   BST <T, A, Ranked>& BST <T, A, Ranked> :: operator = (const std::initializer_list<T>& il)
    {
       clear(); // Clear the existing tree
 
@@ -455,8 +563,8 @@ namespace custom
     * BST :: ASSIGN-MOVE OPERATOR
     * Move one tree to another
     ********************************************/
-   template <typename T>
-   BST <T>& BST <T> :: operator = (BST <T>&& rhs)
+   template <typename T, typename A, bool Ranked>
+   BST <T, A, Ranked>& BST <T, A, Ranked> :: operator = (BST <T, A, Ranked>&& rhs)
    {
       clear();
       swap(rhs);
@@ -467,12 +575,15 @@ namespace custom
     * BST :: SWAP
     * Swap two trees
     ********************************************/
-   template <typename T>
-   void BST <T> ::swap(BST <T>& rhs)
+   template <typename T, typename A, bool Ranked>
+   void BST <T, A, Ranked> ::swap(BST <T, A, Ranked>& rhs)
    {
       // swap the root pointers of the two trees.
       std::swap(root, rhs.root);
 
+      // the nodes stay with the allocator that made them
+      std::swap(alloc, rhs.alloc);
+
       // swap the number of elements.
       std::swap(numElements, rhs.numElements);
    }
@@ -481,8 +592,8 @@ namespace custom
     * BST :: INSERT
     * Insert a node at a given location in the tree
     ****************************************************/
-   template <typename T>
-   std::pair<typename BST <T> ::iterator, bool> BST <T> ::insert(const T& t, bool keepUnique)
+   template <typename T, typename A, bool Ranked>
+   std::pair<typename BST <T, A, Ranked> ::iterator, bool> BST <T, A, Ranked> ::insert(const T& t, bool keepUnique)
    {
       std::pair<iterator, bool> pairReturn(end(), false);
       try
@@ -490,7 +601,7 @@ namespace custom
          // if we are at a trivial state (empty tree), then create a new root.
          if (root == nullptr)
          {
-            root = new BNode(t);
+            root = newNode(t);
             root->isRed = false;
             numElements = 1;
             pairReturn.first = iterator(root);
@@ -520,9 +631,11 @@ namespace custom
                // If we are at the leaf, then create a new node.
                else
                {
-                  node->addLeft(t);
-                  done = true;
+                  node->addLeft(newNode(t));
                   pairReturn.first = iterator(node->pLeft);
+                  node->pLeft->resizeUp();
+                  node->pLeft->balance();
+                  done = true;
                   pairReturn.second = true;
                }
             }
@@ -536,9 +649,11 @@ namespace custom
                // If we are at the left, then create a new node.
                else
                {
-                  node->addRight(t);
-                  done = true;
+                  node->addRight(newNode(t));
                   pairReturn.first = iterator(node->pRight);
+                  node->pRight->resizeUp();
+                  node->pRight->balance();
+                  done = true;
                   pairReturn.second = true;
                }
             }
@@ -562,8 +677,8 @@ namespace custom
 
    }
 
-   template <typename T>
-   std::pair<typename BST <T> ::iterator, bool> BST <T> ::insert(T&& t, bool keepUnique)
+   template <typename T, typename A, bool Ranked>
+   std::pair<typename BST <T, A, Ranked> ::iterator, bool> BST <T, A, Ranked> ::insert(T&& t, bool keepUnique)
    {
       std::pair<iterator, bool> pairReturn(end(), false);
       try
@@ -571,7 +686,7 @@ namespace custom
          // if we are at a trivial state (empty tree), then create a new root.
          if (root == nullptr)
          {
-            root = new BNode(std::move(t));
+            root = newNode(std::move(t));
             root->isRed = false;
             numElements = 1;
             pairReturn.first = iterator(root);
@@ -601,9 +716,11 @@ namespace custom
                // If we are at the leaf, then create a new node.
                else
                {
-                  node->addLeft(std::move(t));
-                  done = true;
+                  node->addLeft(newNode(std::move(t)));
                   pairReturn.first = iterator(node->pLeft);
+                  node->pLeft->resizeUp();
+                  node->pLeft->balance();
+                  done = true;
                   pairReturn.second = true;
                }
             }
@@ -617,9 +734,11 @@ namespace custom
                // If we are at the left, then create a new node.
                else
                {
-                  node->addRight(std::move(t));
-                  done = true;
+                  node->addRight(newNode(std::move(t)));
                   pairReturn.first = iterator(node->pRight);
+                  node->pRight->resizeUp();
+                  node->pRight->balance();
+                  done = true;
                   pairReturn.second = true;
                }
             }
@@ -643,12 +762,365 @@ namespace custom
 
    }
 
+   /*********************************************
+    * BST :: INSERT with a HINT
+    * Insert t next to hint, where it usually belongs when
+    * values come almost in order: hint is the element
+    * after t, or the one before it. Then two comparisons
+    * find the spot instead of a search from the root. If
+    * t belongs somewhere else, search from the root anyway.
+    ********************************************/
+   template <typename T, typename A, bool Ranked>
+   typename BST <T, A, Ranked> ::iterator BST <T, A, Ranked> ::insert(iterator hint, const T& t, bool keepUnique)
+   {
+      BNode* pParent = nullptr;
+      bool isLeft = false;
+      bool isDuplicate = false;
+      if (!findHint(hint.pNode, t, keepUnique, pParent, isLeft, isDuplicate))
+         return insert(t, keepUnique).first;
+      if (isDuplicate)
+         return iterator(pParent);
+      return iterator(linkNode(newNode(t), pParent, isLeft));
+   }
+   template <typename T, typename A, bool Ranked>
+   typename BST <T, A, Ranked> ::iterator BST <T, A, Ranked> ::insert(iterator hint, T&& t, bool keepUnique)
+   {
+      BNode* pParent = nullptr;
+      bool isLeft = false;
+      bool isDuplicate = false;
+      if (!findHint(hint.pNode, t, keepUnique, pParent, isLeft, isDuplicate))
+         return insert(std::move(t), keepUnique).first;
+      if (isDuplicate)
+         return iterator(pParent);
+      return iterator(linkNode(newNode(std::move(t)), pParent, isLeft));
+   }
+
+   /*********************************************
+    * BST :: EMPLACE
+    * Build the element in its node from args, then find
+    * where the node goes. A duplicate, if keepUnique, is
+    * destroyed again.
+    ********************************************/
+   template <typename T, typename A, bool Ranked>
+   template <class ... Args>
+   std::pair<typename BST <T, A, Ranked> ::iterator, bool> BST <T, A, Ranked> ::emplace(bool keepUnique, Args&& ... args)
+   {
+      return insertNode(newNode(Emplace(), std::forward<Args>(args)...), keepUnique);
+   }
+
+   /*********************************************
+    * BST :: EMPLACE with a HINT
+    * emplace() next to hint, as insert() with a hint
+    ********************************************/
+   template <typename T, typename A, bool Ranked>
+   template <class ... Args>
+   typename BST <T, A, Ranked> ::iterator BST <T, A, Ranked> ::emplace_hint(iterator hint, bool keepUnique, Args&& ... args)
+   {
+      BNode* pNew = newNode(Emplace(), std::forward<Args>(args)...);
+      BNode* pParent = nullptr;
+      bool isLeft = false;
+      bool isDuplicate = false;
+      if (!findHint(hint.pNode, pNew->data, keepUnique, pParent, isLeft, isDuplicate))
+         return insertNode(pNew, keepUnique).first;
+      if (isDuplicate)
+      {
+         destroyNode(pNew);
+         return iterator(pParent);
+      }
+      return iterator(linkNode(pNew, pParent, isLeft));
+   }
+
+   /*********************************************
+    * BST :: INSERT NODE
+    * Search from the root for where pNew goes
+    ********************************************/
+   template <typename T, typename A, bool Ranked>
+   std::pair<typename BST <T, A, Ranked> ::iterator, bool> BST <T, A, Ranked> ::insertNode(BNode* pNew, bool keepUnique)
+   {
+      if (root == nullptr)
+      {
+         root = pNew;
+         root->isRed = false;
+         numElements = 1;
+         return std::make_pair(iterator(root), true);
+      }
+
+      for (BNode* p = root; ; )
+      {
+         if (keepUnique && pNew->data == p->data)
+         {
+            destroyNode(pNew);
+            return std::make_pair(iterator(p), false);
+         }
+         bool isLeft = pNew->data < p->data;
+         BNode* pChild = isLeft ? p->pLeft : p->pRight;
+         if (pChild == nullptr)
+            return std::make_pair(iterator(linkNode(pNew, p, isLeft)), true);
+         p = pChild;
+      }
+   }
+
+   /*********************************************
+    * BST :: FIND HINT
+    * Does t go right before hint, or right after it? Then
+    * it hangs off the node after it, as its left child, or
+    * off the node before it, as its right child, whichever
+    * is free. If keepUnique and a neighbor equals t, that
+    * neighbor comes back in pParent with isDuplicate set.
+    ********************************************/
+   template <typename T, typename A, bool Ranked>
+   bool BST <T, A, Ranked> ::findHint(BNode* pHint, const T& t, bool keepUnique,
+                        BNode*& pParent, bool& isLeft, bool& isDuplicate) const
+   {
+      pParent = nullptr;
+      isDuplicate = false;
+      if (root == nullptr)
+         return false;
+
+      // 1. the neighbors t would go between
+      BNode* pPrev;
+      BNode* pNext;
+      if (pHint == nullptr || !(pHint->data < t))
+      {
+         pNext = pHint;
+         if (pHint == nullptr)
+            for (pPrev = root; pPrev->pRight; pPrev = pPrev->pRight);
+         else
+            pPrev = (--iterator(pHint)).pNode;
+         if (pPrev != nullptr && t < pPrev->data)
+            return false;
+      }
+      else
+      {
+         pPrev = pHint;
+         pNext = (++iterator(pHint)).pNode;
+         if (pNext != nullptr && pNext->data < t)
+            return false;
+      }
+
+      // 2. a neighbor may already be t
+      if (keepUnique && pNext != nullptr && t == pNext->data)
+         pParent = pNext;
+      else if (keepUnique && pPrev != nullptr && t == pPrev->data)
+         pParent = pPrev;
+      if (pParent != nullptr)
+      {
+         isDuplicate = true;
+         return true;
+      }
+
+      // 3. whichever neighbor has a free child takes t
+      isLeft = pNext != nullptr && pNext->pLeft == nullptr;
+      pParent = isLeft ? pNext : pPrev;
+      assert(pParent != nullptr && (isLeft || pParent->pRight == nullptr));
+      return true;
+   }
+
+   /*********************************************
+    * BST :: LINK NODE
+    * Hang pNew off pParent and rebalance
+    ********************************************/
+   template <typename T, typename A, bool Ranked>
+   typename BST <T, A, Ranked> ::BNode* BST <T, A, Ranked> ::linkNode(BNode* pNew, BNode* pParent, bool isLeft)
+   {
+      if (isLeft)
+         pParent->addLeft(pNew);
+      else
+         pParent->addRight(pNew);
+      pNew->resizeUp();
+      pNew->balance();
+      numElements++;
+
+      // If the root moved out from under us, find it again.
+      while (root->pParent)
+         root = root->pParent;
+      return pNew;
+   }
+
+   /*********************************************
+    * BST :: INSERT RANGE
+    * Insert everything in [first, last). A range we can
+    * walk twice is sorted, unless it already is, merged
+    * with the elements already here, and linked into a
+    * balanced tree from the bottom up: O(n) and no
+    * rebalancing, rather than O(n log n) one at a time.
+    ********************************************/
+   template <typename T, typename A, bool Ranked>
+   template <class Iterator, class>
+   void BST <T, A, Ranked> ::insert(Iterator first, Iterator last, bool keepUnique)
+   {
+      typedef typename std::decay<decltype(*first)>::type Value;
+      insertRange(first, last, keepUnique, std::integral_constant<bool,
+               is_forward_iterator<Iterator>::value && std::is_same<Value, T>::value>());
+   }
+
+   /*********************************************
+    * BST :: INSERT RANGE
+    * A single pass range, or one of something other than
+    * T, goes in one element at a time
+    ********************************************/
+   template <typename T, typename A, bool Ranked>
+   template <class Iterator>
+   void BST <T, A, Ranked> ::insertRange(Iterator first, Iterator last, bool keepUnique, std::false_type)
+   {
+      for (; first != last; ++first)
+         insert(*first, keepUnique);
+   }
+
+   /*********************************************
+    * BST :: INSERT RANGE
+    * Build the whole tree at once. The new nodes are
+    * allocated back to back in sorted order, so a pool
+    * or an arena hands them out side by side.
+    ********************************************/
+   template <typename T, typename A, bool Ranked>
+   template <class Iterator>
+   void BST <T, A, Ranked> ::insertRange(Iterator first, Iterator last, bool keepUnique, std::true_type)
+   {
+      // 1. point to the new elements, in order
+      std::vector<const T*> pNew;
+      for (auto it = first; it != last; ++it)
+         pNew.push_back(&*it);
+      for (size_t i = 1; i < pNew.size(); i++)
+         if (*pNew[i] < *pNew[i - 1])
+         {
+            sortRange(pNew);
+            break;
+         }
+
+      // 2. drop the duplicates, if asked
+      if (keepUnique && !pNew.empty())
+      {
+         size_t iKeep = 1;
+         for (size_t i = 1; i < pNew.size(); i++)
+            if (!(*pNew[i] == *pNew[iKeep - 1]))
+               pNew[iKeep++] = pNew[i];
+         pNew.resize(iKeep);
+      }
+
+      // 3. a few elements are cheaper to insert than rebuilding a big tree
+      if (pNew.size() < numElements)
+      {
+         for (auto p : pNew)
+            insert(*p, keepUnique);
+         return;
+      }
+
+      // 4. merge with the nodes already here, which go first among equals
+      std::vector<BNode*> pOld;
+      gather(root, pOld);
+      std::vector<BNode*> pNodes;
+      pNodes.reserve(pOld.size() + pNew.size());
+      size_t iOld = 0;
+      size_t iNew = 0;
+      try
+      {
+         while (iNew < pNew.size())
+            if (iOld < pOld.size() && !(*pNew[iNew] < pOld[iOld]->data))
+            {
+               if (keepUnique && *pNew[iNew] == pOld[iOld]->data)
+                  iNew++;
+               pNodes.push_back(pOld[iOld++]);
+            }
+            else
+               pNodes.push_back(newNode(*pNew[iNew++]));
+      }
+      catch (...)
+      {
+         // the tree is untouched, so only the new nodes go
+         for (size_t i = 0, j = 0; i < pNodes.size(); i++)
+            if (j < pOld.size() && pNodes[i] == pOld[j])
+               j++;
+            else
+               destroyNode(pNodes[i]);
+         throw;
+      }
+      while (iOld < pOld.size())
+         pNodes.push_back(pOld[iOld++]);
+
+      // 5. only the deepest level, which may not be full, is red
+      size_t depthRed = 0;
+      for (size_t num = pNodes.size(); num > 1; num /= 2)
+         depthRed++;
+      root = linkRange(pNodes.data(), pNodes.size(), nullptr, 0, depthRed);
+      numElements = pNodes.size();
+   }
+
+   /*********************************************
+    * BST :: SORT RANGE
+    * A stable bottom-up merge sort of pointers to the
+    * elements, so no element is copied to sort them
+    ********************************************/
+   template <typename T, typename A, bool Ranked>
+   void BST <T, A, Ranked> ::sortRange(std::vector<const T*>& pElements)
+   {
+      size_t num = pElements.size();
+      std::vector<const T*> pMerged(num);
+      for (size_t width = 1; width < num; width *= 2)
+      {
+         for (size_t iLow = 0; iLow < num; iLow += 2 * width)
+         {
+            size_t iMid = std::min(iLow + width, num);
+            size_t iHigh = std::min(iLow + 2 * width, num);
+            size_t i = iLow;
+            size_t j = iMid;
+            size_t k = iLow;
+            while (i < iMid && j < iHigh)
+               pMerged[k++] = (*pElements[j] < *pElements[i]) ? pElements[j++] : pElements[i++];
+            while (i < iMid)
+               pMerged[k++] = pElements[i++];
+            while (j < iHigh)
+               pMerged[k++] = pElements[j++];
+         }
+         pElements.swap(pMerged);
+      }
+   }
+
+   /*********************************************
+    * BST :: GATHER
+    * Every node below p, in order
+    ********************************************/
+   template <typename T, typename A, bool Ranked>
+   void BST <T, A, Ranked> ::gather(BNode* p, std::vector<BNode*>& pNodes)
+   {
+      if (!p)
+         return;
+      gather(p->pLeft, pNodes);
+      pNodes.push_back(p);
+      gather(p->pRight, pNodes);
+   }
+
+   /*********************************************
+    * BST :: LINK RANGE
+    * Hang num sorted nodes under pParent, the middle one
+    * on top. Both halves differ in size by at most one,
+    * so every path ends at depthRed or one above it, and
+    * coloring depthRed red gives every path the same
+    * number of black nodes.
+    ********************************************/
+   template <typename T, typename A, bool Ranked>
+   typename BST <T, A, Ranked> ::BNode* BST <T, A, Ranked> ::linkRange(BNode** pNodes, size_t num, BNode* pParent,
+                                          size_t depth, size_t depthRed)
+   {
+      if (num == 0)
+         return nullptr;
+
+      size_t iMid = num / 2;
+      BNode* p = pNodes[iMid];
+      p->pParent = pParent;
+      p->isRed = depth == depthRed && depth > 0;
+      p->pLeft = linkRange(pNodes, iMid, p, depth + 1, depthRed);
+      p->pRight = linkRange(pNodes + iMid + 1, num - iMid - 1, p, depth + 1, depthRed);
+      p->resize();
+      return p;
+   }
+
    /*************************************************
     * BST :: ERASE
     * Remove a given node as specified by the iterator
     ************************************************/
-   template <typename T>
-   typename BST <T> ::iterator BST <T> ::erase(iterator& it)
+   template <typename T, typename A, bool Ranked>
+   typename BST <T, A, Ranked> ::iterator BST <T, A, Ranked> ::erase(iterator& it)
    {
       // do nothing if there is nothing to do.
       if (it == end())
@@ -657,6 +1129,7 @@ namespace custom
       // remember where we were.
       iterator itNext = it;
       BNode* pDelete = it.pNode;
+      BNode* pFix = pDelete->pParent;   // the lowest node left with one fewer below it
 
       // If there is only one child (right) or no children.
       if (pDelete->pLeft == nullptr)
@@ -678,6 +1151,7 @@ namespace custom
          BNode* pIOS = pDelete->pRight;
          while (pIOS->pLeft != nullptr)
             pIOS = pIOS->pLeft;
+         pFix = (pIOS->pParent == pDelete ? pIOS : pIOS->pParent);
 
          // The IOS must not have a right node. Now it will take pDelete's place.
          pIOS->pLeft = pDelete->pLeft;
@@ -710,8 +1184,10 @@ namespace custom
          itNext = iterator(pIOS);
       }
 
+      if (pFix)
+         pFix->resizeUp();
       numElements--;
-      delete pDelete;
+      destroyNode(pDelete);
       return itNext;
 
    }
@@ -729,7 +1205,7 @@ namespace custom
    //        it.pNode->pParent->pRight = nullptr :
    //        it.pNode->pParent->pLeft = nullptr;
 
-   //    delete it.pNode;
+   //    destroyNode(it.pNode);
    //    --numElements;
    //    return itNext;
    //}
@@ -747,7 +1223,7 @@ namespace custom
    //        it.pNode->pParent->pRight = it.pNode->pLeft :
    //        it.pNode->pParent->pLeft = it.pNode->pLeft;
 
-   //    delete it.pNode;
+   //    destroyNode(it.pNode);
    //    --numElements;
    //    return itNext;
    //}
@@ -764,7 +1240,7 @@ namespace custom
    //        it.pNode->pParent->pRight = it.pNode->pRight :
    //        it.pNode->pParent->pLeft = it.pNode->pRight;
 
-   //    delete it.pNode;
+   //    destroyNode(it.pNode);
    //    --numElements;
    //    return itNext;
    //}
@@ -804,7 +1280,7 @@ namespace custom
    //        it.pNode->pRight->pParent = pSuccessor.pNode;
 
    //    // Delete the erased node and update the numElements
-   //    delete it.pNode;
+   //    destroyNode(it.pNode);
    //    --numElements;
    //    return pSuccessor;
    //}
@@ -816,8 +1292,8 @@ namespace custom
  * BST :: CLEAR
  * Removes all the BNodes from a tree
  ****************************************************/
-   template <typename T>
-   void BST <T> ::clear() noexcept
+   template <typename T, typename A, bool Ranked>
+   void BST <T, A, Ranked> ::clear() noexcept
    {
       numElements = 0;
       _clear(root);
@@ -827,14 +1303,14 @@ namespace custom
     * BST :: BEGIN
     * Return the first node (left-most) in a binary search tree
     ****************************************************/
-   template <typename T>
-   typename BST <T> ::iterator custom::BST <T> ::begin() const noexcept
+   template <typename T, typename A, bool Ranked>
+   typename BST <T, A, Ranked> ::iterator custom::BST <T, A, Ranked> ::begin() const noexcept
    {
       //// if it's empty, return end.
       //if (empty())
       //    return end();
 
-      //BST<T>::BNode* pNode = root;
+      //BST<T, A, Ranked>::BNode* pNode = root;
 
       //while (pNode->pLeft)
       //    pNode = pNode->pLeft;
@@ -854,8 +1330,8 @@ namespace custom
     * BST :: FIND
     * Return the node corresponding to a given value
     ****************************************************/
-   template <typename T>
-   typename BST <T> ::iterator BST<T> ::find(const T& t)
+   template <typename T, typename A, bool Ranked>
+   typename BST <T, A, Ranked> ::iterator BST<T, A, Ranked> ::find(const T& t)
    {
       //auto p = root;
 
@@ -883,8 +1359,202 @@ namespace custom
       return end();
    }
 
-   template <typename T>
-   void BST <T> ::deleteNode(BNode*& pDelete, bool toRight)
+   /****************************************************
+    * BST :: FIND
+    * Look up a key that compares with T without
+    * building a T to compare against
+    ****************************************************/
+   template <typename T, typename A, bool Ranked>
+   template <class K, class>
+   typename BST <T, A, Ranked> ::iterator BST<T, A, Ranked> ::find(const K& k)
+   {
+      for (BNode* p = root; p != nullptr; )
+         if (k < p->data)
+            p = p->pLeft;
+         else if (p->data < k)
+            p = p->pRight;
+         else
+            return iterator(p);
+
+      return end();
+   }
+
+   /****************************************************
+    * BST :: FIND
+    * Look up k with less, which compares an element and
+    * k either way round, such as a pair by its key
+    ****************************************************/
+   template <typename T, typename A, bool Ranked>
+   template <class K, class Compare>
+   typename BST <T, A, Ranked> ::iterator BST<T, A, Ranked> ::find(const K& k, Compare less) const
+   {
+      for (BNode* p = root; p != nullptr; )
+         if (less(k, p->data))
+            p = p->pLeft;
+         else if (less(p->data, k))
+            p = p->pRight;
+         else
+            return iterator(p);
+
+      return end();
+   }
+
+   /*****************************************************
+    * BST :: LOWER BOUND
+    * The first element that is not less than k. Each time
+    * we go left the node is the best answer so far.
+    ****************************************************/
+   template <typename T, typename A, bool Ranked>
+   template <class K, class Compare>
+   typename BST <T, A, Ranked> ::iterator BST <T, A, Ranked> ::lower_bound(const K& k, Compare less) const
+   {
+      BNode* pBound = nullptr;
+      for (BNode* p = root; p != nullptr; )
+         if (less(p->data, k))
+            p = p->pRight;
+         else
+         {
+            pBound = p;
+            p = p->pLeft;
+         }
+
+      return iterator(pBound);
+   }
+
+   /*****************************************************
+    * BST :: UPPER BOUND
+    * The first element that is greater than k
+    ****************************************************/
+   template <typename T, typename A, bool Ranked>
+   template <class K, class Compare>
+   typename BST <T, A, Ranked> ::iterator BST <T, A, Ranked> ::upper_bound(const K& k, Compare less) const
+   {
+      BNode* pBound = nullptr;
+      for (BNode* p = root; p != nullptr; )
+         if (less(k, p->data))
+         {
+            pBound = p;
+            p = p->pLeft;
+         }
+         else
+            p = p->pRight;
+
+      return iterator(pBound);
+   }
+
+   /*****************************************************
+    * BST :: EQUAL RANGE
+    * The lower and upper bound of k. Both follow the same
+    * path down until it meets an element equal to k. From
+    * there the lower bound is to its left and the upper
+    * bound to its right, so the search splits in two.
+    ****************************************************/
+   template <typename T, typename A, bool Ranked>
+   template <class K, class Compare>
+   std::pair<typename BST <T, A, Ranked> ::iterator, typename BST <T, A, Ranked> ::iterator>
+   BST <T, A, Ranked> ::equal_range(const K& k, Compare less) const
+   {
+      BNode* pLower = nullptr;
+      BNode* pUpper = nullptr;
+      BNode* p = root;
+      while (p != nullptr)
+      {
+         if (less(p->data, k))
+            p = p->pRight;
+         else if (less(k, p->data))
+         {
+            pLower = pUpper = p;
+            p = p->pLeft;
+         }
+         else
+         {
+            pLower = p;
+            for (BNode* pLeft = p->pLeft; pLeft != nullptr; )
+               if (less(pLeft->data, k))
+                  pLeft = pLeft->pRight;
+               else
+               {
+                  pLower = pLeft;
+                  pLeft = pLeft->pLeft;
+               }
+            for (BNode* pRight = p->pRight; pRight != nullptr; )
+               if (less(k, pRight->data))
+               {
+                  pUpper = pRight;
+                  pRight = pRight->pLeft;
+               }
+               else
+                  pRight = pRight->pRight;
+            break;
+         }
+      }
+      return std::make_pair(iterator(pLower), iterator(pUpper));
+   }
+
+   /*****************************************************
+    * BST :: NTH ELEMENT
+    * The element with k others before it, or end() when
+    * there are not that many. Every node knows how many
+    * are to its left, so one descent finds it.
+    ****************************************************/
+   template <typename T, typename A, bool Ranked>
+   typename BST <T, A, Ranked> ::iterator BST <T, A, Ranked> ::nth_element(size_t k) const
+   {
+      static_assert(Ranked, "nth_element() needs a ranked tree, BST<T, A, true>");
+      for (BNode* p = root; p != nullptr; )
+      {
+         size_t numLeft = BNode::sizeOf(p->pLeft);
+         if (k < numLeft)
+            p = p->pLeft;
+         else if (k == numLeft)
+            return iterator(p);
+         else
+         {
+            k -= numLeft + 1;
+            p = p->pRight;
+         }
+      }
+      return end();
+   }
+
+   /*****************************************************
+    * BST :: RANK
+    * How many elements are less than k. Stepping right
+    * passes a node and everything to its left.
+    ****************************************************/
+   template <typename T, typename A, bool Ranked>
+   template <class K, class Compare>
+   size_t BST <T, A, Ranked> ::rank(const K& k, Compare less) const
+   {
+      static_assert(Ranked, "rank() needs a ranked tree, BST<T, A, true>");
+      size_t num = 0;
+      for (BNode* p = root; p != nullptr; )
+         if (less(p->data, k))
+         {
+            num += BNode::sizeOf(p->pLeft) + 1;
+            p = p->pRight;
+         }
+         else
+            p = p->pLeft;
+
+      return num;
+   }
+
+   /*****************************************************
+    * BST :: COUNT RANGE
+    * How many elements are at least lo and less than hi
+    ****************************************************/
+   template <typename T, typename A, bool Ranked>
+   template <class K, class Compare>
+   size_t BST <T, A, Ranked> ::count_range(const K& lo, const K& hi, Compare less) const
+   {
+      size_t numHi = rank(hi, less);
+      size_t numLo = rank(lo, less);
+      return numHi > numLo ? numHi - numLo : 0;
+   }
+
+   template <typename T, typename A, bool Ranked>
+   void BST <T, A, Ranked> ::deleteNode(BNode*& pDelete, bool toRight)
    {
       // Shift everything up
       BNode* pNext = (toRight ? pDelete->pRight : pDelete->pLeft);
@@ -924,8 +1594,8 @@ namespace custom
      * BINARY NODE :: ADD LEFT
      * Add a node to the left of the current node
      ******************************************************/
-   template <typename T>
-   void BST <T> ::BNode::addLeft(BNode* pNode)
+   template <typename T, typename A, bool Ranked>
+   void BST <T, A, Ranked> ::BNode::addLeft(BNode* pNode)
    {
       //// If pNode is not null...
       //if (pNode)
@@ -945,8 +1615,8 @@ namespace custom
     * BINARY NODE :: ADD RIGHT
     * Add a node to the right of the current node
     ******************************************************/
-   template <typename T>
-   void BST <T> ::BNode::addRight(BNode* pNode)
+   template <typename T, typename A, bool Ranked>
+   void BST <T, A, Ranked> ::BNode::addRight(BNode* pNode)
    {
       //// If pNode is not null...
       //if (pNode)
@@ -961,99 +1631,14 @@ namespace custom
          pNode->pParent = this;
    }
 
-   /******************************************************
-    * BINARY NODE :: ADD LEFT
-    * Add a node to the left of the current node
-    ******************************************************/
-   template <typename T>
-   void BST<T> ::BNode::addLeft(const T& t)
-   {
-      // Create the new node.
-      //BST<T>::BNode* pAdd = new BST<T>::BNode(t);
-
-      //// Make it's parent the Node we're adding it from.
-      //pAdd->pParent = this;
-
-      //// Attatch it to it's parents pLeft.
-      //this->pLeft = pAdd;
-
-      BNode* pNode = new BNode(t);
-      addLeft(pNode);
-      pNode->balance();
-
-   }
-
-   /******************************************************
-    * BINARY NODE :: ADD LEFT
-    * Add a node to the left of the current node
-    ******************************************************/
-   template <typename T>
-   void BST<T> ::BNode::addLeft(T&& t)
-   {
-      //// Create the new node.
-      //BST<T>::BNode* pAdd = new BST<T>::BNode(std::move(t));
-
-      //// Make it's parent the Node we're adding it from.
-      //pAdd->pParent = this;
-
-      //// Attatch it to it's parents pLeft.
-      //this->pLeft = pAdd;
-
-      BNode* pNode = new BNode(std::move(t));
-      addLeft(pNode);
-      pNode->balance();
-   }
-
-   /******************************************************
-    * BINARY NODE :: ADD RIGHT
-    * Add a node to the right of the current node
-    ******************************************************/
-   template <typename T>
-   void BST <T> ::BNode::addRight(const T& t)
-   {
-      //// Create the new node.
-      //BST<T>::BNode* pAdd = new BST<T>::BNode(t);
-
-      //// Make it's parent the Node we're adding it from.
-      //pAdd->pParent = this;
-
-      //// Attatch it to it's parents pRight.
-      //this->pRight = pAdd;
-
-      BNode* pNode = new BNode(t);
-      addRight(pNode);
-      pNode->balance();
-   }
-
-   /******************************************************
-    * BINARY NODE :: ADD RIGHT
-    * Add a node to the right of the current node
-    ******************************************************/
-   template <typename T>
-   void BST <T> ::BNode::addRight(T&& t)
-   {
-      //// Create the new node.
-      //BST<T>::BNode* pAdd = new BST<T>::BNode(std::move(t));
-
-      //// Make it's parent the Node we're adding it from.
-      //pAdd->pParent = this;
-
-      //// Attatch it to it's parents pRight.
-      //this->pRight = pAdd;
-
-      BNode* pNode = new BNode(std::move(t));
-      addRight(std::move(pNode));
-      pNode->balance();
-   }
-
 #ifdef DEBUG
    /****************************************************
     * BINARY NODE :: FIND DEPTH
     * Find the depth of the black nodes. This is useful for
     * verifying that a given red-black tree is valid
     ****************************************************/
-   template <typename T>
-   int BST <T> ::BNode::findDepth() const
+   template <typename T, typename A, bool Ranked>
+   int BST <T, A, Ranked> ::BNode::findDepth() const
    {
       // if there are no children, the depth is ourselves
       if (pRight == nullptr && pLeft == nullptr)
@@ -1070,8 +1655,8 @@ namespace custom
     * BINARY NODE :: VERIFY RED BLACK
     * Do all four red-black rules work here?
     ***************************************************/
-   template <typename T>
-   bool BST <T> ::BNode::verifyRedBlack(int depth) const
+   template <typename T, typename A, bool Ranked>
+   bool BST <T, A, Ranked> ::BNode::verifyRedBlack(int depth) const
    {
       bool fReturn = true;
       depth -= (isRed == false) ? 1 : 0;
@@ -1115,8 +1700,8 @@ namespace custom
     * VERIFY B TREE
     * Verify that the tree is correctly formed
     ******************************************************/
-   template <typename T>
-   std::pair <T, T> BST <T> ::BNode::verifyBTree() const
+   template <typename T, typename A, bool Ranked>
+   std::pair <T, T> BST <T, A, Ranked> ::BNode::verifyBTree() const
    {
       // largest and smallest values
       std::pair <T, T> extremes;
@@ -1159,8 +1744,8 @@ namespace custom
     * COMPUTE SIZE
     * Verify that the BST is as large as we think it is
     ********************************************/
-   template <typename T>
-   int BST <T> ::BNode::computeSize() const
+   template <typename T, typename A, bool Ranked>
+   int BST <T, A, Ranked> ::BNode::computeSize() const
    {
       return 1 +
          (pLeft == nullptr ? 0 : pLeft->computeSize()) +
@@ -1172,8 +1757,8 @@ namespace custom
     * BINARY NODE :: BALANCE
     * Balance the tree from a given location
     ******************************************************/
-   template <typename T>
-   void BST <T> ::BNode::balance()
+   template <typename T, typename A, bool Ranked>
+   void BST <T, A, Ranked> ::BNode::balance()
    {
       // Case 1: if we are the root, then color ourselves black and call it a day.
       if (pParent == nullptr)
@@ -1262,6 +1847,11 @@ namespace custom
          //assert(false);
       }
 
+      // the rotated nodes hold new subtrees, granny lowest
+      pGranny->resize();
+      pParent->resize();
+      pHead->resize();
+
       if (pGreatG == nullptr)
          pHead->pParent = nullptr;
       else if (pGreatG->pRight == pGranny)
@@ -1271,7 +1861,7 @@ namespace custom
 
    }
    //template <typename T>
-   //void BST <T> ::BNode::balance()
+   //void BST <T, A, Ranked> ::BNode::balance()
    //{
    //    // Case 1: if we are the root, then color ourselves black and call it a day.
    //    if (!pParent)
@@ -1425,8 +2015,8 @@ namespace custom
      * BST ITERATOR :: INCREMENT PREFIX
      * advance by one
      *************************************************/
-   template <typename T>
-   typename BST <T> ::iterator& BST <T> ::iterator :: operator ++ ()
+   template <typename T, typename A, bool Ranked>
+   typename BST <T, A, Ranked> ::iterator& BST <T, A, Ranked> ::iterator :: operator ++ ()
    {
       // Do nothing if we have nothing
       if (nullptr == pNode)
@@ -1504,8 +2094,8 @@ namespace custom
     * BST ITERATOR :: DECREMENT PREFIX
     * advance by one
     *************************************************/
-   template <typename T>
-   typename BST <T>::iterator& BST <T>::iterator::operator--()
+   template <typename T, typename A, bool Ranked>
+   typename BST <T, A, Ranked>::iterator& BST <T, A, Ranked>::iterator::operator--()
    {
       if (pNode != nullptr)
       {
@@ -1522,24 +2112,14 @@ namespace custom
          }
          else
          {
-            while (pNode->pParent)
+            // Climb until we come up from a right child. That parent is the
+            // node before us, or nullptr if we were the first node
+            const BNode* pChild = pNode;
+            pNode = pNode->pParent;
+            while (pNode && pNode->pLeft == pChild)
             {
-               // If the current node is the right child
-               if (pNode->isRightChild(pNode->pParent))
-               {
-                  // Move up to the parent
-                  pNode = pNode->pParent;
-                  return *this;
-               }
-               // Move up to the parent
+               pChild = pNode;
                pNode = pNode->pParent;
-
-               if (!pNode->pParent)
-               {
-                  // If we've reached the root, increment to the end. (nullptr)
-                  pNode = pNode->pParent;
-                  return *this;
-               }
             }
          }
       }
@@ -0,0 +1,913 @@
+/***********************************************************************
+ * Header:
+ *    BTREE
+ * Summary:
+ *    A B-tree, a cache friendly engine for set and for map
+ *      __      __     _______        __
+ *     /  |    /  |   |  _____|   _  / /
+ *     `| |    `| |   | |____    (_)/ /
+ *      | |     | |   '_.____''.   / / _
+ *     _| |_   _| |_  | \____) |  / / (_)
+ *    |_____| |_____|  \______.' /_/
+ *
+ *    This will contain the class definition of:
+ *        BTree               : A class that represents a B-tree
+ *        BTree::iterator     : An iterator through BTree
+ * Author
+ *    Peter Benson, Jarom Diaz, Isaac Radford
+ ************************************************************************/
+
+#pragma once
+
+#include "bst.h"       // for is_lookup_key
+#include <cassert>     // because I am paranoid
+#include <cstddef>     // for std::nullptr_t
+#include <initializer_list>
+#include <memory>      // for std::allocator and std::allocator_traits
+#include <type_traits> // for std::aligned_storage and std::enable_if
+#include <utility>     // for std::pair, std::move, and std::forward
+
+class TestBTree;       // forward declaration for unit tests
+
+namespace custom
+{
+
+/*****************************************************
+ * BTREE KEYS
+ * How many elements a node holds by default: as many
+ * as fit in four cache lines, but between 15 and 63.
+ * Always odd, so a full node splits evenly.
+ ****************************************************/
+template <typename T>
+struct btree_keys
+{
+   static const size_t FIT = 256 / sizeof(T);
+   static const size_t value = (FIT < 15 ? 15 : (FIT > 63 ? 63 : FIT)) | 1;
+};
+
+/*****************************************************************
+ * BTREE
+ * A drop-in replacement for BST behind set and map:
+ *    custom::set<int, std::allocator<int>, custom::BTree<int>> s;
+ * Each node holds up to MaxKeys elements side by side, so a
+ * lookup touches one node per level instead of one per
+ * element, and the tree is only log base MaxKeys / 2 deep.
+ *
+ * Unlike BST, an insert or erase moves elements from node to
+ * node, so it invalidates every iterator but the one it returns.
+ *****************************************************************/
+template <typename T, typename A = std::allocator<T>, size_t MaxKeys = btree_keys<T>::value>
+class BTree
+{
+   friend class ::TestBTree; // give unit tests access to the privates
+   static_assert(MaxKeys >= 3 && MaxKeys % 2 == 1, "a node must split into two halves and a median");
+public:
+   //
+   // Construct
+   //
+   BTree(const A& a = A()) : root(nullptr), numElements(0), alloc(a) {}
+   BTree(const BTree& rhs) : root(nullptr), numElements(0), alloc(rhs.alloc)
+   {
+      *this = rhs;
+   }
+   BTree(BTree&& rhs) : root(rhs.root), numElements(rhs.numElements), alloc(rhs.alloc)
+   {
+      rhs.root = nullptr;
+      rhs.numElements = 0;
+   }
+   BTree(const std::initializer_list<T>& il, const A& a = A()) : root(nullptr), numElements(0), alloc(a)
+   {
+      *this = il;
+   }
+   ~BTree()
+   {
+      clear();
+   }
+
+   //
+   // Assign
+   //
+   BTree& operator = (const BTree& rhs);
+   BTree& operator = (BTree&& rhs)
+   {
+      clear();
+      swap(rhs);
+      return *this;
+   }
+   BTree& operator = (const std::initializer_list<T>& il)
+   {
+      clear();
+      for (auto it = il.begin(); it != il.end(); ++it)
+         insert(*it);
+      return *this;
+   }
+   void swap(BTree& rhs)
+   {
+      std::swap(root, rhs.root);
+      std::swap(numElements, rhs.numElements);
+      std::swap(alloc, rhs.alloc);
+   }
+
+   //
+   // Iterator
+   //
+   class iterator;
+   iterator begin() const noexcept;
+   iterator end()   const noexcept { return iterator(this, nullptr, 0); }
+
+   //
+   // Access
+   //
+   iterator find(const T& t) const
+   {
+      return find(t, Less());
+   }
+   template <class K, class = typename std::enable_if<is_lookup_key<T, K>::value>::type>
+   iterator find(const K& k) const
+   {
+      return find(k, Less());
+   }
+   template <class K, class Compare>
+   iterator find(const K& k, Compare less) const;
+   iterator lower_bound(const T& t) const
+   {
+      return lower_bound(t, Less());
+   }
+   template <class K, class Compare>
+   iterator lower_bound(const K& k, Compare less) const;
+   iterator upper_bound(const T& t) const
+   {
+      return upper_bound(t, Less());
+   }
+   template <class K, class Compare>
+   iterator upper_bound(const K& k, Compare less) const;
+   std::pair<iterator, iterator> equal_range(const T& t) const
+   {
+      return equal_range(t, Less());
+   }
+   template <class K, class Compare>
+   std::pair<iterator, iterator> equal_range(const K& k, Compare less) const
+   {
+      return std::make_pair(lower_bound(k, less), upper_bound(k, less));
+   }
+
+   //
+   // Insert
+   //
+   std::pair<iterator, bool> insert(const T& t, bool keepUnique = false)
+   {
+      return insertElement(t, keepUnique);
+   }
+   std::pair<iterator, bool> insert(T&& t, bool keepUnique = false)
+   {
+      return insertElement(std::move(t), keepUnique);
+   }
+   template <class Iterator, class = decltype(*std::declval<Iterator&>())>
+   void insert(Iterator first, Iterator last, bool keepUnique = false)
+   {
+      for (; first != last; ++first)
+         insert(*first, keepUnique);
+   }
+   // a search from the root is only a few nodes deep, so the hint is not needed
+   iterator insert(iterator, const T& t, bool keepUnique = false)
+   {
+      return insertElement(t, keepUnique).first;
+   }
+   iterator insert(iterator, T&& t, bool keepUnique = false)
+   {
+      return insertElement(std::move(t), keepUnique).first;
+   }
+   template <class ... Args>
+   std::pair<iterator, bool> emplace(bool keepUnique, Args&& ... args)
+   {
+      return insertElement(T(std::forward<Args>(args)...), keepUnique);
+   }
+   template <class ... Args>
+   iterator emplace_hint(iterator, bool keepUnique, Args&& ... args)
+   {
+      return insertElement(T(std::forward<Args>(args)...), keepUnique).first;
+   }
+
+   //
+   // Remove
+   //
+   iterator erase(iterator& it);
+   void clear() noexcept
+   {
+      freeTree(root);
+      root = nullptr;
+      numElements = 0;
+   }
+
+   //
+   // Status
+   //
+   bool   empty() const noexcept { return root == nullptr; }
+   size_t size()  const noexcept { return numElements;     }
+
+private:
+   static const size_t MIN_KEYS = MaxKeys / 2;   // fewest elements in any node but the root
+
+   struct Inner;
+
+   // a leaf; the elements are only constructed in slots [0, num)
+   struct Node
+   {
+      Node(bool isLeaf) : pParent(nullptr), iParent(0), num(0), isLeaf(isLeaf) {}
+      T& operator [] (size_t i)             { return *reinterpret_cast<T*>(&slots[i]);       }
+      const T& operator [] (size_t i) const { return *reinterpret_cast<const T*>(&slots[i]); }
+
+      Inner * pParent;                   // nullptr for the root
+      unsigned short iParent;            // which child of the parent we are
+      unsigned short num;                // elements in the slots
+      bool isLeaf;                       // Inner if false
+      typename std::aligned_storage<sizeof(T), alignof(T)>::type slots[MaxKeys];
+   };
+
+   // a node with children; children[i] holds what sorts before element i
+   struct Inner : Node
+   {
+      Inner() : Node(false) {}
+      Node * children[MaxKeys + 1];
+   };
+
+   // every comparison is done with <, just like BST
+   struct Less
+   {
+      template <class X, class Y>
+      bool operator () (const X& x, const Y& y) const { return x < y; }
+   };
+
+   typedef typename std::allocator_traits<A>::template rebind_alloc<Node>  LeafAlloc;
+   typedef typename std::allocator_traits<A>::template rebind_alloc<Inner> InnerAlloc;
+
+   static Inner* inner(Node* p) { return static_cast<Inner*>(p); }
+   static void setChild(Inner* p, size_t i, Node* pChild)
+   {
+      p->children[i] = pChild;
+      pChild->pParent = p;
+      pChild->iParent = (unsigned short)i;
+   }
+
+   // first slot whose element is not less than k
+   template <class K, class Compare>
+   static size_t lowerIndex(const Node* p, const K& k, Compare less)
+   {
+      size_t iLow = 0;
+      size_t iHigh = p->num;
+      while (iLow < iHigh)
+      {
+         size_t iMid = (iLow + iHigh) / 2;
+         if (less((*p)[iMid], k))
+            iLow = iMid + 1;
+         else
+            iHigh = iMid;
+      }
+      return iLow;
+   }
+   // first slot whose element is greater than k
+   template <class K, class Compare>
+   static size_t upperIndex(const Node* p, const K& k, Compare less)
+   {
+      size_t iLow = 0;
+      size_t iHigh = p->num;
+      while (iLow < iHigh)
+      {
+         size_t iMid = (iLow + iHigh) / 2;
+         if (less(k, (*p)[iMid]))
+            iHigh = iMid;
+         else
+            iLow = iMid + 1;
+      }
+      return iLow;
+   }
+
+   // nodes and the elements in them all come from the allocator
+   Node* newLeaf();
+   Inner* newInner();
+   void freeNode(Node* p);
+   void freeTree(Node* p);
+   Node* copyTree(const Node* pSrc);
+   template <typename ... Args>
+   void construct(Node* p, size_t i, Args&& ... args)
+   {
+      std::allocator_traits<A>::construct(alloc, &(*p)[i], std::forward<Args>(args)...);
+   }
+   void destroy(Node* p, size_t i)
+   {
+      std::allocator_traits<A>::destroy(alloc, &(*p)[i]);
+   }
+   void moveSlot(Node* pDest, size_t iDest, Node* pSrc, size_t iSrc)
+   {
+      construct(pDest, iDest, std::move((*pSrc)[iSrc]));
+      destroy(pSrc, iSrc);
+   }
+
+   template <class U>
+   std::pair<iterator, bool> insertElement(U&& t, bool keepUnique);
+   void splitChild(Inner* p, size_t i);
+   void rebalance(Node* p);
+   void rotateLeft(Inner* p, size_t iSep);
+   void rotateRight(Inner* p, size_t iSep);
+   void merge(Inner* p, size_t iSep);
+
+   Node * root;               // root node of the B-tree
+   size_t numElements;        // number of elements currently in the tree
+   A alloc;                   // where the nodes and elements come from
+};
+
+
+/**********************************************************
+ * BTREE ITERATOR
+ * A node and a slot in it. Walking the tree in order
+ * goes down to the leaves and back up through the parents.
+ *********************************************************/
+template <typename T, typename A, size_t MaxKeys>
+class BTree <T, A, MaxKeys> ::iterator
+{
+   friend class ::TestBTree; // give unit tests access to the privates
+   friend class BTree;
+public:
+   //
+   // Construct
+   //
+   iterator() : pTree(nullptr), pNode(nullptr), iSlot(0) {}
+   iterator(std::nullptr_t) : pTree(nullptr), pNode(nullptr), iSlot(0) {}
+   iterator(const BTree* pTree, Node* pNode, size_t iSlot) : pTree(pTree), pNode(pNode), iSlot(iSlot) {}
+
+   //
+   // Compare
+   //
+   bool operator == (const iterator& rhs) const
+   {
+      return pNode == rhs.pNode && iSlot == rhs.iSlot;
+   }
+   bool operator != (const iterator& rhs) const
+   {
+      return !(*this == rhs);
+   }
+
+   //
+   // Access
+   //
+   const T& operator * () const
+   {
+      return (*pNode)[iSlot];
+   }
+
+   //
+   // Increment
+   //
+   iterator& operator ++ ();
+   iterator& operator -- ();
+   iterator operator ++ (int postfix)
+   {
+      iterator itReturn(*this);
+      ++(*this);
+      return itReturn;
+   }
+   iterator operator -- (int postfix)
+   {
+      iterator itReturn(*this);
+      --(*this);
+      return itReturn;
+   }
+
+private:
+   const BTree* pTree;        // the tree, so end() can go back to the last element
+   Node* pNode;               // nullptr at the end
+   size_t iSlot;              // which element of the node
+};
+
+/*********************************************
+ * BTREE :: ITERATOR :: INCREMENT
+ * After an element of an inner node comes the leftmost
+ * element of the child to its right. After the last
+ * element of a leaf comes the first parent element we
+ * have not visited yet.
+ ********************************************/
+template <typename T, typename A, size_t MaxKeys>
+typename BTree <T, A, MaxKeys> ::iterator& BTree <T, A, MaxKeys> ::iterator::operator ++ ()
+{
+   if (pNode == nullptr)
+      return *this;
+
+   if (!pNode->isLeaf)
+   {
+      pNode = inner(pNode)->children[iSlot + 1];
+      while (!pNode->isLeaf)
+         pNode = inner(pNode)->children[0];
+      iSlot = 0;
+      return *this;
+   }
+
+   iSlot++;
+   while (iSlot == pNode->num)
+   {
+      if (pNode->pParent == nullptr)
+      {
+         pNode = nullptr;
+         iSlot = 0;
+         break;
+      }
+      iSlot = pNode->iParent;
+      pNode = pNode->pParent;
+   }
+   return *this;
+}
+
+/*********************************************
+ * BTREE :: ITERATOR :: DECREMENT
+ * The mirror image of increment. From the end we go
+ * to the last element of the tree.
+ ********************************************/
+template <typename T, typename A, size_t MaxKeys>
+typename BTree <T, A, MaxKeys> ::iterator& BTree <T, A, MaxKeys> ::iterator::operator -- ()
+{
+   // 1. from the end, or from an inner node, go down the right side
+   Node* pDown = nullptr;
+   if (pNode == nullptr)
+      pDown = pTree ? pTree->root : nullptr;
+   else if (!pNode->isLeaf)
+      pDown = inner(pNode)->children[iSlot];
+   if (pDown != nullptr || pNode == nullptr)
+   {
+      pNode = pDown;
+      iSlot = 0;
+      if (pNode == nullptr)
+         return *this;
+      while (!pNode->isLeaf)
+         pNode = inner(pNode)->children[pNode->num];
+      iSlot = pNode->num - 1;
+      return *this;
+   }
+
+   // 2. in a leaf, back up one slot or climb until we can
+   if (iSlot > 0)
+   {
+      iSlot--;
+      return *this;
+   }
+   while (pNode->pParent != nullptr && pNode->iParent == 0)
+      pNode = pNode->pParent;
+   if (pNode->pParent == nullptr)
+   {
+      pNode = nullptr;   // before the first element
+      iSlot = 0;
+      return *this;
+   }
+   iSlot = pNode->iParent - 1;
+   pNode = pNode->pParent;
+   return *this;
+}
+
+/*********************************************
+ * BTREE :: NEW LEAF and NEW INNER
+ * Allocate an empty node through the allocator
+ ********************************************/
+template <typename T, typename A, size_t MaxKeys>
+typename BTree <T, A, MaxKeys> ::Node* BTree <T, A, MaxKeys> ::newLeaf()
+{
+   LeafAlloc allocLeaf(alloc);
+   Node* pNew = std::allocator_traits<LeafAlloc>::allocate(allocLeaf, 1);
+   std::allocator_traits<LeafAlloc>::construct(allocLeaf, pNew, true);
+   return pNew;
+}
+template <typename T, typename A, size_t MaxKeys>
+typename BTree <T, A, MaxKeys> ::Inner* BTree <T, A, MaxKeys> ::newInner()
+{
+   InnerAlloc allocInner(alloc);
+   Inner* pNew = std::allocator_traits<InnerAlloc>::allocate(allocInner, 1);
+   std::allocator_traits<InnerAlloc>::construct(allocInner, pNew);
+   return pNew;
+}
+
+/*********************************************
+ * BTREE :: FREE NODE
+ * Give an empty node back to the allocator
+ ********************************************/
+template <typename T, typename A, size_t MaxKeys>
+void BTree <T, A, MaxKeys> ::freeNode(Node* p)
+{
+   if (p->isLeaf)
+   {
+      LeafAlloc allocLeaf(alloc);
+      std::allocator_traits<LeafAlloc>::destroy(allocLeaf, p);
+      std::allocator_traits<LeafAlloc>::deallocate(allocLeaf, p, 1);
+   }
+   else
+   {
+      InnerAlloc allocInner(alloc);
+      std::allocator_traits<InnerAlloc>::destroy(allocInner, inner(p));
+      std::allocator_traits<InnerAlloc>::deallocate(allocInner, inner(p), 1);
+   }
+}
+
+/*********************************************
+ * BTREE :: FREE TREE
+ * Destroy every element below p and free the nodes
+ ********************************************/
+template <typename T, typename A, size_t MaxKeys>
+void BTree <T, A, MaxKeys> ::freeTree(Node* p)
+{
+   if (p == nullptr)
+      return;
+
+   if (!p->isLeaf)
+      for (size_t i = 0; i <= p->num; i++)
+         freeTree(inner(p)->children[i]);
+   for (size_t i = 0; i < p->num; i++)
+      destroy(p, i);
+   freeNode(p);
+}
+
+/*********************************************
+ * BTREE :: COPY TREE
+ * A node for node copy of pSrc and everything below it
+ ********************************************/
+template <typename T, typename A, size_t MaxKeys>
+typename BTree <T, A, MaxKeys> ::Node* BTree <T, A, MaxKeys> ::copyTree(const Node* pSrc)
+{
+   Node* pDest = pSrc->isLeaf ? newLeaf() : newInner();
+   for (size_t i = 0; i < pSrc->num; i++)
+   {
+      construct(pDest, i, (*pSrc)[i]);
+      pDest->num++;
+   }
+   if (!pSrc->isLeaf)
+      for (size_t i = 0; i <= pSrc->num; i++)
+         setChild(inner(pDest), i, copyTree(static_cast<const Inner*>(pSrc)->children[i]));
+   return pDest;
+}
+
+/*********************************************
+ * BTREE :: ASSIGNMENT
+ * Copy the shape and the elements of rhs
+ ********************************************/
+template <typename T, typename A, size_t MaxKeys>
+BTree <T, A, MaxKeys>& BTree <T, A, MaxKeys> ::operator = (const BTree& rhs)
+{
+   if (this == &rhs)
+      return *this;
+
+   clear();
+   if (rhs.root != nullptr)
+      root = copyTree(rhs.root);
+   numElements = rhs.numElements;
+   return *this;
+}
+
+/*********************************************
+ * BTREE :: BEGIN
+ * The leftmost element of the leftmost leaf
+ ********************************************/
+template <typename T, typename A, size_t MaxKeys>
+typename BTree <T, A, MaxKeys> ::iterator BTree <T, A, MaxKeys> ::begin() const noexcept
+{
+   if (root == nullptr)
+      return end();
+
+   Node* p = root;
+   while (!p->isLeaf)
+      p = inner(p)->children[0];
+   return iterator(this, p, 0);
+}
+
+/*********************************************
+ * BTREE :: FIND
+ * Search each node on the way down for k, with less
+ * comparing an element and k either way round
+ ********************************************/
+template <typename T, typename A, size_t MaxKeys>
+template <class K, class Compare>
+typename BTree <T, A, MaxKeys> ::iterator BTree <T, A, MaxKeys> ::find(const K& k, Compare less) const
+{
+   Node* p = root;
+   while (p != nullptr)
+   {
+      size_t i = lowerIndex(p, k, less);
+      if (i < p->num && !less(k, (*p)[i]))
+         return iterator(this, p, i);
+      if (p->isLeaf)
+         break;
+      p = inner(p)->children[i];
+   }
+   return end();
+}
+
+/*********************************************
+ * BTREE :: LOWER BOUND
+ * The first element that is not less than k. Any we
+ * find lower down comes before the ones above it.
+ ********************************************/
+template <typename T, typename A, size_t MaxKeys>
+template <class K, class Compare>
+typename BTree <T, A, MaxKeys> ::iterator BTree <T, A, MaxKeys> ::lower_bound(const K& k, Compare less) const
+{
+   iterator itBound = end();
+   Node* p = root;
+   while (p != nullptr)
+   {
+      size_t i = lowerIndex(p, k, less);
+      if (i < p->num)
+         itBound = iterator(this, p, i);
+      if (p->isLeaf)
+         break;
+      p = inner(p)->children[i];
+   }
+   return itBound;
+}
+
+/*********************************************
+ * BTREE :: UPPER BOUND
+ * The first element that is greater than k
+ ********************************************/
+template <typename T, typename A, size_t MaxKeys>
+template <class K, class Compare>
+typename BTree <T, A, MaxKeys> ::iterator BTree <T, A, MaxKeys> ::upper_bound(const K& k, Compare less) const
+{
+   iterator itBound = end();
+   Node* p = root;
+   while (p != nullptr)
+   {
+      size_t i = upperIndex(p, k, less);
+      if (i < p->num)
+         itBound = iterator(this, p, i);
+      if (p->isLeaf)
+         break;
+      p = inner(p)->children[i];
+   }
+   return itBound;
+}
+
+/*********************************************
+ * BTREE :: INSERT
+ * One pass from the root down to a leaf. Any full node
+ * on the way is split first, so the leaf has room and
+ * no split ever has to climb back up.
+ ********************************************/
+template <typename T, typename A, size_t MaxKeys>
+template <class U>
+std::pair<typename BTree <T, A, MaxKeys> ::iterator, bool> BTree <T, A, MaxKeys> ::insertElement(U&& t, bool keepUnique)
+{
+   // 1. an empty tree gets a leaf for a root
+   if (root == nullptr)
+      root = newLeaf();
+
+   // 2. a full root is split, and the tree is one level taller
+   if (root->num == MaxKeys)
+   {
+      Inner* pNewRoot = newInner();
+      setChild(pNewRoot, 0, root);
+      root = pNewRoot;
+      splitChild(pNewRoot, 0);
+   }
+
+   // 3. walk down, splitting as we go
+   Node* p = root;
+   while (true)
+   {
+      size_t i;
+      if (keepUnique)
+      {
+         i = lowerIndex(p, t, Less());
+         if (i < p->num && !(t < (*p)[i]))
+            return std::make_pair(iterator(this, p, i), false);
+      }
+      else
+         i = upperIndex(p, t, Less());
+
+      // 4. the leaf makes room in slot i
+      if (p->isLeaf)
+      {
+         for (size_t j = p->num; j > i; j--)
+            moveSlot(p, j, p, j - 1);
+         construct(p, i, std::forward<U>(t));
+         p->num++;
+         numElements++;
+         return std::make_pair(iterator(this, p, i), true);
+      }
+
+      // 5. the median of a full child comes up into slot i
+      if (inner(p)->children[i]->num == MaxKeys)
+      {
+         splitChild(inner(p), i);
+         if (keepUnique && !(t < (*p)[i]) && !((*p)[i] < t))
+            return std::make_pair(iterator(this, p, i), false);
+         if (keepUnique ? (*p)[i] < t : !(t < (*p)[i]))
+            i++;
+      }
+      p = inner(p)->children[i];
+   }
+}
+
+/*********************************************
+ * BTREE :: SPLIT CHILD
+ * Child i of p is full. Its upper half becomes a new
+ * child i + 1 and its median moves up into slot i of p.
+ ********************************************/
+template <typename T, typename A, size_t MaxKeys>
+void BTree <T, A, MaxKeys> ::splitChild(Inner* p, size_t i)
+{
+   Node* pLeft = p->children[i];
+   Node* pRight = pLeft->isLeaf ? newLeaf() : newInner();
+   assert(pLeft->num == MaxKeys);
+
+   // 1. the upper half, and the children around it, move right
+   for (size_t j = 0; j < MIN_KEYS; j++)
+      moveSlot(pRight, j, pLeft, MIN_KEYS + 1 + j);
+   if (!pLeft->isLeaf)
+      for (size_t j = 0; j <= MIN_KEYS; j++)
+         setChild(inner(pRight), j, inner(pLeft)->children[MIN_KEYS + 1 + j]);
+   pRight->num = MIN_KEYS;
+
+   // 2. p makes room for the median and the new child
+   for (size_t j = p->num; j > i; j--)
+      moveSlot(p, j, p, j - 1);
+   for (size_t j = p->num + 1; j > i + 1; j--)
+      setChild(p, j, p->children[j - 1]);
+
+   // 3. the median moves up
+   moveSlot(p, i, pLeft, MIN_KEYS);
+   setChild(p, i + 1, pRight);
+   pLeft->num = MIN_KEYS;
+   p->num++;
+}
+
+/*********************************************
+ * BTREE :: ERASE
+ * Remove the element at it, returning the one after it.
+ * An element of an inner node trades places with the
+ * last element of its left subtree, so an element is
+ * always taken out of a leaf. A leaf left too small then
+ * borrows from a sibling or merges with one.
+ ********************************************/
+template <typename T, typename A, size_t MaxKeys>
+typename BTree <T, A, MaxKeys> ::iterator BTree <T, A, MaxKeys> ::erase(iterator& it)
+{
+   if (it.pNode == nullptr)
+      return end();
+
+   // 1. count the equal elements before it: rebalancing keeps their order,
+   //    so the next element is that many past the lower bound afterwards
+   size_t numBefore = 0;
+   iterator itBegin = begin();
+   for (iterator itPrev = it; itPrev != itBegin && !Less()(*--itPrev, *it); )
+      numBefore++;
+
+   // 2. hold on to the element to find the next one once the tree is rebalanced
+   Node* p = it.pNode;
+   size_t i = it.iSlot;
+   T erased(std::move((*p)[i]));
+
+   // 3. fill an inner slot from the bottom of the tree
+   if (!p->isLeaf)
+   {
+      Node* pLeaf = inner(p)->children[i];
+      while (!pLeaf->isLeaf)
+         pLeaf = inner(pLeaf)->children[pLeaf->num];
+      (*p)[i] = std::move((*pLeaf)[pLeaf->num - 1]);
+      p = pLeaf;
+      i = pLeaf->num - 1;
+   }
+
+   // 4. take the slot out of the leaf
+   destroy(p, i);
+   for (size_t j = i + 1; j < p->num; j++)
+      moveSlot(p, j - 1, p, j);
+   p->num--;
+   numElements--;
+
+   // 5. fix the leaf and its ancestors, then step past the equal elements
+   rebalance(p);
+   iterator itNext = lower_bound(erased);
+   while (numBefore-- > 0)
+      ++itNext;
+   return itNext;
+}
+
+/*********************************************
+ * BTREE :: REBALANCE
+ * Give p at least MIN_KEYS elements, by borrowing from
+ * a sibling with some to spare or else merging with one.
+ * A merge takes an element from the parent, which may
+ * then need fixing in turn.
+ ********************************************/
+template <typename T, typename A, size_t MaxKeys>
+void BTree <T, A, MaxKeys> ::rebalance(Node* p)
+{
+   while (p != root && p->num < MIN_KEYS)
+   {
+      Inner* pParent = p->pParent;
+      size_t i = p->iParent;
+      Node* pLeft  = i > 0            ? pParent->children[i - 1] : nullptr;
+      Node* pRight = i < pParent->num ? pParent->children[i + 1] : nullptr;
+
+      if (pLeft && pLeft->num > MIN_KEYS)
+         return rotateRight(pParent, i - 1);
+      if (pRight && pRight->num > MIN_KEYS)
+         return rotateLeft(pParent, i);
+
+      merge(pParent, pLeft ? i - 1 : i);
+      p = pParent;
+   }
+
+   // an empty root goes away, and the tree is one level shorter
+   if (root != nullptr && root->num == 0)
+   {
+      Node* pOld = root;
+      root = root->isLeaf ? nullptr : inner(root)->children[0];
+      if (root != nullptr)
+         root->pParent = nullptr;
+      freeNode(pOld);
+   }
+}
+
+/*********************************************
+ * BTREE :: ROTATE RIGHT
+ * The left child of separator iSep gives its last
+ * element to the parent, which gives the separator to
+ * the right child
+ ********************************************/
+template <typename T, typename A, size_t MaxKeys>
+void BTree <T, A, MaxKeys> ::rotateRight(Inner* p, size_t iSep)
+{
+   Node* pLeft = p->children[iSep];
+   Node* pRight = p->children[iSep + 1];
+
+   for (size_t j = pRight->num; j > 0; j--)
+      moveSlot(pRight, j, pRight, j - 1);
+   moveSlot(pRight, 0, p, iSep);
+   moveSlot(p, iSep, pLeft, pLeft->num - 1);
+
+   if (!pRight->isLeaf)
+   {
+      for (size_t j = pRight->num + 1; j > 0; j--)
+         setChild(inner(pRight), j, inner(pRight)->children[j - 1]);
+      setChild(inner(pRight), 0, inner(pLeft)->children[pLeft->num]);
+   }
+
+   pLeft->num--;
+   pRight->num++;
+}
+
+/*********************************************
+ * BTREE :: ROTATE LEFT
+ * The mirror image of rotate right
+ ********************************************/
+template <typename T, typename A, size_t MaxKeys>
+void BTree <T, A, MaxKeys> ::rotateLeft(Inner* p, size_t iSep)
+{
+   Node* pLeft = p->children[iSep];
+   Node* pRight = p->children[iSep + 1];
+
+   moveSlot(pLeft, pLeft->num, p, iSep);
+   moveSlot(p, iSep, pRight, 0);
+   for (size_t j = 1; j < pRight->num; j++)
+      moveSlot(pRight, j - 1, pRight, j);
+
+   if (!pRight->isLeaf)
+   {
+      setChild(inner(pLeft), pLeft->num + 1, inner(pRight)->children[0]);
+      for (size_t j = 0; j < pRight->num; j++)
+         setChild(inner(pRight), j, inner(pRight)->children[j + 1]);
+   }
+
+   pLeft->num++;
+   pRight->num--;
+}
+
+/*********************************************
+ * BTREE :: MERGE
+ * Separator iSep and everything in the child to its
+ * right join the child to its left. The right child
+ * is freed.
+ ********************************************/
+template <typename T, typename A, size_t MaxKeys>
+void BTree <T, A, MaxKeys> ::merge(Inner* p, size_t iSep)
+{
+   Node* pLeft = p->children[iSep];
+   Node* pRight = p->children[iSep + 1];
+   size_t numLeft = pLeft->num;
+
+   // 1. the separator and the right child move into the left child
+   moveSlot(pLeft, numLeft, p, iSep);
+   for (size_t j = 0; j < pRight->num; j++)
+      moveSlot(pLeft, numLeft + 1 + j, pRight, j);
+   if (!pLeft->isLeaf)
+      for (size_t j = 0; j <= pRight->num; j++)
+         setChild(inner(pLeft), numLeft + 1 + j, inner(pRight)->children[j]);
+   pLeft->num = (unsigned short)(numLeft + 1 + pRight->num);
+
+   // 2. the parent closes the gap
+   for (size_t j = iSep + 1; j < p->num; j++)
+      moveSlot(p, j - 1, p, j);
+   for (size_t j = iSep + 2; j <= p->num; j++)
+      setChild(p, j - 1, p->children[j]);
+   p->num--;
+
+   pRight->num = 0;
+   freeNode(pRight);
+}
+
+} // namespace custom
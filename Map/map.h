@@ -21,6 +21,7 @@
 
 #include "pair.h"     // for pair
 #include "bst.h"      // no nested class necessary for this assignment
+#include "btree.h"    // for BTree, the cache friendly engine
 
 #ifndef debug
 #ifdef DEBUG
@@ -37,22 +38,29 @@ namespace custom
 
 /*****************************************************************
  * MAP
- * Create a Map, similar to a Binary Search Tree
+ * Create a Map, similar to a Binary Search Tree. The pairs
+ * live in a BST unless another tree engine is asked for,
+ * such as the cache friendly B-tree:
+ *    custom::map<K, V, A, custom::BTree<custom::pair<K, V>, A>>
+ * or the BST that counts its subtrees, for rank() and
+ * nth_element() in O(log n):
+ *    custom::map<K, V, A, custom::BST<custom::pair<K, V>, A, true>>
  *****************************************************************/
-template <class K, class V>
+template <class K, class V, class A = std::allocator<custom::pair<K, V>>,
+          class Tree = BST<custom::pair<K, V>, A>>
 class map
 {
    friend class ::TestMap;
 
-   template <class KK, class VV>
-   friend void swap(map<KK, VV>& lhs, map<KK, VV>& rhs); 
+   template <class KK, class VV, class AA, class TTree>
+   friend void swap(map<KK, VV, AA, TTree>& lhs, map<KK, VV, AA, TTree>& rhs); 
 public:
    using Pairs = custom::pair<K, V>;
 
    // 
    // Construct
    //
-   map()
+   map(const A& a = A()) : bst(a)
    {
    }
    map(const map &  rhs) : bst(rhs.bst)
@@ -62,11 +70,11 @@ public:
    { 
    }
    template <class Iterator>
-   map(Iterator first, Iterator last) 
+   map(Iterator first, Iterator last, const A& a = A()) : bst(a)
    {
       insert(first, last);
    }
-   map(const std::initializer_list <Pairs>& il) 
+   map(const std::initializer_list <Pairs>& il, const A& a = A()) : bst(a)
    {
       insert(il); // using built in init insert to not duplicate code.
    }
@@ -119,7 +127,43 @@ public:
          V & at (const K& k);
    iterator find(const K & k)
    {
-      return iterator(bst.find(k));
+      return iterator(bst.find(k, KeyLess()));
+   }
+   template <class KK, class = typename std::enable_if<is_lookup_key<K, KK>::value>::type>
+   iterator find(const KK & k);
+   iterator lower_bound(const K & k) const
+   {
+      return iterator(bst.lower_bound(k, KeyLess()));
+   }
+   iterator upper_bound(const K & k) const
+   {
+      return iterator(bst.upper_bound(k, KeyLess()));
+   }
+   custom::pair<iterator, iterator> equal_range(const K & k) const
+   {
+      auto BSTPair = bst.equal_range(k, KeyLess());
+      return custom::pair<iterator, iterator>(iterator(BSTPair.first), iterator(BSTPair.second));
+   }
+   range_view<iterator> range(const K & lo, const K & hi) const
+   {
+      iterator itLo = lower_bound(lo);
+      return range_view<iterator>(itLo, lo < hi ? lower_bound(hi) : itLo);
+   }
+
+   //
+   // Rank, on a tree that keeps subtree sizes such as BST<Pairs, A, true>
+   //
+   iterator nth_element(size_t k) const
+   {
+      return iterator(bst.nth_element(k));
+   }
+   size_t rank(const K & k) const
+   {
+      return bst.rank(k, KeyLess());
+   }
+   size_t count_range(const K & lo, const K & hi) const
+   {
+      return bst.count_range(lo, hi, KeyLess());
    }
 
    //
@@ -138,11 +182,33 @@ public:
       return make_pair(iterator(BSTPair.first), wasNewNodeCreated);
    }
 
+   iterator insert(iterator hint, const Pairs & rhs)
+   {
+      return iterator(bst.insert(hint.it, rhs, true));
+   }
+   iterator insert(iterator hint, Pairs && rhs)
+   {
+      return iterator(bst.insert(hint.it, std::move(rhs), true));
+   }
+   template <class ... Args>
+   custom::pair<typename map::iterator, bool> emplace(Args&& ... args)
+   {
+      auto BSTPair = bst.emplace(true, std::forward<Args>(args)...);
+      return make_pair(iterator(BSTPair.first), BSTPair.second);
+   }
+   template <class ... Args>
+   iterator emplace_hint(iterator hint, Args&& ... args)
+   {
+      return iterator(bst.emplace_hint(hint.it, true, std::forward<Args>(args)...));
+   }
+   custom::pair<typename map::iterator, bool> try_emplace(const K & k);
+   template <class ... Args>
+   custom::pair<typename map::iterator, bool> try_emplace(const K & k, Args&& ... args);
+
    template <class Iterator>
    void insert(Iterator first, Iterator last)
    {
-      for (auto it = first; it != last; it++)
-         bst.insert(*it, true);
+      bst.insert(first, last, true);
    }
    void insert(const std::initializer_list <Pairs>& il)
    {
@@ -176,8 +242,24 @@ public:
 
 private:
 
+   // compare a pair and a key, either way round, by the key alone
+   struct KeyLess
+   {
+      template <class KK>
+      bool operator () (const Pairs& p, const KK& k) const { return p.first < k; }
+      template <class KK>
+      bool operator () (const KK& k, const Pairs& p) const { return k < p.first; }
+   };
+
+   // the pair a tree iterator refers to. Only the value is
+   // ever changed through it, never the key it is sorted by.
+   static Pairs& data(const typename Tree::iterator& it)
+   {
+      return const_cast<Pairs&>(*it);
+   }
+
    // the students DO NOT need to use a nested class
-   BST < pair <K, V >> bst;
+   Tree bst;
 };
 
 
@@ -186,11 +268,11 @@ private:
  * Forward and reverse iterator through a Map, just call
  * through to BSTIterator
  *********************************************************/
-template <typename K, typename V>
-class map <K, V> :: iterator
+template <typename K, typename V, typename A, typename Tree>
+class map <K, V, A, Tree> :: iterator
 {
    friend class ::TestMap;
-   template <class KK, class VV>
+   template <class KK, class VV, class AA, class TTree>
    friend class custom::map; 
 public:
    //
@@ -200,7 +282,7 @@ public:
    {
       it = nullptr;
    }
-   iterator(const typename BST < pair <K, V> > :: iterator & rhs)
+   iterator(const typename Tree :: iterator & rhs)
    { 
       it = rhs;
    }
@@ -243,9 +325,8 @@ public:
    //
    iterator & operator ++ ()
    {
-      iterator temp(*this);
       ++it;
-      return temp;
+      return *this;
    }
    iterator operator ++ (int postfix)
    {
@@ -255,9 +336,8 @@ public:
    }
    iterator & operator -- ()
    {
-      iterator temp(*this);
       --it;
-      return temp;
+      return *this;
    }
    iterator  operator -- (int postfix)
    {
@@ -269,7 +349,7 @@ public:
 private:
 
    // Member variable
-   typename BST < pair <K, V >>  :: iterator it;   
+   typename Tree :: iterator it;   
 };
 
 
@@ -277,8 +357,8 @@ private:
  * MAP :: SUBSCRIPT
  * Retrieve an element from the map
  ****************************************************/
-template <typename K, typename V>
-V& map <K, V> :: operator [] (const K& key)
+template <typename K, typename V, typename A, typename Tree>
+V& map <K, V, A, Tree> :: operator [] (const K& key)
 {
    // create a pair, then insert if not in bst.
    Pairs pair(key);
@@ -286,42 +366,79 @@ V& map <K, V> :: operator [] (const K& key)
    auto itBST = returnValue.first;
 
    // return the value of the pair.
-   return itBST.pNode->data.second;
+   return data(itBST).second;
 }
 
 /*****************************************************
  * MAP :: SUBSCRIPT
  * Retrieve an element from the map
  ****************************************************/
-template <typename K, typename V>
-const V& map <K, V> :: operator [] (const K& key) const
+template <typename K, typename V, typename A, typename Tree>
+const V& map <K, V, A, Tree> :: operator [] (const K& key) const
 {
-   // create a pair, then find it.
-   Pairs pair(key);
-   auto itBST = bst.find(pair);
+   // only the key is compared, so no blank V is built to look it up
+   auto itBST = bst.find(key, KeyLess());
 
    // If a pair is found, return it.
-   if (itBST == bst.end())
-      return itBST.pNode->data.second;
+   if (itBST != bst.end())
+      return data(itBST).second;
 
    // else, return the default value.
-   return pair.second;
+   static const V blank{};
+   return blank;
+}
+
+/*****************************************************
+ * MAP :: FIND
+ * Look up a key that compares with K. Only the keys are
+ * compared, so neither a K nor a blank V is built.
+ ****************************************************/
+template <typename K, typename V, typename A, typename Tree>
+template <class KK, class>
+typename map <K, V, A, Tree> ::iterator map <K, V, A, Tree> ::find(const KK & k)
+{
+   return iterator(bst.find(k, KeyLess()));
+}
+
+/*****************************************************
+ * MAP :: TRY EMPLACE
+ * Insert k with a V built from args, unless k is already
+ * there. Then nothing is built and the value is left alone.
+ ****************************************************/
+template <typename K, typename V, typename A, typename Tree>
+custom::pair<typename map <K, V, A, Tree> ::iterator, bool> map <K, V, A, Tree> ::try_emplace(const K& k)
+{
+   auto itBST = bst.find(k, KeyLess());
+   if (itBST != bst.end())
+      return make_pair(iterator(itBST), false);
+
+   // the pair and its blank V are built right in the node
+   return make_pair(iterator(bst.emplace(false, k).first), true);
+}
+template <typename K, typename V, typename A, typename Tree>
+template <class ... Args>
+custom::pair<typename map <K, V, A, Tree> ::iterator, bool> map <K, V, A, Tree> ::try_emplace(const K& k, Args&& ... args)
+{
+   auto itBST = bst.find(k, KeyLess());
+   if (itBST != bst.end())
+      return make_pair(iterator(itBST), false);
+
+   return make_pair(iterator(bst.emplace(false, k, V(std::forward<Args>(args)...)).first), true);
 }
 
 /*****************************************************
  * MAP :: AT
  * Retrieve an element from the map
  ****************************************************/
-template <typename K, typename V>
-V& map <K, V> ::at(const K& key)
+template <typename K, typename V, typename A, typename Tree>
+V& map <K, V, A, Tree> ::at(const K& key)
 {
-   // create a pair, then find it in bst.
-   Pairs pair(key);
-   auto it = bst.find(pair);
+   // find the key alone, without building a pair around it
+   auto it = bst.find(key, KeyLess());
 
    // checking if the pair exists, if so the return it.
-   if (it != nullptr)
-      return it.pNode->data.second;
+   if (it != bst.end())
+      return data(it).second;
 
    // throw an exception if not found in bst.
    else
@@ -332,16 +449,15 @@ V& map <K, V> ::at(const K& key)
  * MAP :: AT
  * Retrieve an element from the map
  ****************************************************/
-template <typename K, typename V>
-const V& map <K, V> ::at(const K& key) const
+template <typename K, typename V, typename A, typename Tree>
+const V& map <K, V, A, Tree> ::at(const K& key) const
 {
-   // create a pair, then find it in bst.
-   Pairs pair(key);
-   auto it = bst.find(pair);
+   // find the key alone, without building a pair around it
+   auto it = bst.find(key, KeyLess());
 
    // checking if the pair exists, if so then return it.
-   if (it != nullptr)
-      return it.pNode->data.second;
+   if (it != bst.end())
+      return data(it).second;
 
    // throw an exception if not found in bst.
    else
@@ -352,8 +468,8 @@ const V& map <K, V> ::at(const K& key) const
  * SWAP
  * Swap two maps
  ****************************************************/
-template <typename K, typename V>
-void swap(map <K, V>& lhs, map <K, V>& rhs)
+template <typename K, typename V, typename A, typename Tree>
+void swap(map <K, V, A, Tree>& lhs, map <K, V, A, Tree>& rhs)
 {
    lhs.bst.swap(rhs.bst);
 }
@@ -362,12 +478,11 @@ void swap(map <K, V>& lhs, map <K, V>& rhs)
  * ERASE
  * Erase one element
  ****************************************************/
-template <typename K, typename V>
-size_t map<K, V>::erase(const K& k)
+template <typename K, typename V, typename A, typename Tree>
+size_t map<K, V, A, Tree>::erase(const K& k)
 {
-   // create a pair, then find the pair in the bst.
-   Pairs pair(k);
-   auto it = bst.find(pair);
+   // find the key alone, without building a pair around it
+   auto it = bst.find(k, KeyLess());
 
    // if the pair was not found, return 0 deletions.
    if (it == bst.end())
@@ -382,22 +497,27 @@ size_t map<K, V>::erase(const K& k)
  * ERASE
  * Erase several elements
  ****************************************************/
-template <typename K, typename V>
-typename map<K, V>::iterator map<K, V>::erase(map<K, V>::iterator first, map<K, V>::iterator last)
+template <typename K, typename V, typename A, typename Tree>
+typename map<K, V, A, Tree>::iterator map<K, V, A, Tree>::erase(map<K, V, A, Tree>::iterator first, map<K, V, A, Tree>::iterator last)
 {
-   while (first != last)
+   // count first: an engine such as BTree moves elements when it
+   // erases, so last does not survive the first erase
+   size_t num = 0;
+   for (iterator it = first; it != last; ++it)
+      num++;
+   while (num-- > 0)
       first = erase(first);
-   return last;
+   return first;
 }
 
 /*****************************************************
  * ERASE
  * Erase one element
  ****************************************************/
-template <typename K, typename V>
-typename map<K, V>::iterator map<K, V>::erase(map<K, V>::iterator it)
+template <typename K, typename V, typename A, typename Tree>
+typename map<K, V, A, Tree>::iterator map<K, V, A, Tree>::erase(map<K, V, A, Tree>::iterator it)
 {
-   return map<K, V>::iterator(bst.erase(it.it));
+   return map<K, V, A, Tree>::iterator(bst.erase(it.it));
 }
 
 }; //  namespace custom
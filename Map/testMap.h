@@ -11,6 +11,7 @@
 #ifdef DEBUG
 
 #include "map.h"        // class under test
+#include "arena.h"      // for arena_allocator
 #include "unitTest.h"   // unit test baseclass
 #include "spy.h"        // spy is a mock class to monitor the class under test
 
@@ -120,6 +121,38 @@ public:
       test_size_empty();
       test_size_standard();
 
+      // Lookup
+      test_find_lookupKey();
+      test_find_lookupKeyMissing();
+      test_squareBracket_constLookup();
+
+      // Insert Range
+      test_insertRange_bulk();
+
+      // Emplace
+      test_tryEmplace_missing();
+      test_tryEmplace_present();
+      test_emplaceHint_end();
+      test_insertHint_move();
+
+      // Rank
+      test_rank_keys();
+
+      // Bounds
+      test_bounds_keys();
+      test_range_timeWindow();
+
+      // Allocator
+      test_arena_insert();
+      test_arena_squareBracket();
+
+      // Engine
+      test_btree_squareBracket();
+      test_btree_atMissing();
+      test_btree_lookupKey();
+      test_btree_eraseRange();
+      test_btree_hintedInsert();
+
       report("Map");
    }
 
@@ -1643,8 +1676,8 @@ public:
       // exercise
       it = m.find(s50);
       // verify
-      assertUnit(Spy::numDefault() == 1); // a blank Spy is created for comparison
-      assertUnit(Spy::numDestructor() == 1); // destroy it and the move-copy when done
+      assertUnit(Spy::numDefault() == 0); // only the key is compared, no blank Spy
+      assertUnit(Spy::numDestructor() == 0); // nothing was built to destroy
       assertUnit(Spy::numCopyMove() == 0);
       assertUnit(Spy::numCopy() == 0);
       assertUnit(Spy::numAlloc() == 0);     
@@ -1680,8 +1713,8 @@ public:
       // exercise
       it = m.find(s30);
       // verify
-      assertUnit(Spy::numDefault() == 1); // a blank Spy is created for comparison
-      assertUnit(Spy::numDestructor() == 1); // destroy it and the move-copy when done
+      assertUnit(Spy::numDefault() == 0); // only the key is compared, no blank Spy
+      assertUnit(Spy::numDestructor() == 0); // nothing was built to destroy
       assertUnit(Spy::numCopyMove() == 0);
       assertUnit(Spy::numCopy() == 0);
       assertUnit(Spy::numAlloc() == 0);
@@ -1717,8 +1750,8 @@ public:
       // exercise
       it = m.find(s70);
       // verify
-      assertUnit(Spy::numDefault() == 1); // a blank Spy is created for comparison
-      assertUnit(Spy::numDestructor() == 1); // destroy it and the move-copy when done
+      assertUnit(Spy::numDefault() == 0); // only the key is compared, no blank Spy
+      assertUnit(Spy::numDestructor() == 0); // nothing was built to destroy
       assertUnit(Spy::numCopyMove() == 0);
       assertUnit(Spy::numCopy() == 0);
       assertUnit(Spy::numAlloc() == 0);
@@ -1754,8 +1787,8 @@ public:
       // exercise
       it = m.find(s99);
       // verify
-      assertUnit(Spy::numDefault() == 1); // a blank Spy is created for comparison
-      assertUnit(Spy::numDestructor() == 1); // destroy it and the move-copy when done
+      assertUnit(Spy::numDefault() == 0); // only the key is compared, no blank Spy
+      assertUnit(Spy::numDestructor() == 0); // nothing was built to destroy
       assertUnit(Spy::numCopyMove() == 0);
       assertUnit(Spy::numCopy() == 0);
       assertUnit(Spy::numAlloc() == 0);
@@ -2534,8 +2567,8 @@ public:
       s = m.at(std::string("50"));
       // verify
       assertUnit(Spy::numAssign() == 1);     // assign [50]
-      assertUnit(Spy::numDefault() == 1);    // a blank Spy is created for comparison
-      assertUnit(Spy::numDestructor() == 1); // destroy it and the move-copy when done
+      assertUnit(Spy::numDefault() == 0);    // only the key is compared, no blank Spy
+      assertUnit(Spy::numDestructor() == 0); // nothing was built to destroy
       assertUnit(Spy::numCopy() == 0);
       assertUnit(Spy::numAlloc() == 0);
       assertUnit(Spy::numDelete() == 0);
@@ -2569,8 +2602,8 @@ public:
       s = m.at(std::string("30"));
       // verify
       assertUnit(Spy::numAssign() == 1);     // assign [30]
-      assertUnit(Spy::numDefault() == 1);    // a blank Spy is created for comparison
-      assertUnit(Spy::numDestructor() == 1); // destroy it and the move-copy when done
+      assertUnit(Spy::numDefault() == 0);    // only the key is compared, no blank Spy
+      assertUnit(Spy::numDestructor() == 0); // nothing was built to destroy
       assertUnit(Spy::numCopy() == 0);
       assertUnit(Spy::numAlloc() == 0);
       assertUnit(Spy::numDelete() == 0);
@@ -2604,8 +2637,8 @@ public:
       s = m.at(std::string("70"));
       // verify
       assertUnit(Spy::numAssign() == 1);     // assign [70]
-      assertUnit(Spy::numDefault() == 1);    // a blank Spy is created for comparison
-      assertUnit(Spy::numDestructor() == 1); // destroy it and the move-copy when done
+      assertUnit(Spy::numDefault() == 0);    // only the key is compared, no blank Spy
+      assertUnit(Spy::numDestructor() == 0); // nothing was built to destroy
       assertUnit(Spy::numCopy() == 0);
       assertUnit(Spy::numAlloc() == 0);
       assertUnit(Spy::numDelete() == 0);
@@ -2639,8 +2672,8 @@ public:
       m.at(std::string("50")) = s;
       // verify
       assertUnit(Spy::numAssign() == 1);     // assign [55]
-      assertUnit(Spy::numDefault() == 1);    // a blank Spy is created for comparison
-      assertUnit(Spy::numDestructor() == 1); // destroy it and the move-copy when done
+      assertUnit(Spy::numDefault() == 0);    // only the key is compared, no blank Spy
+      assertUnit(Spy::numDestructor() == 0); // nothing was built to destroy
       assertUnit(Spy::numCopy() == 0);
       assertUnit(Spy::numAlloc() == 0);
       assertUnit(Spy::numDelete() == 0);
@@ -2680,8 +2713,8 @@ public:
       m.at(std::string("30")) = s;
       // verify
       assertUnit(Spy::numAssign() == 1);     // assign [33]
-      assertUnit(Spy::numDefault() == 1);    // a blank Spy is created for comparison
-      assertUnit(Spy::numDestructor() == 1); // destroy it and the move-copy when done
+      assertUnit(Spy::numDefault() == 0);    // only the key is compared, no blank Spy
+      assertUnit(Spy::numDestructor() == 0); // nothing was built to destroy
       assertUnit(Spy::numCopy() == 0);
       assertUnit(Spy::numAlloc() == 0);
       assertUnit(Spy::numDelete() == 0);
@@ -2722,8 +2755,8 @@ public:
       m.at(std::string("70")) = s;
       // verify
       assertUnit(Spy::numAssign() == 1);     // assign [77]
-      assertUnit(Spy::numDefault() == 1);    // a blank Spy is created for comparison
-      assertUnit(Spy::numDestructor() == 1); // destroy it and the move-copy when done
+      assertUnit(Spy::numDefault() == 0);    // only the key is compared, no blank Spy
+      assertUnit(Spy::numDestructor() == 0); // nothing was built to destroy
       assertUnit(Spy::numCopy() == 0);
       assertUnit(Spy::numAlloc() == 0);
       assertUnit(Spy::numDelete() == 0);
@@ -2766,8 +2799,8 @@ public:
       {
          assertUnit(e.what() == std::string("invalid map<K, T> key"));
       }
-      assertUnit(Spy::numDefault() == 1);    // create a default value during search
-      assertUnit(Spy::numDestructor() == 1); // create a default value during search
+      assertUnit(Spy::numDefault() == 0);    // only the key is compared, no blank Spy
+      assertUnit(Spy::numDestructor() == 0); // nothing was built to destroy
       assertUnit(Spy::numCopy() == 0);
       assertUnit(Spy::numAlloc() == 0);     
       assertUnit(Spy::numAssign() == 0);    
@@ -2803,8 +2836,8 @@ public:
       {
          assertUnit(e.what() == std::string("invalid map<K, T> key"));
       }
-      assertUnit(Spy::numDefault() == 1);    // create a default value during search
-      assertUnit(Spy::numDestructor() == 1); // create a default value during search
+      assertUnit(Spy::numDefault() == 0);    // only the key is compared, no blank Spy
+      assertUnit(Spy::numDestructor() == 0); // nothing was built to destroy
       assertUnit(Spy::numCopy() == 0);
       assertUnit(Spy::numAlloc() == 0);
       assertUnit(Spy::numAssign() == 0);
@@ -2833,8 +2866,8 @@ public:
       // exercise
       size = m.erase(key);
       // verify
-      assertUnit(Spy::numDefault() == 1);      // create a default value for find
-      assertUnit(Spy::numDestructor() == 1);   // destroy the default value for find
+      assertUnit(Spy::numDefault() == 0);      // only the key is compared, no blank Spy
+      assertUnit(Spy::numDestructor() == 0);   // nothing was built to destroy
       assertUnit(Spy::numCopyMove() == 0);
       assertUnit(Spy::numCopy() == 0);
       assertUnit(Spy::numAlloc() == 0);
@@ -2864,9 +2897,9 @@ public:
       // exercise
       size = m.erase(key);
       // verify
-      assertUnit(Spy::numDestructor() == 2);   // destroy [50] and default for find
+      assertUnit(Spy::numDestructor() == 1);   // destroy [50]
       assertUnit(Spy::numDelete() == 1);       // delete  [50]  
-      assertUnit(Spy::numDefault() == 1);      // create default for find
+      assertUnit(Spy::numDefault() == 0);      // only the key is compared, no blank Spy
       assertUnit(Spy::numCopy() == 0);
       assertUnit(Spy::numAlloc() == 0);
       assertUnit(Spy::numAssign() == 0);
@@ -2920,8 +2953,8 @@ public:
       // exercise
       size = m.erase(key);
       // verify
-      assertUnit(Spy::numDestructor() == 1);   // default for find
-      assertUnit(Spy::numDefault() == 1);      // create default for find
+      assertUnit(Spy::numDestructor() == 0);   // nothing was built to destroy
+      assertUnit(Spy::numDefault() == 0);      // only the key is compared, no blank Spy
       assertUnit(Spy::numDelete() == 0);
       assertUnit(Spy::numCopy() == 0);
       assertUnit(Spy::numAlloc() == 0);
@@ -3308,6 +3341,378 @@ public:
       m.bst.root = nullptr;
       m.bst.numElements = 0;
    }
+   /***************************************
+    * LOOKUP
+    ***************************************/
+
+   // find by a const char * builds neither a key nor a blank value
+   void test_find_lookupKey()
+   {  // setup
+      custom::map<std::string, Spy> m;
+      setupStandardFixture(m);
+      Spy::reset();
+      // exercise
+      auto it = m.find("70");
+      // verify
+      assertUnit(Spy::numDefault() == 0);
+      assertUnit(Spy::numDestructor() == 0);
+      assertUnit(Spy::numLessthan() == 0);
+      assertUnit(it.it.pNode == m.bst.root->pRight);
+      assertStandardFixture(m);
+      // teardown
+      teardownStandardFixture(m);
+   }
+
+   // a key that is not there gives end()
+   void test_find_lookupKeyMissing()
+   {  // setup
+      custom::map<std::string, Spy> m;
+      setupStandardFixture(m);
+      Spy::reset();
+      // exercise
+      auto it = m.find("60");
+      // verify
+      assertUnit(Spy::numDefault() == 0);
+      assertUnit(it == m.end());
+      assertStandardFixture(m);
+      // teardown
+      teardownStandardFixture(m);
+   }
+
+   // a const map reads the value without adding the key or building a V
+   void test_squareBracket_constLookup()
+   {  // setup
+      custom::map<std::string, Spy> m;
+      setupStandardFixture(m);
+      const custom::map<std::string, Spy> & mConst = m;
+      Spy::reset();
+      // exercise
+      const Spy & sFound = mConst["70"];
+      // verify
+      assertUnit(Spy::numDefault() == 0);
+      assertUnit(Spy::numLessthan() == 0);
+      assertUnit(sFound == Spy(70));
+      assertUnit(mConst["60"] == Spy());
+      assertUnit(mConst.at("30") == Spy(30));
+      assertStandardFixture(m);
+      // teardown
+      teardownStandardFixture(m);
+   }
+
+   /***************************************
+    * INSERT RANGE
+    ***************************************/
+
+   // a big range is built in one go, keeping the first of each key
+   void test_insertRange_bulk()
+   {  // setup
+      typedef custom::pair<int, int> Pairs;
+      std::vector<Pairs> v;
+      for (int i = 0; i < 500; i++)
+         v.push_back(Pairs((i * 7) % 500, i));
+      v.push_back(Pairs(0, -1));
+      custom::map<int, int> m;
+      m[0] = 99;
+      // exercise
+      m.insert(v.begin(), v.end());
+      // verify
+      assertUnit(m.size() == 500);
+      assertUnit(m[0] == 99);
+      assertUnit(m[7] == 1);
+      int expect = 0;
+      for (auto it = m.begin(); it != m.end(); it++, expect++)
+         assertUnit((*it).first == expect);
+      assertUnit(expect == 500);
+      assertUnit(m.bst.root != nullptr && !m.bst.root->isRed);
+   }  // teardown
+
+   /***************************************
+    * EMPLACE
+    *    map::try_emplace(k, args...)
+    *    map::emplace_hint(hint, args...)
+    ***************************************/
+
+   // try_emplace a new key builds one V from the arguments
+   void test_tryEmplace_missing()
+   {  // setup
+      custom::map<int, Spy> m;
+      m.try_emplace(50, 500);
+      Spy::reset();
+      // exercise
+      auto pairReturn = m.try_emplace(30, 300);
+      // verify
+      assertUnit(Spy::numNondefault() == 1);
+      assertUnit(Spy::numDefault() == 0);
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(pairReturn.second == true);
+      assertUnit((*pairReturn.first).first == 30);
+      assertUnit((*pairReturn.first).second == Spy(300));
+      assertUnit(m.size() == 2);
+   }  // teardown
+
+   // try_emplace a key already there builds nothing and changes nothing
+   void test_tryEmplace_present()
+   {  // setup
+      custom::map<int, Spy> m;
+      m.try_emplace(50, 500);
+      Spy::reset();
+      // exercise
+      auto pairReturn = m.try_emplace(50, 999);
+      // verify
+      assertUnit(Spy::numNondefault() == 0);
+      assertUnit(Spy::numDefault() == 0);
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numCopyMove() == 0);
+      assertUnit(pairReturn.second == false);
+      assertUnit((*pairReturn.first).second == Spy(500));
+      assertUnit(m.size() == 1);
+   }  // teardown
+
+   // fill a map in key order, hinting at the end each time
+   void test_emplaceHint_end()
+   {  // setup
+      custom::map<int, int> m;
+      // exercise
+      for (int i = 0; i < 100; i++)
+         m.emplace_hint(m.end(), i, i * i);
+      m.emplace_hint(m.end(), 5, -1);    // already there: left alone
+      // verify
+      assertUnit(m.size() == 100);
+      assertUnit(m[5] == 25);
+      int expect = 0;
+      for (auto it = m.begin(); it != m.end(); it++, expect++)
+         assertUnit((*it).first == expect);
+      assertUnit(m.bst.root != nullptr && !m.bst.root->isRed);
+   }  // teardown
+
+   // a hinted insert of a temporary moves the value in, never copies it
+   void test_insertHint_move()
+   {  // setup
+      typedef custom::pair<int, Spy> Pairs;
+      custom::map<int, Spy> m;
+      m.try_emplace(50, 500);
+      Spy::reset();
+      // exercise
+      auto it = m.insert(m.end(), Pairs(70, Spy(700)));
+      auto itPresent = m.insert(m.begin(), Pairs(50, Spy(999)));
+      // verify
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(m.size() == 2);
+      assertUnit((*it).first == 70);
+      assertUnit((*it).second == Spy(700));
+      assertUnit((*itPresent).second == Spy(500));
+   }  // teardown
+
+   /***************************************
+    * RANK
+    *    map::rank(k)
+    *    map::nth_element(k)
+    *    map::count_range(lo, hi)
+    ***************************************/
+
+   // rank by key alone, whatever the values are
+   void test_rank_keys()
+   {  // setup
+      typedef custom::pair<int, std::string> Pairs;
+      custom::map<int, std::string, std::allocator<Pairs>, custom::BST<Pairs, std::allocator<Pairs>, true>> m;
+      for (int i = 0; i < 50; i++)
+         m[i * 2] = "even";
+      // exercise and verify
+      assertUnit(m.rank(10) == 5);
+      assertUnit(m.rank(11) == 6);
+      assertUnit((*m.nth_element(7)).first == 14);
+      assertUnit(m.count_range(10, 20) == 5);
+      assertUnit(m.nth_element(50) == m.end());
+   }  // teardown
+
+   /***************************************
+    * BOUNDS
+    *    map::lower_bound(k)
+    *    map::upper_bound(k)
+    *    map::equal_range(k)
+    *    map::range(lo, hi)
+    ***************************************/
+
+   // bounds go by the key alone
+   void test_bounds_keys()
+   {  // setup
+      custom::map<int, std::string> m;
+      m[10] = "ten";
+      m[20] = "twenty";
+      m[30] = "thirty";
+      // exercise and verify
+      assertUnit((*m.lower_bound(20)).second == "twenty");
+      assertUnit((*m.upper_bound(20)).second == "thirty");
+      assertUnit((*m.lower_bound(15)).first == 20);
+      assertUnit(m.upper_bound(30) == m.end());
+      auto range = m.equal_range(10);
+      assertUnit((*range.first).first == 10);
+      assertUnit((*range.second).first == 20);
+   }  // teardown
+
+   // the events in a window of time
+   void test_range_timeWindow()
+   {  // setup
+      custom::map<int, int> events;
+      for (int time = 0; time < 1000; time += 10)
+         events[time] = time / 10;
+      // exercise
+      int num = 0;
+      int sum = 0;
+      for (auto& event : events.range(95, 155))
+      {
+         num++;
+         sum += event.second;
+      }
+      // verify
+      assertUnit(num == 6);                 // 100 through 150
+      assertUnit(sum == 10 + 11 + 12 + 13 + 14 + 15);
+      assertUnit(events.range(1000, 2000).empty());
+   }  // teardown
+
+   /***************************************
+    * ALLOCATOR
+    ***************************************/
+
+   // every node of the map comes out of the arena
+   void test_arena_insert()
+   {  // setup
+      typedef custom::arena_allocator<custom::pair<int, Spy>> Alloc;
+      custom::arena a;
+      {
+         custom::map<int, Spy, Alloc> m(a);
+         // exercise
+         m.insert(custom::pair<int, Spy>(50, Spy(50)));
+         m.insert(custom::pair<int, Spy>(30, Spy(30)));
+         // verify
+         assertUnit(m.bst.alloc.resource() == &a);
+         assertUnit(a.bytes_allocated() == 2 * sizeof(custom::BST<custom::pair<int, Spy>, Alloc>::BNode));
+         assertUnit(m.size() == 2);
+         Spy::reset();
+      }
+      assertUnit(Spy::numDestructor() == 2); // the map still destroys its elements
+   }  // teardown
+
+   // operator [] adds its new node to the arena
+   void test_arena_squareBracket()
+   {  // setup
+      typedef custom::arena_allocator<custom::pair<int, int>> Alloc;
+      custom::arena a;
+      custom::map<int, int, Alloc> m(a);
+      // exercise
+      m[26] = 49;
+      m[67] = 89;
+      m[26] = 11;
+      // verify
+      assertUnit(a.bytes_allocated() == 2 * sizeof(custom::BST<custom::pair<int, int>, Alloc>::BNode));
+      assertUnit(m[26] == 11);
+      assertUnit(m[67] == 89);
+   }  // teardown
+
+   /***************************************
+    * ENGINE
+    ***************************************/
+
+   // operator [] works the same on the B-tree engine, splits and all
+   void test_btree_squareBracket()
+   {  // setup
+      typedef custom::pair<int, int> Pairs;
+      custom::map<int, int, std::allocator<Pairs>, custom::BTree<Pairs>> m;
+      // exercise
+      for (int i = 0; i < 200; i++)
+         m[(i * 7) % 200] = i;
+      m[14] = -1;
+      // verify
+      assertUnit(m.size() == 200);
+      assertUnit(m[14] == -1);
+      assertUnit(m[21] == 3);
+      int previous = -1;
+      for (auto it = m.begin(); it != m.end(); it++)
+      {
+         assertUnit((*it).first == previous + 1);
+         previous = (*it).first;
+      }
+      assertUnit(previous == 199);
+   }  // teardown
+
+   // at() still throws for a key that is not there
+   void test_btree_atMissing()
+   {  // setup
+      typedef custom::pair<int, int> Pairs;
+      custom::map<int, int, std::allocator<Pairs>, custom::BTree<Pairs>> m{ Pairs(1, 10), Pairs(2, 20) };
+      bool thrown = false;
+      // exercise
+      try
+      {
+         m.at(3);
+      }
+      catch (const std::out_of_range&)
+      {
+         thrown = true;
+      }
+      // verify
+      assertUnit(thrown);
+      assertUnit(m.at(2) == 20);
+   }  // teardown
+
+   // a lookup key finds its pair without building a K
+   void test_btree_lookupKey()
+   {  // setup
+      typedef custom::pair<std::string, Spy> Pairs;
+      custom::map<std::string, Spy, std::allocator<Pairs>, custom::BTree<Pairs>> m;
+      m["50"] = Spy(50);
+      m["30"] = Spy(30);
+      m["70"] = Spy(70);
+      Spy::reset();
+      // exercise
+      auto it = m.find("70");
+      auto itMissing = m.find("60");
+      // verify
+      assertUnit(Spy::numDefault() == 0);
+      assertUnit(Spy::numLessthan() == 0);
+      assertUnit(it != m.end());
+      if (it != m.end())
+         assertUnit((*it).second == Spy(70));
+      assertUnit(itMissing == m.end());
+   }  // teardown
+
+   // a hint is accepted and ignored: the search starts at the root
+   void test_btree_hintedInsert()
+   {  // setup
+      typedef custom::pair<int, int> Pairs;
+      custom::map<int, int, std::allocator<Pairs>, custom::BTree<Pairs>> m;
+      Pairs p(20, 200);
+      // exercise and verify: an insert moves pairs, so only
+      // the iterator it returns is good afterwards
+      assertUnit((*m.insert(m.end(), p)).second == 200);
+      assertUnit((*m.insert(m.end(), Pairs(10, 100))).second == 100);
+      assertUnit((*m.emplace_hint(m.begin(), 30, 300)).second == 300);
+      assertUnit((*m.emplace_hint(m.end(), 10, -1)).second == 100);
+      assertUnit(m.size() == 3);
+      assertUnit((*m.begin()).first == 10);
+      assertUnit(m[30] == 300);
+   }  // teardown
+
+   // a range erase stops at the end of the range even though
+   // every erase moves the pairs after it
+   void test_btree_eraseRange()
+   {  // setup
+      typedef custom::pair<int, int> Pairs;
+      custom::map<int, int, std::allocator<Pairs>, custom::BTree<Pairs>> m;
+      for (int i = 0; i < 100; i++)
+         m[i] = i * 10;
+      // exercise
+      auto itReturn = m.erase(m.find(20), m.find(70));
+      // verify
+      assertUnit(m.size() == 50);
+      assertUnit(itReturn != m.end() && (*itReturn).first == 70);
+      assertUnit(m.find(19) != m.end());
+      assertUnit(m.find(20) == m.end());
+      assertUnit(m.find(69) == m.end());
+      assertUnit(m[70] == 700);
+      assertUnit(m.size() == 50);
+   }  // teardown
+
 };
 
 #endif // DEBUG
@@ -0,0 +1,235 @@
+/***********************************************************************
+ * Header:
+ *    ARENA
+ * Summary:
+ *    A monotonic memory arena and an allocator that draws from it
+ *      __      __     _______        __
+ *     /  |    /  |   |  _____|   _  / /
+ *     `| |    `| |   | |____    (_)/ /
+ *      | |     | |   '_.____''.   / / _
+ *     _| |_   _| |_  | \____) |  / / (_)
+ *    |_____| |_____|  \______.' /_/
+ *
+ *    This will contain the class definition of:
+ *        arena              : Hands out memory from a few large chunks
+ *        arena_allocator    : An allocator for any custom container
+ *                             that draws from an arena
+ * Author
+ *    Peter Benson, Jarom Diaz, Isaac Radford
+ ************************************************************************/
+
+#pragma once
+
+#include <cassert>     // because I am paranoid
+#include <cstddef>     // for std::max_align_t
+#include <cstdint>     // for std::uintptr_t
+#include <new>         // for ::operator new and placement new
+#include <type_traits> // for std::true_type
+#include <utility>     // for std::forward
+
+class TestArena;       // forward declaration for unit tests
+
+namespace custom
+{
+
+/*****************************************
+ * ARENA
+ * A monotonic buffer. Memory is handed out by bumping
+ * a pointer through the current chunk. When the chunk
+ * runs out, a new one twice as large is chained on.
+ * Giving memory back does nothing: everything is freed
+ * at once by release() or by the destructor, no matter
+ * how many objects were carved out of it.
+ *
+ * Every container built on an arena must be destroyed
+ * (or cleared) before the arena is released.
+ ****************************************/
+class arena
+{
+   friend class ::TestArena; // give unit tests access to the privates
+public:
+   //
+   // Construct
+   //
+   arena(size_t sizeChunk = 4096) : pChunks(nullptr), pNext(nullptr), pEnd(nullptr),
+      sizeFirst(sizeChunk ? sizeChunk : 1), sizeChunk(sizeFirst), numChunks(0), numAllocated(0) {}
+   arena(const arena & rhs) = delete;
+   arena & operator = (const arena & rhs) = delete;
+   ~arena() { release(); }
+
+   //
+   // Allocate
+   //
+   void * allocate(size_t numBytes, size_t alignment = alignof(std::max_align_t));
+   void deallocate(void * /* p */, size_t /* numBytes */) noexcept {}
+   void release() noexcept;
+
+   //
+   // Status
+   //
+   size_t chunks()          const noexcept { return numChunks; }
+   size_t bytes_allocated() const noexcept { return numAllocated; }
+
+private:
+   struct Chunk
+   {
+      Chunk * pNext;           // the chunk allocated before this one
+   };
+
+   void addChunk(size_t numBytesMin);
+
+   Chunk * pChunks;            // most recent chunk, the head of the chain
+   char  * pNext;              // next free byte in the most recent chunk
+   char  * pEnd;               // one past the last byte of that chunk
+   size_t  sizeFirst;          // size of the first chunk, restored on release
+   size_t  sizeChunk;          // size of the next chunk to allocate
+   size_t  numChunks;          // number of chunks in the chain
+   size_t  numAllocated;       // number of bytes handed out so far
+};
+
+/*****************************************
+ * ARENA :: ALLOCATE
+ * Carve numBytes off the current chunk, aligned as
+ * requested. Start a new chunk if it does not fit.
+ ****************************************/
+inline void * arena::allocate(size_t numBytes, size_t alignment)
+{
+   assert(alignment != 0 && (alignment & (alignment - 1)) == 0);
+
+   std::uintptr_t p = ((std::uintptr_t)pNext + alignment - 1) & ~(std::uintptr_t)(alignment - 1);
+   if (pChunks == nullptr || p + numBytes > (std::uintptr_t)pEnd)
+   {
+      addChunk(numBytes + alignment);
+      p = ((std::uintptr_t)pNext + alignment - 1) & ~(std::uintptr_t)(alignment - 1);
+   }
+
+   pNext = (char *)(p + numBytes);
+   numAllocated += numBytes;
+   return (void *)p;
+}
+
+/*****************************************
+ * ARENA :: ADD CHUNK
+ * Chain on a new chunk that can hold at least
+ * numBytesMin bytes
+ ****************************************/
+inline void arena::addChunk(size_t numBytesMin)
+{
+   size_t size = sizeChunk < numBytesMin ? numBytesMin : sizeChunk;
+   Chunk * pChunk = (Chunk *)::operator new(sizeof(Chunk) + size);
+
+   pChunk->pNext = pChunks;
+   pChunks = pChunk;
+   pNext = (char *)(pChunk + 1);
+   pEnd = pNext + size;
+
+   sizeChunk *= 2;
+   numChunks++;
+}
+
+/*****************************************
+ * ARENA :: RELEASE
+ * Free every chunk at once
+ ****************************************/
+inline void arena::release() noexcept
+{
+   while (pChunks)
+   {
+      Chunk * pDelete = pChunks;
+      pChunks = pChunks->pNext;
+      ::operator delete(pDelete);
+   }
+
+   pNext = pEnd = nullptr;
+   sizeChunk = sizeFirst;
+   numChunks = 0;
+   numAllocated = 0;
+}
+
+/*****************************************
+ * ARENA ALLOCATOR
+ * Route a container's allocations through an arena:
+ *    custom::arena a;
+ *    custom::list<int, custom::arena_allocator<int>> l(a);
+ * Containers rebind it to their node type, so every
+ * node lands in the same arena. A default-constructed
+ * arena_allocator has no arena and uses the heap.
+ ****************************************/
+template <typename T>
+class arena_allocator
+{
+   template <typename U>
+   friend class arena_allocator;
+public:
+   typedef T         value_type;
+   typedef T *       pointer;
+   typedef const T * const_pointer;
+   typedef T &       reference;
+   typedef const T & const_reference;
+   typedef size_t    size_type;
+   typedef std::ptrdiff_t difference_type;
+
+   // the arena goes wherever the nodes go
+   typedef std::true_type propagate_on_container_move_assignment;
+   typedef std::true_type propagate_on_container_swap;
+
+   template <typename U>
+   struct rebind
+   {
+      typedef arena_allocator<U> other;
+   };
+
+   //
+   // Construct
+   //
+   arena_allocator() noexcept : pArena(nullptr) {}
+   arena_allocator(arena & a) noexcept : pArena(&a) {}
+   template <typename U>
+   arena_allocator(const arena_allocator<U> & rhs) noexcept : pArena(rhs.pArena) {}
+
+   //
+   // Allocate
+   //
+   T * allocate(size_t num)
+   {
+      if (pArena == nullptr)
+         return (T *)::operator new(num * sizeof(T));
+      return (T *)pArena->allocate(num * sizeof(T), alignof(T));
+   }
+   void deallocate(T * p, size_t num) noexcept
+   {
+      if (pArena == nullptr)
+         ::operator delete(p);
+      else
+         pArena->deallocate(p, num * sizeof(T));
+   }
+
+   //
+   // Construct and destroy elements
+   //
+   template <typename U, typename ... Args>
+   void construct(U * p, Args && ... args)
+   {
+      new ((void *)p) U(std::forward<Args>(args)...);
+   }
+   template <typename U>
+   void destroy(U * p)
+   {
+      p->~U();
+   }
+
+   //
+   // Status
+   //
+   arena * resource() const noexcept { return pArena; }
+
+   template <typename U>
+   bool operator == (const arena_allocator<U> & rhs) const noexcept { return pArena == rhs.pArena; }
+   template <typename U>
+   bool operator != (const arena_allocator<U> & rhs) const noexcept { return pArena != rhs.pArena; }
+
+private:
+   arena * pArena;             // where the memory comes from, or nullptr for the heap
+};
+
+} // namespace custom
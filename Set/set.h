@@ -21,6 +21,7 @@
 #include <cassert>
 #include <iostream>
 #include "bst.h"
+#include "btree.h"
 #include <memory>     // for std::allocator
 #include <functional> // for std::less
 
@@ -33,9 +34,15 @@ namespace custom
 
 /************************************************
  * SET
- * A class that represents a Set
+ * A class that represents a Set. The elements live in a
+ * BST unless another tree engine is asked for, such as
+ * the cache friendly B-tree:
+ *    custom::set<int, std::allocator<int>, custom::BTree<int>>
+ * or the BST that counts its subtrees, for rank() and
+ * nth_element() in O(log n):
+ *    custom::set<int, std::allocator<int>, custom::BST<int, std::allocator<int>, true>>
  ***********************************************/
-template <typename T>
+template <typename T, typename A = std::allocator<T>, typename Tree = custom::BST<T, A>>
 class set
 {
    friend class ::TestSet; // give unit tests access to the privates
@@ -44,22 +51,18 @@ public:
    // 
    // Construct
    //
-   set() {}
+   set(const A& a = A()) : bst(a) {}
    set(const set& rhs) : bst(rhs.bst) {}
    set(set&& rhs) : bst(std::move(rhs.bst)) {}
-   set(const std::initializer_list <T>& il) 
+   set(const std::initializer_list <T>& il, const A& a = A()) : bst(a)
    {
       clear();
       *this = il;
    }
    template <class Iterator>
-   set(Iterator first, Iterator last) 
+   set(Iterator first, Iterator last, const A& a = A()) : bst(a)
    {
-       while (first != last)
-       {
-		   bst.insert(*first, true);
-		   first++;
-	   }
+      bst.insert(first, last, true);
    }
    ~set() { clear(); } 
 
@@ -111,6 +114,45 @@ public:
    {
       return iterator(bst.find(t));
    }
+   template <class K, class = typename std::enable_if<is_lookup_key<T, K>::value>::type>
+   iterator find(const K& k)
+   {
+      return iterator(bst.find(k));
+   }
+   iterator lower_bound(const T& t) const
+   {
+      return iterator(bst.lower_bound(t));
+   }
+   iterator upper_bound(const T& t) const
+   {
+      return iterator(bst.upper_bound(t));
+   }
+   std::pair<iterator, iterator> equal_range(const T& t) const
+   {
+      auto bst_pair = bst.equal_range(t);
+      return std::pair<iterator, iterator>(iterator(bst_pair.first), iterator(bst_pair.second));
+   }
+   range_view<iterator> range(const T& lo, const T& hi) const
+   {
+      iterator itLo = lower_bound(lo);
+      return range_view<iterator>(itLo, lo < hi ? lower_bound(hi) : itLo);
+   }
+
+   //
+   // Rank, on a tree that keeps subtree sizes such as BST<T, A, true>
+   //
+   iterator nth_element(size_t k) const
+   {
+      return iterator(bst.nth_element(k));
+   }
+   size_t rank(const T& t) const
+   {
+      return bst.rank(t);
+   }
+   size_t count_range(const T& lo, const T& hi) const
+   {
+      return bst.count_range(lo, hi);
+   }
 
    //
    // Status
@@ -137,6 +179,25 @@ public:
       auto bst_pair = bst.insert(std::move(t), true);
       return std::pair<iterator, bool>(iterator(bst_pair.first), bst_pair.second);
    }
+   iterator insert(iterator hint, const T& t)
+   {
+      return iterator(bst.insert(hint.it, t, true));
+   }
+   iterator insert(iterator hint, T&& t)
+   {
+      return iterator(bst.insert(hint.it, std::move(t), true));
+   }
+   template <class ... Args>
+   std::pair<iterator, bool> emplace(Args&& ... args)
+   {
+      auto bst_pair = bst.emplace(true, std::forward<Args>(args)...);
+      return std::pair<iterator, bool>(iterator(bst_pair.first), bst_pair.second);
+   }
+   template <class ... Args>
+   iterator emplace_hint(iterator hint, Args&& ... args)
+   {
+      return iterator(bst.emplace_hint(hint.it, true, std::forward<Args>(args)...));
+   }
    void insert(const std::initializer_list <T>& il)
    {
       for (auto&& it : il)
@@ -145,13 +206,7 @@ public:
    template <class Iterator>
    void insert(Iterator first, Iterator last)
    {
-      while (first != last)
-      {
-         first = bst.insert(first);
-         ++first;
-      }
-
-      return last;
+      bst.insert(first, last, true);
    }
 
 
@@ -173,14 +228,19 @@ public:
    }
    iterator erase(iterator &itBegin, iterator &itEnd)
    {
-      while (itBegin != itEnd)
+      // count first: an engine such as BTree moves elements when it
+      // erases, so itEnd does not survive the first erase
+      size_t num = 0;
+      for (iterator it = itBegin; it != itEnd; ++it)
+         num++;
+      while (num-- > 0)
          itBegin = erase(itBegin);
-      return itEnd;
+      return itBegin;
    }
 
 private:
    
-   custom::BST <T> bst;
+   Tree bst;
 };
 
 
@@ -188,18 +248,18 @@ private:
  * SET ITERATOR
  * An iterator through Set
  *************************************************/
-template <typename T>
-class set <T> :: iterator
+template <typename T, typename A, typename Tree>
+class set <T, A, Tree> :: iterator
 {
    friend class ::TestSet; // give unit tests access to the privates
-   friend class custom::set<T>;
+   friend class custom::set<T, A, Tree>;
 public:
    // constructors, destructors, and assignment operator
    iterator()
    {
       it = nullptr;
    }
-   iterator(const typename custom::BST<T>::iterator& itRHS)
+   iterator(const typename Tree::iterator& itRHS)
    {  
       it = itRHS;
    }
@@ -232,9 +292,8 @@ public:
    // prefix increment
    iterator & operator ++ ()
    {
-      iterator temp(*this);
       ++it;
-      return temp;
+      return *this;
    }
 
    // postfix increment
@@ -248,9 +307,8 @@ public:
    // prefix decrement
    iterator & operator -- ()
    {
-      iterator temp(*this);
       --it;
-      return temp;
+      return *this;
    }
    
    // postfix decrement
@@ -263,7 +321,7 @@ public:
    
 private:
 
-   typename custom::BST<T>::iterator it;
+   typename Tree::iterator it;
 };
 
 }; // namespace custom
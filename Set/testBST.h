@@ -19,6 +19,7 @@
 #include <memory>
 #include <iostream>
 #include <string>
+#include <vector>
 #include <functional> // for std::less and std::greater
 
  /***********************************************
@@ -102,6 +103,27 @@ public:
       test_insert_case4bComplex();
       test_insert_case4cComplex();
       test_insert_case4dComplex();
+      test_insertRange_sorted();
+      test_insertRange_unsorted();
+      test_insertRange_keepUnique();
+      test_insertRange_merge();
+      test_insertRange_few();
+      test_insertHint_end();
+      test_insertHint_adjacent();
+      test_insertHint_wrong();
+      test_emplace_inPlace();
+      test_emplace_duplicate();
+      test_iterator_decrement_standard();
+      test_rank_nodeSize();
+      test_rank_standard();
+      test_nthElement_standard();
+      test_countRange_standard();
+      test_rank_insertErase();
+      test_rank_rangeCopy();
+      test_lowerBound_standard();
+      test_upperBound_standard();
+      test_equalRange_duplicates();
+      test_equalRange_missing();
 
       // Remove
       test_erase_empty();
@@ -3347,6 +3369,365 @@ public:
       bst.root = nullptr;
    }
 
+   /***************************************
+    * Insert Range
+    *    BST::insert(first, last)
+    ***************************************/
+
+   // sorted input is only checked, then linked from the bottom up
+   void test_insertRange_sorted()
+   {  // setup
+      std::initializer_list<Spy> il{ Spy(20), Spy(30), Spy(40), Spy(50), Spy(60), Spy(70), Spy(80) };
+      custom::BST <Spy> bst;
+      Spy::reset();
+      // exercise
+      bst.insert(il.begin(), il.end());
+      // verify
+      assertUnit(Spy::numCopy() == 7);      // copy-create [20][30][40][50][60][70][80]
+      assertUnit(Spy::numAlloc() == 7);     // allocate    [20][30][40][50][60][70][80]
+      assertUnit(Spy::numLessthan() == 6);  // sorted? 30:[20] 40:[30] 50:[40] 60:[50] 70:[60] 80:[70]
+      assertUnit(Spy::numEquals() == 0);
+      assertUnit(Spy::numCopyMove() == 0);
+      assertUnit(Spy::numAssign() == 0);
+      assertUnit(Spy::numAssignMove() == 0);
+      assertUnit(Spy::numDestructor() == 0);
+      //                (50b)
+      //          +-------+-------+
+      //        (30b)           (70b)
+      //     +----+----+     +----+----+
+      //   (20r)     (40r) (60r)     (80r)
+      assertStandardFixture(bst);
+   }  // teardown
+
+   // unsorted input of any size comes out balanced
+   void test_insertRange_unsorted()
+   {  // setup
+      std::vector<int> v;
+      for (int i = 0; i < 1000; i++)
+         v.push_back((i * 7919) % 1000);
+      custom::BST <int> bst;
+      // exercise
+      bst.insert(v.begin(), v.end());
+      // verify
+      assertUnit(bst.size() == 1000);
+      assertUnit(blackHeight(bst.root) > 0);
+      assertUnit(bst.root->pParent == nullptr);
+      int expect = 0;
+      for (auto it = bst.begin(); it != bst.end(); ++it, ++expect)
+         assertUnit(*it == expect);
+      assertUnit(expect == 1000);
+   }  // teardown
+
+   // keepUnique leaves one of each
+   void test_insertRange_keepUnique()
+   {  // setup
+      std::vector<int> v{ 5, 3, 5, 1, 3, 5, 2 };
+      custom::BST <int> bst;
+      // exercise
+      bst.insert(v.begin(), v.end(), true);
+      // verify
+      assertUnit(bst.size() == 4);
+      assertUnit(blackHeight(bst.root) > 0);
+      auto it = bst.begin();
+      assertUnit(*it == 1);
+      assertUnit(*(++it) == 2);
+      assertUnit(*(++it) == 3);
+      assertUnit(*(++it) == 5);
+      assertUnit(++it == bst.end());
+   }  // teardown
+
+   // a big range merges with the nodes already there, which are kept
+   void test_insertRange_merge()
+   {  // setup
+      custom::BST <int> bst;
+      bst.insert(10);
+      bst.insert(40);
+      auto it40 = bst.find(40);
+      std::vector<int> v{ 50, 40, 30, 20, 10, 0 };
+      // exercise
+      bst.insert(v.begin(), v.end(), true);
+      // verify
+      assertUnit(bst.size() == 6);
+      assertUnit(blackHeight(bst.root) > 0);
+      assertUnit(bst.find(40) == it40);      // the same node, just relinked
+      int expect = 0;
+      for (auto it = bst.begin(); it != bst.end(); ++it, expect += 10)
+         assertUnit(*it == expect);
+      assertUnit(expect == 60);
+   }  // teardown
+
+   // a few elements into a bigger tree go in one at a time
+   void test_insertRange_few()
+   {  // setup
+      custom::BST <int> bst{ 10, 20, 30, 40, 50 };
+      auto pRoot = bst.root;
+      std::vector<int> v{ 60, 25 };
+      // exercise
+      bst.insert(v.begin(), v.end());
+      // verify
+      assertUnit(bst.size() == 7);
+      assertUnit(bst.root == pRoot);        // not rebuilt
+      assertUnit(blackHeight(bst.root) > 0);
+      assertUnit(bst.find(25) != bst.end());
+      assertUnit(bst.find(60) != bst.end());
+   }  // teardown
+
+   /***************************************
+    * Insert with a hint
+    *    BST::insert(hint, t)
+    *    BST::emplace(keepUnique, args...)
+    ***************************************/
+
+   // insert in order with end() as the hint, as when copying sorted data
+   void test_insertHint_end()
+   {  // setup
+      custom::BST <int> bst;
+      // exercise
+      for (int i = 1; i <= 20; i++)
+         assertUnit(*bst.insert(bst.end(), i) == i);
+      // verify
+      assertUnit(bst.size() == 20);
+      assertUnit(blackHeight(bst.root) > 0);
+      int i = 1;
+      for (auto it = bst.begin(); it != bst.end(); ++it)
+         assertUnit(*it == i++);
+   }  // teardown
+
+   // a good hint takes two comparisons and no descent
+   void test_insertHint_adjacent()
+   {  // setup
+      //                 50 
+      //          +-------+-------+
+      //         30              70  
+      //     +----+----+     +----+----+
+      //    20        40    60        80  
+      custom::BST <Spy> bst;
+      setupStandardFixture(bst);
+      Spy s(45);
+      Spy::reset();
+      // exercise
+      auto it = bst.insert(custom::BST <Spy> ::iterator(bst.root), s);
+      // verify
+      assertUnit(Spy::numLessthan() == 2);
+      assertUnit(Spy::numEquals() == 0);
+      assertUnit(Spy::numCopy() == 1);
+      assertUnit(*it == Spy(45));
+      assertUnit(bst.size() == 8);
+      assertUnit(bst.root->pLeft->pRight->pRight != nullptr);
+      assertUnit(bst.root->pLeft->pRight->pRight->data == Spy(45));
+   }  // teardown
+
+   // a hint in the wrong place falls back to the ordinary insert
+   void test_insertHint_wrong()
+   {  // setup
+      custom::BST <int> bst{ 50, 30, 70, 20, 40, 60, 80 };
+      // exercise
+      auto it = bst.insert(bst.find(20), 75);
+      // verify
+      assertUnit(*it == 75);
+      assertUnit(bst.size() == 8);
+      assertUnit(blackHeight(bst.root) > 0);
+      int expected[] = { 20, 30, 40, 50, 60, 70, 75, 80 };
+      int i = 0;
+      for (auto itCheck = bst.begin(); itCheck != bst.end(); ++itCheck)
+         assertUnit(*itCheck == expected[i++]);
+   }  // teardown
+
+   // emplace builds the element in the node: no copy, no move
+   void test_emplace_inPlace()
+   {  // setup
+      custom::BST <Spy> bst;
+      setupStandardFixture(bst);
+      Spy::reset();
+      // exercise
+      auto pairReturn = bst.emplace(false, 45);
+      // verify
+      assertUnit(Spy::numNondefault() == 1);
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numCopyMove() == 0);
+      assertUnit(pairReturn.second == true);
+      assertUnit(*pairReturn.first == Spy(45));
+      assertUnit(bst.size() == 8);
+   }  // teardown
+
+   // emplace a duplicate into a unique BST: the new element is thrown away
+   void test_emplace_duplicate()
+   {  // setup
+      custom::BST <Spy> bst;
+      setupStandardFixture(bst);
+      Spy::reset();
+      // exercise
+      auto pairReturn = bst.emplace(true, 40);
+      // verify
+      assertUnit(Spy::numNondefault() == 1);
+      assertUnit(Spy::numDestructor() == 1);
+      assertUnit(pairReturn.second == false);
+      assertUnit(pairReturn.first.pNode == bst.root->pLeft->pRight);
+      assertUnit(bst.size() == 7);
+   }  // teardown
+
+   // decrement walks back through the whole tree and off the front
+   void test_iterator_decrement_standard()
+   {  // setup
+      custom::BST <int> bst{ 50, 30, 70, 20, 40, 60, 80 };
+      auto it = custom::BST <int> ::iterator(bst.root->pRight->pRight);
+      int expected[] = { 80, 70, 60, 50, 40, 30, 20 };
+      // exercise
+      for (int i = 0; i < 7; i++, --it)
+         assertUnit(*it == expected[i]);
+      // verify
+      assertUnit(it == bst.end());
+   }  // teardown
+
+   /***************************************
+    * Rank
+    *    BST::rank(t)
+    *    BST::nth_element(k)
+    *    BST::count_range(lo, hi)
+    ***************************************/
+
+   // an ordinary node carries no subtree size
+   void test_rank_nodeSize()
+   {  // verify
+      assertUnit(sizeof(custom::BST <int> ::BNode) <
+                 sizeof(custom::BST <int, std::allocator<int>, true> ::BNode));
+   }  // teardown
+
+   // how many are less than a value, present or not
+   void test_rank_standard()
+   {  // setup
+      custom::BST <int, std::allocator<int>, true> bst{ 50, 30, 70, 20, 40, 60, 80 };
+      // exercise and verify
+      assertUnit(countNodes(bst.root) == 7);
+      assertUnit(bst.rank(20) == 0);
+      assertUnit(bst.rank(45) == 3);
+      assertUnit(bst.rank(50) == 3);
+      assertUnit(bst.rank(80) == 6);
+      assertUnit(bst.rank(90) == 7);
+   }  // teardown
+
+   // the element with k before it, and end() past the last
+   void test_nthElement_standard()
+   {  // setup
+      custom::BST <int, std::allocator<int>, true> bst{ 50, 30, 70, 20, 40, 60, 80 };
+      // exercise and verify
+      for (int k = 0; k < 7; k++)
+         assertUnit(*bst.nth_element(k) == 20 + 10 * k);
+      assertUnit(bst.nth_element(7) == bst.end());
+   }  // teardown
+
+   // count [lo, hi) without walking it
+   void test_countRange_standard()
+   {  // setup
+      custom::BST <int, std::allocator<int>, true> bst{ 50, 30, 70, 20, 40, 60, 80 };
+      // exercise and verify
+      assertUnit(bst.count_range(30, 70) == 4);
+      assertUnit(bst.count_range(25, 65) == 4);
+      assertUnit(bst.count_range(0, 100) == 7);
+      assertUnit(bst.count_range(70, 30) == 0);
+      assertUnit(bst.count_range(45, 45) == 0);
+   }  // teardown
+
+   // the sizes follow every insert, rotation, and erase
+   void test_rank_insertErase()
+   {  // setup
+      custom::BST <int, std::allocator<int>, true> bst;
+      for (int i = 0; i < 100; i++)
+         bst.insert((i * 37) % 100);
+      bst.insert(bst.end(), 100);
+      bst.emplace(false, 50);
+      // exercise
+      for (int i = 0; i < 100; i += 3)
+      {
+         auto it = bst.find(i);
+         bst.erase(it);
+      }
+      // verify
+      assertUnit(countNodes(bst.root) == (int)bst.size());
+      assertUnit(bst.size() == 68);
+      assertUnit(bst.rank(3) == 2);               // 1, 2
+      assertUnit(*bst.nth_element(2) == 4);
+      assertUnit(bst.count_range(50, 51) == 2);   // both 50s
+   }  // teardown
+
+   // a bulk build and a copy count their subtrees too
+   void test_rank_rangeCopy()
+   {  // setup
+      std::vector<int> v;
+      for (int i = 0; i < 1000; i++)
+         v.push_back(i);
+      custom::BST <int, std::allocator<int>, true> bst;
+      bst.insert(v.begin(), v.end());
+      // exercise
+      custom::BST <int, std::allocator<int>, true> bstCopy(bst);
+      // verify
+      assertUnit(countNodes(bst.root) == 1000);
+      assertUnit(countNodes(bstCopy.root) == 1000);
+      assertUnit(*bstCopy.nth_element(500) == 500);
+      assertUnit(bstCopy.rank(250) == 250);
+   }  // teardown
+
+   /***************************************
+    * Bounds
+    *    BST::lower_bound(t)
+    *    BST::upper_bound(t)
+    *    BST::equal_range(t)
+    ***************************************/
+
+   // the first element not less than a value, present or not
+   void test_lowerBound_standard()
+   {  // setup
+      custom::BST <int> bst{ 50, 30, 70, 20, 40, 60, 80 };
+      // exercise and verify
+      assertUnit(*bst.lower_bound(10) == 20);
+      assertUnit(*bst.lower_bound(40) == 40);
+      assertUnit(*bst.lower_bound(45) == 50);
+      assertUnit(*bst.lower_bound(80) == 80);
+      assertUnit(bst.lower_bound(85) == bst.end());
+   }  // teardown
+
+   // the first element greater than a value, present or not
+   void test_upperBound_standard()
+   {  // setup
+      custom::BST <int> bst{ 50, 30, 70, 20, 40, 60, 80 };
+      // exercise and verify
+      assertUnit(*bst.upper_bound(10) == 20);
+      assertUnit(*bst.upper_bound(40) == 50);
+      assertUnit(*bst.upper_bound(45) == 50);
+      assertUnit(bst.upper_bound(80) == bst.end());
+   }  // teardown
+
+   // every copy of a value, wherever the rotations put them
+   void test_equalRange_duplicates()
+   {  // setup
+      custom::BST <int> bst;
+      for (int i = 0; i < 30; i++)
+         bst.insert(i % 5);
+      // exercise
+      auto range = bst.equal_range(2);
+      // verify
+      int num = 0;
+      for (auto it = range.first; it != range.second; ++it, num++)
+         assertUnit(*it == 2);
+      assertUnit(num == 6);
+      assertUnit(range.first == bst.lower_bound(2));
+      assertUnit(range.second == bst.upper_bound(2));
+   }  // teardown
+
+   // a value that is not there gives an empty range where it would go
+   void test_equalRange_missing()
+   {  // setup
+      custom::BST <int> bst{ 50, 30, 70, 20, 40, 60, 80 };
+      // exercise
+      auto range = bst.equal_range(55);
+      // verify
+      assertUnit(range.first == range.second);
+      assertUnit(*range.first == 60);
+      range = bst.equal_range(90);
+      assertUnit(range.first == bst.end());
+      assertUnit(range.second == bst.end());
+   }  // teardown
+
    /***************************************
     * Erase
     *    BST::erase(it)
@@ -3627,6 +4008,48 @@ public:
       bst.numElements = 7;
    }
 
+   /**************************************************************
+    * BLACK HEIGHT
+    * The black nodes on every path down from p, or -1 if
+    * the paths disagree, a red node has a red child, or a
+    * child does not point back at its parent
+    *************************************************************/
+   template <class T>
+   static int blackHeight(const typename custom::BST <T>::BNode* p)
+   {
+      if (p == nullptr)
+         return 1;
+      if (p->isRed && ((p->pLeft && p->pLeft->isRed) || (p->pRight && p->pRight->isRed)))
+         return -1;
+      if ((p->pLeft && p->pLeft->pParent != p) || (p->pRight && p->pRight->pParent != p))
+         return -1;
+      int left = blackHeight<T>(p->pLeft);
+      int right = blackHeight<T>(p->pRight);
+      if (left < 0 || left != right)
+         return -1;
+      return left + (p->isRed ? 0 : 1);
+   }
+   static int blackHeight(const custom::BST <int>::BNode* p)
+   {
+      return (p && p->isRed) ? -1 : blackHeight<int>(p);
+   }
+
+   /**************************************************************
+    * COUNT NODES
+    * The nodes from p down, or -1 if any node's subtree
+    * size disagrees with its children
+    *************************************************************/
+   static int countNodes(const custom::BST <int, std::allocator<int>, true>::BNode* p)
+   {
+      if (p == nullptr)
+         return 0;
+      int left = countNodes(p->pLeft);
+      int right = countNodes(p->pRight);
+      if (left < 0 || right < 0 || p->numNodes != (size_t)(left + right + 1))
+         return -1;
+      return left + right + 1;
+   }
+
    /**************************************************************
     * VERIFY EMPTY FIXTURE
     *************************************************************/
@@ -0,0 +1,557 @@
+/***********************************************************************
+ * Header:
+ *    TEST BTREE
+ * Summary:
+ *    Unit tests for the B-tree engine
+ * Author
+ *    Peter Benson, Jarom Diaz, Isaac Radford
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include "btree.h"
+#include "set.h"
+#include "unitTest.h"
+#include "spy.h"
+#include <memory>
+#include <string>
+
+class TestBTree : public UnitTest
+{
+   // three elements to a node, so a handful of inserts splits
+   typedef custom::BTree<int, std::allocator<int>, 3> Tree;
+   typedef Tree::Node Node;
+
+public:
+   void run()
+   {
+      reset();
+
+      // Construct
+      test_construct_default();
+      test_constructCopy_standard();
+      test_keysPerNode();
+
+      // Insert
+      test_insert_leaf();
+      test_insert_splitRoot();
+      test_insert_ascending();
+      test_insert_descending();
+      test_insert_duplicateUnique();
+      test_insert_duplicateKept();
+
+      // Access
+      test_find_standard();
+      test_find_missing();
+      test_lowerBound_standard();
+      test_equalRange_duplicates();
+      test_iterator_decrementEnd();
+
+      // Remove
+      test_erase_leaf();
+      test_erase_inner();
+      test_erase_all();
+      test_erase_duplicatesNext();
+      test_clear_spy();
+
+      // Set
+      test_set_engine();
+      test_set_eraseRange();
+      test_set_hintedInsert();
+
+      report("BTree");
+   }
+
+   /***************************************
+    * CONSTRUCT
+    ***************************************/
+
+   // an empty tree has no nodes
+   void test_construct_default()
+   {  // setup
+      // exercise
+      Tree t;
+      // verify
+      assertUnit(t.root == nullptr);
+      assertUnit(t.numElements == 0);
+      assertUnit(t.empty());
+      assertUnit(t.begin() == t.end());
+   }  // teardown
+
+   // a copy has the same shape and its own nodes
+   void test_constructCopy_standard()
+   {  // setup
+      Tree tSrc;
+      setupStandard(tSrc);
+      // exercise
+      Tree tDest(tSrc);
+      // verify
+      assertUnit(tDest.size() == 20);
+      assertUnit(tDest.root != tSrc.root);
+      assertUnit(isValid(tDest));
+      assertUnit(height(tDest.root) == height(tSrc.root));
+      int expect = 1;
+      for (auto it = tDest.begin(); it != tDest.end(); ++it, ++expect)
+         assertUnit(*it == expect);
+      assertUnit(expect == 21);
+   }  // teardown
+
+   // nodes hold four cache lines of elements, between 15 and 63
+   void test_keysPerNode()
+   {  // verify
+      assertUnit(custom::btree_keys<char>::value == 63);
+      assertUnit(custom::btree_keys<int>::value == 63);
+      assertUnit(custom::btree_keys<double>::value == 33);
+      assertUnit(custom::btree_keys<char[1024]>::value == 15);
+      assertUnit(custom::btree_keys<int>::value % 2 == 1);
+   }
+
+   /***************************************
+    * INSERT
+    ***************************************/
+
+   // up to three elements fit in the root leaf
+   void test_insert_leaf()
+   {  // setup
+      Tree t;
+      // exercise
+      t.insert(30);
+      t.insert(10);
+      t.insert(20);
+      // verify
+      assertUnit(t.root != nullptr);
+      if (t.root)
+      {
+         assertUnit(t.root->isLeaf);
+         assertUnit(t.root->num == 3);
+         assertUnit((*t.root)[0] == 10);
+         assertUnit((*t.root)[1] == 20);
+         assertUnit((*t.root)[2] == 30);
+      }
+      assertUnit(t.size() == 3);
+   }  // teardown
+
+   // the fourth element splits the root
+   void test_insert_splitRoot()
+   {  // setup
+      //   [1 2 3]
+      Tree t;
+      t.insert(1);
+      t.insert(2);
+      t.insert(3);
+      // exercise
+      t.insert(4);
+      // verify
+      //      [2]
+      //    +--+--+
+      //   [1]   [3 4]
+      assertUnit(t.root != nullptr && !t.root->isLeaf);
+      if (t.root && !t.root->isLeaf)
+      {
+         Node* pLeft = Tree::inner(t.root)->children[0];
+         Node* pRight = Tree::inner(t.root)->children[1];
+         assertUnit(t.root->num == 1);
+         assertUnit((*t.root)[0] == 2);
+         assertUnit(pLeft->num == 1 && (*pLeft)[0] == 1);
+         assertUnit(pRight->num == 2 && (*pRight)[0] == 3 && (*pRight)[1] == 4);
+         assertUnit(pLeft->pParent == t.root && pLeft->iParent == 0);
+         assertUnit(pRight->pParent == t.root && pRight->iParent == 1);
+      }
+      assertUnit(isValid(t));
+   }  // teardown
+
+   // sorted input keeps the tree balanced
+   void test_insert_ascending()
+   {  // setup
+      Tree t;
+      // exercise
+      for (int i = 0; i < 200; i++)
+         t.insert(i);
+      // verify
+      assertUnit(t.size() == 200);
+      assertUnit(isValid(t));
+      assertUnit(height(t.root) <= 8);   // a BST without balancing would be 200 deep
+      int expect = 0;
+      for (auto it = t.begin(); it != t.end(); ++it, ++expect)
+         assertUnit(*it == expect);
+      assertUnit(expect == 200);
+   }  // teardown
+
+   // so does reverse sorted input
+   void test_insert_descending()
+   {  // setup
+      Tree t;
+      // exercise
+      for (int i = 199; i >= 0; i--)
+         t.insert(i);
+      // verify
+      assertUnit(t.size() == 200);
+      assertUnit(isValid(t));
+      assertUnit(height(t.root) <= 8);
+      int expect = 0;
+      for (auto it = t.begin(); it != t.end(); ++it, ++expect)
+         assertUnit(*it == expect);
+   }  // teardown
+
+   // keepUnique finds the copy already there, even in an inner node
+   void test_insert_duplicateUnique()
+   {  // setup
+      Tree t;
+      setupStandard(t);
+      // exercise
+      auto pairRoot = t.insert((*t.root)[0], true);
+      auto pairLeaf = t.insert(1, true);
+      // verify
+      assertUnit(pairRoot.second == false);
+      assertUnit(pairRoot.first.pNode == t.root);
+      assertUnit(pairLeaf.second == false);
+      assertUnit(*pairLeaf.first == 1);
+      assertUnit(t.size() == 20);
+      assertUnit(isValid(t));
+   }  // teardown
+
+   // without keepUnique every copy goes in
+   void test_insert_duplicateKept()
+   {  // setup
+      Tree t;
+      // exercise
+      for (int i = 0; i < 30; i++)
+         t.insert(i % 3);
+      // verify
+      assertUnit(t.size() == 30);
+      assertUnit(isValid(t));
+      int num[3] = { 0, 0, 0 };
+      int previous = 0;
+      for (auto it = t.begin(); it != t.end(); ++it)
+      {
+         assertUnit(*it >= previous);
+         previous = *it;
+         num[*it]++;
+      }
+      assertUnit(num[0] == 10 && num[1] == 10 && num[2] == 10);
+   }  // teardown
+
+   /***************************************
+    * ACCESS
+    ***************************************/
+
+   // every element is found where it lives
+   void test_find_standard()
+   {  // setup
+      Tree t;
+      setupStandard(t);
+      // exercise and verify
+      for (int i = 1; i <= 20; i++)
+      {
+         auto it = t.find(i);
+         assertUnit(it != t.end());
+         if (it != t.end())
+            assertUnit(*it == i);
+      }
+   }  // teardown
+
+   // what is not there is not found
+   void test_find_missing()
+   {  // setup
+      Tree tEmpty;
+      Tree t;
+      setupStandard(t);
+      // exercise and verify
+      assertUnit(tEmpty.find(1) == tEmpty.end());
+      assertUnit(t.find(0) == t.end());
+      assertUnit(t.find(21) == t.end());
+   }  // teardown
+
+   // lower_bound goes to the first element not less than the key
+   void test_lowerBound_standard()
+   {  // setup
+      Tree t;
+      for (int i = 2; i <= 40; i += 2)
+         t.insert(i);
+      // exercise and verify
+      assertUnit(*t.lower_bound(0) == 2);
+      assertUnit(*t.lower_bound(2) == 2);
+      assertUnit(*t.lower_bound(3) == 4);
+      assertUnit(*t.lower_bound(39) == 40);
+      assertUnit(t.lower_bound(41) == t.end());
+   }  // teardown
+
+   // upper_bound and equal_range find every copy, across node boundaries
+   void test_equalRange_duplicates()
+   {  // setup
+      Tree t;
+      for (int i = 0; i < 40; i++)
+         t.insert(i % 4);
+      // exercise
+      auto range = t.equal_range(2);
+      // verify
+      int num = 0;
+      for (auto it = range.first; it != range.second; ++it, num++)
+         assertUnit(*it == 2);
+      assertUnit(num == 10);
+      assertUnit(*t.upper_bound(2) == 3);
+      assertUnit(t.upper_bound(3) == t.end());
+      assertUnit(t.equal_range(5).first == t.end());
+   }  // teardown
+
+   // backing up from the end visits everything in reverse
+   void test_iterator_decrementEnd()
+   {  // setup
+      Tree t;
+      setupStandard(t);
+      auto it = t.end();
+      // exercise and verify
+      for (int expect = 20; expect >= 1; expect--)
+      {
+         --it;
+         assertUnit(it != t.end());
+         if (it != t.end())
+            assertUnit(*it == expect);
+      }
+   }  // teardown
+
+   /***************************************
+    * REMOVE
+    ***************************************/
+
+   // erase from a leaf returns the next element
+   void test_erase_leaf()
+   {  // setup
+      Tree t;
+      setupStandard(t);
+      auto it = t.find(1);
+      // exercise
+      auto itNext = t.erase(it);
+      // verify
+      assertUnit(itNext != t.end() && *itNext == 2);
+      assertUnit(t.size() == 19);
+      assertUnit(t.find(1) == t.end());
+      assertUnit(isValid(t));
+   }  // teardown
+
+   // erase from an inner node pulls up the element before it
+   void test_erase_inner()
+   {  // setup
+      Tree t;
+      setupStandard(t);
+      int value = (*t.root)[0];
+      auto it = t.find(value);
+      // exercise
+      auto itNext = t.erase(it);
+      // verify
+      assertUnit(itNext != t.end() && *itNext == value + 1);
+      assertUnit(t.size() == 19);
+      assertUnit(t.find(value) == t.end());
+      assertUnit(isValid(t));
+   }  // teardown
+
+   // erasing everything borrows, merges, and shrinks back to nothing
+   void test_erase_all()
+   {  // setup
+      Tree t;
+      for (int i = 0; i < 100; i++)
+         t.insert(i);
+      // exercise and verify
+      for (int i = 0; i < 100; i++)
+      {
+         int value = (i * 37) % 100;
+         auto it = t.find(value);
+         assertUnit(it != t.end());
+         t.erase(it);
+         assertUnit(t.size() == (size_t)(99 - i));
+         assertUnit(isValid(t));
+      }
+      assertUnit(t.root == nullptr);
+      assertUnit(t.begin() == t.end());
+   }  // teardown
+
+   // erasing one of several equal elements returns the one after it,
+   // not the first of the run
+   void test_erase_duplicatesNext()
+   {  // setup
+      struct Tagged
+      {
+         int key;
+         int tag;
+         bool operator < (const Tagged& rhs) const { return key < rhs.key; }
+      };
+      custom::BTree<Tagged, std::allocator<Tagged>, 3> t;
+      for (int i = 0; i < 30; i++)
+         t.insert(Tagged{ i % 3, i });
+      // exercise and verify
+      while (!t.empty())
+      {
+         auto it = t.begin();
+         for (size_t i = 0; i < t.size() / 2; i++)
+            ++it;
+         auto itAfter = it;
+         ++itAfter;
+         int tagAfter = (itAfter == t.end()) ? -1 : (*itAfter).tag;
+         auto itNext = t.erase(it);
+         assertUnit((itNext == t.end() ? -1 : (*itNext).tag) == tagAfter);
+      }
+   }  // teardown
+
+   // clear destroys every element exactly once
+   void test_clear_spy()
+   {  // setup
+      custom::BTree<Spy, std::allocator<Spy>, 5> t;
+      for (int i = 0; i < 50; i++)
+         t.insert(Spy(i));
+      Spy::reset();
+      // exercise
+      t.clear();
+      // verify
+      assertUnit(Spy::numDestructor() == 50);
+      assertUnit(Spy::numDelete() == 50);
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numAlloc() == 0);
+      assertUnit(Spy::numLessthan() == 0);
+      assertUnit(t.root == nullptr);
+      assertUnit(t.empty());
+   }  // teardown
+
+   /***************************************
+    * SET
+    ***************************************/
+
+   // set runs on the B-tree when asked to
+   void test_set_engine()
+   {  // setup
+      custom::set<std::string, std::allocator<std::string>, custom::BTree<std::string>> s{ "m", "c", "x" };
+      // exercise
+      auto pairInsert = s.insert(std::string("c"));
+      s.erase(std::string("x"));
+      // verify
+      assertUnit(pairInsert.second == false);
+      assertUnit(s.size() == 2);
+      auto it = s.begin();
+      assertUnit(*it == std::string("c"));
+      it++;
+      assertUnit(*it == std::string("m"));
+      it++;
+      assertUnit(it == s.end());
+      assertUnit(s.find("m") != s.end());
+      assertUnit(s.find("x") == s.end());
+   }  // teardown
+
+   // a range erase stops at the end of the range even though
+   // every erase moves the elements after it
+   void test_set_eraseRange()
+   {  // setup
+      custom::set<int, std::allocator<int>, custom::BTree<int>> s;
+      for (int i = 0; i < 100; i++)
+         s.insert(i);
+      auto itBegin = s.find(20);
+      auto itEnd = s.find(70);
+      // exercise
+      auto itReturn = s.erase(itBegin, itEnd);
+      // verify
+      assertUnit(s.size() == 50);
+      assertUnit(itReturn != s.end() && *itReturn == 70);
+      assertUnit(s.find(19) != s.end());
+      assertUnit(s.find(20) == s.end());
+      assertUnit(s.find(69) == s.end());
+      int previous = -1;
+      for (auto it = s.begin(); it != s.end(); it++)
+      {
+         assertUnit(*it > previous);
+         previous = *it;
+      }
+      assertUnit(previous == 99);
+   }  // teardown
+
+   // a hint is accepted and ignored: the search starts at the root
+   void test_set_hintedInsert()
+   {  // setup
+      custom::set<std::string, std::allocator<std::string>, custom::BTree<std::string>> s;
+      std::string m("m");
+      // exercise and verify: an insert moves elements, so only
+      // the iterator it returns is good afterwards
+      assertUnit(*s.insert(s.end(), m) == "m");
+      assertUnit(*s.insert(s.end(), std::string("c")) == "c");
+      assertUnit(*s.emplace_hint(s.begin(), 1, 'x') == "x");
+      assertUnit(*s.emplace_hint(s.end(), "c") == "c");
+      assertUnit(s.size() == 3);
+      auto it = s.begin();
+      assertUnit(*it++ == "c");
+      assertUnit(*it++ == "m");
+      assertUnit(*it++ == "x");
+      assertUnit(it == s.end());
+   }  // teardown
+
+   /****************************************************************
+    * SETUP STANDARD
+    * 1 through 20, inserted out of order so the tree has
+    * three levels
+    ****************************************************************/
+   void setupStandard(Tree& t)
+   {
+      for (int i = 1; i <= 20; i++)
+         t.insert((i * 7) % 20 + 1);
+   }
+
+   /****************************************************************
+    * HEIGHT
+    * Levels from p down to its leaves
+    ****************************************************************/
+   static size_t height(const Node* p)
+   {
+      size_t num = 0;
+      for (; p != nullptr; num++)
+         p = p->isLeaf ? nullptr : static_cast<const Tree::Inner*>(p)->children[0];
+      return num;
+   }
+
+   /****************************************************************
+    * IS VALID
+    * Every node but the root is at least half full, the
+    * elements are in order, the parent links agree, and
+    * every leaf is at the same depth
+    ****************************************************************/
+   static bool isValid(const Tree& t)
+   {
+      if (t.root == nullptr)
+         return t.numElements == 0;
+      size_t num = 0;
+      size_t depthLeaf = 0;
+      return t.root->pParent == nullptr &&
+             isValid(t.root, true, 1, depthLeaf, num) &&
+             num == t.numElements;
+   }
+   static bool isValid(const Node* p, bool isRoot, size_t depth, size_t& depthLeaf, size_t& num)
+   {
+      if (p->num > 3 || p->num < (isRoot ? 1 : Tree::MIN_KEYS))
+         return false;
+      for (size_t i = 1; i < p->num; i++)
+         if ((*p)[i] < (*p)[i - 1])
+            return false;
+      num += p->num;
+
+      if (p->isLeaf)
+      {
+         if (depthLeaf == 0)
+            depthLeaf = depth;
+         return depth == depthLeaf;
+      }
+
+      const Tree::Inner* pInner = static_cast<const Tree::Inner*>(p);
+      for (size_t i = 0; i <= p->num; i++)
+      {
+         const Node* pChild = pInner->children[i];
+         if (pChild->pParent != pInner || pChild->iParent != i)
+            return false;
+         if (i > 0 && (*pChild)[0] < (*p)[i - 1])
+            return false;
+         if (i < p->num && (*p)[i] < (*pChild)[pChild->num - 1])
+            return false;
+         if (!isValid(pChild, false, depth + 1, depthLeaf, num))
+            return false;
+      }
+      return true;
+   }
+};
+
+#endif // DEBUG
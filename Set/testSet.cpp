@@ -14,6 +14,7 @@
 
 #include "testSet.h"        // for the set unit tests
 #include "testBST.h"        // for the BST unit tests
+#include "testBTree.h"      // for the B-tree unit tests
 #include "testSpy.h"        // for the spy unit tests
 int Spy::counters[] = {};
 
@@ -27,6 +28,7 @@ int main()
    // unit tests
    TestSpy().run();
    TestBST().run();
+   TestBTree().run();
    TestSet().run();
 #endif // DEBUG
    
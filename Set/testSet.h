@@ -13,10 +13,13 @@
 #ifdef DEBUG
 
 #include "set.h"
+#include "arena.h"
+#include "pool.h"
 #include "unitTest.h"
 #include "spy.h"
 #include <set>
 #include <vector>
+#include <string>
 
 
 #include <iostream>
@@ -132,6 +135,26 @@ public:
       test_size_empty();
       test_size_standard();
 
+      // Lookup
+      test_find_lookupKey();
+      test_find_lookupKeyMissing();
+
+      // Emplace
+      test_insertHint_sorted();
+      test_emplace_standard();
+
+      // Rank
+      test_rank_scores();
+
+      // Bounds
+      test_bounds_standard();
+      test_range_window();
+
+      // Allocator
+      test_arena_insert();
+      test_arena_copy();
+      test_pool_churn();
+
       report("Set");
    }
    
@@ -394,8 +417,8 @@ public:
       // verify
       assertUnit(Spy::numCopy() == 7);     // copy-create [50][30][70][20][40][60][80]
       assertUnit(Spy::numAlloc() == 7);    // allocate    [50][30][70][20][40][60][80]
-      assertUnit(Spy::numLessthan() == 10);// compare 50: 30:[50] 70:[50] 20:[50][30] 40:[50][30] 60:[50][70] 80:[50][70]
-      assertUnit(Spy::numEquals() == 10);  // compare 50: 30:[50] 70:[50] 20:[50][30] 40:[50][30] 60:[50][70] 80:[50][70]
+      assertUnit(Spy::numLessthan() == 15); // sorted? 30<50 no. sort: [30 50][20 70][40 60] [20 30 50 70][40 60 80] [20..80]
+      assertUnit(Spy::numEquals() == 6);    // duplicates? 30:[20] 40:[30] 50:[40] 60:[50] 70:[60] 80:[70]
       assertUnit(Spy::numDelete() == 0);
       assertUnit(Spy::numDefault() == 0);
       assertUnit(Spy::numNondefault() == 0);
@@ -463,9 +486,8 @@ public:
       // verify
       assertUnit(Spy::numCopy() == 7);      // copy-construct [50,30,70,20,40,60,80] 
       assertUnit(Spy::numAlloc() == 7);     // allocate [50,30,70,20,40,60,80]
-      assertUnit(Spy::numLessthan() == 10); // compare 50: 30:[50] 70:[50] 20:[50][30] 40:[50][30] 60:[50][70] 80:[50][70]
-      assertUnit(Spy::numEquals() == 10);   // equal   50: 30:[50] 70:[50] 20:[50][30] 40:[50][30] 60:[50][70] 80:[50][70]
-      assertUnit(Spy::numEquals() == 10);
+      assertUnit(Spy::numLessthan() == 15); // sorted? 30<50 no. sort: [30 50][20 70][40 60] [20 30 50 70][40 60 80] [20..80]
+      assertUnit(Spy::numEquals() == 6);    // duplicates? 30:[20] 40:[30] 50:[40] 60:[50] 70:[60] 80:[70]
       assertUnit(Spy::numDelete() == 0);
       assertUnit(Spy::numDefault() == 0);
       assertUnit(Spy::numNondefault() == 0);
@@ -3577,6 +3599,198 @@ public:
       }
    }
 
+   /***************************************
+    * LOOKUP
+    ***************************************/
+
+   // find a string by a const char * without building a string
+   void test_find_lookupKey()
+   {  // setup
+      custom::set<std::string> s{ "30", "50", "70" };
+      // exercise
+      auto it = s.find("50");
+      // verify
+      assertUnit(it != s.end());
+      assertUnit(*it == std::string("50"));
+      assertUnit((custom::is_lookup_key<std::string, const char *>::value));
+      assertUnit(!(custom::is_lookup_key<int, double>::value));
+      assertUnit(!(custom::is_lookup_key<Spy, Spy>::value));
+   }  // teardown
+
+   // a key that is not there gives end()
+   void test_find_lookupKeyMissing()
+   {  // setup
+      custom::set<std::string> s{ "30", "50", "70" };
+      // exercise
+      auto it = s.find("60");
+      // verify
+      assertUnit(it == s.end());
+   }  // teardown
+
+   /***************************************
+    * EMPLACE
+    *    set::insert(hint, t)
+    *    set::emplace(args...)
+    ***************************************/
+
+   // copy sorted data into a set, hinting at the end each time
+   void test_insertHint_sorted()
+   {  // setup
+      custom::set<int> s;
+      // exercise
+      for (int i = 0; i < 100; i++)
+         s.insert(s.end(), i);
+      auto it = s.insert(s.end(), 50);   // already there
+      // verify
+      assertUnit(*it == 50);
+      assertUnit(s.size() == 100);
+      int expect = 0;
+      for (auto itCheck = s.begin(); itCheck != s.end(); itCheck++, expect++)
+         assertUnit(*itCheck == expect);
+   }  // teardown
+
+   // emplace builds the element once, and not at all into the set twice
+   void test_emplace_standard()
+   {  // setup
+      custom::set<Spy> s{ Spy(50), Spy(30), Spy(70) };
+      Spy::reset();
+      // exercise
+      auto pairNew = s.emplace(60);
+      auto pairOld = s.emplace(30);
+      // verify
+      assertUnit(Spy::numNondefault() == 2);
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numCopyMove() == 0);
+      assertUnit(Spy::numDestructor() == 1);
+      assertUnit(pairNew.second == true);
+      assertUnit(*pairNew.first == Spy(60));
+      assertUnit(pairOld.second == false);
+      assertUnit(*pairOld.first == Spy(30));
+      assertUnit(s.size() == 4);
+   }  // teardown
+
+   /***************************************
+    * RANK
+    *    set::rank(t)
+    *    set::nth_element(k)
+    *    set::count_range(lo, hi)
+    ***************************************/
+
+   // percentiles of a set of scores
+   void test_rank_scores()
+   {  // setup
+      custom::set<int, std::allocator<int>, custom::BST<int, std::allocator<int>, true>> s;
+      for (int i = 1; i <= 100; i++)
+         s.insert(i * 10);
+      s.erase(500);
+      // exercise and verify
+      assertUnit(s.rank(10) == 0);
+      assertUnit(s.rank(505) == 49);
+      assertUnit(s.rank(510) == 49);
+      assertUnit(*s.nth_element(49) == 510);
+      assertUnit(s.nth_element(99) == s.end());
+      assertUnit(s.count_range(100, 200) == 10);
+      assertUnit(s.count_range(450, 550) == 9);
+   }  // teardown
+
+   /***************************************
+    * BOUNDS
+    *    set::lower_bound(t)
+    *    set::upper_bound(t)
+    *    set::equal_range(t)
+    *    set::range(lo, hi)
+    ***************************************/
+
+   // bounds of a value in the set and of one that is not
+   void test_bounds_standard()
+   {  // setup
+      custom::set<int> s{ 50, 30, 70, 20, 40, 60, 80 };
+      // exercise and verify
+      assertUnit(*s.lower_bound(40) == 40);
+      assertUnit(*s.upper_bound(40) == 50);
+      assertUnit(*s.lower_bound(45) == 50);
+      assertUnit(s.upper_bound(80) == s.end());
+      auto range = s.equal_range(60);
+      assertUnit(*range.first == 60);
+      assertUnit(*range.second == 70);
+   }  // teardown
+
+   // walk [lo, hi) without copying any of it
+   void test_range_window()
+   {  // setup
+      custom::set<int> s{ 50, 30, 70, 20, 40, 60, 80 };
+      // exercise
+      int sum = 0;
+      for (int value : s.range(30, 60))
+         sum += value;
+      // verify
+      assertUnit(sum == 30 + 40 + 50);
+      assertUnit(s.range(41, 49).empty());
+      assertUnit(s.range(60, 30).empty());
+      assertUnit(s.range(75, 100).begin() != s.end());
+      assertUnit(s.range(75, 100).end() == s.end());
+   }  // teardown
+
+   /***************************************
+    * ALLOCATOR
+    ***************************************/
+
+   // every node of the set comes out of the arena
+   void test_arena_insert()
+   {  // setup
+      custom::arena a;
+      {
+         custom::set<Spy, custom::arena_allocator<Spy>> s(a);
+         // exercise
+         s.insert(Spy(50));
+         s.insert(Spy(30));
+         s.insert(Spy(70));
+         // verify
+         assertUnit(s.bst.alloc.resource() == &a);
+         assertUnit(a.bytes_allocated() == 3 * sizeof(custom::BST<Spy, custom::arena_allocator<Spy>>::BNode));
+         assertUnit(s.size() == 3);
+         assertUnit(*s.begin() == Spy(30));
+         Spy::reset();
+      }
+      assertUnit(Spy::numDestructor() == 3); // the set still destroys its elements
+   }  // teardown
+
+   // a copy draws from the same arena as the original
+   void test_arena_copy()
+   {  // setup
+      custom::arena a;
+      custom::set<int, custom::arena_allocator<int>> sSrc(a);
+      sSrc.insert(50);
+      sSrc.insert(30);
+      // exercise
+      custom::set<int, custom::arena_allocator<int>> sDest(sSrc);
+      // verify
+      assertUnit(sDest.bst.alloc.resource() == &a);
+      assertUnit(a.bytes_allocated() == 4 * sizeof(custom::BST<int, custom::arena_allocator<int>>::BNode));
+      assertUnit(sDest.size() == 2);
+   }  // teardown
+
+   // erase then insert reuses the same node
+   void test_pool_churn()
+   {  // setup
+      typedef custom::set<int, custom::pool_allocator<int>> Set;
+      typedef custom::pool_allocator<custom::BST<int, custom::pool_allocator<int>>::BNode> NodeAlloc;
+      Set s{ 50, 30, 70 };
+      size_t numSlabs = NodeAlloc::resource().slabs();
+      size_t numInUse = NodeAlloc::resource().blocks_in_use();
+      // exercise
+      for (int i = 0; i < 1000; i++)
+      {
+         s.erase(30);
+         s.insert(30);
+      }
+      // verify
+      assertUnit(NodeAlloc::resource().slabs() == numSlabs);
+      assertUnit(NodeAlloc::resource().blocks_in_use() == numInUse);
+      assertUnit(s.size() == 3);
+      assertUnit(*s.begin() == 30);
+   }  // teardown
+
 
 };
 
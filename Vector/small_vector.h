@@ -0,0 +1,777 @@
+/***********************************************************************
+ * Header:
+ *    SMALL VECTOR
+ * Summary:
+ *    A vector that keeps its first N elements inside the object
+ *      __      __     _______        __
+ *     /  |    /  |   |  _____|   _  / /
+ *     `| |    `| |   | |____    (_)/ /
+ *      | |     | |   '_.____''.   / / _
+ *     _| |_   _| |_  | \____) |  / / (_)
+ *    |_____| |_____|  \______.' /_/
+ *
+ *    This will contain the class definition of:
+ *        small_vector           : A vector with inline storage
+ *        small_vector::iterator : An iterator through small_vector
+ *        small_vector::const_iterator : A read-only iterator
+ * Author
+ *    Peter Benson, Jarom Diaz, Isaac Radford
+ ************************************************************************/
+
+#pragma once
+
+#include <cassert>  // because I am paranoid
+#include <new>      // std::bad_alloc
+#include <memory>   // for std::allocator
+#include <initializer_list> // for std::initializer_list
+#include <cstring>  // for std::memcpy and std::memmove
+#include <iterator> // for std::distance and std::random_access_iterator_tag
+#include <type_traits> // for std::aligned_storage and the trivial type traits
+#include "vector.h" // for is_trivially_relocatable and the growth policies
+
+class TestSmallVector; // forward declaration for unit tests
+
+namespace custom
+{
+
+/*****************************************
+ * SMALL VECTOR
+ * Same interface as custom::vector, but the first
+ * N elements live in a buffer inside the object.
+ * The heap is only used once the size grows past N,
+ * so a small_vector that stays small never allocates.
+ ****************************************/
+template <typename T, size_t N, typename A = std::allocator<T>, typename G = growth_double>
+class small_vector
+{
+   static_assert(N > 0, "a small_vector needs room for at least one element");
+   friend class ::TestSmallVector; // give unit tests access to the privates
+public:
+
+   //
+   // Construct
+   //
+   small_vector(const A & a = A());
+   small_vector(size_t numElements,                const A & a = A());
+   small_vector(size_t numElements, const T & t,   const A & a = A());
+   small_vector(const std::initializer_list<T>& l, const A & a = A());
+   small_vector(const small_vector &  rhs);
+   small_vector(      small_vector && rhs);
+  ~small_vector();
+
+   //
+   // Assign
+   //
+   void swap(small_vector& rhs);
+   small_vector & operator = (const small_vector & rhs);
+   small_vector & operator = (small_vector&& rhs);
+
+   //
+   // Iterator
+   //
+   class iterator;
+   class const_iterator;
+   iterator begin()
+   {
+      return iterator(buffer);
+   }
+   iterator end()
+   {
+      return iterator(buffer + numElements);
+   }
+   const_iterator begin()  const { return const_iterator(buffer);               }
+   const_iterator end()    const { return const_iterator(buffer + numElements); }
+   const_iterator cbegin() const { return const_iterator(buffer);               }
+   const_iterator cend()   const { return const_iterator(buffer + numElements); }
+
+   //
+   // Access
+   //
+         T& operator [] (size_t index)       { return buffer[index];                }
+   const T& operator [] (size_t index) const { return buffer[index];                }
+         T& front()                          { return buffer[0];                    }
+   const T& front()                    const { return buffer[0];                    }
+         T& back()                           { return buffer[numElements - 1];      }
+   const T& back()                     const { return buffer[numElements - 1];      }
+         T* data()                           { return buffer;                       }
+   const T* data()                     const { return buffer;                       }
+
+   //
+   // Insert
+   //
+   void push_back(const T& t);
+   void push_back(T&& t);
+   template <class ... Args>
+   T & emplace_back(Args && ... args);
+   template <class Iterator>
+   iterator insert(iterator pos, Iterator first, Iterator last);
+   template <class Iterator>
+   void append(Iterator first, Iterator last);
+   template <class Iterator>
+   void assign(Iterator first, Iterator last);
+   void reserve(size_t newCapacity);
+   void resize(size_t newElements);
+   void resize(size_t newElements, const T& t);
+   void resize_default_init(size_t newElements);
+   void resize_uninitialized(size_t newElements);
+
+   //
+   // Remove
+   //
+   void clear()
+   {
+      for (size_t i = 0; i < numElements; ++i)
+         alloc.destroy(buffer + i);
+
+      numElements = 0;
+   }
+   void pop_back()
+   {
+      if (numElements != 0)
+      {
+         numElements -= 1;
+         alloc.destroy(buffer + numElements);
+      }
+   }
+   void shrink_to_fit();
+
+   //
+   // Status
+   //
+   size_t  size()          const { return numElements;}
+   size_t  capacity()      const { return numCapacity;}
+   bool empty()            const { return numElements == 0;}
+   bool isInline()         const { return buffer == inlineData(); }
+
+private:
+
+   typedef typename std::aligned_storage<sizeof(T), alignof(T)>::type Slot;
+
+   A    alloc;                // use allocator for memory once we spill
+   T *  buffer;               // either the inline storage or the heap
+   size_t  numCapacity;       // the capacity of buffer
+   size_t  numElements;       // the number of items currently used
+   Slot storage[N];           // the inline storage for the first N elements
+
+         T * inlineData()       { return reinterpret_cast<      T *>(storage); }
+   const T * inlineData() const { return reinterpret_cast<const T *>(storage); }
+
+   void moveFrom(small_vector & rhs);
+   void reallocate(size_t newCapacity);
+   void relocate(T * dataNew, std::true_type);
+   void relocate(T * dataNew, std::false_type);
+   void growFor(size_t numNeeded);
+   void shiftRight(size_t index, size_t numShift, std::true_type);
+   void shiftRight(size_t index, size_t numShift, std::false_type);
+};
+
+/**************************************************
+ * SMALL VECTOR ITERATOR
+ * An iterator through small_vector, just like
+ * vector::iterator: the elements are contiguous
+ * whether they are inline or on the heap, so it
+ * is a random access iterator
+ *************************************************/
+template <typename T, size_t N, typename A, typename G>
+class small_vector <T, N, A, G> ::iterator
+{
+   friend class small_vector;      // so insert() can find the position
+   friend class const_iterator;
+   friend class ::TestSmallVector; // give unit tests access to the privates
+public:
+   typedef std::random_access_iterator_tag iterator_category;
+   typedef T                               value_type;
+   typedef std::ptrdiff_t                  difference_type;
+   typedef T *                             pointer;
+   typedef T &                             reference;
+
+   // constructors, destructors, and assignment operator
+   iterator()                         : p(nullptr)               {}
+   iterator(T* p)                     : p(p)                     {}
+   iterator(const iterator& rhs)      : p(rhs.p)                 {}
+   iterator(size_t index, small_vector& v) : p(v.buffer + index) {}
+   iterator& operator = (const iterator& rhs)
+   {
+      p = rhs.p;
+      return *this;
+   }
+
+   // equals, not equals, and relative operators
+   bool operator != (const iterator& rhs) const { return p != rhs.p; }
+   bool operator == (const iterator& rhs) const { return p == rhs.p; }
+   bool operator <  (const iterator& rhs) const { return p <  rhs.p; }
+   bool operator >  (const iterator& rhs) const { return p >  rhs.p; }
+   bool operator <= (const iterator& rhs) const { return p <= rhs.p; }
+   bool operator >= (const iterator& rhs) const { return p >= rhs.p; }
+
+   // dereference operators
+   T& operator * () const
+   {
+      return *p;
+   }
+   T* operator -> () const
+   {
+      return p;
+   }
+   T& operator [] (difference_type offset) const
+   {
+      return p[offset];
+   }
+
+   // prefix increment
+   iterator& operator ++ ()
+   {
+      ++p;
+      return *this;
+   }
+
+   // postfix increment
+   iterator operator ++ (int postfix)
+   {
+      iterator returnCopy(*this);
+      ++p;
+      return returnCopy;
+   }
+
+   // prefix decrement
+   iterator& operator -- ()
+   {
+      --p;
+      return *this;
+   }
+
+   // postfix decrement
+   iterator operator -- (int postfix)
+   {
+      iterator returnCopy(*this);
+      --p;
+      return returnCopy;
+   }
+
+   // jump forward or backward
+   iterator& operator += (difference_type offset) { p += offset; return *this; }
+   iterator& operator -= (difference_type offset) { p -= offset; return *this; }
+   iterator  operator +  (difference_type offset) const { return iterator(p + offset); }
+   iterator  operator -  (difference_type offset) const { return iterator(p - offset); }
+   friend iterator operator + (difference_type offset, const iterator& it)
+   {
+      return iterator(it.p + offset);
+   }
+
+   // distance between two iterators
+   difference_type operator - (const iterator& rhs) const { return p - rhs.p; }
+
+private:
+   T* p;
+};
+
+/**************************************************
+ * SMALL VECTOR CONST ITERATOR
+ * Just like small_vector::iterator, but through a
+ * const small_vector, so the elements can be read
+ * but not changed.
+ *************************************************/
+template <typename T, size_t N, typename A, typename G>
+class small_vector <T, N, A, G> ::const_iterator
+{
+   friend class ::TestSmallVector; // give unit tests access to the privates
+public:
+   typedef std::random_access_iterator_tag iterator_category;
+   typedef T                               value_type;
+   typedef std::ptrdiff_t                  difference_type;
+   typedef const T *                       pointer;
+   typedef const T &                       reference;
+
+   // constructors, destructors, and assignment operator
+   const_iterator()                          : p(nullptr) {}
+   const_iterator(const T* p)                : p(p)       {}
+   const_iterator(const const_iterator& rhs) : p(rhs.p)   {}
+   const_iterator(const iterator& rhs)       : p(rhs.p)   {}
+   const_iterator& operator = (const const_iterator& rhs)
+   {
+      p = rhs.p;
+      return *this;
+   }
+
+   // equals, not equals, and relative operators
+   bool operator != (const const_iterator& rhs) const { return p != rhs.p; }
+   bool operator == (const const_iterator& rhs) const { return p == rhs.p; }
+   bool operator <  (const const_iterator& rhs) const { return p <  rhs.p; }
+   bool operator >  (const const_iterator& rhs) const { return p >  rhs.p; }
+   bool operator <= (const const_iterator& rhs) const { return p <= rhs.p; }
+   bool operator >= (const const_iterator& rhs) const { return p >= rhs.p; }
+
+   // dereference operators
+   const T& operator *  ()                          const { return *p;        }
+   const T* operator -> ()                          const { return p;         }
+   const T& operator [] (difference_type offset)    const { return p[offset]; }
+
+   // increment and decrement
+   const_iterator& operator ++ ()    { ++p; return *this; }
+   const_iterator& operator -- ()    { --p; return *this; }
+   const_iterator  operator ++ (int) { const_iterator returnCopy(*this); ++p; return returnCopy; }
+   const_iterator  operator -- (int) { const_iterator returnCopy(*this); --p; return returnCopy; }
+
+   // jump forward or backward
+   const_iterator& operator += (difference_type offset) { p += offset; return *this; }
+   const_iterator& operator -= (difference_type offset) { p -= offset; return *this; }
+   const_iterator  operator +  (difference_type offset) const { return const_iterator(p + offset); }
+   const_iterator  operator -  (difference_type offset) const { return const_iterator(p - offset); }
+   friend const_iterator operator + (difference_type offset, const const_iterator& it)
+   {
+      return const_iterator(it.p + offset);
+   }
+
+   // distance between two iterators
+   difference_type operator - (const const_iterator& rhs) const { return p - rhs.p; }
+
+private:
+   const T* p;
+};
+
+/*****************************************
+ * SMALL VECTOR :: DEFAULT constructor
+ * Point at the inline buffer. No allocation.
+ ****************************************/
+template <typename T, size_t N, typename A, typename G>
+small_vector <T, N, A, G> :: small_vector(const A & a) : alloc(a)
+{
+   buffer = inlineData();
+   numCapacity = N;
+   numElements = 0;
+}
+
+/*****************************************
+ * SMALL VECTOR :: NON-DEFAULT constructors
+ * Make room for num elements (inline if they fit)
+ * and construct each one
+ ****************************************/
+template <typename T, size_t N, typename A, typename G>
+small_vector <T, N, A, G> :: small_vector(size_t num, const A & a) : small_vector(a)
+{
+   reserve(num);
+   for (size_t i = 0; i < num; ++i)
+      alloc.construct(buffer + i);
+   numElements = num;
+}
+
+template <typename T, size_t N, typename A, typename G>
+small_vector <T, N, A, G> :: small_vector(size_t num, const T & t, const A & a) : small_vector(a)
+{
+   reserve(num);
+   for (size_t i = 0; i < num; ++i)
+      alloc.construct(buffer + i, t);
+   numElements = num;
+}
+
+/*****************************************
+ * SMALL VECTOR :: INITIALIZATION LIST constructor
+ ****************************************/
+template <typename T, size_t N, typename A, typename G>
+small_vector <T, N, A, G> :: small_vector(const std::initializer_list<T> & l, const A & a) : small_vector(a)
+{
+   reserve(l.size());
+   for (auto it = l.begin(); it != l.end(); ++it)
+      alloc.construct(buffer + numElements++, *it);
+}
+
+/*****************************************
+ * SMALL VECTOR :: COPY CONSTRUCTOR
+ ****************************************/
+template <typename T, size_t N, typename A, typename G>
+small_vector <T, N, A, G> :: small_vector(const small_vector & rhs) : small_vector(rhs.alloc)
+{
+   reserve(rhs.numElements);
+   for (size_t i = 0; i < rhs.numElements; ++i)
+      alloc.construct(buffer + i, rhs.buffer[i]);
+   numElements = rhs.numElements;
+}
+
+/*****************************************
+ * SMALL VECTOR :: MOVE CONSTRUCTOR
+ * Steal the heap buffer if there is one, otherwise
+ * move the inline elements over one at a time
+ ****************************************/
+template <typename T, size_t N, typename A, typename G>
+small_vector <T, N, A, G> :: small_vector(small_vector && rhs) : small_vector(rhs.alloc)
+{
+   moveFrom(rhs);
+}
+
+/*****************************************
+ * SMALL VECTOR :: DESTRUCTOR
+ * Destroy the elements and free the heap buffer
+ * if we ever spilled
+ ****************************************/
+template <typename T, size_t N, typename A, typename G>
+small_vector <T, N, A, G> :: ~small_vector()
+{
+   clear();
+   if (!isInline())
+      alloc.deallocate(buffer, numCapacity);
+}
+
+/*****************************************
+ * SMALL VECTOR :: ASSIGN
+ ****************************************/
+template <typename T, size_t N, typename A, typename G>
+small_vector <T, N, A, G> & small_vector <T, N, A, G> :: operator = (const small_vector & rhs)
+{
+   if (this != &rhs)
+   {
+      clear();
+      reserve(rhs.numElements);
+      for (size_t i = 0; i < rhs.numElements; ++i)
+         alloc.construct(buffer + i, rhs.buffer[i]);
+      numElements = rhs.numElements;
+   }
+   return *this;
+}
+
+template <typename T, size_t N, typename A, typename G>
+small_vector <T, N, A, G> & small_vector <T, N, A, G> :: operator = (small_vector && rhs)
+{
+   if (this != &rhs)
+   {
+      clear();
+      moveFrom(rhs);
+   }
+   return *this;
+}
+
+/*****************************************
+ * SMALL VECTOR :: SWAP
+ * Two heap buffers just trade pointers. When either
+ * side is inline the elements have to move.
+ ****************************************/
+template <typename T, size_t N, typename A, typename G>
+void small_vector <T, N, A, G> :: swap(small_vector & rhs)
+{
+   if (this == &rhs)
+      return;
+
+   if (!isInline() && !rhs.isInline())
+   {
+      std::swap(buffer, rhs.buffer);
+      std::swap(numElements, rhs.numElements);
+      std::swap(numCapacity, rhs.numCapacity);
+      return;
+   }
+
+   small_vector temp(std::move(rhs));
+   rhs = std::move(*this);
+   *this = std::move(temp);
+}
+
+/***************************************
+ * SMALL VECTOR :: MOVE FROM
+ * Take the elements of rhs, which is left empty.
+ * We must already be empty.
+ **************************************/
+template <typename T, size_t N, typename A, typename G>
+void small_vector <T, N, A, G> :: moveFrom(small_vector & rhs)
+{
+   assert(numElements == 0);
+
+   // a heap buffer can be stolen outright
+   if (!rhs.isInline())
+   {
+      if (!isInline())
+         alloc.deallocate(buffer, numCapacity);
+      buffer        = rhs.buffer;
+      numCapacity = rhs.numCapacity;
+      numElements = rhs.numElements;
+
+      rhs.buffer        = rhs.inlineData();
+      rhs.numCapacity = N;
+      rhs.numElements = 0;
+      return;
+   }
+
+   // inline elements must be moved. They always fit in our capacity
+   for (size_t i = 0; i < rhs.numElements; ++i)
+      alloc.construct(buffer + i, std::move(rhs.buffer[i]));
+   numElements = rhs.numElements;
+   rhs.clear();
+}
+
+/***************************************
+ * SMALL VECTOR :: RESIZE
+ **************************************/
+template <typename T, size_t N, typename A, typename G>
+void small_vector <T, N, A, G> :: resize(size_t newElements)
+{
+   if (newElements > numElements)
+   {
+      reserve(newElements);
+      for (size_t i = numElements; i < newElements; ++i)
+         alloc.construct(buffer + i);
+   }
+   else
+      for (size_t i = newElements; i < numElements; ++i)
+         alloc.destroy(buffer + i);
+
+   numElements = newElements;
+}
+
+template <typename T, size_t N, typename A, typename G>
+void small_vector <T, N, A, G> :: resize(size_t newElements, const T & t)
+{
+   if (newElements > numElements)
+   {
+      reserve(newElements);
+      for (size_t i = numElements; i < newElements; ++i)
+         alloc.construct(buffer + i, t);
+   }
+   else
+      for (size_t i = newElements; i < numElements; ++i)
+         alloc.destroy(buffer + i);
+
+   numElements = newElements;
+}
+
+/***************************************
+ * SMALL VECTOR :: RESIZE DEFAULT INIT
+ * Like resize(), but new elements are default-initialized,
+ * so trivial types are left unwritten rather than zeroed
+ **************************************/
+template <typename T, size_t N, typename A, typename G>
+void small_vector <T, N, A, G> :: resize_default_init(size_t newElements)
+{
+   if (newElements > numElements)
+   {
+      reserve(newElements);
+      for (size_t i = numElements; i < newElements; ++i)
+         ::new (static_cast<void *>(buffer + i)) T;
+   }
+   else
+      for (size_t i = newElements; i < numElements; ++i)
+         alloc.destroy(buffer + i);
+
+   numElements = newElements;
+}
+
+/***************************************
+ * SMALL VECTOR :: RESIZE UNINITIALIZED
+ * Change the size without touching the elements at all.
+ * Only for trivial types. The caller must write the new
+ * slots before reading them.
+ **************************************/
+template <typename T, size_t N, typename A, typename G>
+void small_vector <T, N, A, G> :: resize_uninitialized(size_t newElements)
+{
+   static_assert(std::is_trivially_default_constructible<T>::value &&
+                 std::is_trivially_destructible<T>::value,
+                 "resize_uninitialized requires a trivial type");
+
+   reserve(newElements);
+   numElements = newElements;
+}
+
+/***************************************
+ * SMALL VECTOR :: RESERVE
+ * Grow the buffer to newCapacity. Anything past
+ * the inline buffer lives on the heap.
+ **************************************/
+template <typename T, size_t N, typename A, typename G>
+void small_vector <T, N, A, G> :: reserve(size_t newCapacity)
+{
+   if (newCapacity > numCapacity)
+      reallocate(newCapacity);
+}
+
+/***************************************
+ * SMALL VECTOR :: SHRINK TO FIT
+ * Move back into the inline buffer when the
+ * elements fit, otherwise trim the heap buffer
+ **************************************/
+template <typename T, size_t N, typename A, typename G>
+void small_vector <T, N, A, G> :: shrink_to_fit()
+{
+   if (!isInline() && numElements < numCapacity)
+      reallocate(numElements);
+}
+
+/***************************************
+ * SMALL VECTOR :: REALLOCATE
+ * Relocate the elements into a buffer of newCapacity,
+ * which is the inline buffer when it is no more than N
+ **************************************/
+template <typename T, size_t N, typename A, typename G>
+void small_vector <T, N, A, G> :: reallocate(size_t newCapacity)
+{
+   assert(newCapacity >= numElements);
+   T * dataNew = newCapacity <= N ? inlineData() : alloc.allocate(newCapacity);
+   if (dataNew == buffer)
+      return;
+
+   relocate(dataNew, is_trivially_relocatable<T>());
+
+   if (!isInline())
+      alloc.deallocate(buffer, numCapacity);
+   buffer = dataNew;
+   numCapacity = isInline() ? N : newCapacity;
+}
+
+/***************************************
+ * SMALL VECTOR :: RELOCATE
+ * Move the elements from buffer into dataNew, leaving
+ * buffer as raw memory
+ **************************************/
+template <typename T, size_t N, typename A, typename G>
+void small_vector <T, N, A, G> :: relocate(T * dataNew, std::true_type)
+{
+   if (numElements > 0)
+      std::memcpy(static_cast<void *>(dataNew), static_cast<const void *>(buffer),
+                  numElements * sizeof(T));
+}
+
+template <typename T, size_t N, typename A, typename G>
+void small_vector <T, N, A, G> :: relocate(T * dataNew, std::false_type)
+{
+   for (size_t i = 0; i < numElements; ++i)
+   {
+      alloc.construct(dataNew + i, std::move(buffer[i]));
+      alloc.destroy(buffer + i);
+   }
+}
+
+/***************************************
+ * SMALL VECTOR :: PUSH BACK
+ * Add t to the end, spilling to the heap
+ * when the inline buffer is full
+ **************************************/
+template <typename T, size_t N, typename A, typename G>
+void small_vector <T, N, A, G> :: push_back(const T & t)
+{
+   if (numElements == numCapacity)
+      reserve(G::grow(numCapacity, sizeof(T)));
+
+   alloc.construct(buffer + numElements, t);
+   ++numElements;
+}
+
+template <typename T, size_t N, typename A, typename G>
+void small_vector <T, N, A, G> :: push_back(T && t)
+{
+   if (numElements == numCapacity)
+      reserve(G::grow(numCapacity, sizeof(T)));
+
+   alloc.construct(buffer + numElements, std::move(t));
+   ++numElements;
+}
+
+/***************************************
+ * SMALL VECTOR :: EMPLACE BACK
+ * Construct a new element at the end directly
+ * from args, without a temporary
+ **************************************/
+template <typename T, size_t N, typename A, typename G>
+template <class ... Args>
+T & small_vector <T, N, A, G> :: emplace_back(Args && ... args)
+{
+   if (numElements == numCapacity)
+      reserve(G::grow(numCapacity, sizeof(T)));
+
+   alloc.construct(buffer + numElements, std::forward<Args>(args)...);
+   return buffer[numElements++];
+}
+
+/***************************************
+ * SMALL VECTOR :: INSERT
+ * Insert the range [first, last) before pos, growing
+ * and shifting at most once
+ **************************************/
+template <typename T, size_t N, typename A, typename G>
+template <class Iterator>
+typename small_vector <T, N, A, G> :: iterator
+small_vector <T, N, A, G> :: insert(iterator pos, Iterator first, Iterator last)
+{
+   size_t index = pos.p - buffer;
+   assert(index <= numElements);
+   size_t numInsert = std::distance(first, last);
+   if (numInsert == 0)
+      return iterator(buffer + index);
+
+   growFor(numElements + numInsert);
+   shiftRight(index, numInsert, is_trivially_relocatable<T>());
+
+   for (size_t i = index; first != last; ++first, ++i)
+      alloc.construct(buffer + i, *first);
+   numElements += numInsert;
+
+   return iterator(buffer + index);
+}
+
+/***************************************
+ * SMALL VECTOR :: APPEND
+ * Add the range [first, last) to the end,
+ * growing at most once
+ **************************************/
+template <typename T, size_t N, typename A, typename G>
+template <class Iterator>
+void small_vector <T, N, A, G> :: append(Iterator first, Iterator last)
+{
+   growFor(numElements + std::distance(first, last));
+
+   for (; first != last; ++first)
+      alloc.construct(buffer + numElements++, *first);
+}
+
+/***************************************
+ * SMALL VECTOR :: ASSIGN
+ * Replace the contents with [first, last),
+ * staying inline when they fit
+ **************************************/
+template <typename T, size_t N, typename A, typename G>
+template <class Iterator>
+void small_vector <T, N, A, G> :: assign(Iterator first, Iterator last)
+{
+   clear();
+   reserve(std::distance(first, last));
+
+   for (; first != last; ++first)
+      alloc.construct(buffer + numElements++, *first);
+}
+
+/***************************************
+ * SMALL VECTOR :: GROW FOR
+ * Make sure there is room for numNeeded elements,
+ * growing by at least what the policy asks for
+ **************************************/
+template <typename T, size_t N, typename A, typename G>
+void small_vector <T, N, A, G> :: growFor(size_t numNeeded)
+{
+   if (numNeeded > numCapacity)
+   {
+      size_t numGrow = G::grow(numCapacity, sizeof(T));
+      reserve(numGrow > numNeeded ? numGrow : numNeeded);
+   }
+}
+
+/***************************************
+ * SMALL VECTOR :: SHIFT RIGHT
+ * Move the elements from index to the end up by
+ * numShift, leaving a hole of raw memory at index.
+ * The buffer must already have room.
+ **************************************/
+template <typename T, size_t N, typename A, typename G>
+void small_vector <T, N, A, G> :: shiftRight(size_t index, size_t numShift, std::true_type)
+{
+   if (index < numElements)
+      std::memmove(static_cast<void *>(buffer + index + numShift),
+                   static_cast<const void *>(buffer + index),
+                   (numElements - index) * sizeof(T));
+}
+
+template <typename T, size_t N, typename A, typename G>
+void small_vector <T, N, A, G> :: shiftRight(size_t index, size_t numShift, std::false_type)
+{
+   for (size_t i = numElements; i > index; --i)
+   {
+      alloc.construct(buffer + i - 1 + numShift, std::move(buffer[i - 1]));
+      alloc.destroy(buffer + i - 1);
+   }
+}
+
+} // namespace custom
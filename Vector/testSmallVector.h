@@ -0,0 +1,401 @@
+/***********************************************************************
+ * Header:
+ *    TEST SMALL VECTOR
+ * Summary:
+ *    Unit tests for small_vector
+ * Author
+ *    Peter Benson, Jarom Diaz, Isaac Radford
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include "small_vector.h"
+#include "unitTest.h"
+#include "spy.h"
+
+#include <cassert>
+#include <memory>
+#include <string>
+#include <algorithm>
+
+class TestSmallVector : public UnitTest
+{
+
+public:
+   void run()
+   {
+      reset();
+
+      // Construct
+      test_construct_default();
+      test_construct_sizeFits();
+      test_construct_sizeSpills();
+      test_constructCopy_inline();
+      test_constructMove_inline();
+      test_constructMove_heap();
+
+      // Assign
+      test_swap_inlineHeap();
+
+      // Insert
+      test_pushback_fits();
+      test_pushback_spills();
+      test_emplaceback_inPlace();
+      test_insert_rangeSpills();
+      test_append_fits();
+      test_assign_replaces();
+      test_resize_defaultInit();
+      test_resize_uninitialized();
+
+      // Iterator
+      test_iterator_randomAccess();
+
+      // Remove
+      test_shrink_backInline();
+
+      // Container
+      test_container_stack();
+
+      report("SmallVector");
+   }
+
+   /***************************************
+    * CONSTRUCTOR
+    ***************************************/
+
+   // default constructor points at the inline buffer
+   void test_construct_default()
+   {  // setup
+      Spy::reset();
+      // exercise
+      custom::small_vector<Spy, 4> v;
+      // verify
+      assertUnit(v.isInline());
+      assertUnit(v.numCapacity == 4);
+      assertUnit(v.numElements == 0);
+      assertUnit(Spy::numDefault() == 0);
+      assertUnit(Spy::numAlloc() == 0);
+   }  // teardown
+
+   // a size that fits stays inline
+   void test_construct_sizeFits()
+   {  // setup
+      Spy::reset();
+      // exercise
+      custom::small_vector<Spy, 4> v(3);
+      // verify
+      assertUnit(v.isInline());
+      assertUnit(v.numCapacity == 4);
+      assertUnit(v.numElements == 3);
+      assertUnit(Spy::numDefault() == 3);
+   }  // teardown
+
+   // a size that does not fit goes on the heap
+   void test_construct_sizeSpills()
+   {  // setup
+      Spy::reset();
+      // exercise
+      custom::small_vector<Spy, 4> v(6, Spy(99));
+      // verify
+      assertUnit(!v.isInline());
+      assertUnit(v.numCapacity == 6);
+      assertUnit(v.numElements == 6);
+      assertUnit(Spy::numCopy() == 6);
+      assertUnit(v.buffer[0] == Spy(99));
+      assertUnit(v.buffer[5] == Spy(99));
+   }  // teardown
+
+   // copy an inline small vector
+   void test_constructCopy_inline()
+   {  // setup
+      //      0    1    2    3
+      //    +----+----+----+----+
+      //    | 26 | 49 | 67 |    |
+      //    +----+----+----+----+
+      custom::small_vector<Spy, 4> vSrc{ Spy(26), Spy(49), Spy(67) };
+      Spy::reset();
+      // exercise
+      custom::small_vector<Spy, 4> vDest(vSrc);
+      // verify
+      assertUnit(Spy::numCopy() == 3);
+      assertUnit(Spy::numCopyMove() == 0);
+      assertUnit(vDest.isInline());
+      assertUnit(vDest.numElements == 3);
+      assertUnit(vDest.buffer[0] == Spy(26));
+      assertUnit(vDest.buffer[2] == Spy(67));
+      assertUnit(vSrc.numElements == 3);
+   }  // teardown
+
+   // moving an inline small vector moves each element
+   void test_constructMove_inline()
+   {  // setup
+      custom::small_vector<Spy, 4> vSrc{ Spy(26), Spy(49), Spy(67) };
+      Spy::reset();
+      // exercise
+      custom::small_vector<Spy, 4> vDest(std::move(vSrc));
+      // verify
+      assertUnit(Spy::numCopyMove() == 3);
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(vDest.isInline());
+      assertUnit(vDest.numElements == 3);
+      assertUnit(vDest.buffer[1] == Spy(49));
+      assertUnit(vSrc.isInline());
+      assertUnit(vSrc.numElements == 0);
+   }  // teardown
+
+   // moving a spilled small vector steals the heap buffer
+   void test_constructMove_heap()
+   {  // setup
+      custom::small_vector<Spy, 2> vSrc{ Spy(26), Spy(49), Spy(67) };
+      Spy * buffer = vSrc.buffer;
+      Spy::reset();
+      // exercise
+      custom::small_vector<Spy, 2> vDest(std::move(vSrc));
+      // verify
+      assertUnit(Spy::numCopyMove() == 0);
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(vDest.buffer == buffer);
+      assertUnit(vDest.numElements == 3);
+      assertUnit(vSrc.isInline());
+      assertUnit(vSrc.numCapacity == 2);
+      assertUnit(vSrc.numElements == 0);
+   }  // teardown
+
+   /***************************************
+    * SWAP
+    ***************************************/
+
+   // swap an inline small vector with a spilled one
+   void test_swap_inlineHeap()
+   {  // setup
+      custom::small_vector<Spy, 2> vLHS{ Spy(26) };
+      custom::small_vector<Spy, 2> vRHS{ Spy(49), Spy(67), Spy(89) };
+      // exercise
+      vLHS.swap(vRHS);
+      // verify
+      assertUnit(!vLHS.isInline());
+      assertUnit(vLHS.numElements == 3);
+      assertUnit(vLHS.buffer[0] == Spy(49));
+      assertUnit(vLHS.buffer[2] == Spy(89));
+      assertUnit(vRHS.isInline());
+      assertUnit(vRHS.numElements == 1);
+      assertUnit(vRHS.buffer[0] == Spy(26));
+   }  // teardown
+
+   /***************************************
+    * PUSH BACK
+    ***************************************/
+
+   // push back while there is inline room
+   void test_pushback_fits()
+   {  // setup
+      custom::small_vector<Spy, 4> v;
+      Spy s(26);
+      Spy::reset();
+      // exercise
+      v.push_back(s);
+      v.push_back(Spy(49));
+      // verify
+      assertUnit(v.isInline());
+      assertUnit(v.numElements == 2);
+      assertUnit(v.numCapacity == 4);
+      assertUnit(v.buffer[0] == Spy(26));
+      assertUnit(v.buffer[1] == Spy(49));
+   }  // teardown
+
+   // push back past the inline buffer moves everything to the heap
+   void test_pushback_spills()
+   {  // setup
+      custom::small_vector<Spy, 2> v{ Spy(26), Spy(49) };
+      Spy::reset();
+      // exercise
+      v.push_back(Spy(67));
+      // verify
+      assertUnit(Spy::numCopyMove() == 3);       // move [26,49] and [67]
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(!v.isInline());
+      assertUnit(v.numCapacity == 4);
+      assertUnit(v.numElements == 3);
+      assertUnit(v.buffer[0] == Spy(26));
+      assertUnit(v.buffer[1] == Spy(49));
+      assertUnit(v.buffer[2] == Spy(67));
+   }  // teardown
+
+   // emplace back builds the element where it lives
+   void test_emplaceback_inPlace()
+   {  // setup
+      custom::small_vector<Spy, 2> v;
+      Spy::reset();
+      // exercise
+      Spy & s = v.emplace_back(26);
+      // verify
+      assertUnit(Spy::numNondefault() == 1);
+      assertUnit(Spy::numCopyMove() == 0);
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(&s == v.data());
+      assertUnit(v.numElements == 1);
+      assertUnit(v.buffer[0] == Spy(26));
+   }  // teardown
+
+   /***************************************
+    * RANGES
+    ***************************************/
+
+   // insert a range in the middle, spilling to the heap once
+   void test_insert_rangeSpills()
+   {  // setup
+      //      0    1
+      //    +----+----+
+      //    | 26 | 89 |
+      //    +----+----+
+      custom::small_vector<Spy, 2> v{ Spy(26), Spy(89) };
+      Spy middle[2] = { Spy(49), Spy(67) };
+      // exercise
+      auto it = v.insert(v.begin() + 1, middle, middle + 2);
+      // verify
+      //      0    1    2    3
+      //    +----+----+----+----+
+      //    | 26 | 49 | 67 | 89 |
+      //    +----+----+----+----+
+      assertUnit(!v.isInline());
+      assertUnit(v.numElements == 4);
+      assertUnit(it == v.begin() + 1);
+      assertUnit(v.buffer[0] == Spy(26));
+      assertUnit(v.buffer[1] == Spy(49));
+      assertUnit(v.buffer[2] == Spy(67));
+      assertUnit(v.buffer[3] == Spy(89));
+   }  // teardown
+
+   // append a range that still fits inline
+   void test_append_fits()
+   {  // setup
+      custom::small_vector<int, 4> v{ 26 };
+      int more[3] = { 49, 67, 89 };
+      // exercise
+      v.append(more, more + 3);
+      // verify
+      assertUnit(v.isInline());
+      assertUnit(v.size() == 4);
+      assertUnit(v[3] == 89);
+   }  // teardown
+
+   // assign replaces everything that was there
+   void test_assign_replaces()
+   {  // setup
+      custom::small_vector<Spy, 4> v{ Spy(26), Spy(49), Spy(67) };
+      Spy other[2] = { Spy(11), Spy(99) };
+      // exercise
+      v.assign(other, other + 2);
+      // verify
+      assertUnit(v.isInline());
+      assertUnit(v.numElements == 2);
+      assertUnit(v.buffer[0] == Spy(11));
+      assertUnit(v.buffer[1] == Spy(99));
+   }  // teardown
+
+   // default-init builds each new element once, with its default constructor
+   void test_resize_defaultInit()
+   {  // setup
+      custom::small_vector<Spy, 2> v{ Spy(26) };
+      Spy::reset();
+      // exercise
+      v.resize_default_init(3);
+      // verify
+      assertUnit(Spy::numDefault() == 2);
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(!v.isInline());
+      assertUnit(v.numElements == 3);
+      assertUnit(v.buffer[0] == Spy(26));
+      // exercise
+      v.resize_default_init(1);
+      // verify
+      assertUnit(v.numElements == 1);
+   }  // teardown
+
+   // uninitialized only moves the size, and the slots can then be written
+   void test_resize_uninitialized()
+   {  // setup
+      custom::small_vector<int, 4> v{ 26, 49 };
+      // exercise
+      v.resize_uninitialized(6);
+      for (int i = 2; i < 6; i++)
+         v[i] = i;
+      // verify
+      assertUnit(!v.isInline());
+      assertUnit(v.size() == 6);
+      assertUnit(v[0] == 26);
+      assertUnit(v[1] == 49);
+      assertUnit(v[5] == 5);
+   }  // teardown
+
+   /***************************************
+    * ITERATOR
+    ***************************************/
+
+   // jump with + and -, read through a const_iterator, and sort
+   void test_iterator_randomAccess()
+   {  // setup
+      custom::small_vector<std::string, 2> v{ "dog", "cat", "bird" };
+      // exercise
+      std::sort(v.begin(), v.end());
+      const custom::small_vector<std::string, 2> & vConst = v;
+      custom::small_vector<std::string, 2>::const_iterator it = vConst.cbegin();
+      // verify
+      assertUnit(vConst.cend() - it == 3);
+      assertUnit(*it == "bird");
+      assertUnit(it[1] == "cat");
+      assertUnit((it + 2)->size() == 3);
+      assertUnit(*(vConst.end() - 1) == "dog");
+      assertUnit(v.begin() < v.end());
+      assertUnit(vConst.data() == &v[0]);
+   }  // teardown
+
+   /***************************************
+    * SHRINK TO FIT
+    ***************************************/
+
+   // shrinking a spilled vector that fits again goes back inline
+   void test_shrink_backInline()
+   {  // setup
+      custom::small_vector<Spy, 2> v{ Spy(26), Spy(49), Spy(67) };
+      v.pop_back();
+      // exercise
+      v.shrink_to_fit();
+      // verify
+      assertUnit(v.isInline());
+      assertUnit(v.numCapacity == 2);
+      assertUnit(v.numElements == 2);
+      assertUnit(v.buffer[0] == Spy(26));
+      assertUnit(v.buffer[1] == Spy(49));
+   }  // teardown
+
+   /***************************************
+    * CONTAINER
+    ***************************************/
+
+   // the calls custom::stack makes on its container
+   void test_container_stack()
+   {  // setup
+      custom::small_vector<int, 8> v;
+      v.resize(0);
+      // exercise
+      for (int i = 0; i < 5; i++)
+         v.push_back(i);
+      v.pop_back();
+      // verify
+      assertUnit(v.isInline());
+      assertUnit(v.size() == 4);
+      assertUnit(!v.empty());
+      assertUnit(v.back() == 3);
+      assertUnit(v.front() == 0);
+      int sum = 0;
+      for (auto it = v.begin(); it != v.end(); ++it)
+         sum += *it;
+      assertUnit(sum == 6);
+   }  // teardown
+
+};
+
+#endif // DEBUG
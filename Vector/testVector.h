@@ -18,6 +18,24 @@
 
 #include <cassert>
 #include <memory>
+#include <algorithm>
+
+/*************************************************************
+ * RELOCATABLE SPY
+ * A Spy that promises it can be moved with a byte copy
+ *************************************************************/
+class RelocatableSpy : public Spy
+{
+public:
+   RelocatableSpy(const Spy & rhs) : Spy(rhs) {}
+   RelocatableSpy(Spy && rhs)      : Spy(std::move(rhs)) {}
+};
+
+namespace custom
+{
+   template <>
+   struct is_trivially_relocatable<RelocatableSpy> : std::true_type {};
+}
 
 class TestVector : public UnitTest
 {
@@ -70,6 +88,12 @@ public:
       test_iterator_construct_default();
       test_iterator_construct_pointer();
       test_iterator_construct_index();
+      test_iterator_endPartiallyFilled();
+      test_iterator_randomAccess();
+      test_iterator_difference();
+      test_iterator_sort();
+      test_iterator_constLowerBound();
+      test_data_standard();
 
       // Access
       test_subscript_read();
@@ -87,12 +111,26 @@ public:
       test_pushback_moveEmpty();
       test_pushback_moveExcessCapacity();
       test_pushback_moveRequireReallocate();
+      test_pushback_growthHalf();
+      test_pushback_growthChunk();
+      test_pushback_growthPage();
+      test_emplaceback_empty();
+      test_emplaceback_requireReallocate();
+      test_append_empty();
+      test_append_standard();
+      test_insert_middle();
+      test_insert_front();
+      test_assignRange_shrink();
       test_resize_emptyZero();
       test_resize_emptyFourDefault();
       test_resize_emptyFourValue();
       test_resize_fourZero();
       test_resize_fourSixDefault();
       test_resize_fourSixValue();
+      test_resizeDefault_fourSix();
+      test_resizeDefault_fourZero();
+      test_resizeUninitialized_emptyTen();
+      test_resizeUninitialized_tenFour();
       test_reserve_emptyZero();
       test_reserve_emptyTen();
       test_reserve_fourZero();
@@ -100,6 +138,8 @@ public:
       test_reserve_fourTen();
       test_reserve_standardZero();
       test_reserve_standardTen();
+      test_reserve_trivialTen();
+      test_reserve_relocatableTen();
 
       // Remove
       test_popback_empty();
@@ -178,13 +218,13 @@ public:
       //    +----+----+----+----+
       //    | 00 | 00 | 00 | 00 |
       //    +----+----+----+----+
-      assertUnit(v.data != nullptr);
-      if (v.data)
+      assertUnit(v.buffer != nullptr);
+      if (v.buffer)
       { 
-         assertUnit(v.data[0] == Spy());
-         assertUnit(v.data[1] == Spy());
-         assertUnit(v.data[2] == Spy());
-         assertUnit(v.data[3] == Spy());
+         assertUnit(v.buffer[0] == Spy());
+         assertUnit(v.buffer[1] == Spy());
+         assertUnit(v.buffer[2] == Spy());
+         assertUnit(v.buffer[3] == Spy());
       }
       assertUnit(v.numElements == 4);
       assertUnit(v.numCapacity == 4);
@@ -212,13 +252,13 @@ public:
       //    +----+----+----+----+
       //    | 99 | 99 | 99 | 99 |
       //    +----+----+----+----+
-      assertUnit(v.data != nullptr);
-      if (v.data)
+      assertUnit(v.buffer != nullptr);
+      if (v.buffer)
       { 
-         assertUnit(v.data[0] == Spy(99));
-         assertUnit(v.data[1] == Spy(99));
-         assertUnit(v.data[2] == Spy(99));
-         assertUnit(v.data[3] == Spy(99));
+         assertUnit(v.buffer[0] == Spy(99));
+         assertUnit(v.buffer[1] == Spy(99));
+         assertUnit(v.buffer[2] == Spy(99));
+         assertUnit(v.buffer[3] == Spy(99));
       }
       assertUnit(v.numElements == 4);
       assertUnit(v.numCapacity == 4);
@@ -277,9 +317,9 @@ public:
          //    | 26 | 49 |    |    |
          //    +----+----+----+----+
          custom::vector<Spy> v;
-         v.data = v.alloc.allocate(4);
-         v.alloc.construct(&v.data[0], Spy(99));
-         v.alloc.construct(&v.data[1], Spy(99));
+         v.buffer = v.alloc.allocate(4);
+         v.alloc.construct(&v.buffer[0], Spy(99));
+         v.alloc.construct(&v.buffer[1], Spy(99));
          v.numElements = 2;
          v.numCapacity = 4;
          Spy::reset();
@@ -338,7 +378,7 @@ public:
       assertUnit(Spy::numAssign() == 0);
       assertUnit(Spy::numAssignMove() == 0);
       assertUnit(Spy::numDestructor() == 0);
-      assertUnit(vSrc.data != vDest.data);
+      assertUnit(vSrc.buffer != vDest.buffer);
       //      0    1    2    3
       //    +----+----+----+----+
       //    | 26 | 49 | 67 | 89 |
@@ -362,9 +402,9 @@ public:
       //    | 26 | 49 |    |    |
       //    +----+----+----+----+
       custom::vector<Spy> vSrc;
-      vSrc.data = vSrc.alloc.allocate(4);
-      vSrc.alloc.construct(&vSrc.data[0], Spy(26));
-      vSrc.alloc.construct(&vSrc.data[1], Spy(49));
+      vSrc.buffer = vSrc.alloc.allocate(4);
+      vSrc.alloc.construct(&vSrc.buffer[0], Spy(26));
+      vSrc.alloc.construct(&vSrc.buffer[1], Spy(49));
       vSrc.numElements = 2;
       vSrc.numCapacity = 4;
       Spy::reset();
@@ -384,20 +424,20 @@ public:
       //    +----+----+----+----+
       //    | 26 | 49 |    |    |
       //    +----+----+----+----+
-      assertUnit(vSrc.data != nullptr);
-      assertUnit(vSrc.data[0] == Spy(26));
-      assertUnit(vSrc.data[1] == Spy(49));
+      assertUnit(vSrc.buffer != nullptr);
+      assertUnit(vSrc.buffer[0] == Spy(26));
+      assertUnit(vSrc.buffer[1] == Spy(49));
       assertUnit(vSrc.numElements == 2);
       assertUnit(vSrc.numCapacity == 4);
       //      0    1
       //    +----+----+
       //    | 26 | 49 |
       //    +----+----+
-      assertUnit(vDest.data != nullptr);
-      if (vDest.data)
+      assertUnit(vDest.buffer != nullptr);
+      if (vDest.buffer)
       {
-         assertUnit(vDest.data[0] == Spy(26));
-         assertUnit(vDest.data[1] == Spy(49));
+         assertUnit(vDest.buffer[0] == Spy(26));
+         assertUnit(vDest.buffer[1] == Spy(49));
       }
       assertUnit(vDest.numElements == 2);
       assertUnit(vDest.numCapacity == 2);
@@ -440,7 +480,7 @@ public:
       //    +----+----+----+----+
       custom::vector<Spy> vSrc;
       setupStandardFixture(vSrc);
-      Spy * p = vSrc.data;
+      Spy * p = vSrc.buffer;
       Spy::reset();
       // exercise
       custom::vector<Spy> vDest(std::move(vSrc));
@@ -460,7 +500,7 @@ public:
       //    | 26 | 49 | 67 | 89 |
       //    +----+----+----+----+
       assertStandardFixture(vDest);
-      assertUnit(p == vDest.data);
+      assertUnit(p == vDest.buffer);
       // teardown
       teardownStandardFixture(vSrc);
       teardownStandardFixture(vDest);
@@ -474,9 +514,9 @@ public:
       //    | 26 | 49 |    |    |
       //    +----+----+----+----+
       custom::vector<Spy> vSrc;
-      vSrc.data = vSrc.alloc.allocate(4);
-      vSrc.alloc.construct(&vSrc.data[0], Spy(26));
-      vSrc.alloc.construct(&vSrc.data[1], Spy(49));
+      vSrc.buffer = vSrc.alloc.allocate(4);
+      vSrc.alloc.construct(&vSrc.buffer[0], Spy(26));
+      vSrc.alloc.construct(&vSrc.buffer[1], Spy(49));
       vSrc.numElements = 2;
       vSrc.numCapacity = 4;
       Spy::reset();
@@ -497,11 +537,11 @@ public:
       //    +----+----+----+----+
       //    | 26 | 49 |    |    |
       //    +----+----+----+----+
-      assertUnit(vDest.data != nullptr);
-      if (vDest.data)
+      assertUnit(vDest.buffer != nullptr);
+      if (vDest.buffer)
       {
-         assertUnit(vDest.data[0] == Spy(26));
-         assertUnit(vDest.data[1] == Spy(49));
+         assertUnit(vDest.buffer[0] == Spy(26));
+         assertUnit(vDest.buffer[1] == Spy(49));
       }
       assertUnit(vDest.numElements == 2);
       assertUnit(vDest.numCapacity == 4);
@@ -699,10 +739,10 @@ public:
       //    +----+----+----+----+----+----+
       assertUnit(v.numCapacity == 6);
       assertUnit(v.numElements == 6);
-      if (v.data)
+      if (v.buffer)
       {
-         assertUnit(v.data[4] == Spy());
-         assertUnit(v.data[5] == Spy());
+         assertUnit(v.buffer[4] == Spy());
+         assertUnit(v.buffer[5] == Spy());
       }
       v.numCapacity = 4;
       v.numElements = 4;
@@ -740,10 +780,10 @@ public:
       //    +----+----+----+----+----+----+
       assertUnit(v.numCapacity == 6);
       assertUnit(v.numElements == 6);
-      if (v.data && v.numElements >= 6)
+      if (v.buffer && v.numElements >= 6)
       {
-         assertUnit(v.data[4] == Spy(99));
-         assertUnit(v.data[5] == Spy(99));
+         assertUnit(v.buffer[4] == Spy(99));
+         assertUnit(v.buffer[5] == Spy(99));
       }
       v.numCapacity = 4;
       v.numElements = 4;
@@ -752,6 +792,91 @@ public:
       teardownStandardFixture(v);
    }
    
+   // default-init two new elements onto the standard fixture
+   void test_resizeDefault_fourSix()
+   {  // setup
+      //      0    1    2    3
+      //    +----+----+----+----+
+      //    | 26 | 49 | 67 | 89 |
+      //    +----+----+----+----+
+      custom::vector<Spy> v;
+      setupStandardFixture(v);
+      Spy::reset();
+      // exercise
+      v.resize_default_init(6);
+      // verify
+      assertUnit(Spy::numDefault() == 2);      // default-construct [ ][ ]
+      assertUnit(Spy::numCopyMove() == 4);     // move [26,49,67,89]
+      assertUnit(Spy::numDestructor() == 4);   // destroy empty [26,49,67,89]
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numAlloc() == 0);
+      assertUnit(Spy::numNondefault() == 0);
+      //      0    1    2    3    4    5
+      //    +----+----+----+----+----+----+
+      //    | 26 | 49 | 67 | 89 |    |    |
+      //    +----+----+----+----+----+----+
+      assertUnit(v.numCapacity == 6);
+      assertUnit(v.numElements == 6);
+      if (v.buffer && v.numElements >= 6)
+      {
+         assertUnit(v.buffer[4].empty());
+         assertUnit(v.buffer[5].empty());
+      }
+      v.pop_back();
+      v.pop_back();
+      v.numCapacity = 4;
+      assertStandardFixture(v);
+      // teardown
+      teardownStandardFixture(v);
+   }
+
+   // default-init resize can also shrink
+   void test_resizeDefault_fourZero()
+   {  // setup
+      //      0    1    2    3
+      //    +----+----+----+----+
+      //    | 26 | 49 | 67 | 89 |
+      //    +----+----+----+----+
+      custom::vector<Spy> v;
+      setupStandardFixture(v);
+      Spy::reset();
+      // exercise
+      v.resize_default_init(0);
+      // verify
+      assertUnit(Spy::numDestructor() == 4);   // destroy [26,49,67,89]
+      assertUnit(Spy::numDelete() == 4);       // delete [26,49,67,89]
+      assertUnit(Spy::numDefault() == 0);
+      assertUnit(v.numCapacity == 4);
+      assertUnit(v.numElements == 0);
+      // teardown
+      teardownStandardFixture(v);
+   }
+
+   // grow a byte buffer without writing to it
+   void test_resizeUninitialized_emptyTen()
+   {  // setup
+      custom::vector<char> v;
+      // exercise
+      v.resize_uninitialized(10);
+      // verify
+      assertUnit(v.numCapacity == 10);
+      assertUnit(v.numElements == 10);
+      assertUnit(v.buffer != nullptr);
+   }  // teardown
+
+   // shrink a byte buffer, keeping the capacity
+   void test_resizeUninitialized_tenFour()
+   {  // setup
+      custom::vector<char> v(10, 'x');
+      // exercise
+      v.resize_uninitialized(4);
+      // verify
+      assertUnit(v.numCapacity == 10);
+      assertUnit(v.numElements == 4);
+      if (v.buffer)
+         assertUnit(v.buffer[3] == 'x');
+   }  // teardown
+
    // reserve zero on an empty vector
    void test_reserve_emptyZero()
    {  // setup
@@ -808,7 +933,7 @@ public:
       //    |    |    |    |    |
       //    +----+----+----+----+
       custom::vector<Spy> v;
-      v.data = v.alloc.allocate(4);
+      v.buffer = v.alloc.allocate(4);
       v.numElements = 0;
       v.numCapacity = 4;
       Spy::reset();
@@ -842,7 +967,7 @@ public:
       //    |    |    |    |    |
       //    +----+----+----+----+
       custom::vector<Spy> v;
-      v.data = v.alloc.allocate(4);
+      v.buffer = v.alloc.allocate(4);
       v.numElements = 0;
       v.numCapacity = 4;
       Spy::reset();
@@ -876,7 +1001,7 @@ public:
       //    |    |    |    |    |
       //    +----+----+----+----+
       custom::vector<Spy> v;
-      v.data = v.alloc.allocate(4);
+      v.buffer = v.alloc.allocate(4);
       v.numElements = 0;
       v.numCapacity = 4;
       Spy::reset();
@@ -967,6 +1092,91 @@ public:
       teardownStandardFixture(v);
    }
    
+   // reserve on a trivially relocatable type moves the block at once
+   void test_reserve_trivialTen()
+   {  // setup
+      //      0    1    2    3
+      //    +----+----+----+----+
+      //    | 26 | 49 | 67 | 89 |
+      //    +----+----+----+----+
+      custom::vector<int> v;
+      v.buffer = v.alloc.allocate(4);
+      v.buffer[0] = 26;
+      v.buffer[1] = 49;
+      v.buffer[2] = 67;
+      v.buffer[3] = 89;
+      v.numElements = 4;
+      v.numCapacity = 4;
+      // exercise
+      v.reserve(10);
+      // verify
+      //      0    1    2    3    4    5    6    7    8    9
+      //    +----+----+----+----+----+----+----+----+----+----+
+      //    | 26 | 49 | 67 | 89 |    |    |    |    |    |    |
+      //    +----+----+----+----+----+----+----+----+----+----+
+      assertUnit(custom::is_trivially_relocatable<int>::value);
+      assertUnit(v.numCapacity == 10);
+      assertUnit(v.numElements == 4);
+      if (v.buffer)
+      {
+         assertUnit(v.buffer[0] == 26);
+         assertUnit(v.buffer[1] == 49);
+         assertUnit(v.buffer[2] == 67);
+         assertUnit(v.buffer[3] == 89);
+      }
+      // teardown
+      v.alloc.deallocate(v.buffer, v.numCapacity);
+      v.buffer = nullptr;
+      v.numElements = v.numCapacity = 0;
+   }
+
+   // a type that opts in is relocated without calling its move constructor
+   void test_reserve_relocatableTen()
+   {  // setup
+      //      0    1    2    3
+      //    +----+----+----+----+
+      //    | 26 | 49 | 67 | 89 |
+      //    +----+----+----+----+
+      custom::vector<RelocatableSpy> v;
+      v.buffer = v.alloc.allocate(4);
+      v.alloc.construct(&v.buffer[0], Spy(26));
+      v.alloc.construct(&v.buffer[1], Spy(49));
+      v.alloc.construct(&v.buffer[2], Spy(67));
+      v.alloc.construct(&v.buffer[3], Spy(89));
+      v.numElements = 4;
+      v.numCapacity = 4;
+      Spy::reset();
+      // exercise
+      v.reserve(10);
+      // verify
+      assertUnit(!custom::is_trivially_relocatable<Spy>::value);
+      assertUnit(custom::is_trivially_relocatable<RelocatableSpy>::value);
+      assertUnit(Spy::numCopyMove() == 0);
+      assertUnit(Spy::numDestructor() == 0);
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numAlloc() == 0);
+      assertUnit(Spy::numDelete() == 0);
+      //      0    1    2    3    4    5    6    7    8    9
+      //    +----+----+----+----+----+----+----+----+----+----+
+      //    | 26 | 49 | 67 | 89 |    |    |    |    |    |    |
+      //    +----+----+----+----+----+----+----+----+----+----+
+      assertUnit(v.numCapacity == 10);
+      assertUnit(v.numElements == 4);
+      if (v.buffer)
+      {
+         assertUnit(v.buffer[0] == Spy(26));
+         assertUnit(v.buffer[1] == Spy(49));
+         assertUnit(v.buffer[2] == Spy(67));
+         assertUnit(v.buffer[3] == Spy(89));
+      }
+      // teardown
+      for (size_t i = 0; i < v.numElements; i++)
+         v.alloc.destroy(&v.buffer[i]);
+      v.alloc.deallocate(v.buffer, v.numCapacity);
+      v.buffer = nullptr;
+      v.numElements = v.numCapacity = 0;
+   }
+
    // shrink an empty fixture
    void test_shrink_empty()
    {  // setup
@@ -995,7 +1205,7 @@ public:
       //    |    |    |    |    |
       //    +----+----+----+----+
       custom::vector<Spy> v;
-      v.data = v.alloc.allocate(4);
+      v.buffer = v.alloc.allocate(4);
       v.numElements = 0;
       v.numCapacity = 4;
       Spy::reset();
@@ -1049,11 +1259,11 @@ public:
       //    | 26 | 49 | 67 | 89 |    |    |
       //    +----+----+----+----+----+----+
       custom::vector<Spy> v;
-      v.data = v.alloc.allocate(6);
-      v.alloc.construct(&v.data[0], Spy(26));
-      v.alloc.construct(&v.data[1], Spy(49));
-      v.alloc.construct(&v.data[2], Spy(67));
-      v.alloc.construct(&v.data[3], Spy(89));
+      v.buffer = v.alloc.allocate(6);
+      v.alloc.construct(&v.buffer[0], Spy(26));
+      v.alloc.construct(&v.buffer[1], Spy(49));
+      v.alloc.construct(&v.buffer[2], Spy(67));
+      v.alloc.construct(&v.buffer[3], Spy(89));
       v.numElements = 4;
       v.numCapacity = 6;
       Spy::reset();
@@ -1213,15 +1423,15 @@ public:
       //    +----+----+----+----+
       custom::vector<Spy> vDest;
       setupStandardFixture(vDest);
-      vDest.data[0] = Spy(99);
-      vDest.data[1] = Spy(99);
-      vDest.data[2] = Spy(99);
-      vDest.data[3] = Spy(99);
+      vDest.buffer[0] = Spy(99);
+      vDest.buffer[1] = Spy(99);
+      vDest.buffer[2] = Spy(99);
+      vDest.buffer[3] = Spy(99);
       Spy::reset();
       // exercise
       vDest.swap(vSrc);
       // verify
-      assert(vDest.data != vSrc.data);
+      assert(vDest.buffer != vSrc.buffer);
       assertUnit(Spy::numAssign() == 0);   
       assertUnit(Spy::numAlloc() == 0);
       assertUnit(Spy::numDelete() == 0);
@@ -1237,13 +1447,13 @@ public:
       //    +----+----+----+----+
       assertUnit(vSrc.numCapacity == 4);
       assertUnit(vSrc.numElements == 4);
-      assertUnit(vSrc.data != nullptr);
-      if (vSrc.data)
+      assertUnit(vSrc.buffer != nullptr);
+      if (vSrc.buffer)
       {
-         assertUnit(vSrc.data[0] == Spy(99));
-         assertUnit(vSrc.data[1] == Spy(99));
-         assertUnit(vSrc.data[2] == Spy(99));
-         assertUnit(vSrc.data[3] == Spy(99));
+         assertUnit(vSrc.buffer[0] == Spy(99));
+         assertUnit(vSrc.buffer[1] == Spy(99));
+         assertUnit(vSrc.buffer[2] == Spy(99));
+         assertUnit(vSrc.buffer[3] == Spy(99));
       }
       //      0    1    2    3
       //    +----+----+----+----+
@@ -1269,16 +1479,16 @@ public:
       //    | 99 | 99 |
       //    +----+----+
       custom::vector<Spy> vDest;
-      vDest.data = vDest.alloc.allocate(2);
-      vDest.alloc.construct(&vDest.data[0], Spy(99));
-      vDest.alloc.construct(&vDest.data[1], Spy(99));
+      vDest.buffer = vDest.alloc.allocate(2);
+      vDest.alloc.construct(&vDest.buffer[0], Spy(99));
+      vDest.alloc.construct(&vDest.buffer[1], Spy(99));
       vDest.numElements = 2;
       vDest.numCapacity = 2;
       Spy::reset();
       // exercise
       vDest.swap(vSrc);
       // verify
-      assert(vDest.data != vSrc.data);
+      assert(vDest.buffer != vSrc.buffer);
       assertUnit(Spy::numCopy() == 0);       
       assertUnit(Spy::numAlloc() == 0);      
       assertUnit(Spy::numDestructor() == 0); 
@@ -1294,11 +1504,11 @@ public:
       //    +----+----+
       assertUnit(vSrc.numCapacity == 2);
       assertUnit(vSrc.numElements == 2);
-      assertUnit(vSrc.data != nullptr);
-      if (vSrc.data)
+      assertUnit(vSrc.buffer != nullptr);
+      if (vSrc.buffer)
       {
-         assertUnit(vSrc.data[0] == Spy(99));
-         assertUnit(vSrc.data[1] == Spy(99));
+         assertUnit(vSrc.buffer[0] == Spy(99));
+         assertUnit(vSrc.buffer[1] == Spy(99));
       }
       //      0    1    2    3
       //    +----+----+----+----+
@@ -1318,9 +1528,9 @@ public:
       //    | 99 | 99 |
       //    +----+----+
       custom::vector<Spy> vSrc;
-      vSrc.data = vSrc.alloc.allocate(2);
-      vSrc.alloc.construct(&vSrc.data[0], Spy(99));
-      vSrc.alloc.construct(&vSrc.data[1], Spy(99));
+      vSrc.buffer = vSrc.alloc.allocate(2);
+      vSrc.alloc.construct(&vSrc.buffer[0], Spy(99));
+      vSrc.alloc.construct(&vSrc.buffer[1], Spy(99));
       vSrc.numElements = 2;
       vSrc.numCapacity = 2;
       //      0    1    2    3
@@ -1333,7 +1543,7 @@ public:
       // exercise
       vDest.swap(vSrc);
       // verify
-      assert(vDest.data != vSrc.data);
+      assert(vDest.buffer != vSrc.buffer);
       assertUnit(Spy::numAssign() == 0); 
       assertUnit(Spy::numDestructor() == 0);
       assertUnit(Spy::numDelete() == 0);    
@@ -1354,11 +1564,11 @@ public:
       //    +----+----+
       assertUnit(vDest.numCapacity == 2);
       assertUnit(vDest.numElements == 2);
-      assertUnit(vDest.data != nullptr);
-      if (vDest.data)
+      assertUnit(vDest.buffer != nullptr);
+      if (vDest.buffer)
       {
-         assertUnit(vDest.data[0] == Spy(99));
-         assertUnit(vDest.data[1] == Spy(99));
+         assertUnit(vDest.buffer[0] == Spy(99));
+         assertUnit(vDest.buffer[1] == Spy(99));
       }
       // teardown
       teardownStandardFixture(vSrc);
@@ -1407,15 +1617,15 @@ public:
       //    +----+----+----+----+
       custom::vector<Spy> vDest;
       setupStandardFixture(vDest);
-      vDest.data[0] = Spy(99);
-      vDest.data[1] = Spy(99);
-      vDest.data[2] = Spy(99);
-      vDest.data[3] = Spy(99);
+      vDest.buffer[0] = Spy(99);
+      vDest.buffer[1] = Spy(99);
+      vDest.buffer[2] = Spy(99);
+      vDest.buffer[3] = Spy(99);
       Spy::reset();
       // exercise
       vDest = vSrc;
       // verify
-      assert(vDest.data != vSrc.data);
+      assert(vDest.buffer != vSrc.buffer);
       assertUnit(Spy::numAssign() == 4);      // assign [26,49,67,89]
       assertUnit(Spy::numAlloc() == 0);
       assertUnit(Spy::numDelete() == 0);
@@ -1454,16 +1664,16 @@ public:
       //    | 99 | 99 |
       //    +----+----+
       custom::vector<Spy> vDest;
-      vDest.data = vDest.alloc.allocate(2);
-      vDest.alloc.construct(&vDest.data[0], Spy(99));
-      vDest.alloc.construct(&vDest.data[1], Spy(99));
+      vDest.buffer = vDest.alloc.allocate(2);
+      vDest.alloc.construct(&vDest.buffer[0], Spy(99));
+      vDest.alloc.construct(&vDest.buffer[1], Spy(99));
       vDest.numElements = 2;
       vDest.numCapacity = 2;
       Spy::reset();
       // exercise
       vDest = vSrc;
       // verify
-      assert(vDest.data != vSrc.data);
+      assert(vDest.buffer != vSrc.buffer);
       assertUnit(Spy::numCopy() == 4);       // copy [26,49,67,89] from src to dest
       assertUnit(Spy::numAlloc() == 4);      // the copy involves a new buffer for [26,49,67,89]
       assertUnit(Spy::numDestructor() == 2); // destroy [99,99]
@@ -1496,9 +1706,9 @@ public:
       //    | 99 | 99 |
       //    +----+----+
       custom::vector<Spy> vSrc;
-      vSrc.data = vSrc.alloc.allocate(2);
-      vSrc.alloc.construct(&vSrc.data[0], Spy(99));
-      vSrc.alloc.construct(&vSrc.data[1], Spy(99));
+      vSrc.buffer = vSrc.alloc.allocate(2);
+      vSrc.alloc.construct(&vSrc.buffer[0], Spy(99));
+      vSrc.alloc.construct(&vSrc.buffer[1], Spy(99));
       vSrc.numElements = 2;
       vSrc.numCapacity = 2;
       //      0    1    2    3
@@ -1511,7 +1721,7 @@ public:
       // exercise
       vDest = vSrc;
       // verify
-      assert(vDest.data != vSrc.data);
+      assert(vDest.buffer != vSrc.buffer);
       assertUnit(Spy::numAssign() == 2);     // assign [99,99] into dest
       assertUnit(Spy::numDestructor() == 2); // destroy [67,89]
       assertUnit(Spy::numDelete() == 2);     // delete [67,89]
@@ -1527,11 +1737,11 @@ public:
       //    +----+----+
       assertUnit(vSrc.numCapacity == 2);
       assertUnit(vSrc.numElements == 2);
-      assertUnit(vSrc.data != nullptr);
-      if (vSrc.data)
+      assertUnit(vSrc.buffer != nullptr);
+      if (vSrc.buffer)
       {
-         assertUnit(vSrc.data[0] == Spy(99));
-         assertUnit(vSrc.data[1] == Spy(99));
+         assertUnit(vSrc.buffer[0] == Spy(99));
+         assertUnit(vSrc.buffer[1] == Spy(99));
       }
       //      0    1    2    3
       //    +----+----+----+----+
@@ -1539,11 +1749,11 @@ public:
       //    +----+----+----+----+
       assertUnit(vDest.numCapacity == 4);
       assertUnit(vDest.numElements == 2);
-      assertUnit(vDest.data != nullptr);
-      if (vDest.data)
+      assertUnit(vDest.buffer != nullptr);
+      if (vDest.buffer)
       {
-         assertUnit(vDest.data[0] == Spy(99));
-         assertUnit(vDest.data[1] == Spy(99));
+         assertUnit(vDest.buffer[0] == Spy(99));
+         assertUnit(vDest.buffer[1] == Spy(99));
       }
       // teardown
       teardownStandardFixture(vSrc);
@@ -1587,15 +1797,15 @@ public:
       //    +----+----+----+----+
       custom::vector<Spy> vDest;
       setupStandardFixture(vDest);
-      vDest.data[0] = Spy(99);
-      vDest.data[1] = Spy(99);
-      vDest.data[2] = Spy(99);
-      vDest.data[3] = Spy(99);
+      vDest.buffer[0] = Spy(99);
+      vDest.buffer[1] = Spy(99);
+      vDest.buffer[2] = Spy(99);
+      vDest.buffer[3] = Spy(99);
       Spy::reset();
       // exercise
       vDest = std::move(vSrc);
       // verify
-      assert(vDest.data != vSrc.data);
+      assert(vDest.buffer != vSrc.buffer);
       assertUnit(Spy::numDestructor() == 4);  // destroy [99,99,99,99]
       assertUnit(Spy::numDelete() == 4);      // delete  [99,99,99,99]
       assertUnit(Spy::numAssign() == 0);
@@ -1630,16 +1840,16 @@ public:
       //    | 99 | 99 |
       //    +----+----+
       custom::vector<Spy> vDest;
-      vDest.data = vDest.alloc.allocate(2);
-      vDest.alloc.construct(&vDest.data[0], Spy(99));
-      vDest.alloc.construct(&vDest.data[1], Spy(99));
+      vDest.buffer = vDest.alloc.allocate(2);
+      vDest.alloc.construct(&vDest.buffer[0], Spy(99));
+      vDest.alloc.construct(&vDest.buffer[1], Spy(99));
       vDest.numElements = 2;
       vDest.numCapacity = 2;
       Spy::reset();
       // exercise
       vDest = std::move(vSrc);
       // verify
-      assert(vDest.data != vSrc.data);
+      assert(vDest.buffer != vSrc.buffer);
       assertUnit(Spy::numDestructor() == 2); // destroy [99,99]
       assertUnit(Spy::numDelete() == 2);     // delete [99,99]
       assertUnit(Spy::numCopy() == 0);
@@ -1668,9 +1878,9 @@ public:
       //    | 99 | 99 |
       //    +----+----+
       custom::vector<Spy> vSrc;
-      vSrc.data = vSrc.alloc.allocate(2);
-      vSrc.alloc.construct(&vSrc.data[0], Spy(99));
-      vSrc.alloc.construct(&vSrc.data[1], Spy(99));
+      vSrc.buffer = vSrc.alloc.allocate(2);
+      vSrc.alloc.construct(&vSrc.buffer[0], Spy(99));
+      vSrc.alloc.construct(&vSrc.buffer[1], Spy(99));
       vSrc.numElements = 2;
       vSrc.numCapacity = 2;
       //      0    1    2    3
@@ -1683,7 +1893,7 @@ public:
       // exercise
       vDest = std::move(vSrc);
       // verify
-      assert(vDest.data != vSrc.data);
+      assert(vDest.buffer != vSrc.buffer);
       assertUnit(Spy::numDestructor() == 4); // destroy [26,49,67,89]
       assertUnit(Spy::numDelete() == 4);     // delete [26,49,67,89]
       assertUnit(Spy::numAssign() == 0);
@@ -1699,11 +1909,11 @@ public:
       //    +----+----+
       assertUnit(vDest.numCapacity == 2);
       assertUnit(vDest.numElements == 2);
-      assertUnit(vDest.data != nullptr);
-      if (vDest.data)
+      assertUnit(vDest.buffer != nullptr);
+      if (vDest.buffer)
       {
-         assertUnit(vDest.data[0] == Spy(99));
-         assertUnit(vDest.data[1] == Spy(99));
+         assertUnit(vDest.buffer[0] == Spy(99));
+         assertUnit(vDest.buffer[1] == Spy(99));
       }
       assertEmptyFixture(vSrc);
       // teardown
@@ -1725,9 +1935,9 @@ public:
       custom::vector<Spy> vDes;
       try
       {
-         vDes.data = vDes.alloc.allocate(4);
-         vDes.alloc.construct(&vDes.data[0], Spy(11));
-         vDes.alloc.construct(&vDes.data[1], Spy(99));
+         vDes.buffer = vDes.alloc.allocate(4);
+         vDes.alloc.construct(&vDes.buffer[0], Spy(11));
+         vDes.alloc.construct(&vDes.buffer[1], Spy(99));
          vDes.numElements = 2;
          vDes.numCapacity = 4;
       }
@@ -1769,9 +1979,9 @@ public:
       custom::vector<Spy> vDes;
       try
       {
-         vDes.data = vDes.alloc.allocate(4);
-         vDes.alloc.construct(&vDes.data[0], Spy(11));
-         vDes.alloc.construct(&vDes.data[1], Spy(99));
+         vDes.buffer = vDes.alloc.allocate(4);
+         vDes.alloc.construct(&vDes.buffer[0], Spy(11));
+         vDes.alloc.construct(&vDes.buffer[1], Spy(99));
          vDes.numElements = 2;
          vDes.numCapacity = 4;
       }
@@ -1860,8 +2070,8 @@ public:
       //    +----+----+----+----+
       //    | 26 | 99 | 67 | 89 |
       //    +----+----+----+----+
-      assertUnit(v.data[1] == Spy(99));
-      v.data[1] = Spy(49);
+      assertUnit(v.buffer[1] == Spy(99));
+      v.buffer[1] = Spy(49);
       assertStandardFixture(v);
       // teardown
       teardownStandardFixture(v);
@@ -1924,11 +2134,11 @@ public:
       //    +----+----+----+----+
       //    | 99 | 49 | 67 | 89 |
       //    +----+----+----+----+
-      assertUnit(v.data != nullptr);
-      if (v.data)
+      assertUnit(v.buffer != nullptr);
+      if (v.buffer)
       { 
-         assertUnit(v.data[0] == Spy(99));
-         v.data[0] = Spy(26);
+         assertUnit(v.buffer[0] == Spy(99));
+         v.buffer[0] = Spy(26);
       }
       assertStandardFixture(v);
       // teardown
@@ -1991,11 +2201,11 @@ public:
       //    +----+----+----+----+
       //    | 26 | 49 | 67 | 99 |
       //    +----+----+----+----+
-      assertUnit(v.data != nullptr);
-      if (v.data)
+      assertUnit(v.buffer != nullptr);
+      if (v.buffer)
       {
-         assertUnit(v.data[3] == Spy(99));
-         v.data[3] = Spy(89);
+         assertUnit(v.buffer[3] == Spy(99));
+         v.buffer[3] = Spy(89);
       }
       assertStandardFixture(v);
       // teardown
@@ -2012,9 +2222,9 @@ public:
       custom::vector<Spy> v;
       try
       {
-         v.data = v.alloc.allocate(4);
-         v.alloc.construct(&v.data[0], Spy(11));
-         v.alloc.construct(&v.data[1], Spy(22));
+         v.buffer = v.alloc.allocate(4);
+         v.alloc.construct(&v.buffer[0], Spy(11));
+         v.alloc.construct(&v.buffer[1], Spy(22));
          v.numElements = 2;
          v.numCapacity = 4;
       }
@@ -2039,11 +2249,11 @@ public:
       assertUnit(value == Spy(22));
       assertUnit(v.numCapacity == 4);
       assertUnit(v.numElements == 2);
-      assertUnit(v.data != nullptr);
-      if (v.data)
+      assertUnit(v.buffer != nullptr);
+      if (v.buffer)
       {
-         assertUnit(v.data[0] == Spy(11));
-         assertUnit(v.data[1] == Spy(22));
+         assertUnit(v.buffer[0] == Spy(11));
+         assertUnit(v.buffer[1] == Spy(22));
       }
       // teardown
       teardownStandardFixture(v);
@@ -2102,12 +2312,12 @@ public:
       //    +----+----+----+----+
       assertUnit(v.numCapacity == 4);
       assertUnit(v.numElements == 3);
-      assertUnit(v.data != nullptr);
-      if (v.data != nullptr)
+      assertUnit(v.buffer != nullptr);
+      if (v.buffer != nullptr)
       {
-         assertUnit(v.data[0] == Spy(26));
-         assertUnit(v.data[1] == Spy(49));
-         assertUnit(v.data[2] == Spy(67));
+         assertUnit(v.buffer[0] == Spy(26));
+         assertUnit(v.buffer[1] == Spy(49));
+         assertUnit(v.buffer[2] == Spy(67));
       }
       // teardown
       teardownStandardFixture(v);
@@ -2121,9 +2331,9 @@ public:
       //    | 26 | 49 |    |    |
       //    +----+----+----+----+
       custom::vector<Spy> v;
-      v.data = v.alloc.allocate(4);
-      v.alloc.construct(&v.data[0], Spy(26));
-      v.alloc.construct(&v.data[1], Spy(49));
+      v.buffer = v.alloc.allocate(4);
+      v.alloc.construct(&v.buffer[0], Spy(26));
+      v.alloc.construct(&v.buffer[1], Spy(49));
       v.numElements = 2;
       v.numCapacity = 4;
       Spy::reset();
@@ -2145,10 +2355,10 @@ public:
       //    +----+----+----+----+
       assertUnit(v.numCapacity == 4);
       assertUnit(v.numElements == 1);
-      assertUnit(v.data != nullptr);
-      if (v.data != nullptr)
+      assertUnit(v.buffer != nullptr);
+      if (v.buffer != nullptr)
       {
-         assertUnit(v.data[0] == Spy(26));
+         assertUnit(v.buffer[0] == Spy(26));
       }      // teardown
       teardownStandardFixture(v);
    }
@@ -2205,7 +2415,7 @@ public:
       //    +----+----+----+----+
       assertUnit(v.numCapacity == 4);
       assertUnit(v.numElements == 0);
-      assertUnit(v.data != nullptr);
+      assertUnit(v.buffer != nullptr);
       // teardown
       teardownStandardFixture(v);
    }
@@ -2218,9 +2428,9 @@ public:
       //    | 26 | 49 |    |    |
       //    +----+----+----+----+
       custom::vector<Spy> v;
-      v.data = v.alloc.allocate(4);
-      v.alloc.construct(&v.data[0], Spy(26));
-      v.alloc.construct(&v.data[1], Spy(49));
+      v.buffer = v.alloc.allocate(4);
+      v.alloc.construct(&v.buffer[0], Spy(26));
+      v.alloc.construct(&v.buffer[1], Spy(49));
       v.numElements = 2;
       v.numCapacity = 4;
       Spy::reset();
@@ -2242,7 +2452,7 @@ public:
       //    +----+----+----+----+
       assertUnit(v.numCapacity == 4);
       assertUnit(v.numElements == 0);
-      assertUnit(v.data != nullptr);
+      assertUnit(v.buffer != nullptr);
       // teardown
       teardownStandardFixture(v);
    }
@@ -2274,9 +2484,9 @@ public:
       //    +----+
       //    | 99 |
       //    +----+
-      assertUnit(v.data != nullptr);
-      if (v.data)
-         assertUnit(v.data[0] == Spy(99));
+      assertUnit(v.buffer != nullptr);
+      if (v.buffer)
+         assertUnit(v.buffer[0] == Spy(99));
       assertUnit(v.numCapacity == 1);
       assertUnit(v.numElements == 1);
       // teardown
@@ -2291,10 +2501,10 @@ public:
       //    | 26 | 49 | 67 |    |
       //    +----+----+----+----+
       custom::vector<Spy> v;
-      v.data = v.alloc.allocate(4);
-      v.alloc.construct(&v.data[0], Spy(26));
-      v.alloc.construct(&v.data[1], Spy(49));
-      v.alloc.construct(&v.data[2], Spy(67));
+      v.buffer = v.alloc.allocate(4);
+      v.alloc.construct(&v.buffer[0], Spy(26));
+      v.alloc.construct(&v.buffer[1], Spy(49));
+      v.alloc.construct(&v.buffer[2], Spy(67));
       v.numElements = 3;
       v.numCapacity = 4;
       Spy s(89);
@@ -2328,10 +2538,10 @@ public:
       //    | 26 | 49 | 67 |
       //    +----+----+----+
       custom::vector<Spy> v;
-      v.data = v.alloc.allocate(3);
-      v.alloc.construct(&v.data[0], Spy(26));
-      v.alloc.construct(&v.data[1], Spy(49));
-      v.alloc.construct(&v.data[2], Spy(67));
+      v.buffer = v.alloc.allocate(3);
+      v.alloc.construct(&v.buffer[0], Spy(26));
+      v.alloc.construct(&v.buffer[1], Spy(49));
+      v.alloc.construct(&v.buffer[2], Spy(67));
       v.numElements = 3;
       v.numCapacity = 3;
       Spy s(99);
@@ -2352,13 +2562,13 @@ public:
       //    +----+----+----+----+----+----+
       //    | 26 | 49 | 67 | 99 |    |    |
       //    +----+----+----+----+----+----+
-      assertUnit(v.data != nullptr);
-      if (v.data && v.numElements >= 4)
+      assertUnit(v.buffer != nullptr);
+      if (v.buffer && v.numElements >= 4)
       {
-         assertUnit(v.data[0] == Spy(26));
-         assertUnit(v.data[1] == Spy(49));
-         assertUnit(v.data[2] == Spy(67));
-         assertUnit(v.data[3] == Spy(99));
+         assertUnit(v.buffer[0] == Spy(26));
+         assertUnit(v.buffer[1] == Spy(49));
+         assertUnit(v.buffer[2] == Spy(67));
+         assertUnit(v.buffer[3] == Spy(99));
       }
       assertUnit(v.numCapacity == 6);
       assertUnit(v.numElements == 4);
@@ -2388,9 +2598,9 @@ public:
       //    +----+
       //    | 99 |
       //    +----+
-      assertUnit(v.data != nullptr);
-      if (v.data)
-         assertUnit(v.data[0] == Spy(99));
+      assertUnit(v.buffer != nullptr);
+      if (v.buffer)
+         assertUnit(v.buffer[0] == Spy(99));
       assertUnit(v.numCapacity == 1);
       assertUnit(v.numElements == 1);
       assertUnit(s == Spy());
@@ -2406,10 +2616,10 @@ public:
      //    | 26 | 49 | 67 |    |
      //    +----+----+----+----+
       custom::vector<Spy> v;
-      v.data = v.alloc.allocate(4);
-      v.alloc.construct(&v.data[0], Spy(26));
-      v.alloc.construct(&v.data[1], Spy(49));
-      v.alloc.construct(&v.data[2], Spy(67));
+      v.buffer = v.alloc.allocate(4);
+      v.alloc.construct(&v.buffer[0], Spy(26));
+      v.alloc.construct(&v.buffer[1], Spy(49));
+      v.alloc.construct(&v.buffer[2], Spy(67));
       v.numElements = 3;
       v.numCapacity = 4;
       Spy s(89);
@@ -2443,10 +2653,10 @@ public:
       //    | 26 | 49 | 67 |
       //    +----+----+----+
       custom::vector<Spy> v;
-      v.data = v.alloc.allocate(3);
-      v.alloc.construct(&v.data[0], Spy(26));
-      v.alloc.construct(&v.data[1], Spy(49));
-      v.alloc.construct(&v.data[2], Spy(67));
+      v.buffer = v.alloc.allocate(3);
+      v.alloc.construct(&v.buffer[0], Spy(26));
+      v.alloc.construct(&v.buffer[1], Spy(49));
+      v.alloc.construct(&v.buffer[2], Spy(67));
       v.numElements = 3;
       v.numCapacity = 3;
       Spy s(99);
@@ -2467,13 +2677,13 @@ public:
       //    +----+----+----+----+----+----+
       //    | 26 | 49 | 67 | 99 |    |    |
       //    +----+----+----+----+----+----+
-      assertUnit(v.data != nullptr);
-      if (v.data && v.numElements >= 4)
+      assertUnit(v.buffer != nullptr);
+      if (v.buffer && v.numElements >= 4)
       {
-         assertUnit(v.data[0] == Spy(26));
-         assertUnit(v.data[1] == Spy(49));
-         assertUnit(v.data[2] == Spy(67));
-         assertUnit(v.data[3] == Spy(99));
+         assertUnit(v.buffer[0] == Spy(26));
+         assertUnit(v.buffer[1] == Spy(49));
+         assertUnit(v.buffer[2] == Spy(67));
+         assertUnit(v.buffer[3] == Spy(99));
       }
       assertUnit(v.numCapacity == 6);
       assertUnit(v.numElements == 4);
@@ -2481,6 +2691,307 @@ public:
       teardownStandardFixture(v);
    }
 
+   // grow by half each time the buffer is full
+   void test_pushback_growthHalf()
+   {  // setup
+      custom::vector<int, std::allocator<int>, custom::growth_half> v;
+      size_t capacities[10];
+      // exercise
+      for (int i = 0; i < 10; i++)
+      {
+         v.push_back(i);
+         capacities[i] = v.numCapacity;
+      }
+      // verify
+      //    1, 2, 3, 4, 6, 6, 9, 9, 9, 13
+      assertUnit(capacities[0] == 1);
+      assertUnit(capacities[1] == 2);
+      assertUnit(capacities[2] == 3);
+      assertUnit(capacities[3] == 4);
+      assertUnit(capacities[4] == 6);
+      assertUnit(capacities[6] == 9);
+      assertUnit(capacities[9] == 13);
+      assertUnit(v.numElements == 10);
+      if (v.buffer && v.numElements == 10)
+      {
+         assertUnit(v.buffer[0] == 0);
+         assertUnit(v.buffer[9] == 9);
+      }
+   }  // teardown
+
+   // grow by a fixed number of elements each time the buffer is full
+   void test_pushback_growthChunk()
+   {  // setup
+      custom::vector<int, std::allocator<int>, custom::growth_chunk<4>> v;
+      size_t capacities[10];
+      // exercise
+      for (int i = 0; i < 10; i++)
+      {
+         v.push_back(i);
+         capacities[i] = v.numCapacity;
+      }
+      // verify
+      //    4, 4, 4, 4, 8, 8, 8, 8, 12, 12
+      assertUnit(capacities[0] == 4);
+      assertUnit(capacities[3] == 4);
+      assertUnit(capacities[4] == 8);
+      assertUnit(capacities[7] == 8);
+      assertUnit(capacities[8] == 12);
+      assertUnit(capacities[9] == 12);
+      assertUnit(v.numElements == 10);
+   }  // teardown
+
+   // double until a page is reached, then round up to whole pages
+   void test_pushback_growthPage()
+   {  // setup
+      custom::vector<int, std::allocator<int>, custom::growth_page<48>> v;
+      size_t capacities[20];
+      // exercise
+      for (int i = 0; i < 20; i++)
+      {
+         v.push_back(i);
+         capacities[i] = v.numCapacity;
+      }
+      // verify
+      //    1, 2, 4, 8 are smaller than a page and just double.
+      //    16 ints are 64 bytes, rounded up to two 48 byte pages
+      //    or 24 ints.
+      assertUnit(capacities[0] == 1);
+      assertUnit(capacities[1] == 2);
+      assertUnit(capacities[3] == 4);
+      assertUnit(capacities[7] == 8);
+      assertUnit(capacities[8] == 24);
+      assertUnit(capacities[19] == 24);
+      assertUnit(custom::growth_page<48>::grow(24, sizeof(int)) == 48);
+      assertUnit(v.numElements == 20);
+   }  // teardown
+
+   // emplace an element into an empty vector
+   void test_emplaceback_empty()
+   {  // setup
+      custom::vector<Spy> v;
+      Spy::reset();
+      // exercise
+      Spy & s = v.emplace_back(99);
+      // verify
+      assertUnit(Spy::numNondefault() == 1);    // construct [99] in place
+      assertUnit(Spy::numAlloc() == 1);         // allocate [99]
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numCopyMove() == 0);
+      assertUnit(Spy::numDestructor() == 0);
+      assertUnit(Spy::numDelete() == 0);
+      assertUnit(Spy::numDefault() == 0);
+      assertUnit(Spy::numAssign() == 0);
+      assertUnit(Spy::numAssignMove() == 0);
+      //      0
+      //    +----+
+      //    | 99 |
+      //    +----+
+      assertUnit(v.numCapacity == 1);
+      assertUnit(v.numElements == 1);
+      if (v.buffer)
+      {
+         assertUnit(v.buffer[0] == Spy(99));
+         assertUnit(&s == &v.buffer[0]);
+      }
+      // teardown
+      teardownStandardFixture(v);
+   }
+
+   // emplace an element into a full vector
+   void test_emplaceback_requireReallocate()
+   {  // setup
+      //      0    1    2    3
+      //    +----+----+----+----+
+      //    | 26 | 49 | 67 | 89 |
+      //    +----+----+----+----+
+      custom::vector<Spy> v;
+      setupStandardFixture(v);
+      Spy::reset();
+      // exercise
+      v.emplace_back(99);
+      // verify
+      assertUnit(Spy::numNondefault() == 1);    // construct [99] in place
+      assertUnit(Spy::numCopyMove() == 4);      // move [26,49,67,89]
+      assertUnit(Spy::numDestructor() == 4);    // destroy empty [26,49,67,89]
+      assertUnit(Spy::numCopy() == 0);
+      //      0    1    2    3    4    5    6    7
+      //    +----+----+----+----+----+----+----+----+
+      //    | 26 | 49 | 67 | 89 | 99 |    |    |    |
+      //    +----+----+----+----+----+----+----+----+
+      assertUnit(v.numCapacity == 8);
+      assertUnit(v.numElements == 5);
+      if (v.buffer && v.numElements == 5)
+         assertUnit(v.buffer[4] == Spy(99));
+      v.pop_back();
+      v.numCapacity = 4;
+      assertStandardFixture(v);
+      // teardown
+      teardownStandardFixture(v);
+   }
+
+   // append a range onto an empty vector
+   void test_append_empty()
+   {  // setup
+      std::vector<Spy> source{ Spy(26), Spy(49), Spy(67), Spy(89) };
+      custom::vector<Spy> v;
+      Spy::reset();
+      // exercise
+      v.append(source.begin(), source.end());
+      // verify
+      assertUnit(Spy::numCopy() == 4);          // copy [26,49,67,89]
+      assertUnit(Spy::numAlloc() == 4);         // allocate [26,49,67,89]
+      assertUnit(Spy::numCopyMove() == 0);      // only one buffer
+      assertUnit(Spy::numDestructor() == 0);
+      assertUnit(Spy::numDelete() == 0);
+      assertUnit(Spy::numDefault() == 0);
+      assertUnit(Spy::numNondefault() == 0);
+      assertUnit(Spy::numAssign() == 0);
+      assertUnit(Spy::numAssignMove() == 0);
+      //      0    1    2    3
+      //    +----+----+----+----+
+      //    | 26 | 49 | 67 | 89 |
+      //    +----+----+----+----+
+      assertStandardFixture(v);
+      // teardown
+      teardownStandardFixture(v);
+   }
+
+   // append a range onto a full vector grows once
+   void test_append_standard()
+   {  // setup
+      //      0    1    2    3
+      //    +----+----+----+----+
+      //    | 26 | 49 | 67 | 89 |
+      //    +----+----+----+----+
+      std::vector<Spy> source{ Spy(11), Spy(31), Spy(77), Spy(88), Spy(99) };
+      custom::vector<Spy> v;
+      setupStandardFixture(v);
+      Spy::reset();
+      // exercise
+      v.append(source.begin(), source.end());
+      // verify
+      assertUnit(Spy::numCopy() == 5);          // copy [11,31,77,88,99]
+      assertUnit(Spy::numCopyMove() == 4);      // move [26,49,67,89] once
+      assertUnit(Spy::numDestructor() == 4);    // destroy empty [26,49,67,89]
+      //      0    1    2    3    4    5    6    7    8
+      //    +----+----+----+----+----+----+----+----+----+
+      //    | 26 | 49 | 67 | 89 | 11 | 31 | 77 | 88 | 99 |
+      //    +----+----+----+----+----+----+----+----+----+
+      assertUnit(v.numCapacity == 9);
+      assertUnit(v.numElements == 9);
+      if (v.buffer && v.numElements == 9)
+      {
+         assertUnit(v.buffer[4] == Spy(11));
+         assertUnit(v.buffer[8] == Spy(99));
+      }
+      while (v.numElements > 4)
+         v.pop_back();
+      v.numCapacity = 4;
+      assertStandardFixture(v);
+      // teardown
+      teardownStandardFixture(v);
+   }
+
+   // insert a range in the middle of the standard fixture
+   void test_insert_middle()
+   {  // setup
+      //      0    1    2    3
+      //    +----+----+----+----+
+      //    | 26 | 49 | 67 | 89 |
+      //    +----+----+----+----+
+      Spy source[] = { Spy(11), Spy(31) };
+      custom::vector<Spy> v;
+      setupStandardFixture(v);
+      Spy::reset();
+      // exercise
+      custom::vector<Spy>::iterator it = v.insert(custom::vector<Spy>::iterator(2, v),
+                                                  source, source + 2);
+      // verify
+      assertUnit(Spy::numCopy() == 2);          // copy [11,31]
+      assertUnit(Spy::numAssign() == 0);
+      //      0    1    2    3    4    5    6    7
+      //    +----+----+----+----+----+----+----+----+
+      //    | 26 | 49 | 11 | 31 | 67 | 89 |    |    |
+      //    +----+----+----+----+----+----+----+----+
+      //                it
+      assertUnit(v.numCapacity == 8);
+      assertUnit(v.numElements == 6);
+      if (v.buffer && v.numElements == 6)
+      {
+         assertUnit(it.p == v.buffer + 2);
+         assertUnit(v.buffer[0] == Spy(26));
+         assertUnit(v.buffer[1] == Spy(49));
+         assertUnit(v.buffer[2] == Spy(11));
+         assertUnit(v.buffer[3] == Spy(31));
+         assertUnit(v.buffer[4] == Spy(67));
+         assertUnit(v.buffer[5] == Spy(89));
+      }
+      // teardown
+      teardownStandardFixture(v);
+   }
+
+   // insert a range of integers at the front, shifting with one block move
+   void test_insert_front()
+   {  // setup
+      int source[] = { 11, 31, 77 };
+      custom::vector<int> v;
+      v.reserve(10);
+      v.push_back(26);
+      v.push_back(49);
+      // exercise
+      v.insert(v.begin(), source, source + 3);
+      // verify
+      //      0    1    2    3    4    5    6    7    8    9
+      //    +----+----+----+----+----+----+----+----+----+----+
+      //    | 11 | 31 | 77 | 26 | 49 |    |    |    |    |    |
+      //    +----+----+----+----+----+----+----+----+----+----+
+      assertUnit(v.numCapacity == 10);
+      assertUnit(v.numElements == 5);
+      if (v.buffer && v.numElements == 5)
+      {
+         assertUnit(v.buffer[0] == 11);
+         assertUnit(v.buffer[1] == 31);
+         assertUnit(v.buffer[2] == 77);
+         assertUnit(v.buffer[3] == 26);
+         assertUnit(v.buffer[4] == 49);
+      }
+   }  // teardown
+
+   // assign a shorter range, reusing the buffer
+   void test_assignRange_shrink()
+   {  // setup
+      //      0    1    2    3
+      //    +----+----+----+----+
+      //    | 26 | 49 | 67 | 89 |
+      //    +----+----+----+----+
+      std::vector<Spy> source{ Spy(11), Spy(31) };
+      custom::vector<Spy> v;
+      setupStandardFixture(v);
+      Spy * data = v.buffer;
+      Spy::reset();
+      // exercise
+      v.assign(source.begin(), source.end());
+      // verify
+      assertUnit(Spy::numCopy() == 2);          // copy [11,31]
+      assertUnit(Spy::numDestructor() == 4);    // destroy [26,49,67,89]
+      assertUnit(Spy::numCopyMove() == 0);
+      //      0    1    2    3
+      //    +----+----+----+----+
+      //    | 11 | 31 |    |    |
+      //    +----+----+----+----+
+      assertUnit(v.buffer == data);
+      assertUnit(v.numCapacity == 4);
+      assertUnit(v.numElements == 2);
+      if (v.buffer && v.numElements == 2)
+      {
+         assertUnit(v.buffer[0] == Spy(11));
+         assertUnit(v.buffer[1] == Spy(31));
+      }
+      // teardown
+      teardownStandardFixture(v);
+   }
+
 
    /***************************************
     * ITERATOR
@@ -2514,11 +3025,11 @@ public:
       //    | 26 | 49 | 67 | 89 |
       //    +----+----+----+----+
       //      it
-      assertUnit(v.data != nullptr);
+      assertUnit(v.buffer != nullptr);
       assertUnit(it.p != nullptr);
-      if (v.data && it.p)
+      if (v.buffer && it.p)
       {
-         assertUnit(it.p == &(v.data[0]));
+         assertUnit(it.p == &(v.buffer[0]));
          assertUnit(*(it.p) == 26);
       }
       assertStandardFixture(v);
@@ -2543,7 +3054,7 @@ public:
       //    | 26 | 49 | 67 | 89 |
       //    +----+----+----+----+
       //                           it
-      assertUnit(it.p == &(v.data[4]));
+      assertUnit(it.p == &(v.buffer[4]));
       assertStandardFixture(v);
       // teardown
       teardownStandardFixture(v);
@@ -2560,7 +3071,7 @@ public:
       custom::vector<Spy> v;
       setupStandardFixture(v);
       custom::vector<Spy>::iterator it;
-      it.p = &(v.data[1]);
+      it.p = &(v.buffer[1]);
       // exercise
       ++it;
       // verify
@@ -2586,12 +3097,12 @@ public:
       custom::vector<Spy> v;
       setupStandardFixture(v);
       custom::vector<Spy>::iterator it;
-      it.p = &(v.data[1]);
+      it.p = &(v.buffer[1]);
       // exercise
       Spy value = *it;
       // verify
       assertUnit(value == Spy(49));
-      assertUnit(it.p == &(v.data[1]));
+      assertUnit(it.p == &(v.buffer[1]));
       assertStandardFixture(v);
       // teardown
       teardownStandardFixture(v);
@@ -2608,7 +3119,7 @@ public:
       custom::vector<Spy> v;
       setupStandardFixture(v);
       custom::vector<Spy>::iterator it;
-      it.p = &(v.data[1]);
+      it.p = &(v.buffer[1]);
       // exercise
       *it = Spy(99);
       // verify
@@ -2617,14 +3128,14 @@ public:
       //    | 26 | 99 | 67 | 89 |
       //    +----+----+----+----+
       //           it
-      assertUnit(v.data != nullptr);
-      if (v.data)
+      assertUnit(v.buffer != nullptr);
+      if (v.buffer)
       {
-         assertUnit(v.data[0] == Spy(26));
-         assertUnit(v.data[1] == Spy(99));
-         assertUnit(v.data[2] == Spy(67));
-         assertUnit(v.data[3] == Spy(89));
-         assertUnit(it.p == &(v.data[1]));
+         assertUnit(v.buffer[0] == Spy(26));
+         assertUnit(v.buffer[1] == Spy(99));
+         assertUnit(v.buffer[2] == Spy(67));
+         assertUnit(v.buffer[3] == Spy(89));
+         assertUnit(it.p == &(v.buffer[1]));
       }
       assertUnit(v.numElements == 4);
       assertUnit(v.numCapacity == 4);
@@ -2663,9 +3174,9 @@ public:
       setupStandardFixture(v);
       Spy::reset();
       // exercise
-      custom::vector<Spy>::iterator it(v.data + 2);
+      custom::vector<Spy>::iterator it(v.buffer + 2);
       // verify
-      assertUnit(it.p == v.data + 2);
+      assertUnit(it.p == v.buffer + 2);
       assertUnit(Spy::numCopyMove() == 0);
       assertUnit(Spy::numDestructor() == 0);
       assertUnit(Spy::numCopy() == 0);
@@ -2694,7 +3205,7 @@ public:
       // exercise
       custom::vector<Spy>::iterator it(2, v);
       // verify
-      assertUnit(it.p == v.data + 2);
+      assertUnit(it.p == v.buffer + 2);
       assertUnit(Spy::numCopyMove() == 0);
       assertUnit(Spy::numDestructor() == 0);
       assertUnit(Spy::numCopy() == 0);
@@ -2709,6 +3220,159 @@ public:
       teardownStandardFixture(v);
    }
 
+   // end() is one past the last element, not the last slot of capacity
+   void test_iterator_endPartiallyFilled()
+   {  // setup
+      //      0    1    2    3    4    5
+      //    +----+----+----+----+----+----+
+      //    | 26 | 49 | 67 | 89 |    |    |
+      //    +----+----+----+----+----+----+
+      custom::vector<Spy> v;
+      setupStandardFixture(v);
+      v.reserve(6);
+      // exercise
+      custom::vector<Spy>::iterator it = v.end();
+      // verify
+      //      0    1    2    3    4    5
+      //    +----+----+----+----+----+----+
+      //    | 26 | 49 | 67 | 89 |    |    |
+      //    +----+----+----+----+----+----+
+      //                           it
+      assertUnit(it.p == v.buffer + 4);
+      assertUnit(v.numCapacity == 6);
+      assertUnit(v.numElements == 4);
+      if (v.buffer)
+      {
+         assertUnit(v.buffer[0] == Spy(26));
+         assertUnit(v.buffer[1] == Spy(49));
+         assertUnit(v.buffer[2] == Spy(67));
+         assertUnit(v.buffer[3] == Spy(89));
+      }
+      // teardown
+      teardownStandardFixture(v);
+   }
+
+   // jump around with +, -, [] and compare with <
+   void test_iterator_randomAccess()
+   {  // setup
+      //      0    1    2    3
+      //    +----+----+----+----+
+      //    | 26 | 49 | 67 | 89 |
+      //    +----+----+----+----+
+      custom::vector<Spy> v;
+      setupStandardFixture(v);
+      custom::vector<Spy>::iterator it = v.begin();
+      // exercise
+      custom::vector<Spy>::iterator itThree = it + 3;
+      custom::vector<Spy>::iterator itOne = itThree - 2;
+      it += 2;
+      // verify
+      //      0    1    2    3
+      //    +----+----+----+----+
+      //    | 26 | 49 | 67 | 89 |
+      //    +----+----+----+----+
+      //           itOne it itThree
+      assertUnit(itThree.p == v.buffer + 3);
+      assertUnit(itOne.p == v.buffer + 1);
+      assertUnit(it.p == v.buffer + 2);
+      assertUnit(*itThree == Spy(89));
+      assertUnit(itOne[1] == Spy(67));
+      assertUnit(itOne < it);
+      assertUnit(itThree > it);
+      assertUnit(it <= it);
+      assertUnit(!(itOne >= it));
+      assertUnit((2 + v.begin()) == it);
+      assertStandardFixture(v);
+      // teardown
+      teardownStandardFixture(v);
+   }
+
+   // the distance between two iterators
+   void test_iterator_difference()
+   {  // setup
+      //      0    1    2    3
+      //    +----+----+----+----+
+      //    | 26 | 49 | 67 | 89 |
+      //    +----+----+----+----+
+      custom::vector<Spy> v;
+      setupStandardFixture(v);
+      // exercise
+      std::ptrdiff_t size = v.end() - v.begin();
+      std::ptrdiff_t distance = std::distance(v.begin() + 1, v.end());
+      // verify
+      assertUnit(size == 4);
+      assertUnit(distance == 3);
+      assertStandardFixture(v);
+      // teardown
+      teardownStandardFixture(v);
+   }
+
+   // std::sort needs a random access iterator
+   void test_iterator_sort()
+   {  // setup
+      //      0    1    2    3    4
+      //    +----+----+----+----+----+
+      //    | 67 | 26 | 89 | 11 | 49 |
+      //    +----+----+----+----+----+
+      custom::vector<int> v{ 67, 26, 89, 11, 49 };
+      // exercise
+      std::sort(v.begin(), v.end());
+      // verify
+      //      0    1    2    3    4
+      //    +----+----+----+----+----+
+      //    | 11 | 26 | 49 | 67 | 89 |
+      //    +----+----+----+----+----+
+      assertUnit(v.numElements == 5);
+      if (v.buffer && v.numElements == 5)
+      {
+         assertUnit(v.buffer[0] == 11);
+         assertUnit(v.buffer[1] == 26);
+         assertUnit(v.buffer[2] == 49);
+         assertUnit(v.buffer[3] == 67);
+         assertUnit(v.buffer[4] == 89);
+      }
+   }  // teardown
+
+   // binary search through a const vector
+   void test_iterator_constLowerBound()
+   {  // setup
+      //      0    1    2    3    4
+      //    +----+----+----+----+----+
+      //    | 11 | 26 | 49 | 67 | 89 |
+      //    +----+----+----+----+----+
+      const custom::vector<int> v{ 11, 26, 49, 67, 89 };
+      // exercise
+      custom::vector<int>::const_iterator it = std::lower_bound(v.begin(), v.end(), 50);
+      // verify
+      //      0    1    2    3    4
+      //    +----+----+----+----+----+
+      //    | 11 | 26 | 49 | 67 | 89 |
+      //    +----+----+----+----+----+
+      //                     it
+      assertUnit(it - v.cbegin() == 3);
+      assertUnit(*it == 67);
+      assertUnit(std::lower_bound(v.cbegin(), v.cend(), 99) == v.cend());
+   }  // teardown
+
+   // data() is the start of the contiguous elements
+   void test_data_standard()
+   {  // setup
+      //      0    1    2    3
+      //    +----+----+----+----+
+      //    | 26 | 49 | 67 | 89 |
+      //    +----+----+----+----+
+      custom::vector<Spy> v;
+      setupStandardFixture(v);
+      // exercise
+      Spy * p = v.data();
+      // verify
+      assertUnit(p == v.buffer);
+      assertUnit(p + 4 == &*(v.end() - 1) + 1);
+      assertStandardFixture(v);
+      // teardown
+      teardownStandardFixture(v);
+   }
+
    /*************************************************************
     * SETUP STANDARD FIXTURE
     *      0    1    2    3
@@ -2720,11 +3384,11 @@ public:
    {
       try
       {
-         v.data = v.alloc.allocate(4);
-         v.alloc.construct(&v.data[0], Spy(26));
-         v.alloc.construct(&v.data[1], Spy(49));
-         v.alloc.construct(&v.data[2], Spy(67));
-         v.alloc.construct(&v.data[3], Spy(89));
+         v.buffer = v.alloc.allocate(4);
+         v.alloc.construct(&v.buffer[0], Spy(26));
+         v.alloc.construct(&v.buffer[1], Spy(49));
+         v.alloc.construct(&v.buffer[2], Spy(67));
+         v.alloc.construct(&v.buffer[3], Spy(89));
          v.numElements = 4;
          v.numCapacity = 4;
       }
@@ -2743,16 +3407,16 @@ public:
     *************************************************************/
    void assertStandardFixtureParameters(const custom::vector<Spy>& v, int line, const char* function)
    {
-      assertIndirect(v.data != nullptr);
+      assertIndirect(v.buffer != nullptr);
       assertIndirect(v.numCapacity == 4);
       assertIndirect(v.numElements == 4);
 
-      if (v.data != nullptr && v.numElements >= 4)
+      if (v.buffer != nullptr && v.numElements >= 4)
       {
-         assertIndirect(v.data[0] == Spy(26));
-         assertIndirect(v.data[1] == Spy(49));
-         assertIndirect(v.data[2] == Spy(67));
-         assertIndirect(v.data[3] == Spy(89));
+         assertIndirect(v.buffer[0] == Spy(26));
+         assertIndirect(v.buffer[1] == Spy(49));
+         assertIndirect(v.buffer[2] == Spy(67));
+         assertIndirect(v.buffer[3] == Spy(89));
       }
    }
    
@@ -2761,7 +3425,7 @@ public:
     *************************************************************/
    void assertEmptyFixtureParameters(const custom::vector<Spy>& v, int line, const char* function)
    {
-      assertIndirect(v.data == nullptr);
+      assertIndirect(v.buffer == nullptr);
       assertIndirect(v.numCapacity == 0);
       assertIndirect(v.numElements == 0);
    }
@@ -2771,14 +3435,14 @@ public:
     *************************************************************/
    void teardownStandardFixture(custom::vector<Spy>&v)
    {
-      if (v.data != nullptr && false)
+      if (v.buffer != nullptr && false)
       {
          for (size_t i = 0; i < v.numElements; i++)
-            v.alloc.destroy(&v.data[i]);
-         v.alloc.deallocate(v.data, v.numCapacity);
+            v.alloc.destroy(&v.buffer[i]);
+         v.alloc.deallocate(v.buffer, v.numCapacity);
 
       }
-         v.data = nullptr;
+         v.buffer = nullptr;
          v.numElements = v.numCapacity = 0;
    }
 
@@ -0,0 +1,311 @@
+/***********************************************************************
+ * Header:
+ *    TEST VECTOR SIMD
+ * Summary:
+ *    Unit tests for the vectorized vector kernels
+ * Author
+ *    Peter Benson, Jarom Diaz, Isaac Radford
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include "vector_simd.h"
+#include "unitTest.h"
+
+#include <cassert>
+#include <cstdint>
+#include <type_traits>
+
+class TestVectorSimd : public UnitTest
+{
+
+public:
+   void run()
+   {
+      reset();
+
+      // Kernels, at every level this CPU supports
+      test_find_int();
+      test_find_float();
+      test_count_int();
+      test_count_float();
+      test_fill_int();
+      test_fill_float();
+      test_minmax_int();
+      test_minmax_float();
+      test_sum_intWidens();
+      test_sum_float();
+      test_sum_typeWidens();
+
+      // Vector
+      test_vector_find();
+      test_vector_findMissing();
+      test_vector_count();
+      test_vector_fill();
+      test_vector_minMax();
+      test_vector_sumDouble();
+
+      report("VectorSimd");
+   }
+
+   /***************************************
+    * KERNELS
+    * Each size from 0 to 40 covers the full
+    * registers and every length of leftover tail
+    ***************************************/
+
+   // find the first match anywhere in the buffer
+   void test_find_int()
+   {  // setup
+      int32_t data[40];
+      for (int i = 0; i < 40; i++)
+         data[i] = i * 3;
+      // exercise and verify
+      for (int level = custom::simd::SCALAR; level <= custom::simd::active(); level++)
+         for (size_t n = 0; n <= 40; n++)
+         {
+            for (size_t i = 0; i < n; i++)
+               assertUnit(custom::simd::findKernel(data, n, data[i], (custom::simd::Level)level) == i);
+            assertUnit(custom::simd::findKernel(data, n, int32_t(1), (custom::simd::Level)level) == n);
+         }
+   }  // teardown
+
+   // find in a float buffer
+   void test_find_float()
+   {  // setup
+      float data[40];
+      for (int i = 0; i < 40; i++)
+         data[i] = (float)i * 0.5f;
+      // exercise and verify
+      for (int level = custom::simd::SCALAR; level <= custom::simd::active(); level++)
+         for (size_t n = 0; n <= 40; n++)
+         {
+            for (size_t i = 0; i < n; i++)
+               assertUnit(custom::simd::findKernel(data, n, data[i], (custom::simd::Level)level) == i);
+            assertUnit(custom::simd::findKernel(data, n, -1.0f, (custom::simd::Level)level) == n);
+         }
+   }  // teardown
+
+   // count every third element
+   void test_count_int()
+   {  // setup
+      int32_t data[40];
+      for (int i = 0; i < 40; i++)
+         data[i] = (i % 3 == 0) ? 7 : i + 100;
+      // exercise and verify
+      for (int level = custom::simd::SCALAR; level <= custom::simd::active(); level++)
+         for (size_t n = 0; n <= 40; n++)
+            assertUnit(custom::simd::countKernel(data, n, int32_t(7), (custom::simd::Level)level) == (n + 2) / 3);
+   }  // teardown
+
+   // count every other float
+   void test_count_float()
+   {  // setup
+      float data[40];
+      for (int i = 0; i < 40; i++)
+         data[i] = (i % 2 == 0) ? 2.5f : (float)i;
+      // exercise and verify
+      for (int level = custom::simd::SCALAR; level <= custom::simd::active(); level++)
+         for (size_t n = 0; n <= 40; n++)
+            assertUnit(custom::simd::countKernel(data, n, 2.5f, (custom::simd::Level)level) == (n + 1) / 2);
+   }  // teardown
+
+   // fill exactly n elements and nothing past them
+   void test_fill_int()
+   {
+      for (int level = custom::simd::SCALAR; level <= custom::simd::active(); level++)
+         for (size_t n = 0; n <= 40; n++)
+         {  // setup
+            int32_t data[41];
+            for (int i = 0; i < 41; i++)
+               data[i] = -1;
+            // exercise
+            custom::simd::fillKernel(data, n, int32_t(99), (custom::simd::Level)level);
+            // verify
+            for (size_t i = 0; i < n; i++)
+               assertUnit(data[i] == 99);
+            assertUnit(data[n] == -1);
+         }  // teardown
+   }
+
+   // fill a float buffer
+   void test_fill_float()
+   {
+      for (int level = custom::simd::SCALAR; level <= custom::simd::active(); level++)
+         for (size_t n = 0; n <= 40; n++)
+         {  // setup
+            float data[41];
+            for (int i = 0; i < 41; i++)
+               data[i] = -1.0f;
+            // exercise
+            custom::simd::fillKernel(data, n, 9.5f, (custom::simd::Level)level);
+            // verify
+            for (size_t i = 0; i < n; i++)
+               assertUnit(data[i] == 9.5f);
+            assertUnit(data[n] == -1.0f);
+         }  // teardown
+   }
+
+   // the extremes may be in a full register or in the tail
+   void test_minmax_int()
+   {  // setup
+      int32_t data[40];
+      for (int i = 0; i < 40; i++)
+         data[i] = (i * 37) % 41 - 20;
+      // exercise and verify
+      for (int level = custom::simd::SCALAR; level <= custom::simd::active(); level++)
+         for (size_t n = 1; n <= 40; n++)
+         {
+            std::pair<int32_t, int32_t> expect = custom::simd::minmaxKernel<int32_t>(data, n, custom::simd::SCALAR);
+            std::pair<int32_t, int32_t> actual = custom::simd::minmaxKernel(data, n, (custom::simd::Level)level);
+            assertUnit(actual.first == expect.first);
+            assertUnit(actual.second == expect.second);
+         }
+   }  // teardown
+
+   // the extremes of a float buffer
+   void test_minmax_float()
+   {  // setup
+      float data[40];
+      for (int i = 0; i < 40; i++)
+         data[i] = (float)((i * 37) % 41) - 20.5f;
+      // exercise and verify
+      for (int level = custom::simd::SCALAR; level <= custom::simd::active(); level++)
+         for (size_t n = 1; n <= 40; n++)
+         {
+            std::pair<float, float> expect = custom::simd::minmaxKernel<float>(data, n, custom::simd::SCALAR);
+            std::pair<float, float> actual = custom::simd::minmaxKernel(data, n, (custom::simd::Level)level);
+            assertUnit(actual.first == expect.first);
+            assertUnit(actual.second == expect.second);
+         }
+   }  // teardown
+
+   // an int32 total does not overflow
+   void test_sum_intWidens()
+   {  // setup
+      int32_t data[40];
+      for (int i = 0; i < 40; i++)
+         data[i] = (i % 2 == 0) ? 2000000000 : -7;
+      // exercise and verify
+      for (int level = custom::simd::SCALAR; level <= custom::simd::active(); level++)
+         for (size_t n = 0; n <= 40; n++)
+         {
+            int64_t expect = (int64_t)((n + 1) / 2) * 2000000000 - (int64_t)(n / 2) * 7;
+            assertUnit(custom::simd::sumKernel(data, n, (custom::simd::Level)level) == expect);
+         }
+   }  // teardown
+
+   // add up floats that are exact in binary
+   void test_sum_float()
+   {  // setup
+      float data[40];
+      for (int i = 0; i < 40; i++)
+         data[i] = 0.25f * (float)i;
+      // exercise and verify
+      for (int level = custom::simd::SCALAR; level <= custom::simd::active(); level++)
+         for (size_t n = 0; n <= 40; n++)
+         {
+            double expect = 0.25 * (double)(n * (n - (n ? 1 : 0)) / 2);
+            assertUnit(custom::simd::sumKernel(data, n, (custom::simd::Level)level) == expect);
+         }
+   }  // teardown
+
+   // every integer adds into 64 bits of the same sign, float into double
+   void test_sum_typeWidens()
+   {  // setup
+      int16_t shorts[40];
+      uint32_t unsigneds[40];
+      for (int i = 0; i < 40; i++)
+      {
+         shorts[i] = 30000;
+         unsigneds[i] = 4000000000u;
+      }
+      // exercise and verify
+      static_assert(std::is_same<custom::simd::sum_type<int8_t>::type,   int64_t>::value,  "int8_t widens");
+      static_assert(std::is_same<custom::simd::sum_type<uint16_t>::type, uint64_t>::value, "uint16_t widens");
+      static_assert(std::is_same<custom::simd::sum_type<float>::type,    double>::value,   "float widens");
+      static_assert(std::is_same<custom::simd::sum_type<double>::type,   double>::value,   "double stays");
+      assertUnit(custom::simd::sumKernel(shorts, 40, custom::simd::active()) == 1200000);
+      assertUnit(custom::simd::sumKernel(unsigneds, 40, custom::simd::active()) == 160000000000u);
+   }  // teardown
+
+   /***************************************
+    * VECTOR
+    ***************************************/
+
+   // find returns an iterator to the element
+   void test_vector_find()
+   {  // setup
+      //      0    1    2    3    4    5    6    7    8    9
+      //    +----+----+----+----+----+----+----+----+----+----+
+      //    | 0  | 1  | 2  | 3  | 4  | 5  | 6  | 7  | 8  | 9  |
+      //    +----+----+----+----+----+----+----+----+----+----+
+      custom::vector<int32_t> v;
+      for (int i = 0; i < 10; i++)
+         v.push_back(i);
+      // exercise
+      custom::vector<int32_t>::const_iterator it = custom::simd::find(v, 9);
+      // verify
+      assertUnit(it - v.cbegin() == 9);
+      assertUnit(*it == 9);
+   }  // teardown
+
+   // find returns end() when nothing matches
+   void test_vector_findMissing()
+   {  // setup
+      custom::vector<float> v{ 1.0f, 2.0f, 3.0f };
+      // exercise
+      custom::vector<float>::const_iterator it = custom::simd::find(v, 4.0f);
+      // verify
+      assertUnit(it == v.cend());
+   }  // teardown
+
+   // count the matching elements
+   void test_vector_count()
+   {  // setup
+      custom::vector<int32_t> v{ 7, 1, 7, 2, 7, 3, 7, 4, 7 };
+      // exercise
+      size_t num = custom::simd::count(v, 7);
+      // verify
+      assertUnit(num == 5);
+   }  // teardown
+
+   // fill every element of the vector
+   void test_vector_fill()
+   {  // setup
+      custom::vector<float> v(11);
+      // exercise
+      custom::simd::fill(v, 3.5f);
+      // verify
+      assertUnit(v.size() == 11);
+      for (size_t i = 0; i < v.size(); i++)
+         assertUnit(v[i] == 3.5f);
+   }  // teardown
+
+   // the smallest and the largest element
+   void test_vector_minMax()
+   {  // setup
+      custom::vector<int32_t> v{ 26, 49, -67, 89, 11, 31, 77, 88, -99, 12, 4 };
+      // exercise
+      int32_t lo = custom::simd::min(v);
+      int32_t hi = custom::simd::max(v);
+      // verify
+      assertUnit(lo == -99);
+      assertUnit(hi == 89);
+   }  // teardown
+
+   // types without a kernel use the scalar loop
+   void test_vector_sumDouble()
+   {  // setup
+      custom::vector<double> v{ 1.5, 2.5, 3.0 };
+      // exercise
+      double total = custom::simd::sum(v);
+      // verify
+      assertUnit(total == 7.0);
+   }  // teardown
+
+};
+
+#endif // DEBUG
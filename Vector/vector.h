@@ -13,6 +13,7 @@
  *    This will contain the class definition of:
  *        vector                 : A class that represents a Vector
  *        vector::iterator       : An iterator through Vector
+ *        vector::const_iterator : A read-only iterator through Vector
  * Author
  *    Peter Benson, Jarom Diaz, Isaac Radford
  ************************************************************************/
@@ -21,7 +22,13 @@
 
 #include <cassert>  // because I am paranoid
 #include <new>      // std::bad_alloc
+#include <cstddef>  // for std::ptrdiff_t
 #include <memory>   // for std::allocator
+#include <initializer_list> // for std::initializer_list
+#include <cstring>  // for std::memcpy and std::memmove
+#include <type_traits> // for std::is_trivially_copyable
+#include <iterator> // for std::distance and std::random_access_iterator_tag
+#include <utility>  // for std::forward
 
 class TestVector; // forward declaration for unit tests
 class TestStack;
@@ -31,11 +38,81 @@ class TestHash;
 namespace custom
 {
 
+/*****************************************
+ * IS TRIVIALLY RELOCATABLE
+ * A type is trivially relocatable when moving it to
+ * a new address and destroying the original is the same
+ * as copying the bytes. This is true for every trivially
+ * copyable type. Other types (such as a record holding an
+ * owning pointer) can opt in with a specialization:
+ *    namespace custom {
+ *       template <> struct is_trivially_relocatable<Record>
+ *          : std::true_type {}; }
+ ****************************************/
+template <typename T>
+struct is_trivially_relocatable
+   : std::integral_constant<bool, std::is_trivially_copyable<T>::value> {};
+
+/*****************************************
+ * GROWTH POLICIES
+ * How much the capacity grows when push_back runs
+ * out of room. Each policy returns the new capacity
+ * given the current capacity and the element size.
+ *    growth_double    : 1, 2, 4, 8, ...  (the default)
+ *    growth_half      : 1, 2, 3, 4, 6, 9, ... (1.5x, so
+ *                       freed blocks can be reused)
+ *    growth_chunk<N>  : N, 2N, 3N, ...
+ *    growth_page<N>   : double, but once the buffer is at
+ *                       least a page, round the bytes up to
+ *                       a multiple of the N-byte page
+ ****************************************/
+struct growth_double
+{
+   static size_t grow(size_t numCapacity, size_t /* sizeElement */)
+   {
+      return numCapacity == 0 ? 1 : numCapacity * 2;
+   }
+};
+
+struct growth_half
+{
+   static size_t grow(size_t numCapacity, size_t /* sizeElement */)
+   {
+      return numCapacity < 2 ? numCapacity + 1 : numCapacity + numCapacity / 2;
+   }
+};
+
+template <size_t numChunk>
+struct growth_chunk
+{
+   static_assert(numChunk > 0, "the chunk must hold at least one element");
+   static size_t grow(size_t numCapacity, size_t /* sizeElement */)
+   {
+      return numCapacity + numChunk;
+   }
+};
+
+template <size_t sizePage = 4096>
+struct growth_page
+{
+   static_assert(sizePage > 0, "the page must be at least one byte");
+   static size_t grow(size_t numCapacity, size_t sizeElement)
+   {
+      size_t numCapacityNew = growth_double::grow(numCapacity, sizeElement);
+      size_t numBytes = numCapacityNew * sizeElement;
+      if (numBytes < sizePage)
+         return numCapacityNew;
+
+      numBytes = (numBytes + sizePage - 1) / sizePage * sizePage;
+      return numBytes / sizeElement;
+   }
+};
+
 /*****************************************
  * VECTOR
  * Just like the std :: vector <T> class
  ****************************************/
-template <typename T, typename A = std::allocator<T>>
+template <typename T, typename A = std::allocator<T>, typename G = growth_double>
 class vector
 {
    friend class ::TestVector; // give unit tests access to the privates
@@ -60,7 +137,7 @@ public:
    //
    void swap(vector& rhs)
    {
-      std::swap(data, rhs.data);
+      std::swap(buffer, rhs.buffer);
       std::swap(numElements, rhs.numElements);
       std::swap(numCapacity, rhs.numCapacity);
    }
@@ -71,14 +148,19 @@ public:
    // Iterator
    //
    class iterator;
+   class const_iterator;
    iterator begin() 
    { 
-      return iterator(data); 
+      return iterator(buffer); 
    }
    iterator end() 
    { 
-      return iterator(data + numCapacity); 
+      return iterator(buffer + numElements); 
    }
+   const_iterator begin()  const { return const_iterator(buffer);               }
+   const_iterator end()    const { return const_iterator(buffer + numElements); }
+   const_iterator cbegin() const { return const_iterator(buffer);               }
+   const_iterator cend()   const { return const_iterator(buffer + numElements); }
 
    //
    // Access
@@ -89,15 +171,27 @@ public:
    const T& front() const;
          T& back();
    const T& back() const;
+         T* data()       { return buffer; }
+   const T* data() const { return buffer; }
 
    //
    // Insert
    //
    void push_back(const T& t);
    void push_back(T&& t);
+   template <class ... Args>
+   T & emplace_back(Args && ... args);
+   template <class Iterator>
+   iterator insert(iterator pos, Iterator first, Iterator last);
+   template <class Iterator>
+   void append(Iterator first, Iterator last);
+   template <class Iterator>
+   void assign(Iterator first, Iterator last);
    void reserve(size_t newCapacity);
    void resize(size_t newElements);
    void resize(size_t newElements, const T& t);
+   void resize_default_init(size_t newElements);
+   void resize_uninitialized(size_t newElements);
 
    //
    // Remove
@@ -105,7 +199,7 @@ public:
    void clear()
    {
       for (size_t i = 0; i < numElements; ++i)
-         alloc.destroy(data + i);
+         alloc.destroy(buffer + i);
 
       numElements = 0;
    }
@@ -114,7 +208,7 @@ public:
       if (numElements != 0)
       {
          numElements -= 1;
-         data[numElements].~T();
+         buffer[numElements].~T();
       }
    }
    void shrink_to_fit();
@@ -129,50 +223,74 @@ public:
 private:
    
    A    alloc;                // use allocator for memory allocation
-   T *  data;                 // user data, a dynamically-allocated array
+   T *  buffer;               // user data, a dynamically-allocated array
    size_t  numCapacity;       // the capacity of the array
    size_t  numElements;       // the number of items currently used
+
+   void relocate(T * dataNew, std::true_type);
+   void relocate(T * dataNew, std::false_type);
+   void growFor(size_t numNeeded);
+   void shiftRight(size_t index, size_t numShift, std::true_type);
+   void shiftRight(size_t index, size_t numShift, std::false_type);
 };
 
 /**************************************************
  * VECTOR ITERATOR
- * An iterator through vector.  You only need to
- * support the following:
- *   1. Constructors (default and copy)
- *   2. Not equals operator
- *   3. Increment (prefix and postfix)
- *   4. Dereference
- * This particular iterator is a bi-directional meaning
- * that ++ and -- both work.  Not all iterators are that way.
+ * An iterator through vector. The elements are
+ * contiguous, so this is a random access iterator:
+ * it can jump with + and -, measure distance with -,
+ * index with [] and compare with <. That lets
+ * std::sort, std::lower_bound and friends work
+ * on a vector at full speed.
  *************************************************/
-template <typename T, typename A>
-class vector <T, A> ::iterator
+template <typename T, typename A, typename G>
+class vector <T, A, G> ::iterator
 {
+   friend class vector;       // so insert() can find the position
+   friend class const_iterator;
    friend class ::TestVector; // give unit tests access to the privates
    friend class ::TestStack;
    friend class ::TestPQueue;
    friend class ::TestHash;
 public:
+   typedef std::random_access_iterator_tag iterator_category;
+   typedef T                               value_type;
+   typedef std::ptrdiff_t                  difference_type;
+   typedef T *                             pointer;
+   typedef T &                             reference;
+
    // constructors, destructors, and assignment operator
    iterator() { this->p = nullptr; }
    iterator(T* p) { this->p = p; }
    iterator(const iterator& rhs) { this->p = rhs.p; }
-   iterator(size_t index, vector<T>& v) { this->p = v.data + index; }
+   iterator(size_t index, vector& v) { this->p = v.buffer + index; }
    iterator& operator = (const iterator& rhs)
    {
-      p = std::move(rhs.p);
+      p = rhs.p;
       return *this;
    }
 
-   // equals, not equals operator
+   // equals, not equals, and relative operators
    bool operator != (const iterator& rhs) const { return p != rhs.p; }
    bool operator == (const iterator& rhs) const { return p == rhs.p; }
+   bool operator <  (const iterator& rhs) const { return p <  rhs.p; }
+   bool operator >  (const iterator& rhs) const { return p >  rhs.p; }
+   bool operator <= (const iterator& rhs) const { return p <= rhs.p; }
+   bool operator >= (const iterator& rhs) const { return p >= rhs.p; }
 
-   // dereference operator
-   T& operator * ()
+   // dereference operators
+   T& operator * () const
    {
       return *p;
    }
+   T* operator -> () const
+   {
+      return p;
+   }
+   T& operator [] (difference_type offset) const
+   {
+      return p[offset];
+   }
 
    // prefix increment
    iterator& operator ++ ()
@@ -184,7 +302,7 @@ public:
    // postfix increment
    iterator operator ++ (int postfix)
    {
-      iterator returnCopy(this);
+      iterator returnCopy(*this);
       ++p;
       return returnCopy;
    }
@@ -199,25 +317,101 @@ public:
    // postfix decrement
    iterator operator -- (int postfix)
    {
-      iterator returnCopy(this);
+      iterator returnCopy(*this);
       --p;
       return returnCopy;
    }
 
+   // jump forward or backward
+   iterator& operator += (difference_type offset) { p += offset; return *this; }
+   iterator& operator -= (difference_type offset) { p -= offset; return *this; }
+   iterator  operator +  (difference_type offset) const { return iterator(p + offset); }
+   iterator  operator -  (difference_type offset) const { return iterator(p - offset); }
+   friend iterator operator + (difference_type offset, const iterator& it)
+   {
+      return iterator(it.p + offset);
+   }
+
+   // distance between two iterators
+   difference_type operator - (const iterator& rhs) const { return p - rhs.p; }
+
 private:
    T* p;
 };
 
+/**************************************************
+ * VECTOR CONST ITERATOR
+ * Just like vector::iterator, but through a const vector,
+ * so the elements can be read but not changed.
+ *************************************************/
+template <typename T, typename A, typename G>
+class vector <T, A, G> ::const_iterator
+{
+   friend class ::TestVector; // give unit tests access to the privates
+public:
+   typedef std::random_access_iterator_tag iterator_category;
+   typedef T                               value_type;
+   typedef std::ptrdiff_t                  difference_type;
+   typedef const T *                       pointer;
+   typedef const T &                       reference;
+
+   // constructors, destructors, and assignment operator
+   const_iterator()                          : p(nullptr) {}
+   const_iterator(const T* p)                : p(p)       {}
+   const_iterator(const const_iterator& rhs) : p(rhs.p)   {}
+   const_iterator(const iterator& rhs)       : p(rhs.p)   {}
+   const_iterator& operator = (const const_iterator& rhs)
+   {
+      p = rhs.p;
+      return *this;
+   }
+
+   // equals, not equals, and relative operators
+   bool operator != (const const_iterator& rhs) const { return p != rhs.p; }
+   bool operator == (const const_iterator& rhs) const { return p == rhs.p; }
+   bool operator <  (const const_iterator& rhs) const { return p <  rhs.p; }
+   bool operator >  (const const_iterator& rhs) const { return p >  rhs.p; }
+   bool operator <= (const const_iterator& rhs) const { return p <= rhs.p; }
+   bool operator >= (const const_iterator& rhs) const { return p >= rhs.p; }
+
+   // dereference operators
+   const T& operator *  ()                          const { return *p;        }
+   const T* operator -> ()                          const { return p;         }
+   const T& operator [] (difference_type offset)    const { return p[offset]; }
+
+   // increment and decrement
+   const_iterator& operator ++ ()    { ++p; return *this; }
+   const_iterator& operator -- ()    { --p; return *this; }
+   const_iterator  operator ++ (int) { const_iterator returnCopy(*this); ++p; return returnCopy; }
+   const_iterator  operator -- (int) { const_iterator returnCopy(*this); --p; return returnCopy; }
+
+   // jump forward or backward
+   const_iterator& operator += (difference_type offset) { p += offset; return *this; }
+   const_iterator& operator -= (difference_type offset) { p -= offset; return *this; }
+   const_iterator  operator +  (difference_type offset) const { return const_iterator(p + offset); }
+   const_iterator  operator -  (difference_type offset) const { return const_iterator(p - offset); }
+   friend const_iterator operator + (difference_type offset, const const_iterator& it)
+   {
+      return const_iterator(it.p + offset);
+   }
+
+   // distance between two iterators
+   difference_type operator - (const const_iterator& rhs) const { return p - rhs.p; }
+
+private:
+   const T* p;
+};
+
 
 /*****************************************
  * VECTOR :: NON-DEFAULT constructors
  * non-default constructor: set the number of elements,
  * construct each element, and copy the values over
  ****************************************/
-template <typename T, typename A>
-vector <T, A> :: vector(const A & a) : alloc(a)
+template <typename T, typename A, typename G>
+vector <T, A, G> :: vector(const A & a) : alloc(a)
 {
-   data = alloc.allocate(0);
+   buffer = alloc.allocate(0);
    numElements = 0;
    numCapacity = 0;
 }
@@ -228,11 +422,11 @@ vector <T, A> :: vector(const A & a) : alloc(a)
  * non-default constructor: set the number of elements,
  * construct each element, and copy the values over
  ****************************************/
-template <typename T, typename A>
-vector <T, A> :: vector(size_t num, const T & t, const A & a) : alloc(a)
+template <typename T, typename A, typename G>
+vector <T, A, G> :: vector(size_t num, const T & t, const A & a) : alloc(a)
 {
    // Use the allocator to allocate memory for 'num' elements
-   data = alloc.allocate(num);
+   buffer = alloc.allocate(num);
 
    // Initialize 'numElements' to the given 'num'
    numElements = num;
@@ -242,23 +436,23 @@ vector <T, A> :: vector(size_t num, const T & t, const A & a) : alloc(a)
 
    // Initialize the elements with the provided value 't'
    for (size_t i = 0; i < num; ++i) 
-      alloc.construct(data + i, t);
+      alloc.construct(buffer + i, t);
 }
 
 /*****************************************
  * VECTOR :: INITIALIZATION LIST constructors
  * Create a vector with an initialization list.
  ****************************************/
-template <typename T, typename A>
-vector <T, A> :: vector(const std::initializer_list<T> & l, const A & a) : alloc(a)
+template <typename T, typename A, typename G>
+vector <T, A, G> :: vector(const std::initializer_list<T> & l, const A & a) : alloc(a)
 {
-   data = alloc.allocate(l.size());
+   buffer = alloc.allocate(l.size());
    numElements = l.size();
    numCapacity = l.size();
 
    // Initialize the elements using values from the initializer list.
    for(size_t i = 0; i < numElements; ++i)
-      alloc.construct(data + i, *(l.begin() + i));
+      alloc.construct(buffer + i, *(l.begin() + i));
 }
 
 /*****************************************
@@ -266,15 +460,15 @@ vector <T, A> :: vector(const std::initializer_list<T> & l, const A & a) : alloc
  * non-default constructor: set the number of elements,
  * construct each element, and copy the values over
  ****************************************/
-template <typename T, typename A>
-vector <T, A> :: vector(size_t num, const A & a) : alloc(a)
+template <typename T, typename A, typename G>
+vector <T, A, G> :: vector(size_t num, const A & a) : alloc(a)
 {
-   data = alloc.allocate(num);
+   buffer = alloc.allocate(num);
    numElements = num;
    numCapacity = num;
 
    for (size_t i = 0; i < num; ++i)
-      alloc.construct(data + i);
+      alloc.construct(buffer + i);
 }
 
 /*****************************************
@@ -282,23 +476,23 @@ vector <T, A> :: vector(size_t num, const A & a) : alloc(a)
  * Allocate the space for numElements and
  * call the copy constructor on each element
  ****************************************/
-template <typename T, typename A>
-vector <T, A> :: vector (const vector & rhs) : numCapacity(rhs.numElements), numElements(rhs.numElements), alloc(rhs.alloc)
+template <typename T, typename A, typename G>
+vector <T, A, G> :: vector (const vector & rhs) : numCapacity(rhs.numElements), numElements(rhs.numElements), alloc(rhs.alloc)
 {
-   data = alloc.allocate(numElements);
+   buffer = alloc.allocate(numElements);
    
    for (size_t i = 0; i < numElements; ++i)
-      alloc.construct(data + i, rhs.data[i]);
+      alloc.construct(buffer + i, rhs.buffer[i]);
 }
    
 /*****************************************
  * VECTOR :: MOVE CONSTRUCTOR
  * Steal the values from the RHS and set it to zero.
  ****************************************/
-template <typename T, typename A>
-vector <T, A> :: vector (vector && rhs) 
+template <typename T, typename A, typename G>
+vector <T, A, G> :: vector (vector && rhs) 
 {
-   std::swap(data, rhs.data);
+   std::swap(buffer, rhs.buffer);
    std::swap(numCapacity, rhs.numCapacity);
    std::swap(numElements, rhs.numElements);
 }
@@ -308,15 +502,15 @@ vector <T, A> :: vector (vector && rhs)
  * Call the destructor for each element from 0..numElements
  * and then free the memory
  ****************************************/
-template <typename T, typename A>
-vector <T, A> :: ~vector()
+template <typename T, typename A, typename G>
+vector <T, A, G> :: ~vector()
 {
    for (size_t i = 0; i < numElements; ++i)
-      data[i].~T();
+      buffer[i].~T();
 
-   alloc.deallocate(data, numCapacity);
+   alloc.deallocate(buffer, numCapacity);
    
-   data = nullptr;
+   buffer = nullptr;
    numElements = 0;
    numCapacity = 0;
 }
@@ -328,14 +522,14 @@ vector <T, A> :: ~vector()
  *     INPUT  : newCapacity the size of the new buffer
  *     OUTPUT :
  **************************************/
-template <typename T, typename A>
-void vector <T, A> :: resize(size_t newElements)
+template <typename T, typename A, typename G>
+void vector <T, A, G> :: resize(size_t newElements)
 {
    if (newElements > numElements)
    {
       reserve(newElements);
       for (size_t i = numElements; i < newElements; ++i)
-         alloc.construct(data + i);
+         alloc.construct(buffer + i);
 
       numElements = newElements;
    }
@@ -344,20 +538,20 @@ void vector <T, A> :: resize(size_t newElements)
    {
       //destroy extra elements
       for (size_t i = newElements; i < numElements; ++i)
-         alloc.destroy(data + i);
+         alloc.destroy(buffer + i);
       
       numElements = newElements;
    }
 }
 
-template <typename T, typename A>
-void vector <T, A> :: resize(size_t newElements, const T & t)
+template <typename T, typename A, typename G>
+void vector <T, A, G> :: resize(size_t newElements, const T & t)
 {
    if (newElements > numElements)
    {
       reserve(newElements);
       for (size_t i = numElements; i < newElements; ++i)
-         alloc.construct(data + i, t);
+         alloc.construct(buffer + i, t);
 
       numElements = newElements;
    }
@@ -366,12 +560,63 @@ void vector <T, A> :: resize(size_t newElements, const T & t)
    {
       // destroy extra elements
       for (size_t i = newElements; i < numElements; ++i)
-         alloc.destroy(data + i);
+         alloc.destroy(buffer + i);
 
       numElements = newElements;
    }
 }
 
+/***************************************
+ * VECTOR :: RESIZE DEFAULT INIT
+ * Like resize(), but new elements are default-initialized
+ * rather than value-initialized. For trivial types such as
+ * char or int this leaves the new slots unwritten, so a
+ * buffer about to be filled is not zeroed first.
+ *     INPUT  : newElements the new size
+ *     OUTPUT :
+ **************************************/
+template <typename T, typename A, typename G>
+void vector <T, A, G> :: resize_default_init(size_t newElements)
+{
+   if (newElements > numElements)
+   {
+      reserve(newElements);
+      for (size_t i = numElements; i < newElements; ++i)
+         ::new (static_cast<void *>(buffer + i)) T;
+
+      numElements = newElements;
+   }
+
+   else if (newElements < numElements)
+   {
+      // destroy extra elements
+      for (size_t i = newElements; i < numElements; ++i)
+         alloc.destroy(buffer + i);
+
+      numElements = newElements;
+   }
+}
+
+/***************************************
+ * VECTOR :: RESIZE UNINITIALIZED
+ * Change the size without touching the elements at all.
+ * Only for types with no constructor or destructor work
+ * to do. The caller must write the new slots before
+ * reading them.
+ *     INPUT  : newElements the new size
+ *     OUTPUT :
+ **************************************/
+template <typename T, typename A, typename G>
+void vector <T, A, G> :: resize_uninitialized(size_t newElements)
+{
+   static_assert(std::is_trivially_default_constructible<T>::value &&
+                 std::is_trivially_destructible<T>::value,
+                 "resize_uninitialized requires a trivial type");
+
+   reserve(newElements);
+   numElements = newElements;
+}
+
 /***************************************
  * VECTOR :: RESERVE
  * This method will grow the current buffer
@@ -380,32 +625,54 @@ void vector <T, A> :: resize(size_t newElements, const T & t)
  *     INPUT  : newCapacity the size of the new buffer
  *     OUTPUT :
  **************************************/
-template <typename T, typename A>
-void vector <T, A> :: reserve(size_t newCapacity)
+template <typename T, typename A, typename G>
+void vector <T, A, G> :: reserve(size_t newCapacity)
 {
    if (newCapacity > numCapacity)
    {
       T* newBuffer = alloc.allocate(newCapacity);
-      for (std::size_t i = 0; i < numElements; ++i)
-      {
-         new(newBuffer + i) T(std::move(data[i]));
-         data[i].~T();
-      }
+      relocate(newBuffer, is_trivially_relocatable<T>());
 
-      alloc.deallocate(data, numCapacity);
-      data = newBuffer;
+      alloc.deallocate(buffer, numCapacity);
+      buffer = newBuffer;
       numCapacity = newCapacity;
    }
 }
 
+/***************************************
+ * VECTOR :: RELOCATE
+ * Move the elements from buffer into dataNew, leaving
+ * buffer as raw memory. Trivially relocatable types are
+ * moved in a single block copy
+ *     INPUT  : dataNew a buffer of at least numElements
+ *     OUTPUT :
+ **************************************/
+template <typename T, typename A, typename G>
+void vector <T, A, G> :: relocate(T * dataNew, std::true_type)
+{
+   if (numElements > 0)
+      std::memcpy(static_cast<void *>(dataNew), static_cast<const void *>(buffer),
+                  numElements * sizeof(T));
+}
+
+template <typename T, typename A, typename G>
+void vector <T, A, G> :: relocate(T * dataNew, std::false_type)
+{
+   for (std::size_t i = 0; i < numElements; ++i)
+   {
+      new(dataNew + i) T(std::move(buffer[i]));
+      buffer[i].~T();
+   }
+}
+
 /***************************************
  * VECTOR :: SHRINK TO FIT
  * Get rid of any extra capacity
  *     INPUT  :
  *     OUTPUT :
  **************************************/
-template <typename T, typename A>
-void vector<T, A>::shrink_to_fit()
+template <typename T, typename A, typename G>
+void vector <T, A, G> ::shrink_to_fit()
 {
    if (numElements < numCapacity)
    {
@@ -415,16 +682,16 @@ void vector<T, A>::shrink_to_fit()
       {
          dataNew = alloc.allocate(numElements);
          for (size_t i = 0; i < numElements; ++i)
-            alloc.construct(dataNew + i, data[i]);
+            alloc.construct(dataNew + i, buffer[i]);
       }
 
       for (size_t i = 0; i < numElements; ++i)
-         alloc.destroy(data + i);
+         alloc.destroy(buffer + i);
 
-      if (data != nullptr)
-         alloc.deallocate(data, numCapacity);
+      if (buffer != nullptr)
+         alloc.deallocate(buffer, numCapacity);
 
-      data = dataNew;
+      buffer = dataNew;
       numCapacity = numElements;
    }
 }
@@ -433,90 +700,222 @@ void vector<T, A>::shrink_to_fit()
  * VECTOR :: SUBSCRIPT
  * Read-Write access
  ****************************************/
-template <typename T, typename A>
-T & vector <T, A> :: operator [] (size_t index)
+template <typename T, typename A, typename G>
+T & vector <T, A, G> :: operator [] (size_t index)
 {
-   return data[index];
+   return buffer[index];
 }
 
 /******************************************
  * VECTOR :: SUBSCRIPT
  * Read-Write access
  *****************************************/
-template <typename T, typename A>
-const T & vector <T, A> :: operator [] (size_t index) const
+template <typename T, typename A, typename G>
+const T & vector <T, A, G> :: operator [] (size_t index) const
 {
-   return data[index];
+   return buffer[index];
 }
 
 /*****************************************
  * VECTOR :: FRONT
  * Read-Write access
  ****************************************/
-template <typename T, typename A>
-T & vector <T, A> :: front ()
+template <typename T, typename A, typename G>
+T & vector <T, A, G> :: front ()
 {
-   return data[0];
+   return buffer[0];
 }
 
 /******************************************
  * VECTOR :: FRONT
  * Read-Write access
  *****************************************/
-template <typename T, typename A>
-const T & vector <T, A> :: front () const
+template <typename T, typename A, typename G>
+const T & vector <T, A, G> :: front () const
 {
-   return data[0];
+   return buffer[0];
 }
 
 /*****************************************
  * VECTOR :: FRONT
  * Read-Write access
  ****************************************/
-template <typename T, typename A>
-T & vector <T, A> :: back()
+template <typename T, typename A, typename G>
+T & vector <T, A, G> :: back()
 {
-   return data[numElements - 1];
+   return buffer[numElements - 1];
 }
 
 /******************************************
  * VECTOR :: FRONT
  * Read-Write access
  *****************************************/
-template <typename T, typename A>
-const T & vector <T, A> :: back() const
+template <typename T, typename A, typename G>
+const T & vector <T, A, G> :: back() const
 {
-   return data[numElements - 1];
+   return buffer[numElements - 1];
 }
 
 /***************************************
  * VECTOR :: PUSH BACK
  * This method will add the element 't' to the
  * end of the current buffer.  It will also grow
- * the buffer as needed to accomodate the new element
+ * the buffer as needed to accomodate the new element,
+ * using the growth policy G to pick the new capacity
  *     INPUT  : 't' the new element to be added
  *     OUTPUT : *this
  **************************************/
-template <typename T, typename A>
-void vector <T, A> :: push_back (const T & t)
+template <typename T, typename A, typename G>
+void vector <T, A, G> :: push_back (const T & t)
 {
    if (numElements == numCapacity)
-      reserve(numCapacity == 0 ? 1 : numCapacity * 2);
+      reserve(G::grow(numCapacity, sizeof(T)));
 
-   new(data + numElements) T(t);
+   new(buffer + numElements) T(t);
    ++numElements;
 }
 
-template <typename T, typename A>
-void vector <T, A> ::push_back(T && t)
+template <typename T, typename A, typename G>
+void vector <T, A, G> ::push_back(T && t)
 {
    if (numElements == numCapacity)
-      reserve(numCapacity == 0 ? 1 : numCapacity * 2);
+      reserve(G::grow(numCapacity, sizeof(T)));
 
-   new(data + numElements) T(std::move(t));
+   new(buffer + numElements) T(std::move(t));
    ++numElements;
 }
 
+/***************************************
+ * VECTOR :: EMPLACE BACK
+ * Construct a new element at the end of the buffer
+ * directly from args, without a temporary
+ *     INPUT  : args the constructor parameters
+ *     OUTPUT : the new element
+ **************************************/
+template <typename T, typename A, typename G>
+template <class ... Args>
+T & vector <T, A, G> :: emplace_back(Args && ... args)
+{
+   if (numElements == numCapacity)
+      reserve(G::grow(numCapacity, sizeof(T)));
+
+   alloc.construct(buffer + numElements, std::forward<Args>(args)...);
+   return buffer[numElements++];
+}
+
+/***************************************
+ * VECTOR :: INSERT
+ * Insert the range [first, last) before pos. The
+ * buffer grows at most once, the elements after pos
+ * are shifted once, and each new element is
+ * constructed in place.
+ *     INPUT  : pos   where the range goes
+ *              first, last a forward iterator range
+ *     OUTPUT : an iterator to the first inserted element
+ **************************************/
+template <typename T, typename A, typename G>
+template <class Iterator>
+typename vector <T, A, G> :: iterator
+vector <T, A, G> :: insert(iterator pos, Iterator first, Iterator last)
+{
+   size_t index = pos.p - buffer;
+   assert(index <= numElements);
+   size_t numInsert = std::distance(first, last);
+   if (numInsert == 0)
+      return iterator(buffer + index);
+
+   growFor(numElements + numInsert);
+   shiftRight(index, numInsert, is_trivially_relocatable<T>());
+
+   for (size_t i = index; first != last; ++first, ++i)
+      alloc.construct(buffer + i, *first);
+   numElements += numInsert;
+
+   return iterator(buffer + index);
+}
+
+/***************************************
+ * VECTOR :: APPEND
+ * Add the range [first, last) to the end,
+ * growing the buffer at most once
+ *     INPUT  : first, last a forward iterator range
+ *     OUTPUT :
+ **************************************/
+template <typename T, typename A, typename G>
+template <class Iterator>
+void vector <T, A, G> :: append(Iterator first, Iterator last)
+{
+   growFor(numElements + std::distance(first, last));
+
+   for (; first != last; ++first)
+      alloc.construct(buffer + numElements++, *first);
+}
+
+/***************************************
+ * VECTOR :: ASSIGN
+ * Replace the contents with [first, last),
+ * reusing the buffer when it is big enough
+ *     INPUT  : first, last a forward iterator range
+ *     OUTPUT :
+ **************************************/
+template <typename T, typename A, typename G>
+template <class Iterator>
+void vector <T, A, G> :: assign(Iterator first, Iterator last)
+{
+   clear();
+   reserve(std::distance(first, last));
+
+   for (; first != last; ++first)
+      alloc.construct(buffer + numElements++, *first);
+}
+
+/***************************************
+ * VECTOR :: GROW FOR
+ * Make sure there is room for numNeeded elements.
+ * When we must grow, grow by at least what the
+ * growth policy asks for so repeated appends stay
+ * amortized constant
+ *     INPUT  : numNeeded the number of elements to hold
+ *     OUTPUT :
+ **************************************/
+template <typename T, typename A, typename G>
+void vector <T, A, G> :: growFor(size_t numNeeded)
+{
+   if (numNeeded > numCapacity)
+   {
+      size_t numGrow = G::grow(numCapacity, sizeof(T));
+      reserve(numGrow > numNeeded ? numGrow : numNeeded);
+   }
+}
+
+/***************************************
+ * VECTOR :: SHIFT RIGHT
+ * Move the elements from index to the end up by
+ * numShift, leaving a hole of raw memory at index.
+ * The buffer must already have room.
+ *     INPUT  : index    the start of the hole
+ *              numShift the size of the hole
+ *     OUTPUT :
+ **************************************/
+template <typename T, typename A, typename G>
+void vector <T, A, G> :: shiftRight(size_t index, size_t numShift, std::true_type)
+{
+   if (index < numElements)
+      std::memmove(static_cast<void *>(buffer + index + numShift),
+                   static_cast<const void *>(buffer + index),
+                   (numElements - index) * sizeof(T));
+}
+
+template <typename T, typename A, typename G>
+void vector <T, A, G> :: shiftRight(size_t index, size_t numShift, std::false_type)
+{
+   for (size_t i = numElements; i > index; --i)
+   {
+      alloc.construct(buffer + i - 1 + numShift, std::move(buffer[i - 1]));
+      alloc.destroy(buffer + i - 1);
+   }
+}
+
 /***************************************
  * VECTOR :: ASSIGNMENT
  * This operator will copy the contents of the
@@ -524,13 +923,13 @@ void vector <T, A> ::push_back(T && t)
  *     INPUT  : rhs the vector to copy from
  *     OUTPUT : *this
  **************************************/
-template <typename T, typename A>
-vector <T, A> & vector <T, A> :: operator = (const vector & rhs)
+template <typename T, typename A, typename G>
+vector <T, A, G> & vector <T, A, G> :: operator = (const vector & rhs)
 {
    if (rhs.size() == size())
       for (size_t i = 0; i < size(); ++i)
       {
-         data[i] = rhs.data[i];
+         buffer[i] = rhs.buffer[i];
       }
 
    else if (rhs.size() > size())
@@ -538,10 +937,10 @@ vector <T, A> & vector <T, A> :: operator = (const vector & rhs)
       if (rhs.size() <= capacity())
       {
          for (size_t i = 0; i < size(); ++i)
-            data[i] = rhs.data[i];
+            buffer[i] = rhs.buffer[i];
 
          for (size_t i = numElements; i < rhs.size(); ++i)
-            alloc.construct(data + i, rhs.data[i]);
+            alloc.construct(buffer + i, rhs.buffer[i]);
       }
 
       else
@@ -549,11 +948,11 @@ vector <T, A> & vector <T, A> :: operator = (const vector & rhs)
          T* dataNew = alloc.allocate(rhs.size());
          
          for (size_t i = 0; i < rhs.size(); ++i)
-            alloc.construct(dataNew + i, rhs.data[i]);
+            alloc.construct(dataNew + i, rhs.buffer[i]);
 
          clear();
-         alloc.deallocate(data, numCapacity);
-         data = dataNew;
+         alloc.deallocate(buffer, numCapacity);
+         buffer = dataNew;
          numCapacity = rhs.size();
       }
    }
@@ -561,24 +960,24 @@ vector <T, A> & vector <T, A> :: operator = (const vector & rhs)
    else
    {
       for (size_t i = 0; i < rhs.size(); ++i)
-         data[i] = rhs.data[i];
+         buffer[i] = rhs.buffer[i];
 
       for (size_t i = rhs.size(); i < size(); ++i)
-         alloc.destroy(data + i);
+         alloc.destroy(buffer + i);
    }
 
    numElements = rhs.size();
 
    return *this;
 }
-template <typename T, typename A>
-vector <T, A>& vector <T, A> :: operator = (vector&& rhs)
+template <typename T, typename A, typename G>
+vector <T, A, G>& vector <T, A, G> :: operator = (vector&& rhs)
 {
    swap(rhs);
    shrink_to_fit();
    rhs.clear();
 
-   rhs.data = nullptr;
+   rhs.buffer = nullptr;
    rhs.numCapacity = 0;
 
    return *this;
@@ -0,0 +1,714 @@
+/***********************************************************************
+ * Header:
+ *    VECTOR SIMD
+ * Summary:
+ *    Vectorized search and fill kernels for a vector of numbers
+ *      __      __     _______        __
+ *     /  |    /  |   |  _____|   _  / /
+ *     `| |    `| |   | |____    (_)/ /
+ *      | |     | |   '_.____''.   / / _
+ *     _| |_   _| |_  | \____) |  / / (_)
+ *    |_____| |_____|  \______.' /_/
+ *
+ *    This will contain the definitions of:
+ *        simd::find   : index of the first element equal to a value
+ *        simd::count  : number of elements equal to a value
+ *        simd::fill   : set every element to a value
+ *        simd::min    : the smallest element
+ *        simd::max    : the largest element
+ *        simd::sum    : the total of the elements
+ *    int32_t and float use SSE2 or AVX2, picked at run time from
+ *    what the CPU supports. Every other arithmetic type, double and
+ *    int64_t included, and every CPU that is not x86-64, uses the
+ *    scalar loop.
+ * Author
+ *    Peter Benson, Jarom Diaz, Isaac Radford
+ ************************************************************************/
+
+#pragma once
+
+#include <cassert>     // because I am paranoid
+#include <cstddef>     // for size_t
+#include <cstdint>     // for int32_t, int64_t, and uint64_t
+#include <utility>     // for std::pair
+#include <type_traits> // for std::is_arithmetic and std::is_integral
+#include "vector.h"
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define CUSTOM_SIMD_X86
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#define CUSTOM_TARGET_AVX2
+#else
+#define CUSTOM_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
+
+class TestVectorSimd; // forward declaration for unit tests
+
+namespace custom
+{
+namespace simd
+{
+
+/*****************************************
+ * LEVEL
+ * The instruction sets a kernel may use
+ ****************************************/
+enum Level { SCALAR, SSE2, AVX2 };
+
+/*****************************************
+ * DETECT
+ * Ask the CPU which instruction sets it supports
+ ****************************************/
+inline Level detect()
+{
+#ifdef CUSTOM_SIMD_X86
+#if defined(_MSC_VER) && !defined(__clang__)
+   int info[4];
+   __cpuid(info, 0);
+   if (info[0] >= 7)
+   {
+      // AVX2 needs the CPU bit and an OS that saves the YMM registers
+      __cpuid(info, 1);
+      bool osxsave = (info[2] & (1 << 27)) != 0;
+      bool avx     = (info[2] & (1 << 28)) != 0;
+      if (osxsave && avx && (_xgetbv(0) & 6) == 6)
+      {
+         __cpuidex(info, 7, 0);
+         if (info[1] & (1 << 5))
+            return AVX2;
+      }
+   }
+   return SSE2;   // every x86-64 CPU has SSE2
+#else
+   __builtin_cpu_init();
+   return __builtin_cpu_supports("avx2") ? AVX2 : SSE2;
+#endif
+#else
+   return SCALAR;
+#endif
+}
+
+/*****************************************
+ * ACTIVE
+ * The best level for this CPU, detected once
+ ****************************************/
+inline Level active()
+{
+   static const Level level = detect();
+   return level;
+}
+
+/*****************************************
+ * SUM TYPE
+ * What sum() adds into. Every integer widens to
+ * 64 bits, keeping its sign, so millions of values
+ * do not overflow. float widens to double so a long
+ * total keeps its precision. double and long double
+ * add into themselves.
+ ****************************************/
+template <typename T,
+          bool isIntegral = std::is_integral<T>::value,
+          bool isSigned   = std::is_signed<T>::value>
+struct sum_type                      { typedef T        type; };
+template <typename T>
+struct sum_type<T, true, true>       { typedef int64_t  type; };
+template <typename T>
+struct sum_type<T, true, false>      { typedef uint64_t type; };
+template <>
+struct sum_type<float, false, true>  { typedef double   type; };
+
+/*****************************************
+ * SCALAR KERNELS
+ * The plain loops. Every other kernel falls
+ * back on these for the elements left over
+ * after the last full register.
+ ****************************************/
+template <typename T>
+size_t findKernel(const T * p, size_t n, T t, Level)
+{
+   for (size_t i = 0; i < n; ++i)
+      if (p[i] == t)
+         return i;
+   return n;
+}
+
+template <typename T>
+size_t countKernel(const T * p, size_t n, T t, Level)
+{
+   size_t num = 0;
+   for (size_t i = 0; i < n; ++i)
+      if (p[i] == t)
+         ++num;
+   return num;
+}
+
+template <typename T>
+void fillKernel(T * p, size_t n, T t, Level)
+{
+   for (size_t i = 0; i < n; ++i)
+      p[i] = t;
+}
+
+template <typename T>
+std::pair<T, T> minmaxKernel(const T * p, size_t n, Level)
+{
+   assert(n > 0);
+   std::pair<T, T> result(p[0], p[0]);
+   for (size_t i = 1; i < n; ++i)
+   {
+      if (p[i] < result.first)
+         result.first = p[i];
+      if (result.second < p[i])
+         result.second = p[i];
+   }
+   return result;
+}
+
+template <typename T>
+typename sum_type<T>::type sumKernel(const T * p, size_t n, Level)
+{
+   typename sum_type<T>::type total = 0;
+   for (size_t i = 0; i < n; ++i)
+      total += p[i];
+   return total;
+}
+
+#ifdef CUSTOM_SIMD_X86
+
+/*****************************************
+ * MASK HELPERS
+ * Movemask results are at most 8 bits wide
+ ****************************************/
+inline int countBits(unsigned int mask)
+{
+   int num = 0;
+   for (; mask; mask &= mask - 1)
+      ++num;
+   return num;
+}
+
+inline int lowestBit(unsigned int mask)
+{
+   assert(mask != 0);
+   int index = 0;
+   for (; !(mask & 1); mask >>= 1)
+      ++index;
+   return index;
+}
+
+/*****************************************
+ * INT32 SSE2 KERNELS
+ * Four lanes at a time
+ ****************************************/
+inline size_t findSSE2(const int32_t * p, size_t n, int32_t t)
+{
+   const __m128i key = _mm_set1_epi32(t);
+   size_t i = 0;
+   for (; i + 4 <= n; i += 4)
+   {
+      __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + i));
+      int mask = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(x, key)));
+      if (mask)
+         return i + lowestBit(mask);
+   }
+   return i + findKernel(p + i, n - i, t, SCALAR);
+}
+
+inline size_t countSSE2(const int32_t * p, size_t n, int32_t t)
+{
+   const __m128i key = _mm_set1_epi32(t);
+   size_t num = 0;
+   size_t i = 0;
+   for (; i + 4 <= n; i += 4)
+   {
+      __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + i));
+      num += countBits(_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(x, key))));
+   }
+   return num + countKernel(p + i, n - i, t, SCALAR);
+}
+
+inline void fillSSE2(int32_t * p, size_t n, int32_t t)
+{
+   const __m128i value = _mm_set1_epi32(t);
+   size_t i = 0;
+   for (; i + 4 <= n; i += 4)
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(p + i), value);
+   fillKernel(p + i, n - i, t, SCALAR);
+}
+
+inline std::pair<int32_t, int32_t> minmaxSSE2(const int32_t * p, size_t n)
+{
+   if (n < 4)
+      return minmaxKernel(p, n, SCALAR);
+
+   // SSE2 has no min/max for int32, so select with a compare mask
+   __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+   __m128i hi = lo;
+   size_t i = 4;
+   for (; i + 4 <= n; i += 4)
+   {
+      __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + i));
+      __m128i less = _mm_cmpgt_epi32(lo, x);
+      __m128i more = _mm_cmpgt_epi32(x, hi);
+      lo = _mm_or_si128(_mm_and_si128(less, x), _mm_andnot_si128(less, lo));
+      hi = _mm_or_si128(_mm_and_si128(more, x), _mm_andnot_si128(more, hi));
+   }
+
+   int32_t lanesLo[4];
+   int32_t lanesHi[4];
+   _mm_storeu_si128(reinterpret_cast<__m128i *>(lanesLo), lo);
+   _mm_storeu_si128(reinterpret_cast<__m128i *>(lanesHi), hi);
+   std::pair<int32_t, int32_t> result = minmaxKernel(lanesLo, 4, SCALAR);
+   result.second = minmaxKernel(lanesHi, 4, SCALAR).second;
+   for (; i < n; ++i)
+   {
+      if (p[i] < result.first)
+         result.first = p[i];
+      if (result.second < p[i])
+         result.second = p[i];
+   }
+   return result;
+}
+
+inline int64_t sumSSE2(const int32_t * p, size_t n)
+{
+   // sign extend each lane to 64 bits before adding
+   __m128i total = _mm_setzero_si128();
+   size_t i = 0;
+   for (; i + 4 <= n; i += 4)
+   {
+      __m128i x    = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + i));
+      __m128i sign = _mm_srai_epi32(x, 31);
+      total = _mm_add_epi64(total, _mm_unpacklo_epi32(x, sign));
+      total = _mm_add_epi64(total, _mm_unpackhi_epi32(x, sign));
+   }
+
+   int64_t lanes[2];
+   _mm_storeu_si128(reinterpret_cast<__m128i *>(lanes), total);
+   return lanes[0] + lanes[1] + sumKernel(p + i, n - i, SCALAR);
+}
+
+/*****************************************
+ * INT32 AVX2 KERNELS
+ * Eight lanes at a time
+ ****************************************/
+CUSTOM_TARGET_AVX2
+inline size_t findAVX2(const int32_t * p, size_t n, int32_t t)
+{
+   const __m256i key = _mm256_set1_epi32(t);
+   size_t i = 0;
+   for (; i + 8 <= n; i += 8)
+   {
+      __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p + i));
+      int mask = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(x, key)));
+      if (mask)
+         return i + lowestBit(mask);
+   }
+   return i + findSSE2(p + i, n - i, t);
+}
+
+CUSTOM_TARGET_AVX2
+inline size_t countAVX2(const int32_t * p, size_t n, int32_t t)
+{
+   const __m256i key = _mm256_set1_epi32(t);
+   size_t num = 0;
+   size_t i = 0;
+   for (; i + 8 <= n; i += 8)
+   {
+      __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p + i));
+      num += countBits(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(x, key))));
+   }
+   return num + countSSE2(p + i, n - i, t);
+}
+
+CUSTOM_TARGET_AVX2
+inline void fillAVX2(int32_t * p, size_t n, int32_t t)
+{
+   const __m256i value = _mm256_set1_epi32(t);
+   size_t i = 0;
+   for (; i + 8 <= n; i += 8)
+      _mm256_storeu_si256(reinterpret_cast<__m256i *>(p + i), value);
+   fillSSE2(p + i, n - i, t);
+}
+
+CUSTOM_TARGET_AVX2
+inline std::pair<int32_t, int32_t> minmaxAVX2(const int32_t * p, size_t n)
+{
+   if (n < 8)
+      return minmaxSSE2(p, n);
+
+   __m256i lo = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+   __m256i hi = lo;
+   size_t i = 8;
+   for (; i + 8 <= n; i += 8)
+   {
+      __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p + i));
+      lo = _mm256_min_epi32(lo, x);
+      hi = _mm256_max_epi32(hi, x);
+   }
+
+   int32_t lanesLo[8];
+   int32_t lanesHi[8];
+   _mm256_storeu_si256(reinterpret_cast<__m256i *>(lanesLo), lo);
+   _mm256_storeu_si256(reinterpret_cast<__m256i *>(lanesHi), hi);
+   std::pair<int32_t, int32_t> result = minmaxKernel(lanesLo, 8, SCALAR);
+   result.second = minmaxKernel(lanesHi, 8, SCALAR).second;
+   for (; i < n; ++i)
+   {
+      if (p[i] < result.first)
+         result.first = p[i];
+      if (result.second < p[i])
+         result.second = p[i];
+   }
+   return result;
+}
+
+CUSTOM_TARGET_AVX2
+inline int64_t sumAVX2(const int32_t * p, size_t n)
+{
+   __m256i total = _mm256_setzero_si256();
+   size_t i = 0;
+   for (; i + 8 <= n; i += 8)
+   {
+      __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + i));
+      __m128i hi = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + i + 4));
+      total = _mm256_add_epi64(total, _mm256_cvtepi32_epi64(lo));
+      total = _mm256_add_epi64(total, _mm256_cvtepi32_epi64(hi));
+   }
+
+   int64_t lanes[4];
+   _mm256_storeu_si256(reinterpret_cast<__m256i *>(lanes), total);
+   return lanes[0] + lanes[1] + lanes[2] + lanes[3] + sumSSE2(p + i, n - i);
+}
+
+/*****************************************
+ * FLOAT SSE2 KERNELS
+ * Four lanes at a time. Like ==, a NaN never
+ * matches. min and max are unspecified when
+ * the vector holds a NaN.
+ ****************************************/
+inline size_t findSSE2(const float * p, size_t n, float t)
+{
+   const __m128 key = _mm_set1_ps(t);
+   size_t i = 0;
+   for (; i + 4 <= n; i += 4)
+   {
+      int mask = _mm_movemask_ps(_mm_cmpeq_ps(_mm_loadu_ps(p + i), key));
+      if (mask)
+         return i + lowestBit(mask);
+   }
+   return i + findKernel(p + i, n - i, t, SCALAR);
+}
+
+inline size_t countSSE2(const float * p, size_t n, float t)
+{
+   const __m128 key = _mm_set1_ps(t);
+   size_t num = 0;
+   size_t i = 0;
+   for (; i + 4 <= n; i += 4)
+      num += countBits(_mm_movemask_ps(_mm_cmpeq_ps(_mm_loadu_ps(p + i), key)));
+   return num + countKernel(p + i, n - i, t, SCALAR);
+}
+
+inline void fillSSE2(float * p, size_t n, float t)
+{
+   const __m128 value = _mm_set1_ps(t);
+   size_t i = 0;
+   for (; i + 4 <= n; i += 4)
+      _mm_storeu_ps(p + i, value);
+   fillKernel(p + i, n - i, t, SCALAR);
+}
+
+inline std::pair<float, float> minmaxSSE2(const float * p, size_t n)
+{
+   if (n < 4)
+      return minmaxKernel(p, n, SCALAR);
+
+   __m128 lo = _mm_loadu_ps(p);
+   __m128 hi = lo;
+   size_t i = 4;
+   for (; i + 4 <= n; i += 4)
+   {
+      __m128 x = _mm_loadu_ps(p + i);
+      lo = _mm_min_ps(lo, x);
+      hi = _mm_max_ps(hi, x);
+   }
+
+   float lanesLo[4];
+   float lanesHi[4];
+   _mm_storeu_ps(lanesLo, lo);
+   _mm_storeu_ps(lanesHi, hi);
+   std::pair<float, float> result = minmaxKernel(lanesLo, 4, SCALAR);
+   result.second = minmaxKernel(lanesHi, 4, SCALAR).second;
+   for (; i < n; ++i)
+   {
+      if (p[i] < result.first)
+         result.first = p[i];
+      if (result.second < p[i])
+         result.second = p[i];
+   }
+   return result;
+}
+
+inline double sumSSE2(const float * p, size_t n)
+{
+   // widen each pair of lanes to double before adding
+   __m128d total = _mm_setzero_pd();
+   size_t i = 0;
+   for (; i + 4 <= n; i += 4)
+   {
+      __m128 x = _mm_loadu_ps(p + i);
+      total = _mm_add_pd(total, _mm_cvtps_pd(x));
+      total = _mm_add_pd(total, _mm_cvtps_pd(_mm_movehl_ps(x, x)));
+   }
+
+   double lanes[2];
+   _mm_storeu_pd(lanes, total);
+   return (lanes[0] + lanes[1]) + sumKernel(p + i, n - i, SCALAR);
+}
+
+/*****************************************
+ * FLOAT AVX2 KERNELS
+ * Eight lanes at a time
+ ****************************************/
+CUSTOM_TARGET_AVX2
+inline size_t findAVX2(const float * p, size_t n, float t)
+{
+   const __m256 key = _mm256_set1_ps(t);
+   size_t i = 0;
+   for (; i + 8 <= n; i += 8)
+   {
+      int mask = _mm256_movemask_ps(_mm256_cmp_ps(_mm256_loadu_ps(p + i), key, _CMP_EQ_OQ));
+      if (mask)
+         return i + lowestBit(mask);
+   }
+   return i + findSSE2(p + i, n - i, t);
+}
+
+CUSTOM_TARGET_AVX2
+inline size_t countAVX2(const float * p, size_t n, float t)
+{
+   const __m256 key = _mm256_set1_ps(t);
+   size_t num = 0;
+   size_t i = 0;
+   for (; i + 8 <= n; i += 8)
+      num += countBits(_mm256_movemask_ps(_mm256_cmp_ps(_mm256_loadu_ps(p + i), key, _CMP_EQ_OQ)));
+   return num + countSSE2(p + i, n - i, t);
+}
+
+CUSTOM_TARGET_AVX2
+inline void fillAVX2(float * p, size_t n, float t)
+{
+   const __m256 value = _mm256_set1_ps(t);
+   size_t i = 0;
+   for (; i + 8 <= n; i += 8)
+      _mm256_storeu_ps(p + i, value);
+   fillSSE2(p + i, n - i, t);
+}
+
+CUSTOM_TARGET_AVX2
+inline std::pair<float, float> minmaxAVX2(const float * p, size_t n)
+{
+   if (n < 8)
+      return minmaxSSE2(p, n);
+
+   __m256 lo = _mm256_loadu_ps(p);
+   __m256 hi = lo;
+   size_t i = 8;
+   for (; i + 8 <= n; i += 8)
+   {
+      __m256 x = _mm256_loadu_ps(p + i);
+      lo = _mm256_min_ps(lo, x);
+      hi = _mm256_max_ps(hi, x);
+   }
+
+   float lanesLo[8];
+   float lanesHi[8];
+   _mm256_storeu_ps(lanesLo, lo);
+   _mm256_storeu_ps(lanesHi, hi);
+   std::pair<float, float> result = minmaxKernel(lanesLo, 8, SCALAR);
+   result.second = minmaxKernel(lanesHi, 8, SCALAR).second;
+   for (; i < n; ++i)
+   {
+      if (p[i] < result.first)
+         result.first = p[i];
+      if (result.second < p[i])
+         result.second = p[i];
+   }
+   return result;
+}
+
+CUSTOM_TARGET_AVX2
+inline double sumAVX2(const float * p, size_t n)
+{
+   __m256d total = _mm256_setzero_pd();
+   size_t i = 0;
+   for (; i + 8 <= n; i += 8)
+   {
+      total = _mm256_add_pd(total, _mm256_cvtps_pd(_mm_loadu_ps(p + i)));
+      total = _mm256_add_pd(total, _mm256_cvtps_pd(_mm_loadu_ps(p + i + 4)));
+   }
+
+   double lanes[4];
+   _mm256_storeu_pd(lanes, total);
+   return ((lanes[0] + lanes[1]) + (lanes[2] + lanes[3])) + sumSSE2(p + i, n - i);
+}
+
+#endif // CUSTOM_SIMD_X86
+
+/*****************************************
+ * DISPATCH
+ * int32_t and float pick the kernel for the
+ * requested level. These are exact matches, so
+ * they win over the scalar templates above.
+ ****************************************/
+#ifdef CUSTOM_SIMD_X86
+#define CUSTOM_SIMD_DISPATCH(name, ...)                  \
+   switch (level)                                        \
+   {                                                     \
+      case AVX2:   return name##AVX2(__VA_ARGS__);       \
+      case SSE2:   return name##SSE2(__VA_ARGS__);       \
+      default:     break;                                \
+   }
+#else
+#define CUSTOM_SIMD_DISPATCH(name, ...)
+#endif
+
+inline size_t findKernel(const int32_t * p, size_t n, int32_t t, Level level)
+{
+   CUSTOM_SIMD_DISPATCH(find, p, n, t)
+   return findKernel<int32_t>(p, n, t, SCALAR);
+}
+
+inline size_t findKernel(const float * p, size_t n, float t, Level level)
+{
+   CUSTOM_SIMD_DISPATCH(find, p, n, t)
+   return findKernel<float>(p, n, t, SCALAR);
+}
+
+inline size_t countKernel(const int32_t * p, size_t n, int32_t t, Level level)
+{
+   CUSTOM_SIMD_DISPATCH(count, p, n, t)
+   return countKernel<int32_t>(p, n, t, SCALAR);
+}
+
+inline size_t countKernel(const float * p, size_t n, float t, Level level)
+{
+   CUSTOM_SIMD_DISPATCH(count, p, n, t)
+   return countKernel<float>(p, n, t, SCALAR);
+}
+
+inline void fillKernel(int32_t * p, size_t n, int32_t t, Level level)
+{
+   CUSTOM_SIMD_DISPATCH(fill, p, n, t)
+   fillKernel<int32_t>(p, n, t, SCALAR);
+}
+
+inline void fillKernel(float * p, size_t n, float t, Level level)
+{
+   CUSTOM_SIMD_DISPATCH(fill, p, n, t)
+   fillKernel<float>(p, n, t, SCALAR);
+}
+
+inline std::pair<int32_t, int32_t> minmaxKernel(const int32_t * p, size_t n, Level level)
+{
+   CUSTOM_SIMD_DISPATCH(minmax, p, n)
+   return minmaxKernel<int32_t>(p, n, SCALAR);
+}
+
+inline std::pair<float, float> minmaxKernel(const float * p, size_t n, Level level)
+{
+   CUSTOM_SIMD_DISPATCH(minmax, p, n)
+   return minmaxKernel<float>(p, n, SCALAR);
+}
+
+inline int64_t sumKernel(const int32_t * p, size_t n, Level level)
+{
+   CUSTOM_SIMD_DISPATCH(sum, p, n)
+   return sumKernel<int32_t>(p, n, SCALAR);
+}
+
+inline double sumKernel(const float * p, size_t n, Level level)
+{
+   CUSTOM_SIMD_DISPATCH(sum, p, n)
+   return sumKernel<float>(p, n, SCALAR);
+}
+
+#undef CUSTOM_SIMD_DISPATCH
+
+/*****************************************
+ * SIMD :: FIND
+ * The first element equal to t, or end()
+ ****************************************/
+template <typename T, typename A, typename G>
+typename vector <T, A, G> :: const_iterator find(const vector <T, A, G> & v, const T & t)
+{
+   static_assert(std::is_arithmetic<T>::value, "simd::find needs a vector of numbers");
+   return v.cbegin() + findKernel(v.data(), v.size(), t, active());
+}
+
+/*****************************************
+ * SIMD :: COUNT
+ * How many elements equal t
+ ****************************************/
+template <typename T, typename A, typename G>
+size_t count(const vector <T, A, G> & v, const T & t)
+{
+   static_assert(std::is_arithmetic<T>::value, "simd::count needs a vector of numbers");
+   return countKernel(v.data(), v.size(), t, active());
+}
+
+/*****************************************
+ * SIMD :: FILL
+ * Set every element to t
+ ****************************************/
+template <typename T, typename A, typename G>
+void fill(vector <T, A, G> & v, const T & t)
+{
+   static_assert(std::is_arithmetic<T>::value, "simd::fill needs a vector of numbers");
+   fillKernel(v.data(), v.size(), t, active());
+}
+
+/*****************************************
+ * SIMD :: MIN and MAX
+ * The smallest and largest element. The vector
+ * must not be empty.
+ ****************************************/
+template <typename T, typename A, typename G>
+std::pair<T, T> minmax(const vector <T, A, G> & v)
+{
+   static_assert(std::is_arithmetic<T>::value, "simd::minmax needs a vector of numbers");
+   assert(!v.empty());
+   return minmaxKernel(v.data(), v.size(), active());
+}
+
+template <typename T, typename A, typename G>
+T min(const vector <T, A, G> & v)
+{
+   return minmax(v).first;
+}
+
+template <typename T, typename A, typename G>
+T max(const vector <T, A, G> & v)
+{
+   return minmax(v).second;
+}
+
+/*****************************************
+ * SIMD :: SUM
+ * The total of every element, in sum_type. The lanes
+ * are added separately, so a float total can differ
+ * from the scalar loop in the last few bits.
+ ****************************************/
+template <typename T, typename A, typename G>
+typename sum_type<T>::type sum(const vector <T, A, G> & v)
+{
+   static_assert(std::is_arithmetic<T>::value, "simd::sum needs a vector of numbers");
+   return sumKernel(v.data(), v.size(), active());
+}
+
+} // namespace simd
+} // namespace custom